@@ -0,0 +1,488 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <bench/bench.h>
+
+#include <algorithm>                          // for sort, max
+#include <credence/error.h>                   // for credence_error
+#include <credence/frontend/compile.h>        // for compile, Program
+#include <credence/ir/cfg.h>                  // for emit_cfg
+#include <credence/ir/ssa.h>                  // for emit_ssa
+#include <credence/ir/symbols.h>              // for hoisted_symbols
+#include <credence/ir/table.h>                // for emit
+#include <credence/passes.h>                  // for Report, Scope
+#include <credence/target/arm64/generator.h>  // for emit
+#include <credence/target/common/assembly.h>  // for Arch_Type, get_os_type
+#include <credence/target/common/runtime.h>   // for add_stdlib_functions_t...
+#include <credence/target/x86_64/generator.h> // for emit
+#include <fmt/format.h>                       // for format
+#include <map>                                // for map
+#include <ostream>                            // for ostream
+#include <sstream>                            // for ostringstream
+
+namespace credence::bench {
+
+namespace {
+
+/**
+ * @brief splitmix64, so a seed gives the same program on every platform
+ */
+class Random
+{
+  public:
+    explicit Random(std::uint64_t seed)
+        : state_(seed)
+    {
+    }
+
+    std::uint64_t next()
+    {
+        auto z = (state_ += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief A value in [0, bound)
+     */
+    std::size_t below(std::size_t bound)
+    {
+        return bound == 0 ? 0 : static_cast<std::size_t>(next() % bound);
+    }
+
+  private:
+    std::uint64_t state_;
+};
+
+constexpr std::size_t vector_size = 8;
+
+/**
+ * @brief Writes one function of a program at a time
+ */
+class Generator
+{
+  public:
+    Generator(Shape const& shape, std::string& out)
+        : shape_(shape)
+        , random_(shape.seed)
+        , out_(out)
+    {
+    }
+
+    void function(std::size_t index)
+    {
+        index_ = index;
+        auto n = std::to_string(index);
+        out_ += "f" + n + "(a, b) {\n  auto x, y, z, t";
+        for (std::size_t i = 0; i < shape_.vectors; ++i)
+            out_ += fmt::format(", v{}[{}]", i, vector_size);
+        for (std::size_t i = 0; i < shape_.strings; ++i)
+            out_ += fmt::format(", *s{}", i);
+        // the parameters are passed and not read, as the arm64 backend
+        // does not yet address a parameter in a local's expression
+        out_ += ";\n  x = 1;\n  y = 2;\n  z = 0;\n  t = 0;\n";
+        // the table rejects a read of an element never written
+        for (std::size_t i = 0; i < shape_.vectors; ++i)
+            for (std::size_t j = 0; j < vector_size; ++j)
+                out_ += fmt::format("  v{}[{}] = {};\n", i, j, j);
+        for (std::size_t i = 0; i < shape_.strings; ++i)
+            out_ += fmt::format("  s{} = \"bench {} {}\";\n", i, index, i);
+        for (std::size_t i = 0; i < shape_.statements; ++i)
+            statement(1);
+        out_ += "  return(x);\n}\n\n";
+    }
+
+  private:
+    void indent(std::size_t level) { out_.append(level * 2, ' '); }
+
+    std::string_view variable()
+    {
+        static constexpr std::string_view names[] = { "x", "y", "z" };
+        return names[random_.below(3)];
+    }
+
+    void statement(std::size_t level)
+    {
+        // nested statements are kept to assignments, so the size of a
+        // body is set by the statement count and not by chance
+        auto kind = level > 1 ? 0 : random_.below(7);
+        indent(level);
+        switch (kind) {
+            case 1:
+                if (shape_.vectors > 0) {
+                    out_ += fmt::format("v{}[{}] = ",
+                        random_.below(shape_.vectors),
+                        random_.below(vector_size));
+                    operation(shape_.depth);
+                    out_ += ";\n";
+                    return;
+                }
+                break;
+            case 2:
+                out_ +=
+                    fmt::format("if ({} < {}) {{\n", variable(), variable());
+                statement(level + 1);
+                indent(level);
+                out_ += "} else {\n";
+                statement(level + 1);
+                indent(level);
+                out_ += "}\n";
+                return;
+            case 3:
+                out_ += "t = 0;\n";
+                indent(level);
+                out_ += "while (t < 10) {\n";
+                indent(level + 1);
+                out_ += "t = t + 1;\n";
+                statement(level + 1);
+                indent(level);
+                out_ += "}\n";
+                return;
+            case 4:
+                if (shape_.arms > 0) {
+                    switch_statement(level);
+                    return;
+                }
+                break;
+            case 5:
+                if (index_ > 0) {
+                    out_ += fmt::format("z = f{}({}, {});\n",
+                        random_.below(index_),
+                        variable(),
+                        variable());
+                    return;
+                }
+                break;
+            case 6:
+                if (shape_.strings > 0) {
+                    auto which = random_.below(shape_.strings);
+                    out_ += fmt::format("s{} = \"bench {} {} {}\";\n",
+                        which,
+                        index_,
+                        which,
+                        random_.below(1000));
+                    return;
+                }
+                break;
+            default:
+                break;
+        }
+        out_ += fmt::format("{} = ", variable());
+        operation(shape_.depth);
+        out_ += ";\n";
+    }
+
+    void switch_statement(std::size_t level)
+    {
+        out_ += fmt::format("switch ({}) {{\n", variable());
+        for (std::size_t arm = 0; arm < shape_.arms; ++arm) {
+            indent(level + 1);
+            out_ += fmt::format("case {}:\n", arm);
+            statement(level + 2);
+            indent(level + 2);
+            out_ += "break;\n";
+        }
+        indent(level);
+        out_ += "}\n";
+    }
+
+    /**
+     * @brief The root of an expression, which is always an operation
+     *
+     * The table types a local by the operand of the operation last assigned
+     * to it, and rejects an element of a vector read into a local of
+     * another type, so the root's own operands are never vector elements.
+     */
+    void operation(std::size_t depth)
+    {
+        binary(std::max<std::size_t>(depth, 1), true);
+    }
+
+    void expression(std::size_t depth, bool root)
+    {
+        // an operand is a leaf one time in four before the last level, so
+        // trees of the same depth are not all the same size
+        if (depth == 0 or random_.below(4) == 0)
+            leaf(root);
+        else
+            binary(depth, false);
+    }
+
+    void binary(std::size_t depth, bool root)
+    {
+        static constexpr std::string_view operators[] = {
+            "+", "-", "*", "&", "|", "^"
+        };
+        out_ += '(';
+        expression(depth - 1, root);
+        out_ += fmt::format(" {} ", operators[random_.below(6)]);
+        expression(depth - 1, root);
+        out_ += ')';
+    }
+
+    void leaf(bool root)
+    {
+        switch (random_.below(4)) {
+            case 0:
+                out_ += std::to_string(random_.below(100));
+                break;
+            case 1:
+                if (shape_.vectors > 0 and !root) {
+                    out_ += fmt::format("v{}[{}]",
+                        random_.below(shape_.vectors),
+                        random_.below(vector_size));
+                    break;
+                }
+                [[fallthrough]];
+            default:
+                out_ += variable();
+                break;
+        }
+    }
+
+  private:
+    Shape const& shape_;
+    Random random_;
+    std::string& out_;
+    std::size_t index_{ 0 };
+};
+
+/**
+ * @brief Take one program through every stage of a target
+ */
+void compile_once(std::string const& source, std::string_view target)
+{
+    auto program = frontend::compile(source);
+    if (program.failed()) {
+        std::ostringstream diagnostics{};
+        frontend::report(diagnostics, program);
+        credence_error(
+            fmt::format("generated program was rejected:\n{}",
+                diagnostics.str()));
+    }
+
+    passes::Scope hoist_pass{ "hoist" };
+    auto symbols = ir::hoisted_symbols(program.unit);
+    hoist_pass.count("symbols", program.unit.symbol_table.symbols().size());
+    hoist_pass.finish();
+
+    if (target == "frontend")
+        return;
+
+    namespace assembly = target::common::assembly;
+    auto arch = target == "arm64" ? assembly::Arch_Type::ARM64
+                                  : assembly::Arch_Type::X8664;
+    target::common::runtime::add_stdlib_functions_to_symbols(
+        symbols, assembly::get_os_type(), arch);
+
+    std::ostringstream out{};
+    if (target == "ir")
+        ir::emit(out, symbols, program.unit);
+    else if (target == "cfg")
+        ir::emit_cfg(out, symbols, program.unit);
+    else if (target == "ssa")
+        ir::emit_ssa(out, symbols, program.unit);
+    else if (target == "x86_64")
+        target::x86_64::emit(out, symbols, program.unit, false);
+    else if (target == "arm64")
+        target::arm64::emit(out, symbols, program.unit, false);
+    else
+        credence_error(fmt::format("invalid target '{}'", target));
+}
+
+double median_of(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    auto middle = values.size() / 2;
+    return values.size() % 2 == 1
+               ? values[middle]
+               : (values[middle - 1] + values[middle]) / 2;
+}
+
+} // namespace
+
+std::string generate(Shape const& shape)
+{
+    auto source = std::string{};
+    source.reserve(
+        shape.functions * (shape.statements + 1) * (16 << shape.depth));
+    // the backends expect main to be the first function defined
+    source += "main() {\n  auto x;\n";
+    if (shape.functions > 0)
+        source += fmt::format("  x = f{}(1, 2);\n", shape.functions - 1);
+    source += "  return(0);\n}\n\n";
+
+    auto generator = Generator{ shape, source };
+    for (std::size_t i = 0; i < shape.functions; ++i)
+        generator.function(i);
+    return source;
+}
+
+double Stage::units_per_second() const
+{
+    return median_ms > 0 ? 1000.0 * static_cast<double>(count) / median_ms : 0;
+}
+
+double Stage::bytes_per_second(std::size_t bytes) const
+{
+    return median_ms > 0 ? 1000.0 * static_cast<double>(bytes) / median_ms : 0;
+}
+
+Result run(Shape const& shape, std::string_view target, std::size_t repeat)
+{
+    auto source = generate(shape);
+    Result result{ shape, source.size(), std::max<std::size_t>(repeat, 1) };
+
+    // the warm up run is not recorded, and settles the allocator and caches
+    compile_once(source, target);
+
+    std::vector<passes::Report> runs(result.repeat);
+    for (auto& report : runs) {
+        passes::active_report = &report;
+        compile_once(source, target);
+        passes::active_report = nullptr;
+    }
+
+    // every run records the same stages in the same order
+    for (std::size_t i = 0; i < runs.front().records().size(); ++i) {
+        auto const& first = runs.front().records()[i];
+        Stage stage{};
+        stage.name = first.name;
+        if (!first.counts.empty()) {
+            stage.unit = first.counts.front().first;
+            stage.count = first.counts.front().second;
+        }
+        stage.allocations = first.allocations;
+        stage.allocated_bytes = first.allocated_bytes;
+
+        std::vector<double> wall{};
+        std::vector<double> cpu{};
+        for (auto const& report : runs) {
+            wall.push_back(report.records()[i].wall_ms);
+            cpu.push_back(report.records()[i].cpu_ms);
+        }
+        stage.min_ms = *std::min_element(wall.begin(), wall.end());
+        stage.median_ms = median_of(wall);
+        for (auto ms : wall)
+            stage.mean_ms += ms / static_cast<double>(wall.size());
+        stage.cpu_ms = median_of(cpu);
+        result.stages.push_back(std::move(stage));
+    }
+    return result;
+}
+
+void dump_table(std::ostream& os, std::vector<Result> const& results)
+{
+    // the cost of an element at the first size, to show how it grows
+    std::map<std::string, double, std::less<>> baseline{};
+    for (auto const& result : results) {
+        os << fmt::format("functions={} statements={} depth={} vectors={} "
+                          "strings={} arms={} seed={}: {} bytes, {} runs\n",
+            result.shape.functions,
+            result.shape.statements,
+            result.shape.depth,
+            result.shape.vectors,
+            result.shape.strings,
+            result.shape.arms,
+            result.shape.seed,
+            result.bytes,
+            result.repeat);
+        os << fmt::format("{:<8}  {:>10}  {:>10}  {:>10}  {:>9}  {:>12}  "
+                          "{:>12}  {:>12}  {:>6}  {}\n",
+            "pass",
+            "min ms",
+            "median ms",
+            "cpu ms",
+            "allocs",
+            "count",
+            "count/s",
+            "MB/s",
+            "growth",
+            "unit");
+        for (auto const& stage : result.stages) {
+            auto per_unit = stage.count > 0
+                                ? stage.median_ms /
+                                      static_cast<double>(stage.count)
+                                : 0;
+            if (!baseline.contains(stage.name))
+                baseline[stage.name] = per_unit;
+            auto growth = baseline[stage.name] > 0
+                              ? per_unit / baseline[stage.name]
+                              : 0;
+            os << fmt::format("{:<8}  {:>10.3f}  {:>10.3f}  {:>10.3f}  "
+                              "{:>9}  {:>12}  {:>12.0f}  {:>12.2f}  "
+                              "{:>6.2f}  {}\n",
+                stage.name,
+                stage.min_ms,
+                stage.median_ms,
+                stage.cpu_ms,
+                stage.allocations,
+                stage.count,
+                stage.units_per_second(),
+                stage.bytes_per_second(result.bytes) / 1e6,
+                growth,
+                stage.unit);
+        }
+        os << '\n';
+    }
+}
+
+void dump_json(std::ostream& os,
+    std::vector<Result> const& results,
+    std::string_view target)
+{
+    os << fmt::format("{{\"target\": \"{}\", \"results\": [", target);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        auto const& result = results[i];
+        os << (i == 0 ? "\n  " : ",\n  ");
+        os << fmt::format(
+            "{{\"shape\": {{\"functions\": {}, \"statements\": {}, "
+            "\"depth\": {}, \"vectors\": {}, \"strings\": {}, \"arms\": {}, "
+            "\"seed\": {}}}, \"bytes\": {}, \"repeat\": {}, \"stages\": [",
+            result.shape.functions,
+            result.shape.statements,
+            result.shape.depth,
+            result.shape.vectors,
+            result.shape.strings,
+            result.shape.arms,
+            result.shape.seed,
+            result.bytes,
+            result.repeat);
+        for (std::size_t j = 0; j < result.stages.size(); ++j) {
+            auto const& stage = result.stages[j];
+            os << fmt::format(
+                "{}\n    {{\"name\": \"{}\", \"unit\": \"{}\", \"count\": {}, "
+                "\"min_ms\": {:.6f}, \"median_ms\": {:.6f}, "
+                "\"mean_ms\": {:.6f}, \"cpu_ms\": {:.6f}, "
+                "\"allocations\": {}, \"allocated_bytes\": {}, "
+                "\"units_per_second\": {:.1f}, \"bytes_per_second\": {:.1f}}}",
+                j == 0 ? "" : ",",
+                stage.name,
+                stage.unit,
+                stage.count,
+                stage.min_ms,
+                stage.median_ms,
+                stage.mean_ms,
+                stage.cpu_ms,
+                stage.allocations,
+                stage.allocated_bytes,
+                stage.units_per_second(),
+                stage.bytes_per_second(result.bytes));
+        }
+        os << "]}";
+    }
+    os << "\n]}\n";
+}
+
+} // namespace credence::bench
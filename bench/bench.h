@@ -0,0 +1,148 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t
+#include <iosfwd>      // for ostream
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <vector>      // for vector
+
+/****************************************************************************
+ *
+ * Compile-time benchmark
+ *
+ * A deterministic generator of B programs, and a driver that compiles one
+ * in-process a number of times and reports what each stage of the compiler
+ * costs per element it produces.
+ *
+ * The program is scaled along six dimensions:
+ *
+ *    functions   function definitions, each calling ones defined before it
+ *    statements  statements in each function body
+ *    depth       the depth of each expression tree
+ *    vectors     auto vectors in each function, read and written by index
+ *    strings     string literals in each function
+ *    arms        case arms in each switch statement
+ *
+ * The same shape and seed always give the same program, so a run can be
+ * repeated against another build of the compiler. Example:
+ *
+ *   f3(a, b) {
+ *     auto x, y, z, t, v0[8], *s0;
+ *     x = 1;
+ *     y = 2;
+ *     z = 0;
+ *     t = 0;
+ *     v0[0] = 0;
+ *     ...
+ *     s0 = "bench 3 0";
+ *     x = ((y + v0[2]) * (z - 7));
+ *     switch (x) {
+ *       case 0:
+ *         y = (z | 3);
+ *         break;
+ *       ...
+ *     }
+ *     z = f1(x, y);
+ *     ...
+ *     return(x);
+ *   }
+ *
+ * The driver reads the stages from passes::Report, the same records as
+ * --time-passes, so a stage benchmarked here is a stage timed there.
+ *
+ *****************************************************************************/
+
+namespace credence::bench {
+
+/**
+ * @brief The dimensions of a generated program
+ */
+struct Shape
+{
+    std::size_t functions{ 64 };
+    std::size_t statements{ 16 };
+    std::size_t depth{ 3 };
+    std::size_t vectors{ 2 };
+    std::size_t strings{ 2 };
+    std::size_t arms{ 4 };
+    std::uint64_t seed{ 1 };
+};
+
+/**
+ * @brief Generate a B program of the given shape
+ */
+std::string generate(Shape const& shape);
+
+/**
+ * @brief The cost of one stage over every repetition
+ */
+struct Stage
+{
+    std::string name;
+    // the first element count the stage records, and what it counts
+    std::string unit;
+    std::size_t count{ 0 };
+    double min_ms{ 0 };
+    double median_ms{ 0 };
+    double mean_ms{ 0 };
+    double cpu_ms{ 0 };
+    std::uint64_t allocations{ 0 };
+    std::uint64_t allocated_bytes{ 0 };
+
+    /**
+     * @brief Elements per second of median wall time
+     */
+    double units_per_second() const;
+
+    /**
+     * @brief Source bytes per second of median wall time
+     */
+    double bytes_per_second(std::size_t bytes) const;
+};
+
+/**
+ * @brief Every stage of one program, compiled some number of times
+ */
+struct Result
+{
+    Shape shape;
+    std::size_t bytes{ 0 };
+    std::size_t repeat{ 0 };
+    std::vector<Stage> stages{};
+};
+
+/**
+ * @brief Compile a program in-process, repeat times after one warm up run
+ *
+ * The target is one of frontend, ir, cfg, ssa, x86_64, or arm64; frontend
+ * stops after the symbols are hoisted.
+ */
+Result run(Shape const& shape, std::string_view target, std::size_t repeat);
+
+/**
+ * @brief Write results as aligned tables, one per program size
+ */
+void dump_table(std::ostream& os, std::vector<Result> const& results);
+
+/**
+ * @brief Write results as one JSON object
+ */
+void dump_json(std::ostream& os,
+    std::vector<Result> const& results,
+    std::string_view target);
+
+} // namespace credence::bench
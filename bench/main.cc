@@ -0,0 +1,192 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <algorithm>                        // for max
+#include <bench/bench.h>                    // for Shape, run, generate, dum...
+#include <credence/error.h>                 // for Credence_Exception
+#include <credence/ir/optimize.h>           // for optimize_options
+#include <credence/target/common/options.h> // for target_options
+#include <credence/util.h>                  // for capitalize
+#include <cxxopts.hpp>                      // for value, Options, ParseResult
+#include <fstream>                          // for ofstream
+#include <iostream>                         // for cout, cerr
+#include <string>                           // for string
+#include <vector>                           // for vector
+
+/****************************************************************************
+ *
+ * credence_bench
+ *
+ * Compile-time throughput of the compiler over generated B programs, see
+ * bench/bench.h. Example usage:
+ *
+ *   $ credence_bench --functions 256 --repeat 10 -t x86_64
+ *   $ credence_bench --functions 64 --sweep 6 --format json -o bench.json
+ *   $ credence_bench --functions 8 --emit-source > program.b
+ *
+ * With --sweep N the program is generated N times, doubling the number of
+ * functions each time. The growth column is the median cost of one element
+ * of a stage relative to the first size: near 1 is linear, and a stage that
+ * doubles it at each step is quadratic.
+ *
+ *****************************************************************************/
+
+int main(int argc, const char* argv[])
+{
+    namespace bench = credence::bench;
+    try {
+        cxxopts::Options options(
+            "credence_bench", "Credence :: Compile-time Benchmark");
+        // clang-format off
+        options.add_options()
+            ("f,functions", "Functions in the program",
+                cxxopts::value<std::size_t>()->default_value("64"))
+            ("statements", "Statements in each function",
+                cxxopts::value<std::size_t>()->default_value("16"))
+            ("depth", "Depth of each expression",
+                cxxopts::value<std::size_t>()->default_value("3"))
+            ("vectors", "Vectors in each function",
+                cxxopts::value<std::size_t>()->default_value("2"))
+            ("strings", "String literals in each function",
+                cxxopts::value<std::size_t>()->default_value("2"))
+            ("arms", "Case arms in each switch",
+                cxxopts::value<std::size_t>()->default_value("4"))
+            ("seed", "Generator seed",
+                cxxopts::value<std::uint64_t>()->default_value("1"))
+            ("r,repeat", "Measured runs of each program",
+                cxxopts::value<std::size_t>()->default_value("5"))
+            ("sweep", "Programs to run, doubling the functions each time",
+                cxxopts::value<std::size_t>()->default_value("1"))
+            ("t,target", "Target [frontend, ir, cfg, ssa, arm64, x86_64]",
+                cxxopts::value<std::string>()->default_value("x86_64"))
+            ("inline", "Inline calls of small functions",
+                cxxopts::value<bool>()->default_value("false"))
+            ("finline-limit", "The most quadruples of a function --inline inlines",
+                cxxopts::value<std::size_t>()->default_value("8"))
+            ("tail", "Turn self-recursive calls in tail position into loops",
+                cxxopts::value<bool>()->default_value("false"))
+            ("ssa", "Take each function into SSA form and back before the table",
+                cxxopts::value<bool>()->default_value("false"))
+            ("sccp", "Propagate and fold constants, and drop the branches they decide",
+                cxxopts::value<bool>()->default_value("false"))
+            ("gvn", "Reuse operations already computed on the same values",
+                cxxopts::value<bool>()->default_value("false"))
+            ("copies", "Coalesce temporaries into the copies that read them",
+                cxxopts::value<bool>()->default_value("false"))
+            ("licm", "Hoist loop-invariant operations out of while loops",
+                cxxopts::value<bool>()->default_value("false"))
+            ("iv", "Reduce multiplies of loop induction variables to adds",
+                cxxopts::value<bool>()->default_value("false"))
+            ("dce", "Drop dead code, unreached blocks, and unused locals",
+                cxxopts::value<bool>()->default_value("false"))
+            ("regalloc", "Keep scalar locals in callee-saved registers",
+                cxxopts::value<bool>()->default_value("false"))
+            ("peephole", "Rewrite short instruction sequences by pattern",
+                cxxopts::value<bool>()->default_value("false"))
+            ("slots", "Share stack slots of locals whose lifetimes do not overlap",
+                cxxopts::value<bool>()->default_value("false"))
+            ("leaf", "Drop the frame pointer of functions that call nothing",
+                cxxopts::value<bool>()->default_value("false"))
+            ("format", "Output format [table, json]",
+                cxxopts::value<std::string>()->default_value("table"))
+            ("emit-source", "Write the generated program to the output and exit",
+                cxxopts::value<bool>()->default_value("false"))
+            ("o,output", "Output file",
+                cxxopts::value<std::string>()->default_value("stdout"))
+            ("h,help", "Print usage");
+        // clang-format on
+
+        auto result = options.parse(argc, argv);
+
+        if (result.count("help")) {
+            std::cout << options.help() << std::endl;
+            return 0;
+        }
+
+        bench::Shape shape{ result["functions"].as<std::size_t>(),
+            result["statements"].as<std::size_t>(),
+            result["depth"].as<std::size_t>(),
+            result["vectors"].as<std::size_t>(),
+            result["strings"].as<std::size_t>(),
+            result["arms"].as<std::size_t>(),
+            result["seed"].as<std::uint64_t>() };
+        auto target = result["target"].as<std::string>();
+        credence::ir::optimize_options.inliner = result["inline"].as<bool>();
+        credence::ir::optimize_options.inline_limit =
+            result["finline-limit"].as<std::size_t>();
+        credence::ir::optimize_options.tail = result["tail"].as<bool>();
+        credence::ir::optimize_options.ssa = result["ssa"].as<bool>();
+        credence::ir::optimize_options.sccp = result["sccp"].as<bool>();
+        credence::ir::optimize_options.gvn = result["gvn"].as<bool>();
+        credence::ir::optimize_options.copies = result["copies"].as<bool>();
+        credence::ir::optimize_options.licm = result["licm"].as<bool>();
+        credence::ir::optimize_options.iv = result["iv"].as<bool>();
+        credence::ir::optimize_options.dce = result["dce"].as<bool>();
+        credence::target::common::target_options.regalloc =
+            result["regalloc"].as<bool>();
+        credence::target::common::target_options.peephole =
+            result["peephole"].as<bool>();
+        credence::target::common::target_options.slots =
+            result["slots"].as<bool>();
+        credence::target::common::target_options.leaf =
+            result["leaf"].as<bool>();
+        auto format = result["format"].as<std::string>();
+        if (format != "table" and format != "json") {
+            std::cerr << "Credence :: Invalid format \"" << format
+                      << "\", expected table or json" << std::endl;
+            return 1;
+        }
+        auto output = result["output"].as<std::string>();
+
+        std::ofstream file{};
+        if (output != "stdout") {
+            file.open(output);
+            if (!file) {
+                std::cerr << "Credence :: Invalid file path: " << output
+                          << std::endl;
+                return 1;
+            }
+        }
+        std::ostream& out = output == "stdout" ? std::cout : file;
+
+        if (result["emit-source"].as<bool>()) {
+            out << bench::generate(shape);
+            return 0;
+        }
+
+        std::vector<bench::Result> results{};
+        auto sweep = result["sweep"].as<std::size_t>();
+        for (std::size_t i = 0; i < std::max<std::size_t>(sweep, 1); ++i) {
+            results.push_back(
+                bench::run(shape, target, result["repeat"].as<std::size_t>()));
+            shape.functions *= 2;
+        }
+
+        if (format == "json")
+            bench::dump_json(out, results, target);
+        else
+            bench::dump_table(out, results);
+
+    } catch (cxxopts::exceptions::exception const& e) {
+        std::cerr << "Credence :: " << e.what()
+                  << ", See \"--help\" for usage overview" << std::endl;
+        return 1;
+    } catch (credence::detail::Credence_Exception const& e) {
+        auto what = credence::util::capitalize(e.what());
+        std::cerr << std::endl
+                  << "Credence Error :: " << "\033[31m" << what << "\033[0m"
+                  << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,14 @@
+cmake_minimum_required(VERSION 3.16...3.29)
+
+# credence_bench: compile-time throughput of the compiler over generated B
+# programs, see bench/bench.h
+
+list(REMOVE_ITEM sources "${CMAKE_CURRENT_SOURCE_DIR}/${PROJECT_NAME}/main.cc")
+
+add_executable(credence_bench ${sources} ${bench_sources})
+
+target_include_directories(
+  credence_bench PUBLIC $<BUILD_INTERFACE:${${PROJECT_NAME}_SOURCE_DIR}>)
+
+target_link_libraries(credence_bench PUBLIC cxxopts::cxxopts fmt::fmt matchit
+                                            easyjson)
@@ -5,7 +5,12 @@ option(TEST_INSTALLED_VERSION "Test the version found by find_package" ON)
 
 list(REMOVE_ITEM sources "${CMAKE_CURRENT_SOURCE_DIR}/${PROJECT_NAME}/main.cc")
 
-add_executable(Test_Suite ${sources} ${test_sources})
+# the program generator is tested, and not the benchmark's entry point
+set(bench_library_sources ${bench_sources})
+list(REMOVE_ITEM bench_library_sources
+     "${CMAKE_CURRENT_SOURCE_DIR}/bench/main.cc")
+
+add_executable(Test_Suite ${sources} ${bench_library_sources} ${test_sources})
 
 target_include_directories(Test_Suite PUBLIC fmt::fmt cxxopts::cxxopts matchit
                                              easyjson)
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>         // for size_t
+#include <memory_resource> // for monotonic_buffer_resource, memory_resource
+
+/****************************************************************************
+ *
+ * Arena
+ *
+ * The memory of one compilation. The ITA builders, the table, and both
+ * backends each build instruction lists one short list at a time and merge
+ * them into longer ones:
+ *
+ *    build_from_block_statement
+ *      build_from_while_statement   -> predicate list, branch list
+ *        build_from_rvalue_statement -> list
+ *      insert(instructions, list)
+ *
+ * With the global heap every one of those lists is allocated and freed on
+ * its own. The instruction lists (ir::Instructions and the assembly
+ * Instructions of each backend) are std::pmr containers, and the ones a
+ * compilation builds, the ITA's and the list each backend emits into, are
+ * given the resource of its Arena to take their memory from. The arena
+ * takes large blocks from the heap and never returns any of them until the
+ * compilation is done, when all of it is released at once. In the blocks
+ * it keeps pools by size, so the chunks of a deque that is dropped go back
+ * to the pool and the next deque of the same shape reuses them, still
+ * warm, rather than touching new memory.
+ *
+ * The lists the ITA builds a function from are lists of nodes,
+ * ir::Instruction_List, so a statement is spliced onto its block and a
+ * block onto its function in constant time. Each function is laid out once
+ * as ir::Instructions, a deque, for the passes and the backends that read
+ * it by position. A pass that rebuilds one, e.g. the inliner or LICM,
+ * copies it into a new deque given the resource of the one it replaces,
+ * and the backends merge their assembly lists by copying; for those the
+ * arena only makes the memory cheap.
+ *
+ * The resource is passed to each list explicitly, and the default memory
+ * resource of the process is left alone, so a pmr container that was not
+ * given it, on this thread or any other, still takes the heap. A list
+ * copied from one of the arena takes the default resource too, as a
+ * polymorphic_allocator is not propagated on copy.
+ *
+ * An arena is made on the stack of the function that runs a compilation,
+ * e.g. ir::emit or x86_64::emit, and every list given its resource must be
+ * gone before it is:
+ *
+ *    Arena arena{};
+ *    auto [globals, instructions] =
+ *        ir::make_ita_instructions(unit, symbols, arena.resource());
+ *
+ *****************************************************************************/
+
+namespace credence {
+
+class Arena
+{
+  public:
+    // the first block; the ones after it grow geometrically
+    static constexpr std::size_t initial_size = 64 * 1024;
+
+  public:
+    Arena() = default;
+
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    /**
+     * @brief The resource to give each instruction list of the compilation
+     */
+    std::pmr::memory_resource* resource() { return &pool_; }
+
+  private:
+    std::pmr::monotonic_buffer_resource blocks_{ initial_size };
+    std::pmr::unsynchronized_pool_resource pool_{ &blocks_ };
+};
+
+} // namespace credence
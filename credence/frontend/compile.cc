@@ -16,6 +16,7 @@
 #include <credence/frontend/hir/address.h> // for resolve_addresses
 #include <credence/frontend/hir/check.h>   // for check
 #include <credence/frontend/parser.h>      // for Parser
+#include <credence/passes.h>               // for Scope
 #include <fmt/format.h>                    // for format
 #include <ostream>                         // for ostream
 #include <utility>                         // for move
@@ -45,11 +46,34 @@ namespace credence::frontend {
 
 Program compile(std::string source)
 {
-    auto tree = Parser::parse(std::move(source));
+    return compile(Source{ std::move(source) });
+}
+
+Program compile(Source source)
+{
+    // the lexer is pulled by the parser, so the two are one stage
+    passes::Scope parse_pass{ "parse" };
+    auto parser = Parser{ std::move(source) };
+    auto tree = parser.parse_program();
+    parse_pass.count("tokens", parser.tokens());
+    parse_pass.count("ast_nodes", tree.nodes.size());
+    parse_pass.finish();
 
+    passes::Scope lower_pass{ "lower" };
     auto lowered = hir::lower(tree);
+    lower_pass.count("hir_nodes", lowered.unit.nodes.size());
+    lower_pass.count("symbols", lowered.unit.symbol_table.symbols().size());
+    lower_pass.finish();
+
+    passes::Scope check_pass{ "check" };
     auto checked = hir::check(lowered.unit);
+    check_pass.count("hir_nodes", lowered.unit.nodes.size());
+    check_pass.finish();
+
+    passes::Scope address_pass{ "address" };
     auto addressed = hir::resolve_addresses(lowered.unit);
+    address_pass.count("hir_nodes", lowered.unit.nodes.size());
+    address_pass.finish();
 
     // every pass runs before any of them is acted on, so one call reports
     // every error in a program and not only the first one found
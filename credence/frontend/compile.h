@@ -15,6 +15,7 @@
 
 #include <credence/frontend/ast.h>     // for AST
 #include <credence/frontend/hir/hir.h> // for Unit, Diagnostic
+#include <credence/frontend/source.h>  // for Source
 #include <iosfwd>                      // for ostream
 #include <string>                      // for string
 #include <vector>                      // for vector
@@ -62,6 +63,14 @@ struct Program
  */
 Program compile(std::string source);
 
+/**
+ * @brief Run every frontend pass over a mapped or buffered source
+ *
+ * The source is released once the tree is built, as nothing after the
+ * parser looks at the text.
+ */
+Program compile(Source source);
+
 /**
  * @brief Write the diagnostics of a program, one per line
  */
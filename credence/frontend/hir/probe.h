@@ -0,0 +1,177 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint32_t, uint64_t
+#include <utility> // for move
+#include <vector>  // for vector
+
+/****************************************************************************
+ *
+ * Handle index
+ *
+ * An open addressing hash index of uint32_t handles, with linear probing
+ * over a power of two number of slots. The index holds handles only and
+ * not the entries they name, which stay in the owning table's array:
+ *
+ *    hash    the caller hashes the key it is looking for
+ *    match   the caller says whether the handle in a slot names that key
+ *
+ * So the type table and the symbol table each index their own flat array
+ * without a second copy of it, and a handle keeps the meaning it had
+ * before the index existed.
+ *
+ * The load factor is kept at or below one half, and an erase shifts the
+ * rest of its probe run back instead of leaving a tombstone, so a probe
+ * never walks a run longer than the keys that collided into it.
+ *
+ *****************************************************************************/
+
+namespace credence::frontend::hir {
+
+/**
+ * @brief Mix a key into a well distributed 64-bit hash
+ */
+constexpr std::uint64_t mix_hash(std::uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return key;
+}
+
+/**
+ * @brief Fold another field into a running hash
+ */
+constexpr std::uint64_t combine_hash(std::uint64_t seed, std::uint64_t value)
+{
+    return mix_hash(seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6)));
+}
+
+/**
+ * @brief An open addressing index from a caller's keys to its handles
+ */
+class Handle_Index
+{
+  public:
+    static constexpr std::uint32_t empty_slot = 0xFFFFFFFFu;
+
+    /**
+     * @brief The handle whose key matches, or empty_slot
+     */
+    template<typename Match>
+    std::uint32_t find(std::uint64_t hash, Match const& match) const
+    {
+        if (slots_.empty())
+            return empty_slot;
+        for (auto slot = hash & mask();; slot = (slot + 1) & mask()) {
+            auto handle = slots_[slot];
+            if (handle == empty_slot or match(handle))
+                return handle;
+        }
+    }
+
+    /**
+     * @brief Add a handle whose key is not in the index yet
+     *
+     * Growing rehashes every handle already in the index, which is why the
+     * hash of a handle is asked for and not only the hash of the new key.
+     */
+    template<typename Hash_Of>
+    void insert(std::uint64_t hash,
+        std::uint32_t handle,
+        Hash_Of const& hash_of)
+    {
+        if ((count_ + 1) * 2 > slots_.size())
+            grow(hash_of);
+        place(hash, handle);
+        ++count_;
+    }
+
+    /**
+     * @brief Point the slot of a key already in the index at a new handle
+     */
+    template<typename Match>
+    void assign(std::uint64_t hash, Match const& match, std::uint32_t handle)
+    {
+        for (auto slot = hash & mask();; slot = (slot + 1) & mask()) {
+            if (slots_[slot] != empty_slot and match(slots_[slot])) {
+                slots_[slot] = handle;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Remove the handle of a key already in the index
+     *
+     * Every handle after it in the same run is moved back into the hole
+     * if its home slot allows, so find() still stops at the first empty
+     * slot.
+     */
+    template<typename Match, typename Hash_Of>
+    void erase(std::uint64_t hash, Match const& match, Hash_Of const& hash_of)
+    {
+        auto hole = hash & mask();
+        while (!match(slots_[hole]))
+            hole = (hole + 1) & mask();
+
+        for (auto next = (hole + 1) & mask(); slots_[next] != empty_slot;
+            next = (next + 1) & mask()) {
+            auto home = hash_of(slots_[next]) & mask();
+            // the handle may fill the hole only if the hole lies on its
+            // probe path, between its home slot and where it sits now
+            bool reachable = hole <= next ? (home <= hole or home > next)
+                                          : (home <= hole and home > next);
+            if (reachable) {
+                slots_[hole] = slots_[next];
+                hole = next;
+            }
+        }
+        slots_[hole] = empty_slot;
+        --count_;
+    }
+
+    std::size_t size() const { return count_; }
+
+  private:
+    std::uint64_t mask() const { return slots_.size() - 1; }
+
+    void place(std::uint64_t hash, std::uint32_t handle)
+    {
+        auto slot = hash & mask();
+        while (slots_[slot] != empty_slot)
+            slot = (slot + 1) & mask();
+        slots_[slot] = handle;
+    }
+
+    template<typename Hash_Of>
+    void grow(Hash_Of const& hash_of)
+    {
+        auto previous = std::move(slots_);
+        slots_.assign(previous.empty() ? 16 : previous.size() * 2, empty_slot);
+        for (auto handle : previous)
+            if (handle != empty_slot)
+                place(hash_of(handle), handle);
+    }
+
+  private:
+    std::vector<std::uint32_t> slots_{};
+    std::size_t count_{ 0 };
+};
+
+} // namespace credence::frontend::hir
@@ -22,10 +22,18 @@
  * once during lowering, so no later pass repeats a name lookup.
  *
  * Scopes are a stack of index ranges over one flat symbol array. Entering
- * a function pushes a scope, leaving it pops back to the enclosing one, and
- * a lookup walks the stack from the innermost outward. Popping does not
- * erase the symbols, so a resolved Symbol_Index stays valid for the life of
- * the unit even after its scope has closed.
+ * a function pushes a scope and leaving it pops back to the enclosing one.
+ * Popping does not erase the symbols, so a resolved Symbol_Index stays
+ * valid for the life of the unit even after its scope has closed.
+ *
+ * A hash index beside the array maps each name to its innermost visible
+ * declaration, and each declaration records the one it shadows. A lookup
+ * is one probe, and closing a scope walks only that scope's symbols to
+ * put back what they shadowed:
+ *
+ *    x   global        visible at file scope
+ *    x   auto, f()     shadows the global while f is open
+ *                      and restores it when f closes
  *
  * The storage class is what the backend needs to place a symbol, and what
  * the checker needs to reject a use that its declaration does not allow,
@@ -35,6 +43,15 @@
 
 namespace credence::frontend::hir {
 
+namespace {
+
+std::uint64_t hash_name(ast::String_Index name)
+{
+    return mix_hash(name);
+}
+
+} // namespace
+
 Symbol_Table::Symbol_Table()
 {
     // file scope, which is never popped
@@ -52,12 +69,29 @@ void Symbol_Table::push_scope()
  *
  * Only the boundary is dropped. The symbols stay in the array so that a
  * Symbol_Index resolved while the scope was open still names the same
- * declaration afterwards.
+ * declaration afterwards, and only their names leave the index, each put
+ * back to whatever declaration it shadowed.
  */
 void Symbol_Table::pop_scope()
 {
     if (scopes_.size() <= 1)
         return;
+
+    auto hash_of = [&](Symbol_Index other) {
+        return hash_name(symbols_[other].name);
+    };
+    for (auto index = static_cast<Symbol_Index>(symbols_.size());
+        index-- > scopes_.back();) {
+        if (symbols_[index].depth != depth_)
+            continue; // left the index when its nested scope closed
+        auto name = symbols_[index].name;
+        auto match = [&](Symbol_Index other) { return other == index; };
+        if (shadowed_[index] != null_symbol_index)
+            visible_.assign(hash_name(name), match, shadowed_[index]);
+        else
+            visible_.erase(hash_name(name), match, hash_of);
+    }
+
     scopes_.pop_back();
     --depth_;
 }
@@ -69,37 +103,38 @@ Symbol_Index Symbol_Table::declare(ast::String_Index name,
     bool indirect,
     bool assumed)
 {
-    if (auto existing = lookup(name);
-        existing != null_symbol_index and symbols_[existing].depth == depth_) {
-        return existing;
-    }
+    auto shadowed = lookup(name);
+    if (shadowed != null_symbol_index and symbols_[shadowed].depth == depth_)
+        return shadowed;
 
     symbols_.push_back(
         Symbol{ name, type, storage, count, depth_, indirect, assumed });
-    return static_cast<Symbol_Index>(symbols_.size() - 1);
+    shadowed_.push_back(shadowed);
+
+    auto index = static_cast<Symbol_Index>(symbols_.size() - 1);
+    if (shadowed != null_symbol_index)
+        visible_.assign(
+            hash_name(name),
+            [&](Symbol_Index other) { return other == shadowed; },
+            index);
+    else
+        visible_.insert(hash_name(name), index, [&](Symbol_Index other) {
+            return hash_name(symbols_[other].name);
+        });
+    return index;
 }
 
 /**
  * @brief The handle of a visible name, or null_symbol_index
  *
- * The search runs from the most recent declaration backwards, so an inner
- * scope shadows an outer one, and only symbols belonging to a scope that
- * is still open are considered.
+ * The index holds only the innermost declaration of each name whose scope
+ * is still open, so an inner scope shadows an outer one.
  */
 Symbol_Index Symbol_Table::lookup(ast::String_Index name) const
 {
-    if (symbols_.empty())
-        return null_symbol_index;
-
-    for (auto index = static_cast<Symbol_Index>(symbols_.size());
-        index-- > 0;) {
-        if (symbols_[index].name != name)
-            continue;
-        if (symbols_[index].depth > depth_)
-            continue; // belongs to a scope that has closed
-        return index;
-    }
-    return null_symbol_index;
+    return visible_.find(hash_name(name), [&](Symbol_Index other) {
+        return symbols_[other].name == name;
+    });
 }
 
 bool Symbol_Table::declared_in_current_scope(ast::String_Index name) const
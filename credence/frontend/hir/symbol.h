@@ -13,10 +13,11 @@
 
 #pragma once
 
-#include <credence/frontend/ast.h>      // for String_Index
-#include <credence/frontend/hir/type.h> // for Type_Index
-#include <cstdint>                      // for uint32_t
-#include <vector>                       // for vector
+#include <credence/frontend/ast.h>       // for String_Index
+#include <credence/frontend/hir/probe.h> // for Handle_Index
+#include <credence/frontend/hir/type.h>  // for Type_Index
+#include <cstdint>                       // for uint32_t
+#include <vector>                        // for vector
 
 /****************************************************************************
  *
@@ -27,10 +28,18 @@
  * once during lowering, so no later pass repeats a name lookup.
  *
  * Scopes are a stack of index ranges over one flat symbol array. Entering
- * a function pushes a scope, leaving it pops back to the enclosing one, and
- * a lookup walks the stack from the innermost outward. Popping does not
- * erase the symbols, so a resolved Symbol_Index stays valid for the life of
- * the unit even after its scope has closed.
+ * a function pushes a scope and leaving it pops back to the enclosing one.
+ * Popping does not erase the symbols, so a resolved Symbol_Index stays
+ * valid for the life of the unit even after its scope has closed.
+ *
+ * A hash index beside the array maps each name to its innermost visible
+ * declaration, and each declaration records the one it shadows. A lookup
+ * is one probe, and closing a scope walks only that scope's symbols to
+ * put back what they shadowed:
+ *
+ *    x   global        visible at file scope
+ *    x   auto, f()     shadows the global while f is open
+ *                      and restores it when f closes
  *
  * The storage class is what the backend needs to place a symbol, and what
  * the checker needs to reject a use that its declaration does not allow,
@@ -141,9 +150,15 @@ class Symbol_Table
   private:
     std::vector<Symbol> symbols_;
 
+    // the visible declaration each symbol hides, parallel to symbols_
+    std::vector<Symbol_Index> shadowed_;
+
     // the first symbol belonging to each open scope, innermost last
     std::vector<std::uint32_t> scopes_;
     std::uint32_t depth_{ 0 };
+
+    // each visible name to its innermost declaration
+    Handle_Index visible_{};
 };
 
 /**
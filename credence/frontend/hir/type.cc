@@ -29,7 +29,9 @@
  *    word int char byte long float double bool null
  *
  * Derived types are interned on demand. Asking twice for a pointer to int
- * gives back the same handle both times.
+ * gives back the same handle both times. The entries are hashed into an
+ * index beside the array, so interning is constant time however many
+ * distinct vector lengths a unit declares.
  *
  * A type holds the size the backend needs, so the (value : type : size)
  * tuple the IR prints is recovered from the handle alone.
@@ -38,23 +40,33 @@
 
 namespace credence::frontend::hir {
 
+namespace {
+
+std::uint64_t hash_entry(Type_Entry const& entry)
+{
+    auto hash = mix_hash(static_cast<std::uint64_t>(entry.kind));
+    hash = combine_hash(hash, entry.size);
+    hash = combine_hash(hash, entry.element);
+    return combine_hash(hash, entry.count);
+}
+
+} // namespace
+
 Type_Table::Type_Table()
 {
     entries_.reserve(primitive_type_count * 2);
 
     // seeded in the order Primitive_Type declares
-    entries_.push_back({ Type_Kind::Null, 0, null_type_index, 0 });
-    entries_.push_back({ Type_Kind::Word, sizeof(void*), null_type_index, 0 });
-    entries_.push_back({ Type_Kind::Int, sizeof(int), null_type_index, 0 });
-    entries_.push_back({ Type_Kind::Char, sizeof(char), null_type_index, 0 });
-    entries_.push_back(
-        { Type_Kind::Byte, sizeof(unsigned char), null_type_index, 0 });
-    entries_.push_back({ Type_Kind::Long, sizeof(long), null_type_index, 0 });
-    entries_.push_back({ Type_Kind::Float, sizeof(float), null_type_index, 0 });
-    entries_.push_back(
-        { Type_Kind::Double, sizeof(double), null_type_index, 0 });
-    entries_.push_back({ Type_Kind::Bool, sizeof(bool), null_type_index, 0 });
-    entries_.push_back({ Type_Kind::String, sizeof(void*), type_char, 0 });
+    intern({ Type_Kind::Null, 0, null_type_index, 0 });
+    intern({ Type_Kind::Word, sizeof(void*), null_type_index, 0 });
+    intern({ Type_Kind::Int, sizeof(int), null_type_index, 0 });
+    intern({ Type_Kind::Char, sizeof(char), null_type_index, 0 });
+    intern({ Type_Kind::Byte, sizeof(unsigned char), null_type_index, 0 });
+    intern({ Type_Kind::Long, sizeof(long), null_type_index, 0 });
+    intern({ Type_Kind::Float, sizeof(float), null_type_index, 0 });
+    intern({ Type_Kind::Double, sizeof(double), null_type_index, 0 });
+    intern({ Type_Kind::Bool, sizeof(bool), null_type_index, 0 });
+    intern({ Type_Kind::String, sizeof(void*), type_char, 0 });
 }
 
 Type_Entry const& Type_Table::at(Type_Index index) const
@@ -77,20 +89,24 @@ Type_Kind Type_Table::kind_of(Type_Index index) const
 /**
  * @brief Return the handle of an entry, adding it only if it is new
  *
- * The table holds a handful of entries for a translation unit, so a linear
- * scan finds a match faster than a hash of the entry would.
+ * A unit with thousands of distinct vector lengths has as many vector
+ * types, so the entry is found through the hash index and not by a scan
+ * of the whole table.
  */
 Type_Index Type_Table::intern(Type_Entry entry)
 {
-    for (Type_Index index = 0; index < entries_.size(); ++index) {
-        auto const& candidate = entries_[index];
-        if (candidate.kind == entry.kind and candidate.size == entry.size and
-            candidate.element == entry.element and
-            candidate.count == entry.count)
-            return index;
-    }
+    auto hash = hash_entry(entry);
+    auto found = index_.find(
+        hash, [&](Type_Index index) { return entries_[index] == entry; });
+    if (found != Handle_Index::empty_slot)
+        return found;
+
     entries_.push_back(entry);
-    return static_cast<Type_Index>(entries_.size() - 1);
+    auto index = static_cast<Type_Index>(entries_.size() - 1);
+    index_.insert(hash, index, [&](Type_Index other) {
+        return hash_entry(entries_[other]);
+    });
+    return index;
 }
 
 Type_Index Type_Table::pointer_to(Type_Index element)
@@ -13,11 +13,12 @@
 
 #pragma once
 
-#include <cstddef>     // for size_t
-#include <cstdint>     // for uint32_t
-#include <string>      // for string
-#include <string_view> // for string_view
-#include <vector>      // for vector
+#include <credence/frontend/hir/probe.h> // for Handle_Index
+#include <cstddef>                       // for size_t
+#include <cstdint>                       // for uint32_t
+#include <string>                        // for string
+#include <string_view>                   // for string_view
+#include <vector>                        // for vector
 
 /****************************************************************************
  *
@@ -33,7 +34,9 @@
  *    word int char byte long float double bool null
  *
  * Derived types are interned on demand. Asking twice for a pointer to int
- * gives back the same handle both times.
+ * gives back the same handle both times. The entries are hashed into an
+ * index beside the array, so interning is constant time however many
+ * distinct vector lengths a unit declares.
  *
  * A type holds the size the backend needs, so the (value : type : size)
  * tuple the IR prints is recovered from the handle alone.
@@ -81,6 +84,8 @@ struct Type_Entry
     std::uint32_t size{ 0 };
     Type_Index element{ null_type_index };
     std::uint32_t count{ 0 };
+
+    bool operator==(Type_Entry const&) const = default;
 };
 
 /**
@@ -169,6 +174,7 @@ class Type_Table
 
   private:
     std::vector<Type_Entry> entries_;
+    Handle_Index index_{};
 };
 
 /**
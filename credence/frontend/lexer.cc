@@ -145,28 +145,22 @@ namespace {
 constexpr std::size_t PADDING = (YYMAXFILL > 0) ? YYMAXFILL : 1;
 }
 
+static_assert(PADDING <= Source::padding);
+
 Lexer::Lexer(std::string source)
+    : Lexer(Source{ std::move(source) })
+{
+}
+
+Lexer::Lexer(Source source)
     : source_(std::move(source))
 {
-    source_.append(PADDING, '\0');
     cursor_ = source_.data();
     marker_ = source_.data();
-    limit_ = source_.data() + source_.size();
+    limit_ = source_.data() + source_.size() + PADDING;
     token_start_ = cursor_;
 }
 
-void Lexer::advance_line_column(const char* from, const char* to)
-{
-    for (const char* p = from; p < to; ++p) {
-        if (*p == '\n') {
-            ++line_;
-            column_ = 1;
-        } else {
-            ++column_;
-        }
-    }
-}
-
 Token Lexer::make_token(Token_Type type)
 {
     Token token;
@@ -185,9 +179,10 @@ Token Lexer::make_token(Token_Type type)
 Token Lexer::next()
 {
     for (;;) {
+        skip_whitespace();
         token_start_ = cursor_;
 
-#line 193 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 189 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         {
             char yych;
             unsigned int yyaccept = 0;
@@ -334,19 +329,19 @@ Token Lexer::next()
             }
         yy1:
             ++cursor_;
-#line 205 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 201 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::END_OF_FILE);
             }
-#line 299 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 295 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy2:
             ++cursor_;
         yy3:
-#line 267 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 263 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::INVALID);
         }
-#line 305 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 301 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy4:
             yych = *++cursor_;
             switch (yych) {
@@ -359,12 +354,12 @@ Token Lexer::next()
                     goto yy5;
             }
         yy5:
-#line 206 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 202 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             advance_line_column(token_start_, cursor_);
             continue;
         }
-#line 318 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 314 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy6:
             yych = *++cursor_;
             switch (yych) {
@@ -374,11 +369,11 @@ Token Lexer::next()
                     goto yy7;
             }
         yy7:
-#line 263 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 259 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::BANG);
         }
-#line 328 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 324 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy8:
             yyaccept = 0;
             yych = *(marker_ = ++cursor_);
@@ -392,11 +387,11 @@ Token Lexer::next()
             }
         yy9:
             ++cursor_;
-#line 258 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 254 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::PERCENT);
             }
-#line 342 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 338 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy10:
             yych = *++cursor_;
             switch (yych) {
@@ -406,11 +401,11 @@ Token Lexer::next()
                     goto yy11;
             }
         yy11:
-#line 259 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 255 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::AMP);
         }
-#line 352 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 348 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy12:
             yyaccept = 0;
             yych = *(marker_ = ++cursor_);
@@ -419,25 +414,25 @@ Token Lexer::next()
             goto yy64;
         yy13:
             ++cursor_;
-#line 230 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 226 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::LPAREN);
             }
-#line 362 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 358 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy14:
             ++cursor_;
-#line 231 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 227 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::RPAREN);
             }
-#line 367 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 363 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy15:
             ++cursor_;
-#line 256 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 252 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::STAR);
             }
-#line 372 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 368 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy16:
             yych = *++cursor_;
             switch (yych) {
@@ -447,18 +442,18 @@ Token Lexer::next()
                     goto yy17;
             }
         yy17:
-#line 254 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 250 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::PLUS);
         }
-#line 382 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 378 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy18:
             ++cursor_;
-#line 236 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 232 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::COMMA);
             }
-#line 387 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 383 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy19:
             yych = *++cursor_;
             switch (yych) {
@@ -468,18 +463,18 @@ Token Lexer::next()
                     goto yy20;
             }
         yy20:
-#line 255 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 251 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::MINUS);
         }
-#line 397 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 393 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy21:
             ++cursor_;
-#line 239 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 235 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::DOT);
             }
-#line 402 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 398 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy22:
             yyaccept = 1;
             yych = *(marker_ = ++cursor_);
@@ -492,11 +487,11 @@ Token Lexer::next()
                     goto yy23;
             }
         yy23:
-#line 257 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 253 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::SLASH);
         }
-#line 414 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 410 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy24:
             yyaccept = 2;
             yych = *(marker_ = ++cursor_);
@@ -521,25 +516,25 @@ Token Lexer::next()
                     goto yy25;
             }
         yy25:
-#line 225 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 221 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::INTEGER);
         }
-#line 437 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 433 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy26:
             ++cursor_;
-#line 238 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 234 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::COLON);
             }
-#line 442 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 438 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy27:
             ++cursor_;
-#line 240 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 236 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::SEMICOLON);
             }
-#line 447 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 443 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy28:
             yych = *++cursor_;
             switch (yych) {
@@ -551,11 +546,11 @@ Token Lexer::next()
                     goto yy29;
             }
         yy29:
-#line 264 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 260 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::LT);
         }
-#line 458 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 454 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy30:
             yych = *++cursor_;
             switch (yych) {
@@ -565,11 +560,11 @@ Token Lexer::next()
                     goto yy31;
             }
         yy31:
-#line 253 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 249 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::ASSIGN);
         }
-#line 468 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 464 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy32:
             yych = *++cursor_;
             switch (yych) {
@@ -581,18 +576,18 @@ Token Lexer::next()
                     goto yy33;
             }
         yy33:
-#line 265 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 261 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::GT);
         }
-#line 479 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 475 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy34:
             ++cursor_;
-#line 237 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 233 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::QUESTION);
             }
-#line 484 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 480 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy35:
             yych = *++cursor_;
             switch (yych) {
@@ -665,32 +660,32 @@ Token Lexer::next()
                     goto yy36;
             }
         yy36:
-#line 228 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 224 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::IDENTIFIER);
         }
-#line 557 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 553 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy37:
             ++cursor_;
-#line 234 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 230 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::LBRACKET);
             }
-#line 562 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 558 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy38:
             ++cursor_;
-#line 235 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 231 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::RBRACKET);
             }
-#line 567 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 563 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy39:
             ++cursor_;
-#line 261 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 257 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::CARET);
             }
-#line 572 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 568 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy40:
             yych = *++cursor_;
             switch (yych) {
@@ -1558,11 +1553,11 @@ Token Lexer::next()
             }
         yy52:
             ++cursor_;
-#line 232 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 228 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::LBRACE);
             }
-#line 1405 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1401 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy53:
             yych = *++cursor_;
             switch (yych) {
@@ -1572,32 +1567,32 @@ Token Lexer::next()
                     goto yy54;
             }
         yy54:
-#line 260 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 256 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::PIPE);
         }
-#line 1415 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1411 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy55:
             ++cursor_;
-#line 233 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 229 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::RBRACE);
             }
-#line 1420 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1416 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy56:
             ++cursor_;
-#line 262 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 258 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::TILDE);
             }
-#line 1425 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1421 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy57:
             ++cursor_;
-#line 243 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 239 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::NEQ);
             }
-#line 1430 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1426 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy58:
             yych = *++cursor_;
         yy59:
@@ -1625,11 +1620,11 @@ Token Lexer::next()
             }
         yy61:
             ++cursor_;
-#line 227 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 223 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::STRING_LITERAL);
             }
-#line 1453 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1449 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy62:
             yych = *++cursor_;
             if (yych <= 0x00)
@@ -1637,11 +1632,11 @@ Token Lexer::next()
             goto yy58;
         yy63:
             ++cursor_;
-#line 248 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 244 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::AND_AND);
             }
-#line 1462 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1458 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy64:
             yych = *++cursor_;
             switch (yych) {
@@ -1654,18 +1649,18 @@ Token Lexer::next()
             }
         yy65:
             ++cursor_;
-#line 250 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 246 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::INC);
             }
-#line 1474 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1470 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy66:
             ++cursor_;
-#line 251 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 247 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::DEC);
             }
-#line 1479 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1475 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy67:
             yych = *++cursor_;
             switch (yych) {
@@ -1687,12 +1682,12 @@ Token Lexer::next()
                     goto yy68;
             }
         yy69:
-#line 207 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 203 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             advance_line_column(token_start_, cursor_);
             continue;
         }
-#line 1498 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1494 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy70:
             yych = *++cursor_;
             switch (yych) {
@@ -1712,46 +1707,46 @@ Token Lexer::next()
             }
         yy71:
             ++cursor_;
-#line 224 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 220 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::FLOAT);
             }
-#line 1518 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1514 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy72:
             ++cursor_;
-#line 246 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 242 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::SHL);
             }
-#line 1523 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1519 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy73:
             ++cursor_;
-#line 244 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 240 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::LE);
             }
-#line 1528 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1524 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy74:
             ++cursor_;
-#line 242 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 238 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::EQ);
             }
-#line 1533 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1529 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy75:
             ++cursor_;
-#line 245 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 241 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::GE);
             }
-#line 1538 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1534 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy76:
             ++cursor_;
-#line 247 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 243 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::SHR);
             }
-#line 1543 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 1539 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy77:
             yych = *++cursor_;
             switch (yych) {
@@ -2399,11 +2394,11 @@ Token Lexer::next()
                     goto yy86;
             }
         yy86:
-#line 215 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 211 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_IF);
         }
-#line 2168 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 2164 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy87:
             yych = *++cursor_;
             switch (yych) {
@@ -2766,11 +2761,11 @@ Token Lexer::next()
             }
         yy92:
             ++cursor_;
-#line 249 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 245 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 return make_token(Token_Type::OR_OR);
             }
-#line 2518 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 2514 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy93:
             yych = *++cursor_;
             switch (yych) {
@@ -2788,11 +2783,11 @@ Token Lexer::next()
                     goto yy95;
             }
         yy95:
-#line 226 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 222 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::CHAR_LITERAL);
         }
-#line 2534 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 2530 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy96:
             yych = *++cursor_;
             switch (yych) {
@@ -3765,12 +3760,12 @@ Token Lexer::next()
             goto yy95;
         yy112:
             ++cursor_;
-#line 208 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 204 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
             {
                 advance_line_column(token_start_, cursor_);
                 continue;
             }
-#line 3464 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 3460 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy113:
             yych = *++cursor_;
             switch (yych) {
@@ -3914,11 +3909,11 @@ Token Lexer::next()
                     goto yy115;
             }
         yy115:
-#line 210 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 206 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_AUTO);
         }
-#line 3606 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 3602 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy116:
             yych = *++cursor_;
             switch (yych) {
@@ -4063,11 +4058,11 @@ Token Lexer::next()
                     goto yy118;
             }
         yy118:
-#line 212 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 208 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_CASE);
         }
-#line 3748 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 3744 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy119:
             yych = *++cursor_;
             switch (yych) {
@@ -4140,11 +4135,11 @@ Token Lexer::next()
                     goto yy120;
             }
         yy120:
-#line 216 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 212 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_ELSE);
         }
-#line 3821 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 3817 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy121:
             yych = *++cursor_;
             switch (yych) {
@@ -4361,11 +4356,11 @@ Token Lexer::next()
                     goto yy124;
             }
         yy124:
-#line 213 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 209 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_GOTO);
         }
-#line 4032 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 4028 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy125:
             yych = *++cursor_;
             switch (yych) {
@@ -4582,11 +4577,11 @@ Token Lexer::next()
                     goto yy128;
             }
         yy128:
-#line 221 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 217 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::BOOL_LITERAL);
         }
-#line 4243 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 4239 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy129:
             yych = *++cursor_;
             switch (yych) {
@@ -4874,11 +4869,11 @@ Token Lexer::next()
                     goto yy133;
             }
         yy133:
-#line 220 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 216 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_BREAK);
         }
-#line 4523 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 4519 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy134:
             yych = *++cursor_;
             switch (yych) {
@@ -4951,11 +4946,11 @@ Token Lexer::next()
                     goto yy135;
             }
         yy135:
-#line 211 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 207 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_EXTRN);
         }
-#line 4596 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 4592 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy136:
             yych = *++cursor_;
             switch (yych) {
@@ -5028,11 +5023,11 @@ Token Lexer::next()
                     goto yy137;
             }
         yy137:
-#line 222 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 218 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::BOOL_LITERAL);
         }
-#line 4669 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 4665 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy138:
             yych = *++cursor_;
             switch (yych) {
@@ -5249,11 +5244,11 @@ Token Lexer::next()
                     goto yy141;
             }
         yy141:
-#line 214 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 210 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_UNION);
         }
-#line 4880 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 4876 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy142:
             yych = *++cursor_;
             switch (yych) {
@@ -5326,11 +5321,11 @@ Token Lexer::next()
                     goto yy143;
             }
         yy143:
-#line 218 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 214 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_WHILE);
         }
-#line 4953 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 4949 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy144:
             yych = *++cursor_;
             switch (yych) {
@@ -5474,11 +5469,11 @@ Token Lexer::next()
                     goto yy146;
             }
         yy146:
-#line 217 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 213 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_RETURN);
         }
-#line 5095 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 5091 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy147:
             yych = *++cursor_;
             switch (yych) {
@@ -5551,11 +5546,11 @@ Token Lexer::next()
                     goto yy148;
             }
         yy148:
-#line 219 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 215 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
         {
             return make_token(Token_Type::KEYWORD_SWITCH);
         }
-#line 5168 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
+#line 5164 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.cc"
         yy149:
             yych = *++cursor_;
             switch (yych) {
@@ -5631,7 +5626,7 @@ Token Lexer::next()
             ++cursor_;
             goto yy36;
         }
-#line 268 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
+#line 264 "/Users/jahan-addison/Git/credence/credence/frontend/lexer.re"
     }
 }
 
@@ -13,7 +13,9 @@
 
 #pragma once
 
+#include <credence/frontend/source.h>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -29,7 +31,7 @@
 
 namespace credence::frontend {
 
-enum class Token_Type
+enum class Token_Type : std::uint8_t
 {
     END_OF_FILE,
     INVALID,
@@ -107,17 +109,50 @@ struct Token
     std::size_t end_column{ 1 };
 };
 
+/**
+ * @brief A token as the parser holds it, in 16 bytes
+ *
+ * The lexeme is not stored, it is the `length` bytes at `start_pos` in
+ * the source buffer the Lexer owns. Positions are 32-bit like ast::Meta,
+ * and a lexeme is at most max_length bytes.
+ */
+struct Packed_Token
+{
+    static constexpr std::uint32_t max_length = (1u << 24) - 1;
+
+    Packed_Token() = default;
+    explicit Packed_Token(Token const& token)
+        : start_pos(static_cast<std::uint32_t>(token.start_pos))
+        , line(static_cast<std::uint32_t>(token.line))
+        , column(static_cast<std::uint32_t>(token.column))
+        , length(static_cast<std::uint32_t>(token.end_pos - token.start_pos))
+        , type(token.type)
+    {
+    }
+
+    std::uint32_t end_pos() const { return start_pos + length; }
+
+    std::uint32_t start_pos{ 0 };
+    std::uint32_t line{ 1 };
+    std::uint32_t column{ 1 };
+    std::uint32_t length : 24 { 0 };
+    Token_Type type : 8 { Token_Type::INVALID };
+};
+
+static_assert(sizeof(Packed_Token) == 16);
+
 /**
  * @brief re2c tokenizer over an in-memory source buffer.
  *
  * The Lexer owns the source buffer for its lifetime. Token::lexeme
  * is a string_view into it, so a Lexer (or its tokenize() result) must
- * outlive any Token taken from it.
+ * outlive any Token taken from it. A mapped Source is scanned in place.
  */
 class Lexer
 {
   public:
     explicit Lexer(std::string source);
+    explicit Lexer(Source source);
 
     /**
      * @brief Scan and return the next token, including END_OF_FILE
@@ -126,6 +161,10 @@ class Lexer
 
     /**
      * @brief SIMD-powered scanning to skip and count whitespace in chunks
+     *
+     * Steps over blanks, newlines, and line comments a block at a time
+     * (see whitespace.cc), and leaves the cursor on the first byte the
+     * re2c scanner has to look at.
      */
     void skip_whitespace();
 
@@ -134,10 +173,10 @@ class Lexer
      */
     std::vector<Token> tokenize();
 
-    std::string_view source() const { return source_; }
+    std::string_view source() const { return source_.text(); }
 
   private:
-    std::string source_;
+    Source source_;
     const char* cursor_;
     const char* marker_;
     const char* limit_;
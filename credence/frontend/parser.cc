@@ -177,21 +177,33 @@ Operator unary_operator_of(Token_Type type)
 } // namespace
 
 Parser::Parser(std::string source)
-    : lexer_(std::move(source))
+    : Parser(Source{ std::move(source) })
 {
-    tokens_ = lexer_.tokenize();
+}
 
-    // One node per token is a reasonable upper bound, and keeps the arenas
-    // from reallocating during the parse
-    ast_.nodes.reserve(tokens_.size());
-    ast_.metadata.reserve(tokens_.size());
-    ast_.extra.reserve(tokens_.size());
+Parser::Parser(Source source)
+    : lexer_(std::move(source))
+{
+    fill();
+
+    // The token count is not known up front, but a token is rarely shorter
+    // than a few bytes of source once blanks are counted, so this is close
+    // to one node per token and keeps the arenas from reallocating often
+    auto estimate = lexer_.source().size() / 4;
+    ast_.nodes.reserve(estimate);
+    ast_.metadata.reserve(estimate);
+    ast_.extra.reserve(estimate);
 }
 
 /**
  * @brief Parse a whole source program in one call
  */
 ast::AST Parser::parse(std::string source)
+{
+    return parse(Source{ std::move(source) });
+}
+
+ast::AST Parser::parse(Source source)
 {
     Parser parser{ std::move(source) };
     return parser.parse_program();
@@ -200,33 +212,63 @@ ast::AST Parser::parse(std::string source)
 /**
  * @brief The token at the current parse position
  */
-Token const& Parser::current() const
+Packed_Token const& Parser::current() const
 {
-    return tokens_[pos_];
+    return ring_[pos_ & (ring_size - 1)];
 }
 
 /**
  * @brief The token `ahead` positions past the current one, clamped to EOF
  */
-Token const& Parser::peek(std::size_t ahead) const
+Packed_Token const& Parser::peek(std::size_t ahead) const
 {
+    credence_assert(ahead <= max_lookahead);
     auto index = pos_ + ahead;
-    if (index >= tokens_.size())
-        return tokens_.back();
-    return tokens_[index];
+    if (index >= pulled_)
+        index = pulled_ - 1;
+    return ring_[index & (ring_size - 1)];
 }
 
 /**
  * @brief Consume and return the current token
  */
-Token const& Parser::advance()
+Packed_Token Parser::advance()
 {
-    auto const& token = current();
-    if (pos_ + 1 < tokens_.size())
+    auto token = current();
+    if (pos_ + 1 < pulled_) {
         ++pos_;
+        fill();
+    }
     return token;
 }
 
+/**
+ * @brief Pull tokens from the lexer until the lookahead window is full
+ *
+ * Nothing past END_OF_FILE is pulled, peek clamps to it instead.
+ */
+void Parser::fill()
+{
+    while (!at_end_ and pulled_ <= pos_ + max_lookahead) {
+        auto token = lexer_.next();
+        if (token.end_pos - token.start_pos > Packed_Token::max_length)
+            credence_error(fmt::format("token at line {} column {} is too long",
+                token.line,
+                token.column));
+        ring_[pulled_ & (ring_size - 1)] = Packed_Token{ token };
+        at_end_ = token.type == Token_Type::END_OF_FILE;
+        ++pulled_;
+    }
+}
+
+/**
+ * @brief The text of a token, a view into the lexer's source buffer
+ */
+std::string_view Parser::lexeme(Packed_Token const& token) const
+{
+    return lexer_.source().substr(token.start_pos, token.length);
+}
+
 bool Parser::check(Token_Type type) const
 {
     return current().type == type;
@@ -251,11 +293,11 @@ bool Parser::match(Token_Type type)
 /**
  * @brief Consume the current token, or raise a syntax error naming `what`
  */
-Token const& Parser::expect(Token_Type type, std::string_view what)
+Packed_Token Parser::expect(Token_Type type, std::string_view what)
 {
     if (!check(type)) {
         error(
-            fmt::format("expected {} but found '{}'", what, current().lexeme));
+            fmt::format("expected {} but found '{}'", what, lexeme(current())));
     }
     return advance();
 }
@@ -265,7 +307,7 @@ Token const& Parser::expect(Token_Type type, std::string_view what)
  */
 void Parser::error(std::string_view message) const
 {
-    auto const& token = current();
+    auto token = current();
     credence_error(fmt::format("syntax error at line {} column {}: {}",
         token.line,
         token.column,
@@ -301,33 +343,29 @@ ast::String_Index Parser::intern(std::string_view text)
 /**
  * @brief Append a node with the source span of `token`
  */
-Node_Index Parser::add(Node node, Token const& token)
+Node_Index Parser::add(Node node, Packed_Token const& token)
 {
     auto index = static_cast<Node_Index>(ast_.nodes.size());
     ast_.nodes.push_back(node);
     ast_.metadata.push_back(
-        ast::Meta{ static_cast<std::uint32_t>(token.start_pos),
-            static_cast<std::uint32_t>(token.end_pos - token.start_pos),
-            static_cast<std::uint32_t>(token.line),
-            static_cast<std::uint32_t>(token.column) });
+        ast::Meta{ token.start_pos, token.length, token.line, token.column });
     return index;
 }
 
 /**
  * @brief Append a node spanning from `token` through the previous token
  */
-Node_Index Parser::add_spanning(Node node, Token const& token)
+Node_Index Parser::add_spanning(Node node, Packed_Token const& token)
 {
-    auto const& last = pos_ > 0 ? tokens_[pos_ - 1] : token;
-    auto end = last.end_pos > token.start_pos ? last.end_pos : token.end_pos;
+    auto const& last =
+        pos_ > 0 ? ring_[(pos_ - 1) & (ring_size - 1)] : token;
+    auto end =
+        last.end_pos() > token.start_pos ? last.end_pos() : token.end_pos();
 
     auto index = static_cast<Node_Index>(ast_.nodes.size());
     ast_.nodes.push_back(node);
-    ast_.metadata.push_back(
-        ast::Meta{ static_cast<std::uint32_t>(token.start_pos),
-            static_cast<std::uint32_t>(end - token.start_pos),
-            static_cast<std::uint32_t>(token.line),
-            static_cast<std::uint32_t>(token.column) });
+    ast_.metadata.push_back(ast::Meta{
+        token.start_pos, end - token.start_pos, token.line, token.column });
     return index;
 }
 
@@ -363,7 +401,7 @@ std::uint32_t Parser::reserve_extra(std::uint32_t count)
  */
 ast::AST Parser::parse_program()
 {
-    auto const& first = current();
+    auto first = current();
     auto base = scratch_.size();
     while (!check(Token_Type::END_OF_FILE)) {
         scratch_.push_back(parse_definition());
@@ -380,7 +418,7 @@ Node_Index Parser::parse_definition()
 {
     if (check(Token_Type::KEYWORD_UNION))
         return parse_union_definition();
-    auto const& name = expect(Token_Type::IDENTIFIER, "an identifier");
+    auto name = expect(Token_Type::IDENTIFIER, "an identifier");
     if (check(Token_Type::LPAREN))
         return parse_function_definition(name);
     return parse_vector_definition(name);
@@ -391,10 +429,10 @@ Node_Index Parser::parse_definition()
  *
  * Laid out in extra as [name, parameters, body].
  */
-Node_Index Parser::parse_function_definition(Token const& name)
+Node_Index Parser::parse_function_definition(Packed_Token const& name)
 {
     auto name_node =
-        add(string_node(Type::Identifier, intern(name.lexeme)), name);
+        add(string_node(Type::Identifier, intern(lexeme(name))), name);
 
     advance(); // '('
     auto parameters = parse_call_arguments_or_parameters();
@@ -415,10 +453,10 @@ Node_Index Parser::parse_function_definition(Token const& name)
  *
  * Laid out in extra as [name, size or null, values].
  */
-Node_Index Parser::parse_vector_definition(Token const& name)
+Node_Index Parser::parse_vector_definition(Packed_Token const& name)
 {
     auto name_node =
-        add(string_node(Type::Identifier, intern(name.lexeme)), name);
+        add(string_node(Type::Identifier, intern(lexeme(name))), name);
 
     auto size = parse_vector_size();
 
@@ -452,21 +490,21 @@ Node_Index Parser::parse_vector_definition(Token const& name)
  */
 Node_Index Parser::parse_union_definition()
 {
-    auto const& keyword = current();
+    auto keyword = current();
     advance(); // 'union'
 
-    auto const& name = expect(Token_Type::IDENTIFIER, "an identifier");
+    auto name = expect(Token_Type::IDENTIFIER, "an identifier");
     auto name_node =
-        add(string_node(Type::Identifier, intern(name.lexeme)), name);
+        add(string_node(Type::Identifier, intern(lexeme(name))), name);
 
     expect(Token_Type::LBRACE, "'{'");
 
     auto base = scratch_.size();
     scratch_.push_back(name_node);
     while (!check(Token_Type::RBRACE)) {
-        auto const& member = expect(Token_Type::IDENTIFIER, "an identifier");
+        auto member = expect(Token_Type::IDENTIFIER, "an identifier");
         auto member_node =
-            add(string_node(Type::Identifier, intern(member.lexeme)), member);
+            add(string_node(Type::Identifier, intern(lexeme(member))), member);
         auto tag = parse_rvalue();
         match(Token_Type::COMMA); // optional
         scratch_.push_back(add_spanning(binary_node(Type::Assignment_Expression,
@@ -488,7 +526,7 @@ Node_Index Parser::parse_union_definition()
  */
 Node_Index Parser::parse_call_arguments_or_parameters()
 {
-    auto const& first = current();
+    auto first = current();
     auto base = scratch_.size();
     if (!check(Token_Type::RPAREN)) {
         scratch_.push_back(parse_rvalue());
@@ -506,8 +544,8 @@ Node_Index Parser::parse_call_arguments_or_parameters()
 Node_Index Parser::parse_vector_symbol()
 {
     if (check(Token_Type::IDENTIFIER)) {
-        auto const& name = advance();
-        return add(string_node(Type::Identifier, intern(name.lexeme)), name);
+        auto name = advance();
+        return add(string_node(Type::Identifier, intern(lexeme(name))), name);
     }
     return parse_constant();
 }
@@ -534,7 +572,7 @@ Node_Index Parser::parse_vector_size()
  */
 Node_Index Parser::parse_function_body()
 {
-    auto const& brace = current();
+    auto brace = current();
     expect(Token_Type::LBRACE, "'{'");
 
     auto base = scratch_.size();
@@ -617,7 +655,7 @@ Node_Index Parser::parse_statement(bool allow_block_and_return)
  */
 Node_Index Parser::parse_block_statement()
 {
-    auto const& brace = current();
+    auto brace = current();
     expect(Token_Type::LBRACE, "'{'");
 
     auto base = scratch_.size();
@@ -635,11 +673,11 @@ Node_Index Parser::parse_block_statement()
  */
 Node_Index Parser::parse_label_statement()
 {
-    auto const& name = current();
+    auto name = current();
     advance(); // NAME
     expect(Token_Type::COLON, "':'");
     return add_spanning(
-        string_node(Type::Label_Statement, intern(name.lexeme)), name);
+        string_node(Type::Label_Statement, intern(lexeme(name))), name);
 }
 
 /**
@@ -647,7 +685,7 @@ Node_Index Parser::parse_label_statement()
  */
 Node_Index Parser::parse_auto_statement()
 {
-    auto const& keyword = current();
+    auto keyword = current();
     advance(); // 'auto'
 
     auto base = scratch_.size();
@@ -666,14 +704,14 @@ Node_Index Parser::parse_auto_statement()
  */
 Node_Index Parser::parse_extrn_statement()
 {
-    auto const& keyword = current();
+    auto keyword = current();
     advance(); // 'extrn'
 
     auto base = scratch_.size();
     do {
-        auto const& name = expect(Token_Type::IDENTIFIER, "an identifier");
+        auto name = expect(Token_Type::IDENTIFIER, "an identifier");
         scratch_.push_back(
-            add(string_node(Type::Identifier, intern(name.lexeme)), name));
+            add(string_node(Type::Identifier, intern(lexeme(name))), name));
     } while (match(Token_Type::COMMA));
     auto span = commit(base);
 
@@ -686,7 +724,7 @@ Node_Index Parser::parse_extrn_statement()
  */
 Node_Index Parser::parse_case_statement()
 {
-    auto const& keyword = current();
+    auto keyword = current();
     advance(); // 'case'
     auto value = parse_constant();
     expect(Token_Type::COLON, "':'");
@@ -708,12 +746,12 @@ Node_Index Parser::parse_case_statement()
  */
 Node_Index Parser::parse_goto_statement()
 {
-    auto const& keyword = current();
+    auto keyword = current();
     advance(); // 'goto'
-    auto const& name = expect(Token_Type::IDENTIFIER, "an identifier");
+    auto name = expect(Token_Type::IDENTIFIER, "an identifier");
     expect(Token_Type::SEMICOLON, "';'");
     return add_spanning(
-        string_node(Type::Goto_Statement, intern(name.lexeme)), keyword);
+        string_node(Type::Goto_Statement, intern(lexeme(name))), keyword);
 }
 
 /**
@@ -723,7 +761,7 @@ Node_Index Parser::parse_goto_statement()
  */
 Node_Index Parser::parse_if_statement()
 {
-    auto const& keyword = current();
+    auto keyword = current();
     advance(); // 'if'
     expect(Token_Type::LPAREN, "'('");
     auto condition = parse_rvalue();
@@ -747,7 +785,7 @@ Node_Index Parser::parse_if_statement()
  */
 Node_Index Parser::parse_return_statement()
 {
-    auto const& keyword = current();
+    auto keyword = current();
     advance(); // 'return'
     auto value = null_node_index;
     if (match(Token_Type::LPAREN)) {
@@ -777,7 +815,7 @@ bool Parser::at_expression_start() const
  */
 Node_Index Parser::parse_expression()
 {
-    auto const& first = current();
+    auto first = current();
     auto base = scratch_.size();
     if (!match(Token_Type::SEMICOLON)) {
         scratch_.push_back(parse_rvalue());
@@ -792,7 +830,7 @@ Node_Index Parser::parse_expression()
  */
 Node_Index Parser::parse_rvalue_statement()
 {
-    auto const& first = current();
+    auto first = current();
     auto base = scratch_.size();
     scratch_.push_back(parse_expression());
     while (at_expression_start()) {
@@ -807,7 +845,7 @@ Node_Index Parser::parse_rvalue_statement()
  */
 Node_Index Parser::parse_while_statement()
 {
-    auto const& keyword = current();
+    auto keyword = current();
     advance(); // 'while'
     expect(Token_Type::LPAREN, "'('");
     auto condition = parse_rvalue();
@@ -823,7 +861,7 @@ Node_Index Parser::parse_while_statement()
  */
 Node_Index Parser::parse_switch_statement()
 {
-    auto const& keyword = current();
+    auto keyword = current();
     advance(); // 'switch'
     expect(Token_Type::LPAREN, "'('");
     auto condition = parse_rvalue();
@@ -848,7 +886,7 @@ Node_Index Parser::parse_switch_statement()
  */
 Node_Index Parser::parse_break_statement()
 {
-    auto const& keyword = current();
+    auto keyword = current();
     advance(); // 'break'
     expect(Token_Type::SEMICOLON, "';'");
     return add_spanning(
@@ -888,7 +926,7 @@ bool Parser::is_lvalue_shaped(Node_Index index) const
  */
 Node_Index Parser::parse_rvalue()
 {
-    auto const& first = current();
+    auto first = current();
     auto left = parse_rvalue_primary();
 
     if (check(Token_Type::ASSIGN) and is_lvalue_shaped(left)) {
@@ -930,7 +968,7 @@ Node_Index Parser::parse_rvalue()
  */
 Node_Index Parser::parse_rvalue_primary()
 {
-    auto const& first = current();
+    auto first = current();
 
     if (check(Token_Type::AMP)) {
         advance();
@@ -956,7 +994,7 @@ Node_Index Parser::parse_rvalue_primary()
  */
 Node_Index Parser::parse_unary_operand()
 {
-    auto const& first = current();
+    auto first = current();
 
     return m::match(current().type)(
         m::pattern | m::or_(Token_Type::INC, Token_Type::DEC) =
@@ -1009,7 +1047,7 @@ Node_Index Parser::parse_unary_operand()
             },
         m::pattern | m::_ = [&]() -> Node_Index {
             error(fmt::format(
-                "expected an expression, found '{}'", current().lexeme));
+                "expected an expression, found '{}'", lexeme(current())));
             return null_node_index;
         });
 }
@@ -1019,7 +1057,7 @@ Node_Index Parser::parse_unary_operand()
  */
 Node_Index Parser::parse_lvalue()
 {
-    auto const& first = current();
+    auto first = current();
     Node_Index node;
 
     if (check(Token_Type::STAR)) {
@@ -1030,8 +1068,8 @@ Node_Index Parser::parse_lvalue()
                 Type::Indirect_Identifier, Operator::Indirection, operand),
             first);
     } else {
-        auto const& name = expect(Token_Type::IDENTIFIER, "an lvalue");
-        node = add(string_node(Type::Identifier, intern(name.lexeme)), name);
+        auto name = expect(Token_Type::IDENTIFIER, "an lvalue");
+        node = add(string_node(Type::Identifier, intern(lexeme(name))), name);
     }
 
     while (check(Token_Type::LBRACKET)) {
@@ -1051,14 +1089,14 @@ Node_Index Parser::parse_lvalue()
  */
 Node_Index Parser::parse_constant()
 {
-    auto const& first = current();
+    auto first = current();
 
     return m::match(current().type)(
         m::pattern | Token_Type::FLOAT =
             [&] {
                 // the trailing 'f' or 'F' suffix is not part of the value
                 auto text =
-                    current().lexeme.substr(0, current().lexeme.size() - 1);
+                    lexeme(current()).substr(0, current().length - 1);
                 advance();
                 Node node{};
                 node.type = Type::Float_Literal;
@@ -1068,12 +1106,12 @@ Node_Index Parser::parse_constant()
             },
         m::pattern | Token_Type::INTEGER =
             [&] {
-                auto text = current().lexeme;
+                auto text = lexeme(current());
                 advance();
                 if (check(Token_Type::DOT) and
                     check_ahead(1, Token_Type::INTEGER)) {
                     advance(); // '.'
-                    auto fraction = current().lexeme;
+                    auto fraction = lexeme(current());
                     advance();
                     // the two halves are adjacent in the source buffer, so
                     // the whole literal is one view over them
@@ -1094,7 +1132,7 @@ Node_Index Parser::parse_constant()
             },
         m::pattern | Token_Type::CHAR_LITERAL =
             [&] {
-                auto text = current().lexeme;
+                auto text = lexeme(current());
                 advance();
                 auto inner = text.substr(1, text.size() - 2);
                 // a lone whitespace character keeps its quotes, matching
@@ -1107,21 +1145,21 @@ Node_Index Parser::parse_constant()
             },
         m::pattern | Token_Type::STRING_LITERAL =
             [&] {
-                auto text = current().lexeme;
+                auto text = lexeme(current());
                 advance();
                 return add(
                     string_node(Type::String_Literal, intern(text)), first);
             },
         m::pattern | Token_Type::BOOL_LITERAL =
             [&] {
-                auto text = current().lexeme;
+                auto text = lexeme(current());
                 advance();
                 return add(
                     string_node(Type::Bool_Literal, intern(text)), first);
             },
         m::pattern | m::_ = [&]() -> Node_Index {
             error(fmt::format(
-                "expected a constant, found '{}'", current().lexeme));
+                "expected a constant, found '{}'", lexeme(current())));
             return null_node_index;
         });
 }
@@ -13,15 +13,17 @@
 
 #pragma once
 
-#include <credence/frontend/ast.h>   // for AST, Node, Node_Index, Span
-#include <credence/frontend/lexer.h> // for Lexer, Token, Token_Type
-#include <credence/util.h>           // for CREDENCE_PRIVATE_UNLESS_TESTED
-#include <cstddef>                   // for size_t
-#include <cstdint>                   // for uint32_t
-#include <string>                    // for string
-#include <string_view>               // for string_view
-#include <unordered_map>             // for unordered_map
-#include <vector>                    // for vector
+#include <array>                      // for array
+#include <credence/frontend/ast.h>    // for AST, Node, Node_Index, Span
+#include <credence/frontend/lexer.h>  // for Lexer, Packed_Token, Token_Type
+#include <credence/frontend/source.h> // for Source
+#include <credence/util.h>            // for CREDENCE_PRIVATE_UNLESS_TESTED
+#include <cstddef>                    // for size_t
+#include <cstdint>                    // for uint32_t
+#include <string>                     // for string
+#include <string_view>                // for string_view
+#include <unordered_map>              // for unordered_map
+#include <vector>                     // for vector
 
 /****************************************************************************
  *
@@ -45,6 +47,7 @@ class Parser
 {
   public:
     explicit Parser(std::string source);
+    explicit Parser(Source source);
 
     Parser(Parser const&) = delete;
     Parser& operator=(Parser const&) = delete;
@@ -59,17 +62,33 @@ class Parser
      * @brief Parse a whole source program in one call
      */
     static ast::AST parse(std::string source);
+    static ast::AST parse(Source source);
+
+    /**
+     * @brief The number of tokens pulled from the lexer so far
+     */
+    std::size_t tokens() const { return pulled_; }
 
   private:
-    Token const& current() const;
-    Token const& peek(std::size_t ahead = 1) const;
-    Token const& advance();
+    Packed_Token const& current() const;
+    Packed_Token const& peek(std::size_t ahead = 1) const;
+    Packed_Token advance();
     bool check(Token_Type type) const;
     bool check_ahead(std::size_t ahead, Token_Type type) const;
     bool match(Token_Type type);
-    Token const& expect(Token_Type type, std::string_view what);
+    Packed_Token expect(Token_Type type, std::string_view what);
     void error(std::string_view message) const;
 
+    /**
+     * @brief The text of a token, a view into the lexer's source buffer
+     */
+    std::string_view lexeme(Packed_Token const& token) const;
+
+    /**
+     * @brief Pull tokens from the lexer until the lookahead window is full
+     */
+    void fill();
+
   private:
     /**
      * @brief Intern text and return a stable handle for equal text
@@ -82,12 +101,12 @@ class Parser
     /**
      * @brief Append a node with the source span of `token`
      */
-    ast::Node_Index add(ast::Node node, Token const& token);
+    ast::Node_Index add(ast::Node node, Packed_Token const& token);
 
     /**
      * @brief Append a node spanning from `token` to the previous token
      */
-    ast::Node_Index add_spanning(ast::Node node, Token const& token);
+    ast::Node_Index add_spanning(ast::Node node, Packed_Token const& token);
 
     /**
      * @brief Move a scratch run of children into AST::extra
@@ -103,8 +122,8 @@ class Parser
 
   CREDENCE_PRIVATE_UNLESS_TESTED:
     ast::Node_Index parse_definition();
-    ast::Node_Index parse_function_definition(Token const& name);
-    ast::Node_Index parse_vector_definition(Token const& name);
+    ast::Node_Index parse_function_definition(Packed_Token const& name);
+    ast::Node_Index parse_vector_definition(Packed_Token const& name);
     ast::Node_Index parse_union_definition();
     ast::Node_Index parse_call_arguments_or_parameters();
     ast::Node_Index parse_vector_symbol();
@@ -144,9 +163,26 @@ class Parser
     bool is_lvalue_shaped(ast::Node_Index index) const;
 
   private:
+    /**
+     * The deepest peek(ahead) the grammar makes: a label's ':' and the
+     * '.' of a double literal are one token past the current one.
+     */
+    static constexpr std::size_t max_lookahead = 1;
+
+    /**
+     * The previous token (for add_spanning), the current one, and the
+     * lookahead, rounded up to a power of two so a slot is an index mask.
+     */
+    static constexpr std::size_t ring_size = 4;
+
+    static_assert(ring_size >= max_lookahead + 2);
+    static_assert((ring_size & (ring_size - 1)) == 0);
+
     Lexer lexer_;
-    std::vector<Token> tokens_;
+    std::array<Packed_Token, ring_size> ring_{};
     std::size_t pos_{ 0 };
+    std::size_t pulled_{ 0 };
+    bool at_end_{ false };
 
     ast::AST ast_{};
 
@@ -0,0 +1,185 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/frontend/source.h>
+
+#include <filesystem>   // for filesystem_error, path
+#include <fstream>      // for ifstream
+#include <istream>      // for istream
+#include <iterator>     // for istreambuf_iterator
+#include <iostream>     // for cin
+#include <system_error> // for error_code, errc, make_error_code
+#include <utility>      // for move, exchange
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CREDENCE_SOURCE_MMAP
+#include <cerrno>     // for errno
+#include <fcntl.h>    // for open, O_RDONLY
+#include <sys/mman.h> // for mmap, munmap, madvise, MAP_FAILED
+#include <sys/stat.h> // for fstat, S_ISREG
+#include <unistd.h>   // for close, sysconf
+#endif
+
+/****************************************************************************
+ *
+ * Source buffer
+ *
+ * A regular file is mapped in two steps:
+ *
+ *    1. reserve size + padding, rounded up to a page, as anonymous zero
+ *       pages
+ *    2. map the file over the front of the reservation with MAP_FIXED
+ *
+ * The bytes between the end of the file and the end of its last page are
+ * zero by the mmap contract, and the reservation is at least one padding
+ * longer than that, so text() always ends in NUL bytes the lexer may read.
+ *
+ *****************************************************************************/
+
+namespace credence::frontend {
+
+namespace {
+
+[[noreturn]] void throw_path_error(std::string_view path, int error)
+{
+    throw std::filesystem::filesystem_error("cannot read source file",
+        std::filesystem::path{ path },
+        std::make_error_code(static_cast<std::errc>(error)));
+}
+
+} // namespace
+
+Source::Source()
+    : Source(std::string{})
+{
+}
+
+Source::Source(std::string text)
+    : buffer_(std::move(text))
+    , size_(buffer_.size())
+{
+    buffer_.append(padding, '\0');
+}
+
+Source::~Source()
+{
+    unmap();
+}
+
+Source::Source(Source&& other) noexcept
+    : buffer_(std::move(other.buffer_))
+    , mapping_(std::exchange(other.mapping_, nullptr))
+    , mapping_size_(std::exchange(other.mapping_size_, 0))
+    , size_(std::exchange(other.size_, 0))
+{
+}
+
+Source& Source::operator=(Source&& other) noexcept
+{
+    if (this != &other) {
+        unmap();
+        buffer_ = std::move(other.buffer_);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapping_size_ = std::exchange(other.mapping_size_, 0);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+const char* Source::data() const
+{
+    return mapped() ? static_cast<const char*>(mapping_) : buffer_.data();
+}
+
+void Source::unmap()
+{
+#if defined(CREDENCE_SOURCE_MMAP)
+    if (mapping_ != nullptr)
+        ::munmap(mapping_, mapping_size_);
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+}
+
+Source Source::from_stream(std::istream& stream)
+{
+    return Source{ std::string{ std::istreambuf_iterator<char>{ stream },
+        std::istreambuf_iterator<char>{} } };
+}
+
+Source Source::from_path(std::string_view path)
+{
+    if (path == "-")
+        return from_stream(std::cin);
+
+#if defined(CREDENCE_SOURCE_MMAP)
+    auto name = std::string{ path };
+    int fd = ::open(name.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw_path_error(path, errno);
+
+    struct stat status{};
+    if (::fstat(fd, &status) < 0) {
+        int error = errno;
+        ::close(fd);
+        throw_path_error(path, error);
+    }
+
+    // a pipe or a device has no size to map up front, and an empty file
+    // has nothing to map at all
+    if (!S_ISREG(status.st_mode) or status.st_size == 0) {
+        ::close(fd);
+        std::ifstream stream{ name, std::ios::in | std::ios::binary };
+        if (!stream.is_open())
+            throw_path_error(path, EIO);
+        return from_stream(stream);
+    }
+
+    auto size = static_cast<std::size_t>(status.st_size);
+    auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto length = (size + padding + page - 1) / page * page;
+
+    void* reserved = ::mmap(
+        nullptr, length, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        throw_path_error(path, error);
+    }
+    void* mapping = ::mmap(
+        reserved, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        ::munmap(reserved, length);
+        throw_path_error(path, error);
+    }
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+    Source source{};
+    source.buffer_.clear();
+    source.buffer_.shrink_to_fit();
+    source.mapping_ = mapping;
+    source.mapping_size_ = length;
+    source.size_ = size;
+    return source;
+#else
+    std::ifstream stream{ std::string{ path },
+        std::ios::in | std::ios::binary };
+    if (!stream.is_open())
+        throw_path_error(path, static_cast<int>(std::errc::io_error));
+    return from_stream(stream);
+#endif
+}
+
+} // namespace credence::frontend
@@ -0,0 +1,91 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <iosfwd>      // for istream
+#include <string>      // for string
+#include <string_view> // for string_view
+
+/****************************************************************************
+ *
+ * Source buffer
+ *
+ * The bytes of one B program, followed by `padding` NUL bytes the lexer
+ * reads as the end of input. A source comes from one of two places:
+ *
+ *    a regular file   mapped read-only, and never copied
+ *    anything else    stdin, a pipe, or a string, read into a buffer
+ *
+ * A mapping is laid over an anonymous reservation one page longer than the
+ * file, so the NUL padding is the zero fill of the pages past the end of
+ * the file and not a copy with bytes appended. The lexer and every token
+ * it hands out look straight into the mapping.
+ *
+ * A Source is move-only, and must outlive any view taken from text().
+ *
+ *****************************************************************************/
+
+namespace credence::frontend {
+
+class Source
+{
+  public:
+    /**
+     * @brief NUL bytes guaranteed readable past the end of text()
+     */
+    static constexpr std::size_t padding = 16;
+
+    Source();
+    explicit Source(std::string text);
+    ~Source();
+
+    Source(Source&& other) noexcept;
+    Source& operator=(Source&& other) noexcept;
+    Source(Source const&) = delete;
+    Source& operator=(Source const&) = delete;
+
+    /**
+     * @brief Map a file, or read it when it cannot be mapped
+     *
+     * The path "-" is stdin. Pipes, character devices, and platforms
+     * without mmap fall back to a read into an owned buffer.
+     */
+    static Source from_path(std::string_view path);
+
+    /**
+     * @brief Read a stream to its end into an owned buffer
+     */
+    static Source from_stream(std::istream& stream);
+
+    std::string_view text() const { return { data(), size_ }; }
+    const char* data() const;
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief Whether text() is a file mapping and not an owned buffer
+     */
+    bool mapped() const { return mapping_ != nullptr; }
+
+  private:
+    void unmap();
+
+  private:
+    std::string buffer_{};
+    void* mapping_{ nullptr };
+    std::size_t mapping_size_{ 0 };
+    std::size_t size_{ 0 };
+};
+
+} // namespace credence::frontend
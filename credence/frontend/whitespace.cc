@@ -0,0 +1,257 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/frontend/lexer.h>
+
+#include <bit>     // for popcount, countr_zero, countl_zero
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h> // for _mm_cmpeq_epi8, _mm256_cmpeq_epi8
+#elif defined(__ARM_NEON)
+#include <arm_neon.h> // for vceqq_u8, vshrn_n_u16
+#endif
+
+/****************************************************************************
+ *
+ * Whitespace skipper
+ *
+ * Blanks, newlines, and line comments are the bulk of a large source and
+ * never become tokens, so they are stepped over a block at a time before
+ * the re2c scanner sees the next byte:
+ *
+ *    AVX2      32 bytes a block
+ *    SSE2      16 bytes a block
+ *    NEON      16 bytes a block
+ *    scalar     8 bytes a block
+ *
+ * Each block is compared against the bytes of interest at once, and the
+ * comparison is folded into a bitmask. The number of newlines in a block is
+ * the popcount of its newline mask, and the column is the distance from the
+ * highest newline bit to the end of what was consumed, so line and column
+ * stay exact without looking at each byte again.
+ *
+ * A block is only loaded when it lies inside the padded buffer, and the
+ * short tail falls back to a byte loop. The NUL padding the Lexer appends
+ * is neither whitespace nor part of a comment, so a skip always stops at
+ * the end of the source.
+ *
+ *****************************************************************************/
+
+namespace credence::frontend {
+
+namespace {
+
+#if defined(__AVX2__)
+
+constexpr std::size_t BLOCK_SIZE = 32;
+constexpr unsigned int MASK_BITS = 1;
+
+inline __m256i load_block(const char* p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+inline std::uint64_t byte_mask(__m256i block, char byte)
+{
+    return static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(byte))));
+}
+
+#elif defined(__SSE2__)
+
+constexpr std::size_t BLOCK_SIZE = 16;
+constexpr unsigned int MASK_BITS = 1;
+
+inline __m128i load_block(const char* p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+inline std::uint64_t byte_mask(__m128i block, char byte)
+{
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(byte))));
+}
+
+#elif defined(__ARM_NEON)
+
+constexpr std::size_t BLOCK_SIZE = 16;
+// NEON has no movemask, the narrowing shift leaves a nibble per byte
+constexpr unsigned int MASK_BITS = 4;
+
+inline uint8x16_t load_block(const char* p)
+{
+    return vld1q_u8(reinterpret_cast<const std::uint8_t*>(p));
+}
+
+inline std::uint64_t byte_mask(uint8x16_t block, char byte)
+{
+    auto equal = vceqq_u8(block, vdupq_n_u8(static_cast<std::uint8_t>(byte)));
+    return vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+}
+
+#else
+
+constexpr std::size_t BLOCK_SIZE = 8;
+constexpr unsigned int MASK_BITS = 1;
+
+inline const char* load_block(const char* p)
+{
+    return p;
+}
+
+inline std::uint64_t byte_mask(const char* block, char byte)
+{
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i)
+        mask |= static_cast<std::uint64_t>(block[i] == byte) << i;
+    return mask;
+}
+
+#endif
+
+/**
+ * @brief The mask bits of the first n bytes of a block
+ */
+constexpr std::uint64_t leading_bytes(std::size_t n)
+{
+    return n * MASK_BITS >= 64 ? ~std::uint64_t{ 0 }
+                               : (std::uint64_t{ 1 } << (n * MASK_BITS)) - 1;
+}
+
+constexpr std::uint64_t FULL_MASK = leading_bytes(BLOCK_SIZE);
+
+/**
+ * @brief The number of bytes before the first set byte of a mask
+ */
+constexpr std::size_t first_byte(std::uint64_t mask)
+{
+    return static_cast<std::size_t>(std::countr_zero(mask)) / MASK_BITS;
+}
+
+inline std::uint64_t whitespace_mask(const char* p)
+{
+    auto block = load_block(p);
+    return byte_mask(block, ' ') | byte_mask(block, '\t') |
+           byte_mask(block, '\r') | byte_mask(block, '\n');
+}
+
+inline std::uint64_t newline_mask(const char* p)
+{
+    return byte_mask(load_block(p), '\n');
+}
+
+inline std::uint64_t line_end_mask(const char* p)
+{
+    auto block = load_block(p);
+    return byte_mask(block, '\n') | byte_mask(block, '\r') |
+           byte_mask(block, '\0');
+}
+
+constexpr bool is_whitespace(char c)
+{
+    return c == ' ' or c == '\t' or c == '\r' or c == '\n';
+}
+
+constexpr bool is_line_end(char c)
+{
+    return c == '\n' or c == '\r' or c == '\0';
+}
+
+/**
+ * @brief Move line and column over the consumed bytes of one block, given
+ *  the newline mask of those bytes
+ */
+inline void count_block_lines(std::size_t& line,
+    std::size_t& column,
+    std::uint64_t newlines,
+    std::size_t consumed)
+{
+    if (newlines) {
+        line += static_cast<std::size_t>(std::popcount(newlines)) / MASK_BITS;
+        auto last =
+            static_cast<std::size_t>(63 - std::countl_zero(newlines)) /
+            MASK_BITS;
+        column = consumed - last;
+    } else {
+        column += consumed;
+    }
+}
+
+} // namespace
+
+void Lexer::advance_line_column(const char* from, const char* to)
+{
+    const char* p = from;
+    for (; static_cast<std::size_t>(to - p) >= BLOCK_SIZE; p += BLOCK_SIZE) {
+        auto newlines = newline_mask(p);
+        count_block_lines(line_, column_, newlines, BLOCK_SIZE);
+    }
+    for (; p < to; ++p) {
+        if (*p == '\n') {
+            ++line_;
+            column_ = 1;
+        } else {
+            ++column_;
+        }
+    }
+}
+
+void Lexer::skip_whitespace()
+{
+    const char* p = cursor_;
+    for (;;) {
+        // blanks and newlines
+        while (static_cast<std::size_t>(limit_ - p) >= BLOCK_SIZE) {
+            auto blank = whitespace_mask(p);
+            auto consumed = blank == FULL_MASK ? BLOCK_SIZE
+                                               : first_byte(~blank & FULL_MASK);
+            auto newlines = newline_mask(p) & leading_bytes(consumed);
+            count_block_lines(line_, column_, newlines, consumed);
+            p += consumed;
+            if (consumed < BLOCK_SIZE)
+                break;
+        }
+        if (static_cast<std::size_t>(limit_ - p) < BLOCK_SIZE) {
+            const char* start = p;
+            while (is_whitespace(*p))
+                ++p;
+            advance_line_column(start, p);
+        }
+
+        // a line comment runs up to its line end, which is left for the
+        // blank skip above
+        if (p[0] != '/' or p[1] != '/')
+            break;
+        const char* start = p;
+        p += 2;
+        while (static_cast<std::size_t>(limit_ - p) >= BLOCK_SIZE) {
+            auto end = line_end_mask(p);
+            if (end) {
+                p += first_byte(end);
+                break;
+            }
+            p += BLOCK_SIZE;
+        }
+        if (static_cast<std::size_t>(limit_ - p) < BLOCK_SIZE)
+            while (!is_line_end(*p))
+                ++p;
+        column_ += static_cast<std::size_t>(p - start);
+    }
+    cursor_ = p;
+}
+
+} // namespace credence::frontend
@@ -0,0 +1,680 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/cfg.h>
+
+#include <algorithm>               // for find, max
+#include <credence/arena.h>        // for Arena
+#include <credence/ir/ita.h>       // for make_ita_instructions, emit_to
+#include <credence/ir/optimize.h>  // for optimize
+#include <credence/ir/quadruple.h> // for Operand_Scope
+#include <credence/ir/table.h>     // for Table
+#include <credence/passes.h>       // for Scope
+#include <cstddef>                 // for size_t
+#include <sstream>                 // for ostringstream
+#include <string>                  // for string
+#include <unordered_map>           // for unordered_map
+#include <utility>                 // for move
+#include <vector>                  // for vector
+
+namespace credence::ir {
+
+namespace {
+
+using Edges = std::vector<std::vector<Block_Index>>;
+
+/**
+ * @brief Whether an instruction ends the block it is in
+ */
+constexpr bool is_terminator(Instruction op)
+{
+    return op == Instruction::GOTO or op == Instruction::IF or
+           op == Instruction::JMP_E or op == Instruction::LEAVE;
+}
+
+/**
+ * @brief The label a jump lands on, the operand that names it
+ */
+Quadruple::Handle jump_target(Quadruple const& quadruple)
+{
+    return quadruple.op == Instruction::GOTO ? quadruple.operands[0]
+                                             : quadruple.operands[2];
+}
+
+/**
+ * @brief The immediate dominator of each node reachable from the root
+ *
+ * Lengauer and Tarjan's algorithm, with path compression. The edges of
+ * the graph are given both ways, so the postdominators are the same call
+ * with the edges swapped and the exit as the root.
+ */
+std::vector<Block_Index> immediate_dominators(Edges const& successors,
+    Edges const& predecessors,
+    Block_Index root)
+{
+    constexpr std::uint32_t none = null_block_index;
+    auto size = successors.size();
+
+    // the depth first numbering, and the blocks by their number
+    std::vector<std::uint32_t> number(size, none);
+    std::vector<Block_Index> vertex{};
+    std::vector<std::uint32_t> parent(size, none);
+    vertex.reserve(size);
+
+    std::vector<std::pair<Block_Index, std::size_t>> stack{ { root, 0 } };
+    number[root] = 0;
+    vertex.push_back(root);
+    while (not stack.empty()) {
+        auto& [block, next] = stack.back();
+        if (next == successors[block].size()) {
+            stack.pop_back();
+            continue;
+        }
+        auto successor = successors[block][next++];
+        if (number[successor] != none)
+            continue;
+        number[successor] = static_cast<std::uint32_t>(vertex.size());
+        parent[number[successor]] = number[block];
+        vertex.push_back(successor);
+        stack.emplace_back(successor, 0);
+    }
+
+    // from here on every node is its depth first number
+    auto count = vertex.size();
+    std::vector<std::uint32_t> semi(count), label(count), ancestor(count, none);
+    std::vector<std::uint32_t> dominator(count, none);
+    std::vector<std::vector<std::uint32_t>> bucket(count);
+    for (std::uint32_t i = 0; i < count; i++)
+        semi[i] = label[i] = i;
+
+    std::vector<std::uint32_t> path{};
+    auto eval = [&](std::uint32_t v) {
+        if (ancestor[v] == none)
+            return v;
+        path.clear();
+        for (auto x = v; ancestor[ancestor[x]] != none; x = ancestor[x])
+            path.push_back(x);
+        for (auto x = path.rbegin(); x != path.rend(); x++) {
+            auto a = ancestor[*x];
+            if (semi[label[a]] < semi[label[*x]])
+                label[*x] = label[a];
+            ancestor[*x] = ancestor[a];
+        }
+        return label[v];
+    };
+
+    for (auto w = static_cast<std::uint32_t>(count) - 1; w > 0; w--) {
+        for (auto p : predecessors[vertex[w]]) {
+            if (number[p] == none)
+                continue;
+            auto u = eval(number[p]);
+            if (semi[u] < semi[w])
+                semi[w] = semi[u];
+        }
+        bucket[semi[w]].push_back(w);
+        ancestor[w] = parent[w];
+        for (auto v : bucket[parent[w]]) {
+            auto u = eval(v);
+            dominator[v] = semi[u] < semi[v] ? u : parent[w];
+        }
+        bucket[parent[w]].clear();
+    }
+    for (std::uint32_t w = 1; w < count; w++)
+        if (dominator[w] != semi[w])
+            dominator[w] = dominator[dominator[w]];
+
+    std::vector<Block_Index> result(size, null_block_index);
+    for (std::uint32_t w = 1; w < count; w++)
+        result[vertex[w]] = vertex[dominator[w]];
+    return result;
+}
+
+/**
+ * @brief The preorder and postorder number of each node of a tree
+ *
+ * a is an ancestor of b when its interval holds b's, so a dominance query
+ * is two comparisons and not a walk up the tree.
+ */
+std::vector<std::pair<std::uint32_t, std::uint32_t>> tree_intervals(
+    std::vector<Block_Index> const& parent,
+    Block_Index root)
+{
+    auto size = parent.size();
+    Edges children(size);
+    for (Block_Index block = 0; block < size; block++)
+        if (parent[block] != null_block_index)
+            children[parent[block]].push_back(block);
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> interval(
+        size, { 1, 0 });
+    std::uint32_t clock = 0;
+    std::vector<std::pair<Block_Index, std::size_t>> stack{ { root, 0 } };
+    interval[root].first = clock++;
+    while (not stack.empty()) {
+        auto& [block, next] = stack.back();
+        if (next == children[block].size()) {
+            interval[block].second = clock++;
+            stack.pop_back();
+            continue;
+        }
+        auto child = children[block][next++];
+        interval[child].first = clock++;
+        stack.emplace_back(child, 0);
+    }
+    return interval;
+}
+
+std::string block_name(Block_Index block)
+{
+    return block == null_block_index ? "-" : "B" + std::to_string(block);
+}
+
+std::string block_list(std::vector<Block_Index> const& blocks)
+{
+    if (blocks.empty())
+        return "-";
+    std::string list{};
+    for (auto block : blocks) {
+        if (not list.empty())
+            list += " ";
+        list += block_name(block);
+    }
+    return list;
+}
+
+/**
+ * @brief The text of a block's instructions as a dot label, left aligned
+ */
+std::string dot_label(CFG const& cfg, Block_Index block)
+{
+    std::ostringstream text{};
+    for (auto i = cfg[block].begin; i < cfg[block].end; i++)
+        detail::emit_to(text, cfg.instructions()[i], false);
+    std::string label = block_name(block) + "\\l";
+    for (auto c : text.str()) {
+        if (c == '\n')
+            label += "\\l";
+        else if (c == '"' or c == '\\')
+            label += std::string{ '\\', c };
+        else
+            label += c;
+    }
+    return label;
+}
+
+} // namespace
+
+/**
+ * @brief Build the graph of a function, from its LABEL to its EndFunc
+ */
+CFG CFG::build(Instructions const& instructions,
+    std::size_t begin,
+    std::size_t end)
+{
+    CFG cfg{};
+    cfg.instructions_ = &instructions;
+    cfg.name_ = ir::get<1>(instructions[begin]);
+    cfg.build_blocks(begin, end);
+    cfg.build_order();
+    cfg.build_dominators();
+    cfg.build_postdominators();
+    cfg.build_loops();
+    return cfg;
+}
+
+/**
+ * @brief Split the function at each label and after each jump, and join
+ * the blocks by the edges their last instruction makes
+ */
+void CFG::build_blocks(std::size_t begin, std::size_t end)
+{
+    auto const& instructions = *instructions_;
+    // EndFunc is the exit block on its own
+    auto last = end - 1;
+
+    std::unordered_map<Quadruple::Handle, Block_Index> labels{};
+    for (auto i = begin; i < last; i++) {
+        auto const& quadruple = instructions[i];
+        bool leader = i == begin or
+                      (quadruple.op == Instruction::LABEL and i != begin) or
+                      is_terminator(instructions[i - 1].op);
+        if (leader) {
+            if (not blocks_.empty())
+                blocks_.back().end = i;
+            blocks_.push_back(Block{ .begin = i, .end = last });
+        }
+        if (quadruple.op == Instruction::LABEL and i != begin)
+            labels.emplace(quadruple.operands[0],
+                static_cast<Block_Index>(blocks_.size() - 1));
+    }
+    blocks_.push_back(Block{ .begin = last, .end = end });
+
+    auto exit_block = exit();
+    auto add_edge = [&](Block_Index from, Block_Index to) {
+        auto& successors = blocks_[from].successors;
+        if (std::ranges::find(successors, to) != successors.end())
+            return;
+        successors.push_back(to);
+        blocks_[to].predecessors.push_back(from);
+    };
+
+    for (Block_Index block = 0; block < exit_block; block++) {
+        auto const& tail = instructions[blocks_[block].end - 1];
+        if (tail.op == Instruction::GOTO or tail.op == Instruction::IF or
+            tail.op == Instruction::JMP_E) {
+            // a jump to a label the function does not have has no edge,
+            // the table reports it
+            if (auto target = labels.find(jump_target(tail));
+                target != labels.end())
+                add_edge(block, target->second);
+        }
+        if (tail.op == Instruction::LEAVE)
+            add_edge(block, exit_block);
+        else if (tail.op != Instruction::GOTO)
+            add_edge(block, block + 1);
+    }
+}
+
+/**
+ * @brief Number the blocks reachable from the entry in reverse postorder
+ */
+void CFG::build_order()
+{
+    std::vector<bool> seen(blocks_.size(), false);
+    std::vector<std::pair<Block_Index, std::size_t>> stack{ { entry(), 0 } };
+    seen[entry()] = true;
+    while (not stack.empty()) {
+        auto& [block, next] = stack.back();
+        if (next == blocks_[block].successors.size()) {
+            order_.push_back(block);
+            stack.pop_back();
+            continue;
+        }
+        auto successor = blocks_[block].successors[next++];
+        if (seen[successor])
+            continue;
+        seen[successor] = true;
+        stack.emplace_back(successor, 0);
+    }
+    std::ranges::reverse(order_);
+}
+
+void CFG::build_dominators()
+{
+    Edges successors(blocks_.size()), predecessors(blocks_.size());
+    for (Block_Index block = 0; block < blocks_.size(); block++) {
+        successors[block] = blocks_[block].successors;
+        predecessors[block] = blocks_[block].predecessors;
+    }
+    auto dominators = immediate_dominators(successors, predecessors, entry());
+    for (Block_Index block = 0; block < blocks_.size(); block++)
+        blocks_[block].dominator = dominators[block];
+    dominator_interval_ = tree_intervals(dominators, entry());
+}
+
+/**
+ * @brief The dominators of the graph with its edges reversed, from the exit
+ *
+ * A block that cannot reach the exit, e.g. one in a loop with no way out,
+ * has no postdominator.
+ */
+void CFG::build_postdominators()
+{
+    Edges successors(blocks_.size()), predecessors(blocks_.size());
+    for (Block_Index block = 0; block < blocks_.size(); block++) {
+        successors[block] = blocks_[block].predecessors;
+        predecessors[block] = blocks_[block].successors;
+    }
+    auto postdominators =
+        immediate_dominators(successors, predecessors, exit());
+    for (Block_Index block = 0; block < blocks_.size(); block++)
+        blocks_[block].postdominator = postdominators[block];
+    postdominator_interval_ = tree_intervals(postdominators, exit());
+}
+
+/**
+ * @brief Find the natural loop of each header, innermost first
+ *
+ * A header is a block that one of the blocks it dominates jumps back to.
+ * Headers are taken in reverse of the reverse postorder, so a loop nested
+ * in another is found first and is then part of the outer loop's body as
+ * one node, its header, rather than block by block.
+ */
+void CFG::build_loops()
+{
+    // the outermost loop found so far that a block is in, by its header
+    std::vector<Block_Index> outer(blocks_.size());
+    for (Block_Index block = 0; block < blocks_.size(); block++)
+        outer[block] = block;
+    auto find = [&](Block_Index block) {
+        while (outer[block] != block) {
+            outer[block] = outer[outer[block]];
+            block = outer[block];
+        }
+        return block;
+    };
+    std::vector<Loop_Index> loop_of_header(blocks_.size(), null_loop_index);
+    std::vector<Loop_Index> seen(blocks_.size(), null_loop_index);
+
+    for (auto header = order_.rbegin(); header != order_.rend(); header++) {
+        std::vector<Block_Index> work{};
+        for (auto latch : blocks_[*header].predecessors)
+            if (reachable(latch) and dominates(*header, latch))
+                work.push_back(latch);
+        if (work.empty())
+            continue;
+
+        auto index = static_cast<Loop_Index>(loops_.size());
+        loops_.push_back(Loop{ .header = *header });
+        loop_of_header[*header] = index;
+        blocks_[*header].loop = index;
+        seen[*header] = index;
+
+        std::vector<Block_Index> body{};
+        while (not work.empty()) {
+            auto block = find(work.back());
+            work.pop_back();
+            if (seen[block] == index)
+                continue;
+            seen[block] = index;
+            body.push_back(block);
+            if (loop_of_header[block] != null_loop_index)
+                loops_[loop_of_header[block]].parent = index;
+            else if (blocks_[block].loop == null_loop_index)
+                blocks_[block].loop = index;
+            for (auto predecessor : blocks_[block].predecessors) {
+                if (not reachable(predecessor))
+                    continue;
+                // entered from outside the header, a goto into the loop
+                if (not dominates(*header, predecessor)) {
+                    loops_[index].irreducible = true;
+                    continue;
+                }
+                work.push_back(predecessor);
+            }
+        }
+        for (auto block : body)
+            outer[block] = *header;
+    }
+
+    // an outer loop is found after the loops in it, so has a higher index
+    for (auto loop = loops_.rbegin(); loop != loops_.rend(); loop++)
+        if (loop->parent != null_loop_index)
+            loop->depth = loops_[loop->parent].depth + 1;
+    for (auto block : order_)
+        for (auto loop = blocks_[block].loop; loop != null_loop_index;
+            loop = loops_[loop].parent)
+            loops_[loop].blocks.push_back(block);
+}
+
+bool CFG::dominates(Block_Index a, Block_Index b) const
+{
+    if (not reachable(a) or not reachable(b))
+        return false;
+    return dominator_interval_[a].first <= dominator_interval_[b].first and
+           dominator_interval_[b].second <= dominator_interval_[a].second;
+}
+
+bool CFG::postdominates(Block_Index a, Block_Index b) const
+{
+    auto exits = [&](Block_Index block) {
+        return block == exit() or
+               blocks_[block].postdominator != null_block_index;
+    };
+    if (not exits(a) or not exits(b))
+        return false;
+    return postdominator_interval_[a].first <=
+               postdominator_interval_[b].first and
+           postdominator_interval_[b].second <=
+               postdominator_interval_[a].second;
+}
+
+/**
+ * @brief The [begin, end) of each function of a list of instructions, from
+ * its LABEL to its EndFunc, in order
+ */
+std::vector<std::pair<std::size_t, std::size_t>> function_ranges(
+    Instructions const& instructions)
+{
+    std::vector<std::pair<std::size_t, std::size_t>> ranges{};
+    for (std::size_t i = 0; i + 1 < instructions.size(); i++) {
+        if (instructions[i].op != Instruction::LABEL or
+            instructions[i + 1].op != Instruction::FUNC_START)
+            continue;
+        auto end = i + 1;
+        while (end < instructions.size() and
+               instructions[end].op != Instruction::FUNC_END)
+            end++;
+        if (end == instructions.size())
+            break;
+        ranges.emplace_back(i, end + 1);
+        i = end;
+    }
+    return ranges;
+}
+
+/**
+ * @brief The largest number of an operand of a kind in a function, e.g.
+ * 9 of its temporaries if _t9 is the last, so a new one can follow it
+ */
+std::uint32_t last_number(Instructions const& instructions, Operand_Kind kind)
+{
+    std::uint32_t last = 0;
+    auto& table = operand_table();
+    for (auto const& quadruple : instructions)
+        if (table.kind(quadruple.operands[0]) == kind)
+            last = std::max(last, table.number(quadruple.operands[0]));
+    return last;
+}
+
+/**
+ * @brief The graph of each function of a list of instructions, in order
+ */
+std::vector<CFG> make_cfgs(Instructions const& instructions)
+{
+    std::vector<CFG> cfgs{};
+    for (auto [begin, end] : function_ranges(instructions))
+        cfgs.push_back(CFG::build(instructions, begin, end));
+    return cfgs;
+}
+
+/**
+ * @brief Drop the blocks of a function, from its LABEL to its EndFunc,
+ * that no path from the entry reaches, and give the quadruples dropped
+ *
+ * A block with a LEAVE is kept all the same, as the backends close the
+ * frame of the function there, and it jumps nowhere but to the exit.
+ */
+std::size_t remove_unreachable_blocks(Instructions& function)
+{
+    auto cfg = CFG::build(function, 0, function.size());
+    Instructions reached{ resource_of(function) };
+    for (Block_Index block = 0; block < cfg.size(); block++) {
+        auto const& b = cfg[block];
+        if (not cfg.reachable(block) and block != cfg.exit() and
+            function[b.end - 1].op != Instruction::LEAVE)
+            continue;
+        reached.insert(reached.end(),
+            function.begin() + static_cast<std::ptrdiff_t>(b.begin),
+            function.begin() + static_cast<std::ptrdiff_t>(b.end));
+    }
+    auto removed = function.size() - reached.size();
+    if (removed > 0)
+        function = std::move(reached);
+    return removed;
+}
+
+/**
+ * @brief The preheader of a loop of a function, from its LABEL to its
+ * EndFunc, or none if it can have none
+ *
+ * The block outside the loop that flows into the header alone is the
+ * preheader, and the code is inserted before its GOTO. Otherwise a block
+ * labeled past the last _L label of the function is added before the
+ * header, which the block before it falls into, unless that block is in
+ * the loop and so would run it on each iteration.
+ */
+std::optional<Preheader> make_preheader(Instructions& function,
+    CFG const& cfg,
+    Loop const& loop)
+{
+    auto& table = operand_table();
+    auto const& header = cfg[loop.header];
+    if (loop.header == 0 or function[header.begin].op != Instruction::LABEL)
+        return std::nullopt;
+    auto header_label = function[header.begin].operands[0];
+
+    std::vector<bool> in_loop(cfg.size(), false);
+    for (auto block : loop.blocks)
+        in_loop[block] = true;
+    std::vector<Block_Index> outside{};
+    for (auto predecessor : header.predecessors)
+        if (not in_loop[predecessor] and cfg.reachable(predecessor))
+            outside.push_back(predecessor);
+    if (outside.empty())
+        return std::nullopt;
+
+    auto const& entering = cfg[outside.front()];
+    if (outside.size() == 1 and entering.successors.size() == 1) {
+        auto at = entering.end;
+        if (function[at - 1].op == Instruction::GOTO)
+            at--;
+        return Preheader{ at, Operand_Table::empty };
+    }
+
+    auto before = loop.header - 1;
+    if (in_loop[before] and
+        function[cfg[before].end - 1].op != Instruction::GOTO)
+        return std::nullopt;
+    auto label = table.intern(
+        "_L" + std::to_string(last_number(function, Operand_Kind::Label) + 1));
+    for (auto predecessor : outside) {
+        auto& tail = function[cfg[predecessor].end - 1];
+        if (tail.op == Instruction::GOTO and tail.operands[0] == header_label)
+            tail.operands[0] = label;
+        if ((tail.op == Instruction::IF or tail.op == Instruction::JMP_E) and
+            tail.operands[2] == header_label)
+            tail.operands[2] = label;
+    }
+    return Preheader{ header.begin, label };
+}
+
+/**
+ * @brief Print a graph as text, or as Graphviz dot if dot is true
+ *
+ *    __f(x):
+ *    B0  succ B1 B2  pred -  idom -  ipdom B3  depth 0
+ *     BeginFunc ;
+ *        _t2 = x > (1:int:4);
+ *        IF _t2 GOTO _L3;
+ *    ...
+ *    L0  header B2  depth 1  parent -  blocks B2 B4
+ */
+void dump(std::ostream& os, CFG const& cfg, bool dot)
+{
+    auto const& blocks = cfg.blocks();
+    if (dot) {
+        os << "digraph \"" << cfg.name() << "\" {" << std::endl
+           << "    node [shape=box, fontname=\"monospace\"];" << std::endl;
+        for (Block_Index block = 0; block < blocks.size(); block++) {
+            os << "    " << block_name(block) << " [label=\""
+               << dot_label(cfg, block) << "\"";
+            if (blocks[block].loop != null_loop_index and
+                cfg.loops()[blocks[block].loop].header == block)
+                os << ", style=bold";
+            if (not cfg.reachable(block))
+                os << ", style=dashed";
+            os << "];" << std::endl;
+        }
+        for (Block_Index block = 0; block < blocks.size(); block++)
+            for (auto successor : blocks[block].successors)
+                os << "    " << block_name(block) << " -> "
+                   << block_name(successor) << ";" << std::endl;
+        os << "}" << std::endl;
+        return;
+    }
+
+    os << cfg.name() << ":" << std::endl;
+    for (Block_Index block = 0; block < blocks.size(); block++) {
+        auto const& b = blocks[block];
+        os << block_name(block) << "  succ " << block_list(b.successors)
+           << "  pred " << block_list(b.predecessors) << "  idom "
+           << block_name(b.dominator) << "  ipdom "
+           << block_name(b.postdominator) << "  depth "
+           << cfg.loop_depth(block);
+        if (not cfg.reachable(block))
+            os << "  unreachable";
+        os << std::endl;
+        for (auto i = b.begin; i < b.end; i++) {
+            auto const& quadruple = cfg.instructions()[i];
+            detail::emit_to(
+                os, quadruple, quadruple.op != Instruction::FUNC_END);
+        }
+    }
+    auto const& loops = cfg.loops();
+    for (Loop_Index loop = 0; loop < loops.size(); loop++) {
+        os << "L" << loop << "  header " << block_name(loops[loop].header)
+           << "  depth " << loops[loop].depth << "  parent "
+           << (loops[loop].parent == null_loop_index
+                      ? std::string{ "-" }
+                      : "L" + std::to_string(loops[loop].parent))
+           << "  blocks " << block_list(loops[loop].blocks);
+        if (loops[loop].irreducible)
+            os << "  irreducible";
+        os << std::endl;
+    }
+}
+
+/**
+ * @brief Build the ITA and the table of a unit and print each function's
+ * graph, as -t cfg does
+ */
+void emit_cfg(std::ostream& os,
+    Symbols const& symbols,
+    frontend::hir::Unit const& unit,
+    bool dot)
+{
+    Arena arena{};
+    Operand_Scope operands{};
+
+    passes::Scope ita_pass{ "ita" };
+    auto [globals, instructions] =
+        ir::make_ita_instructions(unit, symbols, arena.resource());
+    ita_pass.count("quadruples", instructions.size());
+    ita_pass.finish();
+
+    ir::optimize(instructions);
+
+    passes::Scope table_pass{ "table" };
+    auto table = ir::Table{ symbols, instructions, globals };
+    table.build_from_ir_instructions();
+    table_pass.count("quadruples", table.get_table_instructions()->size());
+    table_pass.finish();
+
+    passes::Scope cfg_pass{ "cfg" };
+    auto cfgs = make_cfgs(*table.get_table_instructions());
+    std::size_t blocks = 0;
+    for (auto const& cfg : cfgs)
+        blocks += cfg.size();
+    cfg_pass.count("blocks", blocks);
+    cfg_pass.finish();
+
+    passes::Scope emit_pass{ "emit" };
+    for (auto const& cfg : cfgs) {
+        dump(os, cfg, dot);
+        os << std::endl;
+    }
+    emit_pass.count("functions", cfgs.size());
+}
+
+} // namespace credence::ir
@@ -0,0 +1,246 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/frontend/hir/hir.h> // for Unit
+#include <credence/ir/quadruple.h>     // for Instructions, Quadruple
+#include <credence/ir/symbols.h>       // for Symbols
+#include <cstddef>                     // for size_t
+#include <cstdint>                     // for uint32_t
+#include <optional>                    // for optional
+#include <ostream>                     // for ostream
+#include <string>                      // for string
+#include <utility>                     // for pair
+#include <vector>                      // for vector
+
+/****************************************************************************
+ *
+ * Control-flow graph
+ *
+ * The blocks of one function of the ITA and the edges between them. In the
+ * ITA control flow is only in the text of its instructions: a LABEL starts
+ * a place a jump may land, and GOTO, IF and JMP_E jump to one. A CFG reads
+ * that once into blocks and edges, so a pass asks for the successors of a
+ * block and not for the next instruction that names a label:
+ *
+ *    main() {          B0  succ B1      __main(): BeginFunc ; x = 1;
+ *      auto x;         B1  succ B4 B2   _L2: _t5 = x > 1; IF _t5 GOTO _L4;
+ *      x = 1;          B2  succ B3      _L3: x = 0;
+ *      if (x > 1) {    B3  succ B5      _L1: LEAVE;
+ *        x = 2;        B4  succ B2      _L4: x = 2; GOTO _L3;
+ *      }               B5  succ -       EndFunc ;
+ *      x = 0;
+ *    }
+ *
+ * Block 0 is the entry, from the label of the function to the first place
+ * a jump lands, and the last block is the exit, EndFunc on its own, that
+ * every LEAVE flows to. A block is a range of the instructions of the
+ * function and does not copy them.
+ *
+ * Over the edges the graph keeps:
+ *
+ *    order         the blocks reachable from the entry, in reverse postorder
+ *    dominator     the immediate dominator of each block
+ *    postdominator the immediate postdominator of each block
+ *    loops         the loop nesting forest, one loop per header
+ *
+ * The dominator trees are built by Lengauer and Tarjan's algorithm, with
+ * path compression, and the loops by Havlak's walk from each header over
+ * the latches that jump back to it. Each is one pass, or close to one,
+ * over the blocks and edges, so the graph is cheap enough to build on
+ * every compile. A cycle with no block that dominates the rest of it,
+ * which a goto can make, is not a loop, and a loop whose body a goto
+ * jumps into past its header is marked irreducible.
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+using Block_Index = std::uint32_t;
+using Loop_Index = std::uint32_t;
+
+constexpr Block_Index null_block_index = 0xFFFFFFFFu;
+constexpr Loop_Index null_loop_index = 0xFFFFFFFFu;
+
+struct Block
+{
+    // the instructions of the block, [begin, end) in the function's list
+    std::size_t begin{ 0 };
+    std::size_t end{ 0 };
+
+    std::vector<Block_Index> successors{};
+    std::vector<Block_Index> predecessors{};
+
+    Block_Index dominator{ null_block_index };
+    Block_Index postdominator{ null_block_index };
+
+    // the innermost loop the block is in
+    Loop_Index loop{ null_loop_index };
+
+    bool empty() const { return begin == end; }
+};
+
+struct Loop
+{
+    Block_Index header{ null_block_index };
+    Loop_Index parent{ null_loop_index };
+    // 1 for an outermost loop
+    std::uint32_t depth{ 1 };
+    // the blocks of the loop, including those of the loops nested in it
+    std::vector<Block_Index> blocks{};
+    bool irreducible{ false };
+};
+
+class CFG
+{
+  public:
+    /**
+     * @brief Build the graph of a function, from its LABEL to its EndFunc
+     */
+    static CFG build(Instructions const& instructions,
+        std::size_t begin,
+        std::size_t end);
+
+    std::string const& name() const { return name_; }
+
+    Block_Index entry() const { return 0; }
+    Block_Index exit() const
+    {
+        return static_cast<Block_Index>(blocks_.size() - 1);
+    }
+
+    std::vector<Block> const& blocks() const { return blocks_; }
+    Block const& operator[](Block_Index index) const
+    {
+        return blocks_[index];
+    }
+    std::size_t size() const { return blocks_.size(); }
+
+    /**
+     * @brief The blocks reachable from the entry, in reverse postorder
+     */
+    std::vector<Block_Index> const& order() const { return order_; }
+
+    std::vector<Loop> const& loops() const { return loops_; }
+
+    bool reachable(Block_Index block) const
+    {
+        return block == entry() or
+               blocks_[block].dominator != null_block_index;
+    }
+
+    /**
+     * @brief Whether every path from the entry to b passes through a, and
+     * false when either is unreachable
+     */
+    bool dominates(Block_Index a, Block_Index b) const;
+
+    /**
+     * @brief Whether every path from b to the exit passes through a, and
+     * false when either cannot reach the exit
+     */
+    bool postdominates(Block_Index a, Block_Index b) const;
+
+    /**
+     * @brief The loop depth of a block, 0 outside of every loop
+     */
+    std::uint32_t loop_depth(Block_Index block) const
+    {
+        auto loop = blocks_[block].loop;
+        return loop == null_loop_index ? 0 : loops_[loop].depth;
+    }
+
+    Instructions const& instructions() const { return *instructions_; }
+
+  private:
+    void build_blocks(std::size_t begin, std::size_t end);
+    void build_order();
+    void build_dominators();
+    void build_postdominators();
+    void build_loops();
+
+  private:
+    std::string name_{};
+    Instructions const* instructions_{ nullptr };
+    std::vector<Block> blocks_{};
+    std::vector<Block_Index> order_{};
+    std::vector<Loop> loops_{};
+    // the preorder and postorder numbers of each block in the two trees
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> dominator_interval_{};
+    std::vector<std::pair<std::uint32_t, std::uint32_t>>
+        postdominator_interval_{};
+};
+
+/**
+ * @brief The [begin, end) of each function of a list of instructions, from
+ * its LABEL to its EndFunc, in order
+ */
+std::vector<std::pair<std::size_t, std::size_t>> function_ranges(
+    Instructions const& instructions);
+
+/**
+ * @brief The largest number of an operand of a kind in a function, e.g.
+ * 9 of its temporaries if _t9 is the last, so a new one can follow it
+ */
+std::uint32_t last_number(Instructions const& instructions, Operand_Kind kind);
+
+/**
+ * @brief The graph of each function of a list of instructions, in order
+ */
+std::vector<CFG> make_cfgs(Instructions const& instructions);
+
+/**
+ * @brief Drop the blocks of a function, from its LABEL to its EndFunc,
+ * that no path from the entry reaches, and give the quadruples dropped
+ */
+std::size_t remove_unreachable_blocks(Instructions& function);
+
+/**
+ * @brief Where code run once before a loop is inserted, and the label of
+ * the block added for it, or empty where the block entering the loop is
+ * kept for it
+ */
+struct Preheader
+{
+    std::size_t at{ 0 };
+    Operand_Table::Handle label{ Operand_Table::empty };
+};
+
+/**
+ * @brief The preheader of a loop of a function, from its LABEL to its
+ * EndFunc, or none if it can have none
+ *
+ * Where a new block is needed, the jumps into the loop from outside it
+ * are retargeted to its label, and a pass inserts that LABEL at the
+ * preheader first.
+ */
+std::optional<Preheader> make_preheader(Instructions& function,
+    CFG const& cfg,
+    Loop const& loop);
+
+/**
+ * @brief Print a graph as text, or as Graphviz dot if dot is true
+ */
+void dump(std::ostream& os, CFG const& cfg, bool dot = false);
+
+/**
+ * @brief Build the ITA and the table of a unit and print each function's
+ * graph, as -t cfg does
+ */
+void emit_cfg(std::ostream& os,
+    Symbols const& symbols,
+    frontend::hir::Unit const& unit,
+    bool dot = false);
+
+} // namespace credence::ir
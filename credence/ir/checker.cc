@@ -13,19 +13,21 @@
 
 #include <credence/ir/checker.h>
 
-#include <credence/error.h>     // for throw_type_check_error, credence_as...
-#include <credence/ir/object.h> // for RValue, Vector, LValue, Object, get_...
-#include <credence/types.h>     // for get_type_from_rvalue_data_type, is_d...
-#include <credence/util.h>      // for contains, is_numeric, overload
-#include <easyjson.h>           // for JSON
-#include <fmt/format.h>         // for format
-#include <functional>           // for __bind, __ph, bind, _1
-#include <matchit.h>            // for app, Ds, App, pattern, ds, Wildcard
-#include <memory>               // for shared_ptr
-#include <string>               // for basic_string, operator==, char_traits
-#include <string_view>          // for basic_string_view
-#include <tuple>                // for tuple, get
-#include <variant>              // for visit
+#include <credence/error.h>        // for throw_type_check_error, credence_as...
+#include <credence/ir/object.h>    // for RValue, Vector, LValue, Object, get_...
+#include <credence/ir/quadruple.h> // for value_of, text_of, Lvalue_Shape
+#include <credence/types.h>        // for get_type_from_rvalue_data_type, is_d...
+#include <credence/util.h>         // for contains, is_numeric, overload
+#include <easyjson.h>              // for JSON
+#include <fmt/format.h>            // for format
+#include <functional>              // for __bind, __ph, bind, _1
+#include <matchit.h>               // for app, Ds, App, pattern, ds, Wildcard
+#include <memory>                  // for shared_ptr
+#include <string>                  // for basic_string, operator==, char_traits
+#include <string_view>             // for basic_string_view
+#include <tuple>                   // for tuple, get
+#include <utility>                 // for pair
+#include <variant>                 // for visit
 
 /****************************************************************************
  *  Type Checker
@@ -58,6 +60,36 @@ namespace credence::ir {
 
 namespace m = matchit;
 
+namespace {
+
+/**
+ * @brief Check if an operand is a vector offset, e.g. v[k]
+ */
+bool is_vector_offset(RValue const& rvalue)
+{
+    return value_of(rvalue).shape == Lvalue_Shape::Offset;
+}
+
+/**
+ * @brief Check if an operand is a dereference, e.g. *p
+ */
+bool is_dereference(RValue const& rvalue)
+{
+    return value_of(rvalue).unary == "*";
+}
+
+/**
+ * @brief The vector and the offset of a vector offset, e.g. v and k of v[k]
+ */
+std::pair<RValue, RValue> vector_and_offset_of(RValue const& rvalue)
+{
+    auto const& value = value_of(rvalue);
+    credence_assert(value.shape == Lvalue_Shape::Offset);
+    return { text_of(value.base), text_of(value.offset) };
+}
+
+} // namespace
+
 /**
  * @brief Type check pointer and address-of pointer assignments
  */
@@ -113,9 +145,10 @@ void Type_Checker::type_safe_assign_pointer(LValue const& lvalue,
         }
     }
 
-    auto human_symbol = type::is_rvalue_data_type(rvalue)
+    auto const& value = value_of(rvalue);
+    auto human_symbol = value.is_literal()
                             ? type::get_value_from_rvalue_data_type(
-                                  type::get_data_type_from_string(rvalue))
+                                  value.literal)
                             : rvalue;
     if (indirection) {
         if (!locals.is_pointer(lvalue) or
@@ -210,18 +243,20 @@ void Type_Checker::type_safe_assign_vector(LValue const& lvalue,
         std::bind(&Type_Checker::local_contains_, this, std::placeholders::_1);
 
     auto lvalue_direct = m::match(lvalue)(
-        m::pattern | m::app(object::is_vector_lvalue, true) =
+        m::pattern | m::app(is_vector_offset, true) =
             [&] {
-                lvalue_offset = type::from_decay_offset(lvalue);
-                return type::from_lvalue_offset(lvalue);
+                auto [vector, offset] = vector_and_offset_of(lvalue);
+                lvalue_offset = offset;
+                return vector;
             },
         m::pattern | m::_ = [&] { return lvalue; });
 
     auto rvalue_direct = m::match(rvalue)(
-        m::pattern | m::app(object::is_vector_lvalue, true) =
+        m::pattern | m::app(is_vector_offset, true) =
             [&] {
-                rvalue_offset = type::from_decay_offset(rvalue);
-                return type::from_lvalue_offset(rvalue);
+                auto [vector, offset] = vector_and_offset_of(rvalue);
+                rvalue_offset = offset;
+                return vector;
             },
         m::pattern | m::_ = [&] { return rvalue; });
 
@@ -283,15 +318,15 @@ void Type_Checker::type_safe_assign_dereference(LValue const& lvalue,
     auto lhs_lvalue = type::get_unary_rvalue_reference(lvalue);
     auto rhs_lvalue = type::get_unary_rvalue_reference(rvalue);
 
-    if (locals.is_pointer(lvalue) and type::is_dereference_expression(rvalue))
+    if (locals.is_pointer(lvalue) and is_dereference(rvalue))
         throw_type_check_error("invalid pointer dereference, "
                                "right-hand-side is not a pointer",
             lvalue);
-    if (locals.is_pointer(rvalue) and type::is_dereference_expression(lvalue))
+    if (locals.is_pointer(rvalue) and is_dereference(lvalue))
         throw_type_check_error("invalid pointer dereference, "
                                "right-hand-side is not a pointer",
             lvalue);
-    if (type::is_dereference_expression(rvalue)) {
+    if (is_dereference(rvalue)) {
         auto symbol = get_rvalue_at_lvalue_object_storage(
             rhs_lvalue, stack_frame_, vectors, __source__);
         if (type::get_type_from_rvalue_data_type(symbol) == "null")
@@ -299,17 +334,15 @@ void Type_Checker::type_safe_assign_dereference(LValue const& lvalue,
                                    "right-hand-side is a null pointer!",
                 lvalue);
     }
-    if (!locals.is_pointer(lhs_lvalue) and
-        not type::is_dereference_expression(rvalue))
+    if (!locals.is_pointer(lhs_lvalue) and not is_dereference(rvalue))
         throw_type_check_error("invalid pointer dereference, "
                                "left-hand-side is not a pointer",
             lhs_lvalue);
-    if (!locals.is_pointer(rhs_lvalue) and
-        not type::is_dereference_expression(lvalue))
+    if (!locals.is_pointer(rhs_lvalue) and not is_dereference(lvalue))
         throw_type_check_error("invalid pointer dereference, "
                                "right-hand-side is not a pointer",
             lhs_lvalue);
-    if (type::is_dereference_expression(lvalue) and
+    if (is_dereference(lvalue) and
         type::get_type_from_rvalue_data_type(rvalue) != "null") {
         locals.set_symbol_by_name(lhs_lvalue, rvalue);
         return;
@@ -365,7 +398,7 @@ void Type_Checker::type_safe_assign_pointer_or_vector_lvalue(
                 return; // Done
             }
             if (is_pointer(lvalue) or is_pointer(value)) {
-                if (!type::is_dereference_expression(value)) {
+                if (!is_dereference(value)) {
                     type_safe_assign_pointer(lvalue, value);
                     return; // Done
                 }
@@ -376,8 +409,7 @@ void Type_Checker::type_safe_assign_pointer_or_vector_lvalue(
             }
             // A dereference assignment, check for invalid or
             // null pointers
-            if (type::is_dereference_expression(lvalue) or
-                type::is_dereference_expression(value)) {
+            if (is_dereference(lvalue) or is_dereference(value)) {
                 type_safe_assign_dereference(lvalue, value);
                 return;
             }
@@ -414,10 +446,9 @@ Type Type_Checker::get_type_from_rvalue_data_type(LValue const& lvalue)
 {
     auto const& locals = get_stack_frame_locals();
     auto& vectors = objects_->get_vectors();
-    if (util::contains(lvalue, "[")) {
+    if (is_vector_offset(lvalue)) {
         is_boundary_out_of_range(lvalue);
-        auto lhs_lvalue = type::from_lvalue_offset(lvalue);
-        auto offset = type::from_decay_offset(lvalue);
+        auto [lhs_lvalue, offset] = vector_and_offset_of(lvalue);
         return std::get<1>(vectors[lhs_lvalue]->get_data()[offset]);
     }
     return std::get<1>(locals.get_symbol_by_name(lvalue));
@@ -430,10 +461,9 @@ Size Type_Checker::get_size_from_local_lvalue(LValue const& lvalue)
 {
     auto const& locals = get_stack_frame_locals();
     auto& vectors = objects_->get_vectors();
-    if (util::contains(lvalue, "[")) {
+    if (is_vector_offset(lvalue)) {
         is_boundary_out_of_range(lvalue);
-        auto lhs_lvalue = type::from_lvalue_offset(lvalue);
-        auto offset = type::from_decay_offset(lvalue);
+        auto [lhs_lvalue, offset] = vector_and_offset_of(lvalue);
         return std::get<2>(vectors[lhs_lvalue]->get_data()[offset]);
     }
     if (get_type_from_rvalue_data_type(lvalue) == "word" and
@@ -450,11 +480,8 @@ Size Type_Checker::get_size_from_local_lvalue(LValue const& lvalue)
  */
 void Type_Checker::is_boundary_out_of_range(RValue const& rvalue)
 {
-    credence_assert(util::contains(rvalue, "["));
-    credence_assert(util::contains(rvalue, "]"));
     auto& vectors = objects_->get_vectors();
-    auto lvalue = type::from_lvalue_offset(rvalue);
-    auto offset = type::from_decay_offset(rvalue);
+    auto [lvalue, offset] = vector_and_offset_of(rvalue);
     if (!vectors.contains(lvalue))
         throw_type_check_error(
             fmt::format("invalid vector assignment, vector identifier "
@@ -463,8 +490,7 @@ void Type_Checker::is_boundary_out_of_range(RValue const& rvalue)
                 lvalue),
             rvalue);
     if (util::is_numeric(offset)) {
-        auto global_symbol = objects_->get_hoisted_symbols()[lvalue];
-        auto ul_offset = std::stoul(offset);
+        auto ul_offset = static_cast<std::size_t>(value_of(offset).integer);
         if (ul_offset > object::Vector::max_size)
             throw_type_check_error(
                 fmt::format("invalid rvalue, integer offset '{}' is a"
@@ -13,19 +13,20 @@
 
 #pragma once
 
-#include <algorithm>            // for __find, find
-#include <credence/error.h>     // for throw_compiletime_error
-#include <credence/ir/object.h> // for LValue, RValue, Object, Function
-#include <credence/types.h>     // for get_type_from_rvalue_data_type, Data...
-#include <credence/util.h>      // for contains, str_trim_ws
-#include <fmt/format.h>         // for format
-#include <functional>           // for function
-#include <initializer_list>     // for initializer_list
-#include <memory>               // for shared_ptr
-#include <source_location>      // for source_location
-#include <string>               // for basic_string, operator==, char_traits
-#include <string_view>          // for basic_string_view
-#include <tuple>                // for get, tuple
+#include <algorithm>               // for __find, find
+#include <credence/error.h>        // for throw_compiletime_error
+#include <credence/ir/object.h>    // for LValue, RValue, Object, Function
+#include <credence/ir/quadruple.h> // for value_of, text_of, Lvalue_Shape
+#include <credence/types.h>        // for get_type_from_rvalue_data_type, Data...
+#include <credence/util.h>         // for contains, str_trim_ws
+#include <fmt/format.h>            // for format
+#include <functional>              // for function
+#include <initializer_list>        // for initializer_list
+#include <memory>                  // for shared_ptr
+#include <source_location>         // for source_location
+#include <string>                  // for basic_string, operator==, char_traits
+#include <string_view>             // for basic_string_view
+#include <tuple>                   // for get, tuple
 
 /****************************************************************************
  *  Type Checker
@@ -143,8 +144,9 @@ class Type_Checker
 
     inline bool is_vector(RValue const& rvalue)
     {
-        auto label = util::contains(rvalue, "[")
-                         ? type::from_lvalue_offset(rvalue)
+        auto const& value = value_of(rvalue);
+        auto label = value.shape == Lvalue_Shape::Offset
+                         ? text_of(value.base)
                          : rvalue;
         return objects_->get_vectors().contains(label);
     }
@@ -169,7 +171,7 @@ class Type_Checker
     inline bool is_vector_or_pointer(RValue const& rvalue)
     {
         return is_vector(rvalue) or is_pointer(rvalue) or
-               type::is_dereference_expression(rvalue);
+               value_of(rvalue).unary == "*";
     }
 
   private:
@@ -224,8 +226,7 @@ class Type_Checker
             symbol,
             __source__,
             type_,
-            objects_->get_stack_frame()->get_symbol(),
-            objects_->get_hoisted_symbols());
+            objects_->get_stack_frame()->get_symbol());
     }
 
   private:
@@ -0,0 +1,148 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/copies.h>
+
+#include <credence/ir/cfg.h> // for CFG
+#include <string_view>       // for string_view
+#include <unordered_map>     // for unordered_map
+#include <unordered_set>     // for unordered_set
+
+namespace credence::ir {
+
+namespace {
+
+using Handle = Operand_Table::Handle;
+
+constexpr auto empty = Operand_Table::empty;
+
+} // namespace
+
+/**
+ * @brief Coalesce each temporary read once by a copy into it, propagate
+ * the copies of versions left, and give the number of copies dropped
+ *
+ * A dropped copy is a NOOP until the function is ordinary ITA again, as
+ * the graph of the form holds the index of each instruction.
+ */
+std::size_t propagate_copies(SSA& ssa)
+{
+    auto& table = operand_table();
+    auto const& cfg = ssa.cfg();
+    auto& instructions = ssa.instructions();
+    auto is_version = [&](Handle name) {
+        return ssa.variable_of(name) != name;
+    };
+    // a MOV of one operand to a version, e.g. x#3 = _t6#1
+    auto is_copy = [&](Quadruple const& quadruple) {
+        return quadruple.op == Instruction::MOV and
+               quadruple.operands[2] == empty and
+               is_version(quadruple.operands[0]);
+    };
+
+    // the reads of each version, the instruction that assigns each, and
+    // the versions the backends read by name
+    std::unordered_map<Handle, std::size_t> reads{};
+    std::unordered_map<Handle, std::size_t> defined{};
+    std::unordered_set<Handle> fixed{};
+    auto returned = table.intern("RET");
+    for (auto block : cfg.order()) {
+        for (auto const& phi : ssa.phis(block))
+            for (auto argument : phi.arguments)
+                if (argument != empty)
+                    reads[argument]++;
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++) {
+            auto const& quadruple = instructions[i];
+            detail::for_each_read(
+                quadruple, [&](Handle name) { reads[name]++; });
+            if (auto name = detail::assigned(quadruple);
+                name != empty and is_version(name)) {
+                defined[name] = i;
+                if (quadruple.operands[1] == returned)
+                    fixed.insert(name);
+            }
+            if (quadruple.op == Instruction::MOV and
+                quadruple.operands[2] != empty)
+                fixed.insert(quadruple.operands[2]);
+        }
+    }
+
+    std::size_t dropped = 0;
+    for (auto block : cfg.order()) {
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++) {
+            auto& quadruple = instructions[i];
+            if (not is_copy(quadruple))
+                continue;
+            auto temporary = quadruple.operands[1];
+            if (not is_version(temporary) or
+                table.kind(temporary) != Operand_Kind::Temporary or
+                reads[temporary] != 1 or fixed.contains(temporary))
+                continue;
+            auto found = defined.find(temporary);
+            if (found == defined.end() or
+                instructions[found->second].operands[2] != empty)
+                continue;
+            instructions[found->second].operands[0] = quadruple.operands[0];
+            quadruple = Quadruple{};
+            dropped++;
+        }
+    }
+
+    std::unordered_map<Handle, Handle> copy_of{};
+    for (auto block : cfg.order()) {
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++) {
+            auto& quadruple = instructions[i];
+            if (not is_copy(quadruple))
+                continue;
+            auto lhs = quadruple.operands[0];
+            auto rhs = quadruple.operands[1];
+            if (not(is_version(rhs) or ssa.is_variable(rhs)) or
+                fixed.contains(lhs) or fixed.contains(rhs))
+                continue;
+            copy_of[lhs] = rhs;
+            quadruple = Quadruple{};
+            dropped++;
+        }
+    }
+    if (copy_of.empty())
+        return dropped;
+
+    auto root = [&](Handle version) {
+        for (auto found = copy_of.find(version); found != copy_of.end();
+            found = copy_of.find(version))
+            version = found->second;
+        return version;
+    };
+    for (auto block : cfg.order()) {
+        for (auto& phi : ssa.phis(block))
+            for (auto& argument : phi.arguments)
+                if (argument != empty)
+                    argument = root(argument);
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++) {
+            auto& quadruple = instructions[i];
+            for (std::size_t k = 0; k < 3; k++) {
+                if (not detail::reads(quadruple, k))
+                    continue;
+                quadruple.operands[k] = detail::replace_names(
+                    quadruple.operands[k], [&](std::string_view text) {
+                        auto name = table.intern(text);
+                        auto copied = root(name);
+                        return copied == name ? empty : copied;
+                    });
+            }
+        }
+    }
+    return dropped;
+}
+
+} // namespace credence::ir
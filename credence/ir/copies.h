@@ -0,0 +1,56 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/ir/ssa.h> // for SSA
+#include <cstddef>           // for size_t
+
+/****************************************************************************
+ *
+ * Copy propagation and temporary coalescing
+ *
+ * The ITA computes an assignment into a temporary and then copies it to
+ * the name, and each temporary is a stack slot or a register of its own
+ * in the backends, with a mov for the copy:
+ *
+ *    _t6 = x - (1:int:4);
+ *    x = _t6;
+ *
+ * In SSA form a temporary read once, by a copy, is coalesced into the
+ * copy: the instruction that computes it assigns the version the copy
+ * assigned, and the copy is dropped. So the above is x = x - (1:int:4)
+ * once the form is left, when the two versions of x do not overlap:
+ *
+ *    _t6#1 = x#2 - (1:int:4);        x#3 = x#2 - (1:int:4);
+ *    x#3 = _t6#1;
+ *
+ * A copy of one version to another that is left is then propagated: each
+ * read of the version it assigns reads the version it copies, phis too,
+ * and the copy is dropped.
+ *
+ * A version read by an increment or decrement in place, x = ++x, and one
+ * that holds the RET of a call, is left as it is, as the backends read
+ * each of those by its name.
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+/**
+ * @brief Coalesce each temporary read once by a copy into it, propagate
+ * the copies of versions left, and give the number of copies dropped
+ */
+std::size_t propagate_copies(SSA& ssa);
+
+} // namespace credence::ir
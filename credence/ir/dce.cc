@@ -0,0 +1,274 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/dce.h>
+
+#include <algorithm>          // for find_if
+#include <credence/ir/cfg.h>  // for CFG, remove_unreachable_blocks
+#include <string_view>        // for string_view
+#include <unordered_map>      // for unordered_map
+#include <unordered_set>      // for unordered_set
+#include <utility>            // for move
+#include <vector>             // for vector
+
+namespace credence::ir {
+
+namespace {
+
+using Handle = Operand_Table::Handle;
+
+constexpr auto empty = Operand_Table::empty;
+
+/**
+ * @brief Keep the instructions of a function that keep(i) is true of
+ */
+template<typename F>
+void keep_if(Instructions& function, F&& keep)
+{
+    Instructions kept{ resource_of(function) };
+    for (std::size_t i = 0; i < function.size(); i++)
+        if (keep(i))
+            kept.push_back(function[i]);
+    if (kept.size() != function.size())
+        function = std::move(kept);
+}
+
+constexpr bool is_straight_line(Instruction op)
+{
+    return op == Instruction::MOV or op == Instruction::PUSH or
+           op == Instruction::POP or op == Instruction::CALL;
+}
+
+/**
+ * @brief Drop the straight-line code after a RETURN in its block
+ *
+ * Not where the rest of the block branches, or assigns a name read past
+ * it, as the statement it is part of may go on in another block.
+ */
+void drop_after_return(Instructions& function)
+{
+    auto cfg = CFG::build(function, 0, function.size());
+    std::vector<bool> dropped(function.size(), false);
+    for (Block_Index block = 0; block < cfg.size(); block++) {
+        auto const& b = cfg[block];
+        auto begin = function.begin() + static_cast<std::ptrdiff_t>(b.begin);
+        auto end = function.begin() + static_cast<std::ptrdiff_t>(b.end);
+        auto returned = std::find_if(begin, end, [](auto const& quadruple) {
+            return quadruple.op == Instruction::RETURN;
+        });
+        if (returned == end)
+            continue;
+        auto first = static_cast<std::size_t>(returned - function.begin()) + 1;
+
+        bool branches = false;
+        std::unordered_set<Handle> assigned{};
+        for (auto i = first; i < b.end; i++) {
+            auto const& quadruple = function[i];
+            if (quadruple.op == Instruction::IF or
+                quadruple.op == Instruction::JMP_E)
+                branches = true;
+            if (auto name = detail::assigned(quadruple); name != empty)
+                assigned.insert(name);
+        }
+        bool read_past = false;
+        for (std::size_t i = 0; i < function.size() and not branches; i++) {
+            if (i >= first and i < b.end)
+                continue;
+            detail::for_each_read(function[i], [&](Handle name) {
+                read_past = read_past or assigned.contains(name);
+            });
+        }
+        if (branches or read_past)
+            continue;
+        for (auto i = first; i < b.end; i++)
+            if (is_straight_line(function[i].op))
+                dropped[i] = true;
+    }
+    keep_if(function, [&](std::size_t i) { return not dropped[i]; });
+}
+
+/**
+ * @brief Drop the _L labels no jump names
+ *
+ * The backends only place the _L1 label of the epilogue in a function
+ * with another label, so a function that jumps to it keeps them all.
+ */
+void drop_unused_labels(Instructions& function)
+{
+    auto& table = operand_table();
+    auto reserved = table.intern("_L1");
+    std::unordered_set<Handle> targets{};
+    for (auto const& quadruple : function) {
+        if (quadruple.op == Instruction::GOTO)
+            targets.insert(quadruple.operands[0]);
+        if (quadruple.op == Instruction::IF or
+            quadruple.op == Instruction::JMP_E)
+            targets.insert(quadruple.operands[2]);
+    }
+    if (targets.contains(reserved))
+        return;
+    keep_if(function, [&](std::size_t i) {
+        auto const& quadruple = function[i];
+        auto label = quadruple.operands[0];
+        return quadruple.op != Instruction::LABEL or
+               table.kind(label) != Operand_Kind::Label or
+               label == reserved or targets.contains(label);
+    });
+}
+
+/**
+ * @brief Drop the LOCL of each name no other instruction names
+ */
+void drop_unused_locals(Instructions& function)
+{
+    auto& table = operand_table();
+    auto first_name = [&](Handle operand) {
+        std::string_view text = table.text(operand);
+        Handle name = empty;
+        detail::for_each_name(text, [&](std::size_t begin, std::size_t end) {
+            if (name == empty)
+                name = table.intern(text.substr(begin, end - begin));
+        });
+        return name;
+    };
+    std::unordered_set<Handle> named{};
+    for (auto const& quadruple : function) {
+        if (quadruple.op == Instruction::LOCL)
+            continue;
+        for (auto operand : quadruple.operands) {
+            std::string_view text = table.text(operand);
+            detail::for_each_name(
+                text, [&](std::size_t begin, std::size_t end) {
+                    named.insert(
+                        table.intern(text.substr(begin, end - begin)));
+                });
+        }
+    }
+    keep_if(function, [&](std::size_t i) {
+        auto const& quadruple = function[i];
+        return quadruple.op != Instruction::LOCL or
+               named.contains(first_name(quadruple.operands[0]));
+    });
+}
+
+} // namespace
+
+/**
+ * @brief Drop the assignments of a function in SSA form whose versions are
+ * not read by anything live, and give the number of quadruples dropped
+ *
+ * Each dropped instruction is a NOOP until the function is ordinary ITA
+ * again, as the graph of the form holds the index of each instruction.
+ */
+std::size_t eliminate_dead_code(SSA& ssa)
+{
+    auto const& cfg = ssa.cfg();
+    auto& instructions = ssa.instructions();
+
+    // where each version is assigned, by an instruction or a phi
+    struct Definition
+    {
+        Block_Index block;
+        std::size_t index;
+        bool phi;
+    };
+    std::unordered_map<Handle, Definition> defined{};
+    std::vector<std::vector<bool>> live_phis(cfg.size());
+    std::vector<bool> live(instructions.size(), false);
+    for (auto block : cfg.order()) {
+        auto const& phis = ssa.phis(block);
+        live_phis[block].assign(phis.size(), false);
+        for (std::size_t i = 0; i < phis.size(); i++)
+            defined.emplace(phis[i].result, Definition{ block, i, true });
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++)
+            if (auto name = detail::assigned(instructions[i]);
+                name != empty and ssa.variable_of(name) != name)
+                defined.emplace(name, Definition{ block, i, false });
+    }
+
+    std::vector<Definition> work{};
+    auto mark = [&](Handle version) {
+        auto found = defined.find(version);
+        if (found == defined.end())
+            return;
+        auto [block, index, phi] = found->second;
+        if (phi ? live_phis[block][index] : live[index])
+            return;
+        if (phi)
+            live_phis[block][index] = true;
+        else
+            live[index] = true;
+        work.push_back(found->second);
+    };
+    // everything but an assignment to a version must run, and so must one
+    // that changes a name in place, e.g. _t5 = ++ x
+    for (auto block : cfg.order())
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++)
+            if (auto name = detail::assigned(instructions[i]);
+                name == empty or ssa.variable_of(name) == name or
+                detail::is_in_place_update(instructions[i].operands[1])) {
+                live[i] = true;
+                work.push_back(Definition{ block, i, false });
+            }
+    while (not work.empty()) {
+        auto definition = work.back();
+        work.pop_back();
+        if (definition.phi) {
+            auto const& phi = ssa.phis(definition.block)[definition.index];
+            for (auto argument : phi.arguments)
+                if (argument != empty)
+                    mark(argument);
+        } else
+            detail::for_each_read(instructions[definition.index], mark);
+    }
+
+    std::size_t removed = 0;
+    for (auto block : cfg.order()) {
+        auto& phis = ssa.phis(block);
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < phis.size(); i++) {
+            if (not live_phis[block][i])
+                continue;
+            // a phi moved onto itself would lose its arguments
+            if (kept != i)
+                phis[kept] = std::move(phis[i]);
+            kept++;
+        }
+        phis.resize(kept);
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++)
+            if (not live[i]) {
+                instructions[i] = Quadruple{};
+                removed++;
+            }
+    }
+    return removed;
+}
+
+/**
+ * @brief Drop the code after a return, the unreached blocks, the unused
+ * labels, and the unused locals of a function, from its LABEL to its
+ * EndFunc, and give the number of quadruples dropped
+ */
+std::size_t remove_dead_code(Instructions& function)
+{
+    auto size = function.size();
+    keep_if(function,
+        [&](std::size_t i) { return function[i].op != Instruction::NOOP; });
+    drop_after_return(function);
+    remove_unreachable_blocks(function);
+    drop_unused_labels(function);
+    drop_unused_locals(function);
+    return size - function.size();
+}
+
+} // namespace credence::ir
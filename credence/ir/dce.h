@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/ir/quadruple.h> // for Instructions
+#include <credence/ir/ssa.h>       // for SSA
+#include <cstddef>                 // for size_t
+
+/****************************************************************************
+ *
+ * Dead code elimination
+ *
+ * An assignment to a version that nothing live reads is dead. In SSA form
+ * each version has one definition, so liveness is a mark from the
+ * instructions that must run - a call, a store to a name that is not
+ * split, a branch, a return - back along the definitions of the versions
+ * they read, and through the arguments of each phi reached. What is not
+ * marked is dropped:
+ *
+ *    x#1 = (1:int:4);          x#1 = (1:int:4);
+ *    _t2#1 = x#1 * (2:int:4);
+ *    y#1 = _t2#1;
+ *    _t3#1 = RET;
+ *    RET x#1;                  RET x#1;
+ *
+ * The right-hand side of a MOV only reads, so an assignment is dead by
+ * the use of its version alone, however it was computed.
+ *
+ * remove_dead_code() then cleans the ordinary ITA the form gives back:
+ *
+ *    - the straight-line code after a RETURN in its block, which the
+ *      return leaves before it runs
+ *    - the blocks no path from the entry reaches
+ *    - the _L labels no jump names, so their blocks join the one above
+ *    - the LOCL of a name nothing reads or assigns any longer, so the
+ *      table gives it no stack slot
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+/**
+ * @brief Drop the assignments of a function in SSA form whose versions are
+ * not read by anything live, and give the number of quadruples dropped
+ */
+std::size_t eliminate_dead_code(SSA& ssa);
+
+/**
+ * @brief Drop the code after a return, the unreached blocks, the unused
+ * labels, and the unused locals of a function, from its LABEL to its
+ * EndFunc, and give the number of quadruples dropped
+ */
+std::size_t remove_dead_code(Instructions& function);
+
+} // namespace credence::ir
@@ -0,0 +1,373 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/gvn.h>
+
+#include <algorithm>                     // for find
+#include <credence/frontend/hir/probe.h> // for combine_hash, mix_hash
+#include <credence/ir/cfg.h>             // for CFG, Block_Index
+#include <cstdint>                       // for uint64_t
+#include <optional>                      // for optional, nullopt
+#include <string_view>                   // for string_view
+#include <unordered_map>                 // for unordered_map
+#include <unordered_set>                 // for unordered_set
+#include <utility>                       // for move, swap
+#include <vector>                        // for vector
+
+namespace credence::ir {
+
+namespace {
+
+using Handle = Operand_Table::Handle;
+
+constexpr auto empty = Operand_Table::empty;
+
+/**
+ * @brief An operation by its operator and the values of its operands
+ */
+struct Key
+{
+    Handle op{ empty };
+    Handle lhs{ empty };
+    Handle rhs{ empty };
+
+    bool operator==(Key const& other) const = default;
+};
+
+struct Key_Hash
+{
+    std::size_t operator()(Key const& key) const
+    {
+        using frontend::hir::combine_hash;
+        return static_cast<std::size_t>(combine_hash(
+            combine_hash(frontend::hir::mix_hash(key.op), key.lhs), key.rhs));
+    }
+};
+
+/**
+ * @brief A load computed in a block, and what a store may change it by
+ */
+struct Load
+{
+    Handle value{ empty };
+    // the names it reads that are not split, e.g. g of "g + x#1"
+    std::vector<Handle> names{};
+    // whether it reads through a pointer, e.g. *p or p[k]
+    bool indirect{ false };
+};
+
+using Loads = std::unordered_map<Key, Load, Key_Hash>;
+
+bool is_commutative(std::string_view op)
+{
+    return op == "+" or op == "*" or op == "&" or op == "|" or op == "^" or
+           op == "==" or op == "!=";
+}
+
+/**
+ * @brief The numbering of one function in SSA form, by a walk of its
+ * dominator tree
+ */
+class Value_Numbering
+{
+  public:
+    explicit Value_Numbering(SSA& ssa);
+
+    std::size_t run();
+
+  private:
+    bool is_split(Handle name) const
+    {
+        return ssa_.variable_of(name) != name or ssa_.is_variable(name);
+    }
+    Handle representative(Handle operand) const;
+    bool is_load(Handle operand) const;
+    std::optional<Key> key_of(Handle operand) const;
+    Load load_of(Handle operand, Handle value) const;
+    void store(Quadruple const& quadruple, Loads& loads) const;
+    void visit(Block_Index block, Loads& loads, std::vector<Key>& scoped);
+
+  private:
+    SSA& ssa_;
+    CFG const& cfg_;
+    std::size_t reused_{ 0 };
+    // each version that is a copy, to the value it copies
+    std::unordered_map<Handle, Handle> representatives_{};
+    // the operations on versions alone in scope, to the version of each
+    std::unordered_map<Key, Handle, Key_Hash> available_{};
+    // the vectors of the function, each an object of its own
+    std::unordered_set<Handle> vectors_{};
+    // the versions read by an increment or decrement in place
+    std::unordered_set<Handle> in_place_{};
+};
+
+Value_Numbering::Value_Numbering(SSA& ssa)
+    : ssa_(ssa)
+    , cfg_(ssa.cfg())
+{
+    auto& table = operand_table();
+    // a vector is a local indexed by name and never assigned whole, as a
+    // local that is may hold the address of another
+    std::unordered_set<Handle> assigned{};
+    std::unordered_set<Handle> indexed{};
+    for (auto const& quadruple : ssa_.instructions()) {
+        if (quadruple.op != Instruction::MOV)
+            continue;
+        auto lhs = quadruple.operands[0];
+        if (table.value(lhs).shape == Lvalue_Shape::Scalar)
+            assigned.insert(lhs);
+        if (quadruple.operands[2] != empty)
+            in_place_.insert(quadruple.operands[2]);
+        for (auto operand : quadruple.operands)
+            if (auto const& value = table.value(operand);
+                value.shape == Lvalue_Shape::Offset)
+                indexed.insert(value.base);
+    }
+    for (auto const& quadruple : ssa_.instructions()) {
+        auto name = quadruple.operands[0];
+        if (quadruple.op == Instruction::LOCL and
+            table.value(name).shape == Lvalue_Shape::Scalar and
+            indexed.contains(name) and not assigned.contains(name))
+            vectors_.insert(name);
+    }
+}
+
+/**
+ * @brief The value of an operand, the operand a copy of it copies or the
+ * operand itself
+ */
+Handle Value_Numbering::representative(Handle operand) const
+{
+    auto found = representatives_.find(operand);
+    return found == representatives_.end() ? operand : found->second;
+}
+
+/**
+ * @brief Whether an operand reads a name that is not split
+ */
+bool Value_Numbering::is_load(Handle operand) const
+{
+    auto& table = operand_table();
+    std::string_view text = table.text(operand);
+    bool load = false;
+    detail::for_each_name(text, [&](std::size_t begin, std::size_t end) {
+        auto name = table.intern(text.substr(begin, end - begin));
+        load = load or not is_split(name);
+    });
+    return load;
+}
+
+/**
+ * @brief The key of an operation, or none if the operand is not one that
+ * may be reused
+ */
+std::optional<Key> Value_Numbering::key_of(Handle operand) const
+{
+    auto& table = operand_table();
+    auto const& value = table.value(operand);
+    if (value.is_binary()) {
+        auto lhs = representative(value.lhs);
+        auto rhs = representative(value.rhs);
+        if (is_commutative(value.binary) and rhs < lhs)
+            std::swap(lhs, rhs);
+        return Key{ table.intern(value.binary), lhs, rhs };
+    }
+    if (value.is_literal())
+        return std::nullopt;
+    if (value.shape == Lvalue_Shape::Offset)
+        return Key{ table.intern("[]"),
+            value.base,
+            representative(value.offset) };
+    if (value.shape == Lvalue_Shape::Dereference)
+        return Key{ table.intern("*"), value.base, empty };
+
+    std::string_view text = table.text(operand);
+    auto op = value.unary;
+    if (op != "-" and op != "~" and op != "!")
+        return std::nullopt;
+    if (not text.starts_with(op))
+        return std::nullopt;
+    auto rest = text.substr(op.size());
+    while (not rest.empty() and rest.front() == ' ')
+        rest.remove_prefix(1);
+    return Key{ table.intern(op), representative(table.intern(rest)), empty };
+}
+
+/**
+ * @brief A load and the names a store to which may change it
+ */
+Load Value_Numbering::load_of(Handle operand, Handle value) const
+{
+    auto& table = operand_table();
+    Load load{ value, {}, false };
+    std::string_view text = table.text(operand);
+    detail::for_each_name(text, [&](std::size_t begin, std::size_t end) {
+        auto name = table.intern(text.substr(begin, end - begin));
+        if (is_split(name))
+            return;
+        load.names.push_back(name);
+        if ((end < text.size() and text[end] == '[' and
+                not vectors_.contains(name)) or
+            (begin > 0 and text[begin - 1] == '*'))
+            load.indirect = true;
+    });
+    return load;
+}
+
+/**
+ * @brief Clobber the loads a store or a call may change
+ */
+void Value_Numbering::store(Quadruple const& quadruple, Loads& loads) const
+{
+    if (quadruple.op == Instruction::CALL) {
+        loads.clear();
+        return;
+    }
+    if (quadruple.op != Instruction::MOV)
+        return;
+    auto lhs = quadruple.operands[0];
+    auto const& value = operand_table().value(lhs);
+    Handle name = empty;
+    if (value.shape == Lvalue_Shape::Scalar) {
+        if (is_split(lhs))
+            return;
+        name = lhs;
+    } else if (value.shape == Lvalue_Shape::Offset and
+               vectors_.contains(value.base))
+        name = value.base;
+    if (name == empty) {
+        loads.clear();
+        return;
+    }
+    std::erase_if(loads, [&](auto const& entry) {
+        auto const& load = entry.second;
+        return load.indirect or
+               std::ranges::find(load.names, name) != load.names.end();
+    });
+}
+
+void Value_Numbering::visit(Block_Index block,
+    Loads& loads,
+    std::vector<Key>& scoped)
+{
+    auto& table = operand_table();
+    auto& instructions = ssa_.instructions();
+    for (auto i = cfg_[block].begin; i < cfg_[block].end; i++) {
+        auto& quadruple = instructions[i];
+        if (quadruple.op != Instruction::MOV or
+            quadruple.operands[2] != empty) {
+            store(quadruple, loads);
+            continue;
+        }
+        auto lhs = quadruple.operands[0];
+        auto rhs = quadruple.operands[1];
+        bool version = ssa_.variable_of(lhs) != lhs;
+        auto key = key_of(rhs);
+        if (not key.has_value()) {
+            // a copy of a version or a literal has the value it copies
+            auto const& value = table.value(rhs);
+            if (version and (value.is_literal() or
+                                (value.shape == Lvalue_Shape::Scalar and
+                                    is_split(rhs))))
+                representatives_[lhs] = representative(rhs);
+            store(quadruple, loads);
+            continue;
+        }
+
+        bool load = is_load(rhs);
+        Handle found = empty;
+        if (load) {
+            if (auto entry = loads.find(*key); entry != loads.end())
+                found = entry->second.value;
+        } else if (auto entry = available_.find(*key);
+                   entry != available_.end())
+            found = entry->second;
+
+        if (found != empty) {
+            quadruple.operands[1] = found;
+            reused_++;
+            if (version)
+                representatives_[lhs] = representative(found);
+            store(quadruple, loads);
+            continue;
+        }
+        store(quadruple, loads);
+        if (not version or in_place_.contains(lhs))
+            continue;
+        if (load)
+            loads.emplace(*key, load_of(rhs, lhs));
+        else {
+            available_.emplace(*key, lhs);
+            scoped.push_back(*key);
+        }
+    }
+}
+
+/**
+ * @brief Number the function, and give the number of operations reused
+ *
+ * A block is visited after its immediate dominator, so each operation in
+ * the table then is one computed on every path to it. A block entered
+ * from its immediate dominator alone starts with the loads that block
+ * ends with.
+ */
+std::size_t Value_Numbering::run()
+{
+    auto size = cfg_.size();
+    std::vector<std::vector<Block_Index>> children(size);
+    for (auto block : cfg_.order())
+        if (block != cfg_.entry())
+            children[cfg_[block].dominator].push_back(block);
+
+    struct Frame
+    {
+        Block_Index block;
+        std::size_t child{ 0 };
+        Loads loads{};
+        // the keys the block added, to put out of scope
+        std::vector<Key> scoped{};
+    };
+    std::vector<Frame> stack{};
+    stack.push_back(Frame{ .block = cfg_.entry() });
+    visit(stack.back().block, stack.back().loads, stack.back().scoped);
+    while (not stack.empty()) {
+        auto& frame = stack.back();
+        if (frame.child < children[frame.block].size()) {
+            auto child = children[frame.block][frame.child++];
+            Frame next{ .block = child };
+            auto const& predecessors = cfg_[child].predecessors;
+            if (predecessors.size() == 1 and predecessors[0] == frame.block)
+                next.loads = frame.loads;
+            stack.push_back(std::move(next));
+            visit(stack.back().block, stack.back().loads, stack.back().scoped);
+            continue;
+        }
+        for (auto const& key : frame.scoped)
+            available_.erase(key);
+        stack.pop_back();
+    }
+    return reused_;
+}
+
+} // namespace
+
+/**
+ * @brief Read the earlier computation of each operation of a function in
+ * SSA form computed twice, and give the number of operations reused
+ */
+std::size_t number_values(SSA& ssa)
+{
+    return Value_Numbering{ ssa }.run();
+}
+
+} // namespace credence::ir
@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/ir/ssa.h> // for SSA
+#include <cstddef>           // for size_t
+
+/****************************************************************************
+ *
+ * Value numbering
+ *
+ * The ITA computes each subexpression into a temporary of its own, so the
+ * same a * b, or the same v[i], is computed again each time the source
+ * says it. Value numbering finds an operation that was already computed,
+ * with the same operator on the same values, and reads the temporary of
+ * the first in its place:
+ *
+ *    _t3#1 = a#1 * b#1;        _t3#1 = a#1 * b#1;
+ *    x#1 = a#1;                x#1 = a#1;
+ *    _t5#1 = b#1 * x#1;  ->    _t5#1 = _t3#1;
+ *
+ * A copy has the value of what it copies, and a + b is b + a, so the two
+ * above are one value. Each operation is keyed by its operator and the
+ * values of its operands in a hash table.
+ *
+ * An operation on versions alone has the value it had wherever it is
+ * read, so the table of those is scoped to the dominator tree: an
+ * operation is reused in every block its first computation dominates,
+ * as in Briggs, Cooper and Simpson's dominator-based value numbering.
+ *
+ * A load, an operation that reads a name that is not split - a global,
+ * a vector, a pointer, or a local whose address is taken - has the value
+ * it had only until a store may change what it reads, and is reused in
+ * its block and the blocks entered from it alone. A store clobbers:
+ *
+ *    x = ...      the loads of x, and the loads through a pointer
+ *    v[k] = ...   the loads of v, and the loads through a pointer, where
+ *                 v is a vector of the function, as two vectors never
+ *                 overlap
+ *    *p = ...     every load, and so does p[k] = ... and a CALL
+ *
+ * An increment or decrement is never reused, and neither is an operation
+ * whose temporary is then changed in place.
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+/**
+ * @brief Read the earlier computation of each operation of a function in
+ * SSA form computed twice, and give the number of operations reused
+ */
+std::size_t number_values(SSA& ssa);
+
+} // namespace credence::ir
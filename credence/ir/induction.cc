@@ -0,0 +1,524 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/induction.h>
+
+#include <algorithm>             // for max, min
+#include <credence/ir/cfg.h>     // for CFG, Loop, make_preheader
+#include <credence/ir/operand.h> // for literal_to_string, TYPE_LITERAL
+#include <credence/ir/ssa.h>     // for scalar_names, for_each_read
+#include <cstdint>               // for int64_t, int32_t
+#include <limits>                // for numeric_limits
+#include <optional>              // for optional, nullopt
+#include <string>                // for string, to_string
+#include <string_view>           // for string_view
+#include <unordered_map>         // for unordered_map
+#include <unordered_set>         // for unordered_set
+#include <utility>               // for move
+#include <vector>                // for vector
+
+namespace credence::ir {
+
+namespace {
+
+using Handle = Operand_Table::Handle;
+
+constexpr auto empty = Operand_Table::empty;
+
+/**
+ * @brief The value of an int or long literal, and its type
+ */
+struct Integer
+{
+    std::int64_t value{ 0 };
+    Value_Type type{ Value_Type::None };
+};
+
+std::optional<Integer> integer_of(Handle operand)
+{
+    auto const& value = operand_table().value(operand);
+    if (not value.is_literal() or value.is_binary() or
+        (value.type != Value_Type::Int and value.type != Value_Type::Long))
+        return std::nullopt;
+    return Integer{ value.integer, value.type };
+}
+
+bool fits_int(std::int64_t value)
+{
+    return value >= std::numeric_limits<std::int32_t>::min() and
+           value <= std::numeric_limits<std::int32_t>::max();
+}
+
+/**
+ * @brief The literal of an integer of a type, as constant propagation
+ * writes the constants it folds
+ */
+Handle integer_literal(std::int64_t integer, Value_Type type)
+{
+    auto name = type == Value_Type::Long ? "long" : "int";
+    operand::Literal literal =
+        type == Value_Type::Long
+            ? operand::Literal{ static_cast<long>(integer),
+                  operand::TYPE_LITERAL.at(name) }
+            : operand::Literal{ static_cast<int>(integer),
+                  operand::TYPE_LITERAL.at(name) };
+    return operand_table().intern(operand::literal_to_string(literal));
+}
+
+Handle binary(Handle lhs, std::string_view op, Handle rhs)
+{
+    auto& table = operand_table();
+    std::string text{ table.text(lhs) };
+    text.append(" ").append(op).append(" ").append(table.text(rhs));
+    return table.intern(text);
+}
+
+/**
+ * @brief One step of a basic induction variable: i = ++i, i = i + c, or
+ * _t = i + c; i = _t, from its first quadruple to its last
+ */
+struct Step
+{
+    std::size_t first{ 0 };
+    std::size_t last{ 0 };
+    std::int64_t by{ 0 };
+    // the type of the literal it steps by, and none for ++ and --
+    Value_Type type{ Value_Type::None };
+};
+
+/**
+ * @brief The step of i by an operand of a MOV, i + c, c + i, or i - c
+ */
+std::optional<Step> step_by(Handle variable, Handle operand)
+{
+    auto const& value = operand_table().value(operand);
+    if (value.binary == "+" or value.binary == "-") {
+        auto literal = integer_of(value.rhs);
+        if (value.lhs == variable and literal.has_value())
+            return Step{ 0,
+                0,
+                value.binary == "+" ? literal->value : -literal->value,
+                literal->type };
+        literal = integer_of(value.lhs);
+        if (value.binary == "+" and value.rhs == variable and
+            literal.has_value())
+            return Step{ 0, 0, literal->value, literal->type };
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief A multiply or shift of a basic induction variable by a literal,
+ * the product it computes, and the quadruple it is
+ */
+struct Derived
+{
+    std::size_t at{ 0 };
+    Handle variable{ empty };
+    std::int64_t factor{ 0 };
+    Value_Type type{ Value_Type::None };
+};
+
+/**
+ * @brief What of a function the reduction of each of its loops reads
+ */
+struct Function_Facts
+{
+    std::unordered_set<Handle> scalars{};
+    std::unordered_map<Handle, std::size_t> assignments{};
+    std::unordered_map<Handle, std::size_t> reads{};
+};
+
+std::size_t count_of(std::unordered_map<Handle, std::size_t> const& counts,
+    Handle name)
+{
+    auto found = counts.find(name);
+    return found == counts.end() ? 0 : found->second;
+}
+
+Function_Facts facts_of(Instructions const& function)
+{
+    Function_Facts facts{ detail::scalar_names(function), {}, {} };
+    for (auto const& quadruple : function) {
+        if (auto name = detail::assigned(quadruple); name != empty)
+            facts.assignments[name]++;
+        detail::for_each_read(
+            quadruple, [&](Handle name) { facts.reads[name]++; });
+    }
+    return facts;
+}
+
+/**
+ * @brief The step of the name a quadruple of a loop assigns, if it is one
+ */
+std::optional<Step> step_of(Instructions const& function,
+    std::size_t i,
+    Function_Facts const& facts)
+{
+    auto& table = operand_table();
+    auto const& quadruple = function[i];
+    auto variable = quadruple.operands[0];
+    auto rhs = quadruple.operands[1];
+    if (quadruple.operands[2] == variable) {
+        auto op = table.text(rhs);
+        if (op != "++" and op != "--")
+            return std::nullopt;
+        return Step{ i, i, op == "++" ? 1 : -1, Value_Type::None };
+    }
+    if (quadruple.operands[2] != empty)
+        return std::nullopt;
+    if (auto step = step_by(variable, rhs); step.has_value()) {
+        step->first = step->last = i;
+        return step;
+    }
+    // _t6 = i + (1:int:4); i = _t6;
+    if (i == 0 or table.kind(rhs) != Operand_Kind::Temporary or
+        not facts.scalars.contains(rhs) or
+        count_of(facts.assignments, rhs) != 1 or
+        count_of(facts.reads, rhs) != 1)
+        return std::nullopt;
+    auto const& before = function[i - 1];
+    if (before.op != Instruction::MOV or before.operands[0] != rhs or
+        before.operands[2] != empty)
+        return std::nullopt;
+    if (auto step = step_by(variable, before.operands[1]); step.has_value()) {
+        step->first = i - 1;
+        step->last = i;
+        return step;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief The multiply or shift of a basic induction variable a quadruple
+ * is, if it is one
+ */
+std::optional<Derived> derived_of(Quadruple const& quadruple,
+    std::size_t i,
+    std::unordered_map<Handle, std::vector<Step>> const& basic)
+{
+    if (quadruple.op != Instruction::MOV or quadruple.operands[2] != empty)
+        return std::nullopt;
+    auto const& value = operand_table().value(quadruple.operands[1]);
+    auto variable = value.lhs;
+    auto literal = integer_of(value.rhs);
+    if (value.binary == "*" and not basic.contains(variable)) {
+        variable = value.rhs;
+        literal = integer_of(value.lhs);
+    }
+    if (not basic.contains(variable) or not literal.has_value())
+        return std::nullopt;
+    auto factor = literal->value;
+    if (value.binary == "<<") {
+        auto width = literal->type == Value_Type::Long ? 63 : 31;
+        if (factor < 0 or factor >= width)
+            return std::nullopt;
+        factor = std::int64_t{ 1 } << factor;
+    } else if (value.binary != "*")
+        return std::nullopt;
+    // a product by 0 or 1 is no multiply to reduce
+    if (factor == 0 or factor == 1)
+        return std::nullopt;
+    return Derived{ i, variable, factor, literal->type };
+}
+
+/**
+ * @brief The product of a step and a factor as a literal of the type of
+ * the factor, or none if it does not fit in it
+ */
+std::optional<Handle> stride_of(Step const& step, Derived const& derived)
+{
+    std::int64_t stride = 0;
+    if (__builtin_mul_overflow(step.by, derived.factor, &stride))
+        return std::nullopt;
+    if (derived.type == Value_Type::Int and not fits_int(stride))
+        return std::nullopt;
+    return integer_literal(stride, derived.type);
+}
+
+/**
+ * @brief Reduce the multiplies and shifts of the induction variables of
+ * one loop
+ */
+Reduction reduce(Instructions& function, CFG const& cfg, Loop const& loop)
+{
+    auto& table = operand_table();
+    auto facts = facts_of(function);
+    std::vector<bool> in_loop(cfg.size(), false);
+    for (auto block : loop.blocks)
+        in_loop[block] = true;
+
+    // the steps of each scalar the loop assigns, or none if it assigns it
+    // by what is not a step
+    std::unordered_map<Handle, std::vector<Step>> basic{};
+    std::unordered_set<Handle> assigned{};
+    for (auto block : loop.blocks) {
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++) {
+            auto name = detail::assigned(function[i]);
+            if (name == empty)
+                continue;
+            auto step = facts.scalars.contains(name)
+                            ? step_of(function, i, facts)
+                            : std::nullopt;
+            if (step.has_value() and not assigned.contains(name))
+                basic[name].push_back(*step);
+            else {
+                basic.erase(name);
+                assigned.insert(name);
+            }
+        }
+    }
+    if (basic.empty())
+        return {};
+
+    // each product, by the operand it is computed from, with the temporary
+    // that holds it
+    std::vector<Derived> derived{};
+    std::vector<Handle> computed{};
+    std::unordered_map<Handle, Handle> reduced{};
+    std::unordered_map<Handle, Derived> product_of{};
+    auto temporaries = last_number(function, Operand_Kind::Temporary);
+    for (auto block : loop.blocks) {
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++) {
+            auto found = derived_of(function[i], i, basic);
+            if (not found.has_value())
+                continue;
+            auto rhs = function[i].operands[1];
+            bool strided = true;
+            for (auto const& step : basic.at(found->variable))
+                strided = strided and stride_of(step, *found).has_value();
+            if (not strided)
+                continue;
+            derived.push_back(*found);
+            if (not reduced.contains(rhs)) {
+                computed.push_back(rhs);
+                reduced[rhs] =
+                    table.intern("_t" + std::to_string(++temporaries));
+                product_of[rhs] = *found;
+            }
+        }
+    }
+    if (derived.empty())
+        return {};
+
+    auto preheader = make_preheader(function, cfg, loop);
+    if (not preheader.has_value())
+        return {};
+
+    Reduction reduction{};
+    std::unordered_map<Handle, Handle> initial{};
+    std::vector<bool> dropped(function.size(), false);
+    // the products of each variable, in the order they were found
+    std::vector<Handle> variables{};
+    std::unordered_map<Handle, std::vector<Handle>> products{};
+    for (auto rhs : computed) {
+        auto variable = product_of.at(rhs).variable;
+        if (not products.contains(variable))
+            variables.push_back(variable);
+        products[variable].push_back(rhs);
+    }
+
+    // a variable read by nothing but its steps, its products, and the
+    // test that leaves the loop, against a literal, is replaced in the test
+    // by its one product, if its value on entry is a literal
+    auto replace_test = [&](Handle variable) {
+        auto const& steps = basic.at(variable);
+        auto const& rhs = products.at(variable);
+        if (rhs.size() != 1 or steps.size() != 1 or
+            preheader->label != empty)
+            return;
+        auto const& product = product_of.at(rhs.front());
+        auto const& step = steps.front();
+        if (product.type != Value_Type::Int or product.factor <= 0 or
+            (step.type != Value_Type::None and step.type != Value_Type::Int))
+            return;
+
+        // the one block the loop is left from, by the fallthrough of an
+        // IF on a comparison of the variable just before it
+        std::optional<Block_Index> exit{};
+        for (auto block : loop.blocks)
+            for (auto successor : cfg[block].successors)
+                if (not in_loop[successor]) {
+                    if (exit.has_value() and *exit != block)
+                        return;
+                    exit = block;
+                }
+        if (not exit.has_value() or cfg[*exit].end - cfg[*exit].begin < 2 or
+            *exit + 1 >= cfg.size() or in_loop[*exit + 1])
+            return;
+        auto branch = cfg[*exit].end - 1;
+        auto test = branch - 1;
+        auto const& compare = function[test];
+        if (function[branch].op != Instruction::IF or
+            compare.op != Instruction::MOV or compare.operands[2] != empty or
+            function[branch].operands[0] != compare.operands[0] or
+            count_of(facts.reads, compare.operands[0]) != 1)
+            return;
+        auto const& relation = table.value(compare.operands[1]);
+        auto bound = integer_of(relation.rhs);
+        if (relation.lhs != variable or not bound.has_value() or
+            bound->type != Value_Type::Int)
+            return;
+
+        // the step runs once an iteration at most, in no loop nested in
+        // this one, and the variable is read by nothing else
+        for (auto block : loop.blocks)
+            if (step.first >= cfg[block].begin and
+                step.first < cfg[block].end and
+                cfg[block].loop != cfg[loop.header].loop)
+                return;
+        // its step and the test, and each product
+        std::size_t known = 2;
+        for (auto const& found : derived)
+            if (found.variable == variable)
+                known++;
+        if (count_of(facts.reads, variable) != known)
+            return;
+
+        // the value on entry, from the block that enters the loop alone
+        std::optional<Integer> entry{};
+        for (auto i = preheader->at; i-- > 0;) {
+            auto const& quadruple = function[i];
+            if (quadruple.op == Instruction::LABEL or
+                quadruple.op == Instruction::FUNC_START or
+                quadruple.op == Instruction::GOTO or
+                quadruple.op == Instruction::IF or
+                quadruple.op == Instruction::JMP_E)
+                break;
+            if (detail::assigned(quadruple) != variable)
+                continue;
+            if (quadruple.operands[2] == empty)
+                entry = integer_of(quadruple.operands[1]);
+            break;
+        }
+        if (not entry.has_value() or entry->type != Value_Type::Int)
+            return;
+
+        // the values the test can see, from the value on entry to the last
+        // that passes it plus one step
+        auto first = entry->value;
+        auto limit = bound->value;
+        auto by = step.by;
+        std::int64_t low = first, high = first;
+        if (relation.binary == "<" and by > 0)
+            high = std::max(first, limit - 1 + by);
+        else if (relation.binary == "<=" and by > 0)
+            high = std::max(first, limit + by);
+        else if (relation.binary == ">" and by < 0)
+            low = std::min(first, limit + 1 + by);
+        else if (relation.binary == ">=" and by < 0)
+            low = std::min(first, limit + by);
+        else
+            return;
+        auto factor = product.factor;
+        if (not fits_int(low) or not fits_int(high) or
+            not fits_int(low * factor) or not fits_int(high * factor) or
+            not fits_int(limit * factor))
+            return;
+
+        auto temporary = reduced.at(rhs.front());
+        function[test].operands[1] = binary(temporary,
+            relation.binary,
+            integer_literal(limit * factor, Value_Type::Int));
+        initial[rhs.front()] =
+            integer_literal(first * factor, Value_Type::Int);
+        for (auto i = step.first; i <= step.last; i++)
+            dropped[i] = true;
+        reduction.removed += step.last - step.first + 1;
+    };
+
+    for (auto const& found : derived) {
+        auto& quadruple = function[found.at];
+        quadruple.operands[1] = reduced.at(quadruple.operands[1]);
+        reduction.reduced++;
+    }
+    for (auto variable : variables)
+        replace_test(variable);
+
+    // the products set in the preheader, and stepped after each step of
+    // their variable
+    Instructions entering{ resource_of(function) };
+    if (preheader->label != empty)
+        entering.push_back(
+            Quadruple{ Instruction::LABEL, { preheader->label } });
+    std::unordered_map<std::size_t, Instructions> after{};
+    for (auto variable : variables) {
+        for (auto operand : products.at(variable)) {
+            auto temporary = reduced.at(operand);
+            auto found = initial.find(operand);
+            entering.push_back(Quadruple{ Instruction::MOV,
+                { temporary,
+                    found == initial.end() ? operand : found->second } });
+            for (auto const& step : basic.at(variable)) {
+                auto& stepped =
+                    after.try_emplace(step.last, resource_of(function))
+                        .first->second;
+                stepped.push_back(Quadruple{ Instruction::MOV,
+                    { temporary,
+                        binary(temporary,
+                            "+",
+                            *stride_of(step, product_of.at(operand))) } });
+            }
+        }
+    }
+
+    Instructions strength{ resource_of(function) };
+    for (std::size_t i = 0; i < function.size(); i++) {
+        if (i == preheader->at)
+            strength.insert(strength.end(), entering.begin(), entering.end());
+        if (not dropped[i])
+            strength.push_back(function[i]);
+        if (auto found = after.find(i); found != after.end())
+            strength.insert(
+                strength.end(), found->second.begin(), found->second.end());
+    }
+    function = std::move(strength);
+    return reduction;
+}
+
+} // namespace
+
+/**
+ * @brief Reduce the multiplies and shifts of the induction variables of
+ * each loop of a function, from its LABEL to its EndFunc, to adds
+ *
+ * The graph is built again after each loop, as a reduction adds
+ * instructions and may add a block.
+ */
+Reduction reduce_induction_variables(Instructions& function)
+{
+    Reduction reduction{};
+    // the loops visited, by the label of each header
+    std::unordered_set<Handle> visited{};
+    for (;;) {
+        auto cfg = CFG::build(function, 0, function.size());
+        Loop const* next = nullptr;
+        for (auto const& loop : cfg.loops()) {
+            auto const& head = function[cfg[loop.header].begin];
+            if (loop.irreducible or head.op != Instruction::LABEL or
+                visited.contains(head.operands[0]))
+                continue;
+            if (next == nullptr or loop.depth > next->depth)
+                next = &loop;
+        }
+        if (next == nullptr)
+            break;
+        visited.insert(function[cfg[next->header].begin].operands[0]);
+        auto reduced = reduce(function, cfg, *next);
+        reduction.reduced += reduced.reduced;
+        reduction.removed += reduced.removed;
+    }
+    return reduction;
+}
+
+} // namespace credence::ir
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/ir/quadruple.h> // for Instructions
+#include <cstddef>                 // for size_t
+
+/****************************************************************************
+ *
+ * Induction variable strength reduction
+ *
+ * A basic induction variable of a loop is a scalar the loop assigns only
+ * by a step of a literal, i = ++i or i = i + (1:int:4), and an operation
+ * that multiplies or shifts it by a literal is computed again on each
+ * iteration, an imul or a mul in the backends. Each such operation reads a
+ * temporary of its own instead, set to the product once in the preheader
+ * and stepped by an add after each step of the variable:
+ *
+ *                                     _t9 = i * (4:int:4);
+ *    _L2:                             _L2:
+ *    _L4:                             _L4:
+ *        _t5 = i < (10:int:4);            _t5 = i < (10:int:4);
+ *        IF _t5 GOTO _L3;                 IF _t5 GOTO _L3;
+ *    ...                              ...
+ *    _L3:                             _L3:
+ *        _t7 = i * (4:int:4);             _t7 = _t9;
+ *        s = s + _t7;                     s = s + _t7;
+ *        i = ++i;                         i = ++i;
+ *        GOTO _L2;                        _t9 = _t9 + (4:int:4);
+ *                                         GOTO _L2;
+ *
+ * A product wraps as the sum of its steps does, so the temporary is the
+ * product at each point of the loop. The loops are reduced innermost
+ * first.
+ *
+ * Where the variable is then read only by its steps and by the test that
+ * leaves the loop, against a literal, and its value on entry is a
+ * literal, the test is replaced by one of the temporary against the
+ * literal times the factor, and the steps of the variable are dropped:
+ *
+ *        _t5 = _t9 < (40:int:4);
+ *
+ * The test is only replaced where no value of the variable it can see,
+ * nor its product, overflows an int, so the two tests agree.
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+/**
+ * @brief The operations reduced and the steps of dead induction variables
+ * dropped from a function
+ */
+struct Reduction
+{
+    std::size_t reduced{ 0 };
+    std::size_t removed{ 0 };
+};
+
+/**
+ * @brief Reduce the multiplies and shifts of the induction variables of
+ * each loop of a function, from its LABEL to its EndFunc, to adds
+ */
+Reduction reduce_induction_variables(Instructions& function);
+
+} // namespace credence::ir
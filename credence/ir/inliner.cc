@@ -0,0 +1,389 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/inliner.h>
+
+#include <algorithm>         // for any_of
+#include <credence/ir/cfg.h> // for function_ranges, last_number
+#include <credence/ir/ssa.h> // for scalar_names, replace_names
+#include <credence/util.h>   // for str_trim_ws
+#include <optional>          // for optional, nullopt
+#include <string>            // for string, to_string
+#include <string_view>       // for string_view
+#include <unordered_map>     // for unordered_map
+#include <unordered_set>     // for unordered_set
+#include <utility>           // for move
+#include <vector>            // for vector
+
+namespace credence::ir {
+
+namespace {
+
+using Handle = Operand_Table::Handle;
+
+constexpr auto empty = Operand_Table::empty;
+
+/**
+ * @brief A function of the unit that may be inlined, read once from its
+ * LABEL to its EndFunc
+ */
+struct Callee
+{
+    // the LABEL of the function, where it begins
+    std::size_t begin{ 0 };
+    std::vector<Handle> parameters{};
+    // the MOVs of its body, its RET operand or empty, and its extrns
+    Instructions body{};
+    Handle returned{ empty };
+    bool returns{ false };
+    std::vector<Handle> globals{};
+    // the parameters, locals and temporaries of the body
+    std::unordered_set<Handle> names{};
+};
+
+/**
+ * @brief The name a function is called by, and its parameters, from the
+ * text of its label, e.g. add and x, y of __add(x,y)
+ */
+std::pair<std::string_view, std::vector<std::string_view>> signature_of(
+    std::string_view label)
+{
+    std::vector<std::string_view> parameters{};
+    auto open = label.find('(');
+    if (not label.starts_with("__") or open == std::string_view::npos)
+        return { {}, parameters };
+    auto name = label.substr(2, open - 2);
+    auto list = label.substr(open + 1, label.rfind(')') - open - 1);
+    while (not list.empty()) {
+        auto comma = list.find(',');
+        parameters.push_back(list.substr(0, comma));
+        if (comma == std::string_view::npos)
+            break;
+        list.remove_prefix(comma + 1);
+    }
+    return { name, parameters };
+}
+
+/**
+ * @brief Whether an operand reads memory through a name, v[k], *p, or
+ * & x, which the backends resolve by the names a function declares
+ */
+bool is_indirect(Handle operand)
+{
+    auto const& value = operand_table().value(operand);
+    if (value.shape == Lvalue_Shape::Offset or
+        value.shape == Lvalue_Shape::Dereference or value.unary == "&" or
+        value.unary == "*")
+        return true;
+    if (value.is_binary())
+        return is_indirect(value.lhs) or is_indirect(value.rhs);
+    return false;
+}
+
+/**
+ * @brief The function from its LABEL to its EndFunc as a callee, if it is
+ * one that may be inlined within the limit
+ */
+std::optional<Callee> callee_of(Instructions const& instructions,
+    std::size_t begin,
+    std::size_t end,
+    std::size_t limit)
+{
+    auto& table = operand_table();
+    Instructions function{
+        instructions.begin() + static_cast<std::ptrdiff_t>(begin),
+        instructions.begin() + static_cast<std::ptrdiff_t>(end),
+        resource_of(instructions)
+    };
+    auto [name, parameters] = signature_of(table.text(function[0].operands[0]));
+    // LABEL, BeginFunc, the body, _L1:, LEAVE, EndFunc
+    if (name.empty() or function.size() < 5 or
+        function[1].op != Instruction::FUNC_START or
+        function[function.size() - 3].op != Instruction::LABEL or
+        table.text(function[function.size() - 3].operands[0]) != "_L1" or
+        function[function.size() - 2].op != Instruction::LEAVE)
+        return std::nullopt;
+
+    auto scalars = detail::scalar_names(function);
+    Callee callee{ begin,
+        {},
+        Instructions{ resource_of(instructions) },
+        empty,
+        false,
+        {},
+        {} };
+    std::unordered_set<Handle> defined{};
+    for (auto parameter : parameters) {
+        auto handle = table.intern(parameter);
+        if (not scalars.contains(handle))
+            return std::nullopt;
+        callee.parameters.push_back(handle);
+        callee.names.insert(handle);
+        defined.insert(handle);
+    }
+
+    std::size_t cost = 0;
+    for (std::size_t i = 2; i < function.size() - 3; i++) {
+        auto const& quadruple = function[i];
+        switch (quadruple.op) {
+            case Instruction::LOCL:
+                if (not scalars.contains(quadruple.operands[0]))
+                    return std::nullopt;
+                callee.names.insert(quadruple.operands[0]);
+                break;
+            case Instruction::GLOBL:
+                callee.globals.push_back(quadruple.operands[0]);
+                break;
+            case Instruction::RETURN: {
+                // the backends set the value of a call at its RET, and
+                // what runs after it may overwrite it
+                bool undefined = false;
+                detail::for_each_read(quadruple, [&](Handle name) {
+                    if (callee.names.contains(name) and
+                        not defined.contains(name))
+                        undefined = true;
+                });
+                if (undefined or i + 1 != function.size() - 3 or
+                    is_indirect(quadruple.operands[0]))
+                    return std::nullopt;
+                callee.returns = true;
+                // held with the space after it, e.g. "x ", as
+                // operand_to_string writes an lvalue or a literal
+                callee.returned = table.intern(util::str_trim_ws(
+                    std::string{ table.text(quadruple.operands[0]) }));
+                cost++;
+                break;
+            }
+            case Instruction::MOV: {
+                // each name of the body becomes a temporary of the caller,
+                // so each is assigned once and read after it is
+                auto lhs = quadruple.operands[0];
+                auto rhs = quadruple.operands[1];
+                bool undefined = false;
+                detail::for_each_read(quadruple, [&](Handle name) {
+                    if (callee.names.contains(name) and
+                        not defined.contains(name))
+                        undefined = true;
+                });
+                if (undefined or quadruple.operands[2] != empty or
+                    is_indirect(lhs) or is_indirect(rhs) or
+                    table.text(rhs) == "RET")
+                    return std::nullopt;
+                if (table.kind(lhs) == Operand_Kind::Temporary)
+                    callee.names.insert(lhs);
+                if (callee.names.contains(lhs) and
+                    not defined.insert(lhs).second)
+                    return std::nullopt;
+                callee.body.push_back(quadruple);
+                cost++;
+                break;
+            }
+            default:
+                return std::nullopt;
+        }
+    }
+    if (cost > limit)
+        return std::nullopt;
+    return callee;
+}
+
+/**
+ * @brief Inline the calls of the callees in one function, from its LABEL
+ * to its EndFunc, and give the number inlined
+ */
+std::size_t inline_into(Instructions& function,
+    std::size_t begin,
+    std::unordered_map<std::string_view, Callee> const& callees)
+{
+    auto& table = operand_table();
+    auto returned = table.intern("RET");
+    auto temporaries = last_number(function, Operand_Kind::Temporary);
+
+    // the parameters, locals and extrns of the caller, and where its
+    // declarations end
+    std::unordered_set<Handle> locals{};
+    std::unordered_set<Handle> globals{};
+    for (auto parameter :
+        signature_of(table.text(function[0].operands[0])).second)
+        locals.insert(table.intern(parameter));
+    std::size_t declarations = 2;
+    for (std::size_t i = 2; i < function.size(); i++) {
+        auto op = function[i].op;
+        if (op != Instruction::LOCL and op != Instruction::GLOBL)
+            break;
+        (op == Instruction::LOCL ? locals : globals)
+            .insert(function[i].operands[0]);
+        declarations = i + 1;
+    }
+
+    std::size_t inlined = 0;
+    Instructions expanded{ resource_of(function) };
+    Instructions declared{ resource_of(function) };
+    std::vector<bool> dropped(function.size(), false);
+    std::unordered_map<std::size_t, Instructions> at{};
+    for (std::size_t i = declarations; i < function.size(); i++) {
+        if (function[i].op != Instruction::CALL)
+            continue;
+        auto found = callees.find(table.text(function[i].operands[0]));
+        if (found == callees.end() or found->second.begin == begin)
+            continue;
+        auto const& callee = found->second;
+
+        // one PUSH for each parameter just before the CALL, the last the
+        // first argument, then its POP and the read of its RET
+        auto arity = callee.parameters.size();
+        if (i < declarations + arity)
+            continue;
+        std::size_t pushed = 0;
+        while (pushed < i - declarations and
+               function[i - pushed - 1].op == Instruction::PUSH)
+            pushed++;
+        if (pushed != arity)
+            continue;
+        auto next = i + 1;
+        if (next < function.size() and function[next].op == Instruction::POP)
+            next++;
+        Handle result = empty;
+        if (next < function.size() and
+            function[next].op == Instruction::MOV and
+            function[next].operands[1] == returned and
+            function[next].operands[2] == empty)
+            result = function[next++].operands[0];
+        if ((result != empty and not callee.returns) or
+            std::ranges::any_of(callee.globals,
+                [&](Handle name) { return locals.contains(name); }))
+            continue;
+
+        // each argument is pushed as a _p name assigned it before, where
+        // its parameter is assigned it instead, so that it is evaluated
+        // where it was
+        std::vector<std::size_t> arguments{};
+        for (std::size_t k = 0; k < arity; k++) {
+            auto pushed_name = function[i - 1 - k].operands[0];
+            std::size_t j = i - arity;
+            while (j > declarations and
+                   not(function[j - 1].op == Instruction::MOV and
+                       function[j - 1].operands[0] == pushed_name))
+                j--;
+            if (j == declarations or function[j - 1].operands[2] != empty or
+                not table.text(pushed_name).starts_with("_p"))
+                break;
+            arguments.push_back(j - 1);
+        }
+        if (arguments.size() != arity)
+            continue;
+
+        std::unordered_map<Handle, Handle> renamed{};
+        for (auto name : callee.names)
+            renamed[name] = table.intern("_t" + std::to_string(++temporaries));
+        auto rename = [&](Handle operand) {
+            return detail::replace_names(operand, [&](std::string_view text) {
+                auto name = renamed.find(table.intern(text));
+                return name == renamed.end() ? empty : name->second;
+            });
+        };
+
+        for (std::size_t k = 0; k < arity; k++)
+            function[arguments[k]].operands[0] =
+                renamed.at(callee.parameters[k]);
+        auto& body =
+            at.try_emplace(i - arity, resource_of(function)).first->second;
+        for (auto quadruple : callee.body) {
+            for (auto& operand : quadruple.operands)
+                operand = rename(operand);
+            body.push_back(quadruple);
+        }
+        if (result != empty)
+            body.push_back(Quadruple{
+                Instruction::MOV, { result, rename(callee.returned) } });
+        for (auto name : callee.globals)
+            if (globals.insert(name).second)
+                declared.push_back(Quadruple{ Instruction::GLOBL, { name } });
+        for (auto k = i - arity; k < next; k++)
+            dropped[k] = true;
+        i = next - 1;
+        inlined++;
+    }
+    if (inlined == 0)
+        return 0;
+
+    for (std::size_t i = 0; i < function.size(); i++) {
+        if (i == declarations)
+            expanded.insert(expanded.end(), declared.begin(), declared.end());
+        if (auto body = at.find(i); body != at.end())
+            expanded.insert(
+                expanded.end(), body->second.begin(), body->second.end());
+        if (not dropped[i])
+            expanded.push_back(function[i]);
+    }
+    function = std::move(expanded);
+    return inlined;
+}
+
+} // namespace
+
+/**
+ * @brief Replace each call of a small function of the unit by the body of
+ * the function, and give the number of calls inlined
+ *
+ * Each round inlines the functions that call nothing into their callers,
+ * and the functions those calls were all that a caller called become such
+ * functions for the next, until a round inlines none. A round drops at
+ * least one CALL, so there are no more rounds than calls.
+ */
+std::size_t inline_calls(Instructions& instructions, std::size_t limit)
+{
+    auto& table = operand_table();
+    std::size_t inlined = 0;
+    for (bool changed = true; changed;) {
+        changed = false;
+        auto ranges = function_ranges(instructions);
+        std::unordered_map<std::string_view, Callee> callees{};
+        for (auto [begin, end] : ranges) {
+            auto callee = callee_of(instructions, begin, end, limit);
+            if (not callee.has_value())
+                continue;
+            auto name =
+                signature_of(table.text(instructions[begin].operands[0]))
+                    .first;
+            callees.emplace(name, std::move(*callee));
+        }
+        if (callees.empty())
+            break;
+
+        Instructions inlining{ resource_of(instructions) };
+        std::size_t next = 0;
+        for (auto [begin, end] : ranges) {
+            Instructions function{
+                instructions.begin() + static_cast<std::ptrdiff_t>(begin),
+                instructions.begin() + static_cast<std::ptrdiff_t>(end),
+                resource_of(instructions)
+            };
+            auto count = inline_into(function, begin, callees);
+            inlined += count;
+            changed = changed or count > 0;
+            inlining.insert(inlining.end(),
+                instructions.begin() + static_cast<std::ptrdiff_t>(next),
+                instructions.begin() + static_cast<std::ptrdiff_t>(begin));
+            inlining.insert(inlining.end(), function.begin(), function.end());
+            next = end;
+        }
+        inlining.insert(inlining.end(),
+            instructions.begin() + static_cast<std::ptrdiff_t>(next),
+            instructions.end());
+        instructions = std::move(inlining);
+    }
+    return inlined;
+}
+
+} // namespace credence::ir
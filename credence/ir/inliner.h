@@ -0,0 +1,72 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/ir/quadruple.h> // for Instructions
+#include <cstddef>                 // for size_t
+
+/****************************************************************************
+ *
+ * Inliner
+ *
+ * Each call of a function of the unit is a prologue and an epilogue in the
+ * backends, its arguments pushed and popped, and a stack frame of its own,
+ * however little the function does. A call of a small function is
+ * replaced by its body, with each parameter a new temporary of the caller
+ * assigned its argument where the argument was, and each local and
+ * temporary of the body a new temporary too:
+ *
+ *    __add(x,y):                      __main():
+ *     BeginFunc ;                      BeginFunc ;
+ *        _t2 = x + y;                     ...
+ *        RET _t2;                         _t12 = c;
+ *    ...                                  ...
+ *    __main():                 ->         _t13 = _t7;
+ *     BeginFunc ;                         _t14 = _t12 + _t13;
+ *        ...                              _t8 = _t14;
+ *        _p3_1 = c;
+ *        ...
+ *        _p4_2 = _t7;
+ *        PUSH _p4_2;
+ *        PUSH _p3_1;
+ *        CALL add;
+ *        POP 16;
+ *        _t8 = RET;
+ *
+ * A function is inlined when its body is straight-line code that calls
+ * nothing, with at most one RET and that last, and its cost - the
+ * quadruples of its body but for its declarations - is no more than the
+ * limit -finline-limit sets. A function that calls nothing cannot be
+ * recursive, and a function is never inlined into itself. The calls of a
+ * function are inlined before it is inlined in turn, so a function that
+ * calls only small ones is inlined once they are, if it is still small
+ * enough.
+ *
+ * The parameters and locals of a function it inlines are scalars no
+ * pointer, vector or address reaches, and an extrn of the function is
+ * declared in the caller, which must not have a local of that name. Its
+ * body reads no vector or pointer, as the backends resolve the index of
+ * each by the names a function declares.
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+/**
+ * @brief Replace each call of a small function of the unit by the body of
+ * the function, and give the number of calls inlined
+ */
+std::size_t inline_calls(Instructions& instructions, std::size_t limit);
+
+} // namespace credence::ir
@@ -93,23 +93,15 @@ namespace m = matchit;
 std::pair<std::string, std::string> get_rvalue_from_mov_qaudruple(
     Quadruple const& instruction)
 {
-    std::string rvalue{};
-    std::string unary{};
+    auto const& r2 = ir::value_of<2>(instruction);
+    auto const& r3 = ir::value_of<3>(instruction);
 
-    auto r2 = std::get<2>(instruction);
-    auto r3 = std::get<3>(instruction);
+    auto unary = r3.is_unary() ? r3.unary : r2.unary;
+    if (r3.kind == Operand_Kind::Empty)
+        return { ir::get<2>(instruction), std::string{ unary } };
 
-    if (type::is_unary_expression(r2))
-        unary = type::get_unary_operator(r2);
-    if (!r2.empty())
-        rvalue += r2;
-
-    if (type::is_unary_expression(r3))
-        unary = type::get_unary_operator(r3);
-    if (!r3.empty())
-        rvalue += r3;
-
-    return { rvalue, unary };
+    return { ir::get<2>(instruction) + ir::get<3>(instruction),
+        std::string{ unary } };
 }
 
 /**
@@ -195,7 +187,7 @@ void ITA::check_call_is_resolvable(Node node)
         return;
 
     auto name = std::string{ unit_->symbol_name(symbol) };
-    if (!details_.has_key(name))
+    if (!details_.contains(name))
         ita_error("identifier does not exist in current scope, did you mean "
                   "to use extrn?",
             name);
@@ -203,7 +195,7 @@ void ITA::check_call_is_resolvable(Node node)
 
 Instructions ITA::build_from_definitions()
 {
-    Instructions instructions{};
+    Instruction_List definitions{ resource_ };
 
     // vectors are placed before any function body refers to them
     for (auto definition : unit_->definitions)
@@ -214,9 +206,13 @@ Instructions ITA::build_from_definitions()
         if (unit_->nodes[definition].type != hir::Type::Function)
             continue;
         auto function_instructions = build_from_function_definition(definition);
-        ir::insert(instructions, function_instructions);
+        ir::insert(definitions, std::move(function_instructions));
     }
 
+    // laid out once, for the passes and the backends that read by position
+    Instructions instructions{
+        definitions.begin(), definitions.end(), resource_
+    };
     ir::insert(instructions_, instructions);
     return instructions;
 }
@@ -224,9 +220,9 @@ Instructions ITA::build_from_definitions()
 /**
  * @brief Construct a set of ita instructions from a function definition
  */
-Instructions ITA::build_from_function_definition(Node node)
+Instruction_List ITA::build_from_function_definition(Node node)
 {
-    Instructions instructions{};
+    Instruction_List instructions{ resource_ };
     auto span = unit_->nodes[node].data.span;
 
     // [name, parameter..., body]
@@ -267,7 +263,7 @@ Instructions ITA::build_from_function_definition(Node node)
 
     auto block_instructions = build_from_block_statement(body, true);
 
-    ir::insert(instructions, block_instructions);
+    ir::insert(instructions, std::move(block_instructions));
 
     instructions.emplace_back(make_quadruple(Instruction::FUNC_END));
 
@@ -338,7 +334,7 @@ void ITA::build_from_vector_definition(Node node)
  * @brief Setup branch state and label stack based on statement type
  */
 void ITA::build_statement_setup_branches(std::string_view type,
-    Instructions& instructions)
+    Instruction_List& instructions)
 {
     if (branch.is_branching_statement(type)) {
         branch.increment_branch_level();
@@ -350,14 +346,14 @@ void ITA::build_statement_setup_branches(std::string_view type,
  * @brief Teardown branch state and jump to resume from label on stack
  */
 void ITA::build_statement_teardown_branches(std::string_view type,
-    Instructions& instructions)
+    Instruction_List& instructions)
 {
     if (branch.is_branching_statement(type)) {
         bool lookbehind = type == "while";
         if (instructions.empty() or
             not branch.last_instruction_is_jump(instructions.back()))
             instructions.emplace_back(make_quadruple(Instruction::GOTO,
-                std::get<1>(branch.get_parent_branch(lookbehind).value()),
+                ir::get<1>(branch.get_parent_branch(lookbehind).value()),
                 ""));
         branch.stack.pop();
         branch.decrement_branch_level(true);
@@ -368,7 +364,7 @@ void ITA::build_statement_teardown_branches(std::string_view type,
  *
  * @brief Construct a set of ita instructions from a block statement
  */
-Instructions ITA::build_from_block_statement(Node node,
+Instruction_List ITA::build_from_block_statement(Node node,
     bool root_function_scope)
 {
     auto [instructions, branches] = make_statement_instructions();
@@ -390,47 +386,47 @@ Instructions ITA::build_from_block_statement(Node node,
                 [&] {
                     auto [jump_instructions, if_instructions] =
                         build_from_if_statement(statement);
-                    ir::insert(instructions, jump_instructions);
-                    ir::insert(branches, if_instructions);
+                    ir::insert(instructions, std::move(jump_instructions));
+                    ir::insert(branches, std::move(if_instructions));
                 },
             m::pattern | hir::Type::Switch =
                 [&] {
                     auto [jump_instructions, switch_statements] =
                         build_from_switch_statement(statement);
-                    ir::insert(instructions, jump_instructions);
-                    ir::insert(branches, switch_statements);
+                    ir::insert(instructions, std::move(jump_instructions));
+                    ir::insert(branches, std::move(switch_statements));
                 },
             m::pattern | hir::Type::While =
                 [&] {
                     auto [jump_instructions, while_instructions] =
                         build_from_while_statement(statement);
-                    ir::insert(instructions, jump_instructions);
-                    ir::insert(branches, while_instructions);
+                    ir::insert(instructions, std::move(jump_instructions));
+                    ir::insert(branches, std::move(while_instructions));
                 },
             m::pattern | hir::Type::Label =
                 [&] {
                     auto label_instructions =
                         build_from_label_statement(statement);
-                    ir::insert(instructions, label_instructions);
+                    ir::insert(instructions, std::move(label_instructions));
                 },
             m::pattern | hir::Type::Goto =
                 [&] {
                     auto goto_instructions =
                         build_from_goto_statement(statement);
-                    ir::insert(instructions, goto_instructions);
+                    ir::insert(instructions, std::move(goto_instructions));
                 },
             m::pattern | hir::Type::Return =
                 [&] {
                     auto return_instructions =
                         build_from_return_statement(statement);
-                    ir::insert(instructions, return_instructions);
+                    ir::insert(instructions, std::move(return_instructions));
                 },
             // anything else in a statement position holds an expression
             m::pattern | m::_ =
                 [&] {
                     auto rvalue_instructions =
                         build_from_rvalue_statement(statement);
-                    ir::insert(instructions, rvalue_instructions);
+                    ir::insert(instructions, std::move(rvalue_instructions));
                 });
 
         build_statement_teardown_branches(statement_type, branches);
@@ -442,7 +438,7 @@ Instructions ITA::build_from_block_statement(Node node,
         instructions.emplace_back(make_quadruple(Instruction::LEAVE));
     }
 
-    ir::insert(instructions, branches);
+    ir::insert(instructions, std::move(branches));
     return instructions;
 }
 
@@ -454,20 +450,20 @@ Instructions ITA::build_from_block_statement(Node node,
  * the GOTO, we add it here during stacks of branches
  */
 void ITA::insert_branch_jump_and_resume_instructions(Node block,
-    Instructions& predicate_instructions,
-    Instructions& branch_instructions,
+    Instruction_List& predicate_instructions,
+    Instruction_List& branch_instructions,
     Quadruple const& label,
     detail::Branch::Last_Branch const& tail)
 {
     predicate_instructions.emplace_back(make_quadruple(Instruction::IF,
         build_from_branch_comparator_rvalue(block, predicate_instructions),
         detail::instruction_to_string(Instruction::GOTO),
-        std::get<1>(label)));
+        ir::get<1>(label)));
 
     if (branch.stack.size() > 2) {
         auto jump = tail.value_or(branch.get_parent_branch(true).value());
         branch_instructions.emplace_back(
-            make_quadruple(Instruction::GOTO, std::get<1>(jump)));
+            make_quadruple(Instruction::GOTO, ir::get<1>(jump)));
     }
 }
 
@@ -475,12 +471,12 @@ void ITA::insert_branch_jump_and_resume_instructions(Node block,
  * @brief Construct block statement ita instructions for a branch
  */
 void ITA::insert_branch_block_instructions(Node block,
-    Instructions& branch_instructions)
+    Instruction_List& branch_instructions)
 {
     if (block == hir::null_node_index)
         return;
     auto block_instructions = build_from_block_statement(block, false);
-    ir::insert(branch_instructions, block_instructions);
+    ir::insert(branch_instructions, std::move(block_instructions));
 }
 
 /**
@@ -488,7 +484,7 @@ void ITA::insert_branch_block_instructions(Node block,
  * predicates
  */
 std::string ITA::build_from_branch_comparator_rvalue(Node block,
-    Instructions& instructions)
+    Instruction_List& instructions)
 {
     std::string temp_lvalue{};
     auto comparator_instructions = hir_to_ita_instructions(
@@ -511,8 +507,7 @@ std::string ITA::build_from_branch_comparator_rvalue(Node block,
                          hir::Type::Ternary) =
             [&] {
                 ir::insert(instructions, comparator_instructions);
-                temp_lvalue =
-                    std::get<1>(instructions[instructions.size() - 1]);
+                temp_lvalue = ir::get<1>(instructions.back());
             },
 
         // a name is compared by what it holds, so the comparison names it
@@ -524,7 +519,7 @@ std::string ITA::build_from_branch_comparator_rvalue(Node block,
                     symbol_name_of(block));
                 auto temp = ir::make_temporary(&temporary, rhs);
                 instructions.emplace_back(temp);
-                temp_lvalue = std::get<1>(temp);
+                temp_lvalue = ir::get<1>(temp);
             },
 
         // a constant is compared directly
@@ -539,7 +534,7 @@ std::string ITA::build_from_branch_comparator_rvalue(Node block,
                     operand::literal_to_string(literal_of(block)));
                 auto temp = ir::make_temporary(&temporary, rhs);
                 instructions.emplace_back(temp);
-                temp_lvalue = std::get<1>(temp);
+                temp_lvalue = ir::get<1>(temp);
             },
 
         m::pattern | hir::Type::Call =
@@ -549,14 +544,13 @@ std::string ITA::build_from_branch_comparator_rvalue(Node block,
                     "{} RET", detail::instruction_to_string(Instruction::CMP));
                 auto temp = ir::make_temporary(&temporary, rhs);
                 instructions.emplace_back(temp);
-                temp_lvalue = std::get<1>(temp);
+                temp_lvalue = ir::get<1>(temp);
             },
 
         m::pattern | m::_ =
             [&] {
                 ir::insert(instructions, comparator_instructions);
-                temp_lvalue =
-                    std::get<1>(instructions[instructions.size() - 1]);
+                temp_lvalue = ir::get<1>(instructions.back());
             });
 
     return temp_lvalue;
@@ -580,11 +574,11 @@ ITA::Branch_Instructions ITA::build_from_case_statement(Node node,
     predicate_instructions.emplace_back(make_quadruple(Instruction::JMP_E,
         switch_label,
         operand::literal_to_string(literal_of(value)),
-        std::get<1>(jump)));
+        ir::get<1>(jump)));
     if (branch.stack.size() > 2) {
         auto parent = tail.value_or(branch.get_parent_branch(true).value());
         branch_instructions.emplace_back(
-            make_quadruple(Instruction::GOTO, std::get<1>(parent)));
+            make_quadruple(Instruction::GOTO, ir::get<1>(parent)));
     }
     branch_instructions.emplace_back(jump);
 
@@ -601,10 +595,11 @@ ITA::Branch_Instructions ITA::build_from_case_statement(Node node,
         if (branch_instructions.empty() or
             !branch.last_instruction_is_jump(branch_instructions.back()))
             branch_instructions.emplace_back(make_quadruple(Instruction::GOTO,
-                std::get<1>(branch.get_parent_branch().value()),
+                ir::get<1>(branch.get_parent_branch().value()),
                 ""));
 
-    return { predicate_instructions, branch_instructions };
+    return { std::move(predicate_instructions),
+        std::move(branch_instructions) };
 }
 
 /**
@@ -632,8 +627,8 @@ ITA::Branch_Instructions ITA::build_from_switch_statement(Node node)
         auto [jump_instructions, case_statements] =
             build_from_case_statement(statement, switch_label, tail);
         cases.emplace(branch.stack.top());
-        ir::insert(predicate_instructions, jump_instructions);
-        ir::insert(branch_instructions, case_statements);
+        ir::insert(predicate_instructions, std::move(jump_instructions));
+        ir::insert(branch_instructions, std::move(case_statements));
         branch.stack.pop();
     }
     while (!cases.empty()) {
@@ -642,7 +637,8 @@ ITA::Branch_Instructions ITA::build_from_switch_statement(Node node)
         cases.pop();
     }
     branch.stack.pop();
-    return { predicate_instructions, branch_instructions };
+    return { std::move(predicate_instructions),
+        std::move(branch_instructions) };
 }
 
 /**
@@ -670,7 +666,8 @@ ITA::Branch_Instructions ITA::build_from_while_statement(Node node)
 
     insert_branch_block_instructions(body, branch_instructions);
 
-    return { predicate_instructions, branch_instructions };
+    return { std::move(predicate_instructions),
+        std::move(branch_instructions) };
 }
 
 /**
@@ -707,24 +704,25 @@ ITA::Branch_Instructions ITA::build_from_if_statement(Node node)
         auto else_label = make_temporary();
         if (!branch.last_instruction_is_jump(branch_instructions.back()))
             branch_instructions.emplace_back(make_quadruple(Instruction::GOTO,
-                std::get<1>(branch.get_parent_branch().value()),
+                ir::get<1>(branch.get_parent_branch().value()),
                 ""));
         predicate_instructions.emplace_back(
-            make_quadruple(Instruction::GOTO, std::get<1>(else_label)));
+            make_quadruple(Instruction::GOTO, ir::get<1>(else_label)));
         branch_instructions.emplace_back(else_label);
         insert_branch_block_instructions(else_branch, branch_instructions);
         predicate_instructions.emplace_back(start);
     }
 
-    return { predicate_instructions, branch_instructions };
+    return { std::move(predicate_instructions),
+        std::move(branch_instructions) };
 }
 
 /**
  * @brief Construct ita instructions from a label statement
  */
-Instructions ITA::build_from_label_statement(Node node)
+Instruction_List ITA::build_from_label_statement(Node node)
 {
-    Instructions instructions{};
+    Instruction_List instructions{ resource_ };
     auto label = std::string{ symbol_name_of(node) };
     instructions.emplace_back(
         make_quadruple(Instruction::LABEL, fmt::format("__L{}", label), ""));
@@ -734,9 +732,9 @@ Instructions ITA::build_from_label_statement(Node node)
 /**
  * @brief Construct a set of ita instructions from a goto statement
  */
-Instructions ITA::build_from_goto_statement(Node node)
+Instruction_List ITA::build_from_goto_statement(Node node)
 {
-    Instructions instructions{};
+    Instruction_List instructions{ resource_ };
     auto label = std::string{ symbol_name_of(node) };
     instructions.emplace_back(
         make_quadruple(Instruction::GOTO, fmt::format("__L{}", label), ""));
@@ -746,9 +744,9 @@ Instructions ITA::build_from_goto_statement(Node node)
 /**
  * @brief Construct a set of ita instructions from a block statement
  */
-Instructions ITA::build_from_return_statement(Node node)
+Instruction_List ITA::build_from_return_statement(Node node)
 {
-    Instructions instructions{};
+    Instruction_List instructions{ resource_ };
     auto value = unit_->nodes[node].data.unary;
 
     if (value == hir::null_node_index) {
@@ -766,9 +764,9 @@ Instructions ITA::build_from_return_statement(Node node)
         instructions.emplace_back(make_quadruple(
             Instruction::RETURN, operand::operand_to_string(*last_rvalue)));
     } else {
-        auto last = instructions[instructions.size() - 1];
+        auto last = instructions.back();
         instructions.emplace_back(
-            make_quadruple(Instruction::RETURN, std::get<1>(last)));
+            make_quadruple(Instruction::RETURN, ir::get<1>(last)));
     }
     return instructions;
 }
@@ -776,7 +774,7 @@ Instructions ITA::build_from_return_statement(Node node)
 /**
  * @brief Symbol construction from extrn declaration statements
  */
-void ITA::build_from_extrn_statement(Node node, Instructions& instructions)
+void ITA::build_from_extrn_statement(Node node, Instruction_List& instructions)
 {
     auto span = unit_->nodes[node].data.span;
     for (std::uint32_t i = 0; i < span.count; ++i) {
@@ -795,7 +793,7 @@ void ITA::build_from_extrn_statement(Node node, Instructions& instructions)
 /**
  * @brief Symbol construction from auto declaration statements
  */
-void ITA::build_from_auto_statement(Node node, Instructions& instructions)
+void ITA::build_from_auto_statement(Node node, Instruction_List& instructions)
 {
     auto span = unit_->nodes[node].data.span;
     for (std::uint32_t i = 0; i < span.count; ++i) {
@@ -825,7 +823,7 @@ void ITA::build_from_auto_statement(Node node, Instructions& instructions)
 /**
  * @brief Construct a set of ita instructions from an rvalue statement
  */
-Instructions ITA::build_from_rvalue_statement(Node node)
+Instruction_List ITA::build_from_rvalue_statement(Node node)
 {
     auto const& statement = unit_->nodes[node];
 
@@ -836,19 +834,22 @@ Instructions ITA::build_from_rvalue_statement(Node node)
     // a block of expression statements, each of which may be empty
     if (statement.type == hir::Type::Block or
         statement.type == hir::Type::Expression) {
-        Instructions instructions{};
+        Instruction_List instructions{ resource_ };
         auto span = statement.data.span;
         for (std::uint32_t i = 0; i < span.count; ++i) {
             auto child = unit_->extra[span.start + i];
             auto child_instructions = build_from_rvalue_statement(child);
-            ir::insert(instructions, child_instructions);
+            ir::insert(instructions, std::move(child_instructions));
         }
         return instructions;
     }
 
-    return hir_to_ita_instructions(
-        *unit_, node, details_, &temporary, &identifier)
-        .first;
+    Instruction_List instructions{ resource_ };
+    ir::insert(instructions,
+        hir_to_ita_instructions(
+            *unit_, node, details_, &temporary, &identifier)
+            .first);
+    return instructions;
 }
 
 /**
@@ -857,7 +858,7 @@ Instructions ITA::build_from_rvalue_statement(Node node)
  */
 void detail::emit_to(std::ostream& os, Quadruple const& ita, bool indent)
 { // not constexpr until C++23
-    Instruction op = std::get<Instruction>(ita);
+    Instruction op = ir::get<0>(ita);
     const std::initializer_list<Instruction> lhs_instruction = {
         Instruction::GOTO,
         Instruction::GLOBL,
@@ -870,11 +871,11 @@ void detail::emit_to(std::ostream& os, Quadruple const& ita, bool indent)
     // clang-format on
     if (util::range_contains(op, lhs_instruction)) {
         if (op == Instruction::LABEL) {
-            os << std::get<1>(ita) << ":" << std::endl;
+            os << ir::get<1>(ita) << ":" << std::endl;
         } else {
             if (indent)
                 os << "    ";
-            os << op << " " << std::get<1>(ita) << ";" << std::endl;
+            os << op << " " << ir::get<1>(ita) << ";" << std::endl;
         }
     } else {
         if (indent) {
@@ -884,20 +885,20 @@ void detail::emit_to(std::ostream& os, Quadruple const& ita, bool indent)
         m::match(op)(
             m::pattern | Instruction::RETURN =
                 [&] {
-                    os << op << " " << std::get<1>(ita) << ";" << std::endl;
+                    os << op << " " << ir::get<1>(ita) << ";" << std::endl;
                 },
             m::pattern |
                 Instruction::LEAVE = [&] { os << op << ";" << std::endl; },
             m::pattern | m::or_(Instruction::IF, Instruction::JMP_E) =
                 [&] {
-                    os << op << " " << std::get<1>(ita) << " "
-                       << std::get<2>(ita) << " " << std::get<3>(ita) << ";"
+                    os << op << " " << ir::get<1>(ita) << " "
+                       << ir::get<2>(ita) << " " << ir::get<3>(ita) << ";"
                        << std::endl;
                 },
             m::pattern | m::_ =
                 [&] {
-                    os << std::get<1>(ita) << " " << op << " "
-                       << std::get<2>(ita) << std::get<3>(ita) << ";"
+                    os << ir::get<1>(ita) << " " << op << " "
+                       << ir::get<2>(ita) << ir::get<3>(ita) << ";"
                        << std::endl;
                     if (indent and op == Instruction::FUNC_END)
                         os << std::endl << std::endl;
@@ -921,7 +922,7 @@ constexpr inline bool detail::Branch::is_branching_statement(std::string_view s)
 constexpr inline bool detail::Branch::last_instruction_is_jump(
     Quadruple const& inst)
 {
-    return std::get<0>(inst) == Instruction::GOTO;
+    return ir::get<0>(inst) == Instruction::GOTO;
 }
 
 /**
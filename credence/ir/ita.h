@@ -16,12 +16,15 @@
 #include <compare> // for _CmpUnspecifiedParam, operator<, strong...
 #include <credence/frontend/hir/hir.h> // for Unit, Node_Index
 #include <credence/ir/operand.h>       // for Literal
-#include <credence/ir/symbols.h>       // for hoisted_symbols
+#include <credence/ir/quadruple.h>     // for Quadruple, Instruction, make_qu...
+#include <credence/ir/symbols.h>       // for Symbols, hoisted_symbols
 #include <credence/symbol.h>           // for Symbol_Table
-#include <credence/util.h> // for AST_Node, CREDENCE_PRIVATE_UNLESS_TESTED
+#include <credence/util.h> // for CREDENCE_PRIVATE_UNLESS_TESTED
 #include <deque>           // for deque, operator<=>, operator==
 #include <easyjson.h>      // for JSON, object
 #include <iomanip>         // for operator<<, setw
+#include <list>            // for list
+#include <memory_resource> // for memory_resource, get_default_resource
 #include <optional>        // for nullopt, nullopt_t, optional
 #include <source_location> // for source_location
 #include <sstream>         // for basic_ostream, basic_ostringstream, ope...
@@ -64,55 +67,61 @@ namespace credence {
 
 namespace ir {
 
-enum class Instruction
+/**
+ * @brief Insert instructions from one std::deque into another
+ */
+inline void insert(Instructions& to, Instructions const& from)
 {
-    FUNC_START,
-    FUNC_END,
-    LABEL,
-    GOTO,
-    LOCL,
-    GLOBL,
-    IF,
-    JMP_E,
-    PUSH,
-    POP,
-    CALL,
-    CMP,
-    MOV,
-    RETURN,
-    LEAVE,
-    NOOP
-};
-
-using Quadruple =
-    std::tuple<Instruction, std::string, std::string, std::string>;
-using Instructions = std::deque<Quadruple>;
+    to.insert(to.end(), from.begin(), from.end());
+}
 
 /**
- * @brief Create a qaudruple-tuple from 4 operands, 3 optional
+ * @brief Append instructions that are done with to another std::deque
+ *
+ * A deque moved into an empty one is taken over whole where both take
+ * their memory from the same resource, e.g. the Arena of the compilation,
+ * which is the common case for the first statement of a block or a
+ * branch. Otherwise each instruction is copied to the end, in time linear
+ * in the instructions appended.
  */
-constexpr Quadruple make_quadruple(Instruction op,
-    std::string const& s1 = "",
-    std::string const& s2 = "",
-    std::string const& s3 = "")
+inline void insert(Instructions& to, Instructions&& from)
 {
-    return std::make_tuple(op, s1, s2, s3);
+    if (to.empty())
+        to = std::move(from);
+    else
+        to.insert(to.end(), from.begin(), from.end());
 }
 
 /**
- * @brief Insert instructions from one std::deque into another
+ * @brief Append a copy of instructions to a list the ITA builds, e.g. the
+ * instructions of an expression
  */
-inline void insert(Instructions& to, Instructions const& from)
+inline void insert(Instruction_List& to, Instructions const& from)
 {
     to.insert(to.end(), from.begin(), from.end());
 }
 
+/**
+ * @brief Append a list the ITA built to another, e.g. a statement to its
+ * block
+ *
+ * Where both take their memory from the same resource, the Arena of the
+ * compilation, the nodes of from are relinked onto the end of to in
+ * constant time and none is copied. A list of another resource is copied.
+ */
+inline void insert(Instruction_List& to, Instruction_List&& from)
+{
+    if (to.get_allocator() == from.get_allocator())
+        to.splice(to.end(), from);
+    else
+        to.insert(to.end(), from.begin(), from.end());
+}
+
 /**
  * @brief Create a temporary (e.g. _t5) lvalue from the current temporary
  * size Set as a Instruction::MOV instruction with the right-hamd-side
  */
-constexpr inline Quadruple make_temporary(int* temporary_size,
-    std::string const& temp)
+inline Quadruple make_temporary(int* temporary_size, std::string const& temp)
 {
     return make_quadruple(Instruction::MOV,
         std::string{ "_t" } +
@@ -124,7 +133,7 @@ constexpr inline Quadruple make_temporary(int* temporary_size,
  * @brief Create a temporary (e.g. _t5) lvalue from the current temporary
  * size Set as a standlone Instruction::LABEL instruction
  */
-constexpr inline Quadruple make_temporary(int* temporary_size)
+inline Quadruple make_temporary(int* temporary_size)
 {
     return make_quadruple(Instruction::LABEL,
         std::string{ "_L" } +
@@ -209,8 +218,8 @@ inline std::string quadruple_to_string(
     Quadruple const& ita) // not constexpr until C++23
 {
     std::ostringstream os;
-    os << std::setw(2) << std::get<1>(ita) << std::get<0>(ita)
-       << std::get<2>(ita) << std::get<3>(ita);
+    os << std::setw(2) << ir::get<1>(ita) << ir::get<0>(ita)
+       << ir::get<2>(ita) << ir::get<3>(ita);
 
     return os.str();
 }
@@ -231,8 +240,8 @@ class Branch
 
   public:
     using Last_Branch = std::optional<Quadruple>;
-    using Branch_Comparator = std::pair<std::string, Instructions>;
-    using Branch_Instructions = std::pair<Instructions, Instructions>;
+    using Branch_Comparator = std::pair<std::string, Instruction_List>;
+    using Branch_Instructions = std::pair<Instruction_List, Instruction_List>;
 
   public:
     static constexpr auto BRANCH_STATEMENTS = { "if", "while", "case" };
@@ -245,7 +254,7 @@ class Branch
     /**
      * @brief Construct root branch label and set to root block
      */
-    constexpr inline void set_root_branch(int* temporary_index)
+    inline void set_root_branch(int* temporary_index)
     {
         if (level == 1) {
             // _L1 label is reserved for function scope resume
@@ -313,8 +322,11 @@ class ITA
 #endif
     ~ITA() = default;
     explicit ITA() = default;
-    explicit ITA(frontend::hir::Unit const& unit)
-        : unit_(&unit)
+    explicit ITA(frontend::hir::Unit const& unit,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource_(resource)
+        , instructions_(resource)
+        , unit_(&unit)
         , details_(hoisted_symbols(unit))
     {
     }
@@ -324,10 +336,15 @@ class ITA
      *
      * The standard library adds its own names after the frontend has run,
      * so a call resolves against what the caller knows and not against
-     * the unit alone.
+     * the unit alone. The instruction lists are allocated from resource,
+     * e.g. the Arena of the compilation, see credence/arena.h.
      */
-    explicit ITA(frontend::hir::Unit const& unit, util::AST_Node const& details)
-        : unit_(&unit)
+    explicit ITA(frontend::hir::Unit const& unit,
+        Symbols const& details,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource_(resource)
+        , instructions_(resource)
+        , unit_(&unit)
         , details_(details)
     {
     }
@@ -345,7 +362,7 @@ class ITA
      * @brief Create a temporary (e.g. _L5) label from the
      * current temporary size Set as a Instruction::LABEL
      */
-    constexpr inline Quadruple make_temporary()
+    inline Quadruple make_temporary()
     {
         return make_quadruple(Instruction::LABEL,
             std::string{ "_L" } + util::to_constexpr_string<int>(++temporary),
@@ -390,9 +407,10 @@ class ITA
     }
     static inline Instruction_Pair make_ita_instructions_with_globals(
         frontend::hir::Unit const& unit,
-        util::AST_Node const& details)
+        Symbols const& details,
+        std::pmr::memory_resource* resource)
     {
-        auto ita = ITA{ unit, details };
+        auto ita = ITA{ unit, details, resource };
         return std::pair<Symbol_Table<>&, Instructions>(
             ita.globals_, ita.build_from_definitions());
     }
@@ -408,7 +426,7 @@ class ITA
   public:
     // clang-format off
   CREDENCE_PRIVATE_UNLESS_TESTED:
-    Instructions build_from_function_definition(Node node);
+    Instruction_List build_from_function_definition(Node node);
     void build_from_vector_definition(Node node);
     void build_from_union_definition(Node node);
     constexpr std::string build_function_label_from_parameters(
@@ -416,16 +434,16 @@ class ITA
         Parameters const& parameters);
 
   CREDENCE_PRIVATE_UNLESS_TESTED:
-    Instructions build_from_block_statement(
+    Instruction_List build_from_block_statement(
     Node node,
     bool root_function_scope = false);
   private:
     void build_statement_setup_branches(
         std::string_view type,
-        Instructions& instructions);
+        Instruction_List& instructions);
     void build_statement_teardown_branches(
         std::string_view type,
-        Instructions& instructions);
+        Instruction_List& instructions);
 
   CREDENCE_PRIVATE_UNLESS_TESTED:
     Branch_Instructions build_from_switch_statement(
@@ -440,35 +458,35 @@ class ITA
         Node node);
 
   CREDENCE_PRIVATE_UNLESS_TESTED:
-    Instructions build_from_label_statement(Node node);
-    Instructions build_from_goto_statement(Node node);
-    Instructions build_from_return_statement(Node node);
+    Instruction_List build_from_label_statement(Node node);
+    Instruction_List build_from_goto_statement(Node node);
+    Instruction_List build_from_return_statement(Node node);
 
   CREDENCE_PRIVATE_UNLESS_TESTED:
     void build_from_auto_statement(
         Node node,
-        Instructions& instructions);
+        Instruction_List& instructions);
     void build_from_extrn_statement(
         Node node,
-        Instructions& instructions);
+        Instruction_List& instructions);
 
   CREDENCE_PRIVATE_UNLESS_TESTED:
-    Instructions build_from_rvalue_statement(Node node);
+    Instruction_List build_from_rvalue_statement(Node node);
 
   private:
     void insert_branch_block_instructions(
         Node block,
-        Instructions& branch_instructions);
+        Instruction_List& branch_instructions);
     void insert_branch_jump_and_resume_instructions(
         Node block,
-        Instructions& predicate_instructions,
-        Instructions& branch_instructions,
+        Instruction_List& predicate_instructions,
+        Instruction_List& branch_instructions,
         Quadruple const& label,
         detail::Branch::Last_Branch const& tail = std::nullopt);
 
     std::string build_from_branch_comparator_rvalue(
         Node block,
-        Instructions& instructions);
+        Instruction_List& instructions);
 
   CREDENCE_PRIVATE_UNLESS_TESTED:
     int temporary{ 0 };
@@ -481,13 +499,16 @@ class ITA
         std::source_location const& location = std::source_location::current());
 
   private:
-    Instructions instructions_;
+    // where each instruction list the ITA builds is allocated from
+    std::pmr::memory_resource* resource_{ std::pmr::get_default_resource() };
+    Instructions instructions_{ resource_ };
 
   private:
     detail::Branch branch{ &temporary };
-    static detail::Branch::Branch_Instructions make_statement_instructions()
+    detail::Branch::Branch_Instructions make_statement_instructions() const
     {
-        return std::make_pair(Instructions{}, Instructions{});
+        return std::make_pair(
+            Instruction_List{ resource_ }, Instruction_List{ resource_ });
     }
 
     // clang-format off
@@ -501,7 +522,7 @@ class ITA
 
     // the shape of every declared name, which a call reads to know
     // whether it leaves a value behind
-    util::AST_Node details_{};
+    Symbols details_{};
     Symbol_Table<> symbols_{};
     Symbol_Table<> globals_{};
 };
@@ -510,9 +531,10 @@ class ITA
 
 inline ITA::Instruction_Pair make_ita_instructions(
     frontend::hir::Unit const& unit,
-    util::AST_Node const& details)
+    Symbols const& details,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
 {
-    return ITA::make_ita_instructions_with_globals(unit, details);
+    return ITA::make_ita_instructions_with_globals(unit, details, resource);
 }
 
 std::pair<std::string, std::string> get_rvalue_from_mov_qaudruple(
@@ -521,10 +543,10 @@ std::pair<std::string, std::string> get_rvalue_from_mov_qaudruple(
 /**
  * @brief Get the lvalue from an ita MOV instruction
  */
-constexpr std::string get_lvalue_from_mov_qaudruple(
+inline std::string get_lvalue_from_mov_qaudruple(
     Quadruple const& instruction)
 {
-    return std::get<1>(instruction);
+    return ir::get<1>(instruction);
 }
 
 } // namespace ir
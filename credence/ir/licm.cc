@@ -0,0 +1,275 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/licm.h>
+
+#include <algorithm>         // for any_of, all_of
+#include <credence/ir/cfg.h> // for CFG, Loop, make_preheader
+#include <credence/ir/ssa.h> // for scalar_names, for_each_name
+#include <string_view>       // for string_view
+#include <unordered_map>     // for unordered_map
+#include <unordered_set>     // for unordered_set
+#include <utility>           // for move, pair
+#include <vector>            // for vector
+
+namespace credence::ir {
+
+namespace {
+
+using Handle = Operand_Table::Handle;
+
+constexpr auto empty = Operand_Table::empty;
+
+/**
+ * @brief What of a function is the same for each of its loops
+ */
+struct Function_Facts
+{
+    // the scalars no instruction reaches but by name
+    std::unordered_set<Handle> scalars{};
+    // the vectors, local or global, indexed by name and never assigned
+    // whole, as one that is may hold the address of another
+    std::unordered_set<Handle> vectors{};
+    // the number of instructions that assign each name
+    std::unordered_map<Handle, std::size_t> assignments{};
+};
+
+Function_Facts facts_of(Instructions const& function)
+{
+    auto& table = operand_table();
+    Function_Facts facts{ detail::scalar_names(function), {}, {} };
+    std::unordered_set<Handle> declared{};
+    std::unordered_set<Handle> indexed{};
+    for (auto const& quadruple : function) {
+        if (quadruple.op == Instruction::GLOBL or
+            quadruple.op == Instruction::LOCL)
+            declared.insert(quadruple.operands[0]);
+        if (auto name = detail::assigned(quadruple); name != empty)
+            facts.assignments[name]++;
+        if (quadruple.op == Instruction::MOV)
+            for (auto operand : quadruple.operands)
+                if (auto const& value = table.value(operand);
+                    value.shape == Lvalue_Shape::Offset)
+                    indexed.insert(value.base);
+    }
+    for (auto name : declared)
+        if (table.value(name).shape == Lvalue_Shape::Scalar and
+            indexed.contains(name) and
+            not facts.assignments.contains(name))
+            facts.vectors.insert(name);
+    return facts;
+}
+
+bool is_nonzero_literal(Handle operand)
+{
+    auto const& value = operand_table().value(operand);
+    return value.is_literal() and not value.is_binary() and
+           (value.integer != 0 or value.real != 0);
+}
+
+/**
+ * @brief Whether an operation may trap where the loop would not have run
+ * it: a division by what is not a literal, or a load that is not of a
+ * vector at a literal index
+ */
+bool may_trap(Handle operand, Function_Facts const& facts)
+{
+    auto const& value = operand_table().value(operand);
+    if (value.is_binary())
+        return ((value.binary == "/" or value.binary == "%") and
+                   not is_nonzero_literal(value.rhs)) or
+               may_trap(value.lhs, facts) or may_trap(value.rhs, facts);
+    if (value.shape == Lvalue_Shape::Dereference)
+        return true;
+    if (value.shape == Lvalue_Shape::Offset)
+        return not facts.vectors.contains(value.base) or
+               not operand_table().value(value.offset).is_literal();
+    return false;
+}
+
+/**
+ * @brief Whether the right-hand side of a MOV is an operation that may be
+ * hoisted at all: not the RET of a call, a comparison a branch reads, or
+ * an increment
+ */
+bool is_movable(Handle operand)
+{
+    auto& table = operand_table();
+    auto const& value = table.value(operand);
+    std::string_view text = table.text(operand);
+    if (text == "RET" or text.starts_with("CMP "))
+        return false;
+    if (value.is_binary() or value.is_literal() or
+        value.shape != Lvalue_Shape::None)
+        return true;
+    auto op = value.unary;
+    return op == "-" or op == "~" or op == "!" or op == "&";
+}
+
+/**
+ * @brief Hoist the invariant operations of one loop to its preheader, and
+ * give the number hoisted
+ */
+std::size_t hoist(Instructions& function,
+    CFG const& cfg,
+    Loop const& loop,
+    Function_Facts const& facts)
+{
+    auto& table = operand_table();
+    std::vector<bool> in_loop(cfg.size(), false);
+    for (auto block : loop.blocks)
+        in_loop[block] = true;
+
+    // what the loop assigns, whether it may store to memory, the blocks
+    // it is left from, and where each name is read in it
+    std::unordered_set<Handle> assigned{};
+    bool clobbers = false;
+    std::vector<Block_Index> exits{};
+    std::unordered_map<Handle, std::vector<std::pair<Block_Index, std::size_t>>>
+        reads{};
+    for (auto block : loop.blocks) {
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++) {
+            auto const& quadruple = function[i];
+            if (quadruple.op == Instruction::CALL)
+                clobbers = true;
+            if (quadruple.op == Instruction::MOV) {
+                auto name = detail::assigned(quadruple);
+                if (name != empty)
+                    assigned.insert(name);
+                if (name == empty or not facts.scalars.contains(name))
+                    clobbers = true;
+            }
+            detail::for_each_read(quadruple, [&](Handle name) {
+                reads[name].emplace_back(block, i);
+            });
+        }
+        if (std::ranges::any_of(cfg[block].successors,
+                [&](auto successor) { return not in_loop[successor]; }))
+            exits.push_back(block);
+    }
+
+    auto invariant = [&](Block_Index block, std::size_t i) {
+        auto const& quadruple = function[i];
+        auto lhs = quadruple.operands[0];
+        auto rhs = quadruple.operands[1];
+        if (quadruple.op != Instruction::MOV or
+            quadruple.operands[2] != empty or
+            table.kind(lhs) != Operand_Kind::Temporary or
+            not facts.scalars.contains(lhs) or
+            facts.assignments.at(lhs) != 1 or not is_movable(rhs))
+            return false;
+        auto const& value = table.value(rhs);
+        bool load = value.shape == Lvalue_Shape::Offset or
+                    value.shape == Lvalue_Shape::Dereference;
+        bool changed = false;
+        std::string_view text = table.text(rhs);
+        detail::for_each_name(text, [&](std::size_t begin, std::size_t end) {
+            auto name = table.intern(text.substr(begin, end - begin));
+            if (assigned.contains(name))
+                changed = true;
+            // a vector or an address is where it is, whatever is stored
+            if (not facts.scalars.contains(name) and
+                not facts.vectors.contains(name) and value.unary != "&")
+                load = true;
+        });
+        if (changed or (load and clobbers))
+            return false;
+        if (may_trap(rhs, facts) and
+            not std::ranges::all_of(exits,
+                [&](auto exit) { return cfg.dominates(block, exit); }))
+            return false;
+        // each read in the loop is after it, and never of the value it
+        // held on the iteration before
+        if (auto found = reads.find(lhs); found != reads.end())
+            for (auto [use_block, use] : found->second)
+                if (use_block == block ? use <= i
+                                       : not cfg.dominates(block, use_block))
+                    return false;
+        return true;
+    };
+
+    std::vector<bool> hoisted(function.size(), false);
+    Instructions moved{ resource_of(function) };
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (auto block : cfg.order()) {
+            if (not in_loop[block])
+                continue;
+            for (auto i = cfg[block].begin; i < cfg[block].end; i++) {
+                if (hoisted[i] or not invariant(block, i))
+                    continue;
+                hoisted[i] = true;
+                moved.push_back(function[i]);
+                assigned.erase(function[i].operands[0]);
+                changed = true;
+            }
+        }
+    }
+    if (moved.empty())
+        return 0;
+
+    auto preheader = make_preheader(function, cfg, loop);
+    if (not preheader.has_value())
+        return 0;
+    auto count = moved.size();
+    if (preheader->label != empty)
+        moved.insert(moved.begin(),
+            Quadruple{ Instruction::LABEL, { preheader->label } });
+
+    Instructions motion{ resource_of(function) };
+    for (std::size_t i = 0; i < function.size(); i++) {
+        if (i == preheader->at)
+            motion.insert(motion.end(), moved.begin(), moved.end());
+        if (not hoisted[i])
+            motion.push_back(function[i]);
+    }
+    function = std::move(motion);
+    return count;
+}
+
+} // namespace
+
+/**
+ * @brief Hoist the loop-invariant operations of a function, from its LABEL
+ * to its EndFunc, to the preheader of each loop, and give the number
+ * hoisted
+ *
+ * The graph is built again after each loop, as a hoist moves instructions
+ * and may add a block.
+ */
+std::size_t hoist_invariants(Instructions& function)
+{
+    auto facts = facts_of(function);
+    std::size_t hoisted = 0;
+    // the loops visited, by the label of each header
+    std::unordered_set<Handle> visited{};
+    for (;;) {
+        auto cfg = CFG::build(function, 0, function.size());
+        Loop const* next = nullptr;
+        for (auto const& loop : cfg.loops()) {
+            auto const& head = function[cfg[loop.header].begin];
+            if (loop.irreducible or head.op != Instruction::LABEL or
+                visited.contains(head.operands[0]))
+                continue;
+            if (next == nullptr or loop.depth > next->depth)
+                next = &loop;
+        }
+        if (next == nullptr)
+            break;
+        visited.insert(function[cfg[next->header].begin].operands[0]);
+        hoisted += hoist(function, cfg, *next, facts);
+    }
+    return hoisted;
+}
+
+} // namespace credence::ir
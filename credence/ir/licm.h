@@ -0,0 +1,65 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/ir/quadruple.h> // for Instructions
+#include <cstddef>                 // for size_t
+
+/****************************************************************************
+ *
+ * Loop-invariant code motion
+ *
+ * A while loop is its predicate and body under _L labels, and whatever it
+ * computes is computed again on each iteration. An operation whose
+ * operands the loop never changes has the same value each time, and is
+ * hoisted to the preheader of the loop, the block that enters it:
+ *
+ *    _L2:                             _t7 = a * b;
+ *    _L4:                             _L2:
+ *        _t5 = i < n;                 _L4:
+ *        IF _t5 GOTO _L3;                 _t5 = i < n;
+ *    ...                                  IF _t5 GOTO _L3;
+ *    _L3:                             ...
+ *        _t7 = a * b;                 _L3:
+ *        v[i] = _t7;                      v[i] = _t7;
+ *
+ * The loops are the natural loops of the graph, innermost first, so an
+ * operation hoisted out of one loop may be hoisted again out of the loop
+ * around it. The block outside the loop that flows into its header alone
+ * is the preheader, and where there is no such block a labeled one is
+ * added before the header and the jumps into the loop from outside it go
+ * to it instead.
+ *
+ * An operation is hoisted when it assigns a temporary assigned nowhere
+ * else, before each read of it in the loop, and each name it reads is one
+ * the loop does not assign. A load - of a vector, through a pointer, or
+ * of a global or a local whose address is taken - is hoisted only from a
+ * loop with no call and no store but to the scalars of the function. An
+ * operation that may trap, a division by what is not a literal or a load
+ * that is not a vector at a literal index, is hoisted only from a block
+ * run on every iteration that leaves the loop, as a while loop may not run
+ * its body at all.
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+/**
+ * @brief Hoist the loop-invariant operations of a function, from its LABEL
+ * to its EndFunc, to the preheader of each loop, and give the number
+ * hoisted
+ */
+std::size_t hoist_invariants(Instructions& function);
+
+} // namespace credence::ir
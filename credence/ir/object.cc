@@ -322,7 +322,7 @@ unsigned int Function::get_allocation() const
 struct Object::Object_IMPL
 {
     Instruction_PTR ir_instructions{};
-    util::AST_Node hoisted_symbols;
+    Symbols hoisted_symbols{};
     Symbol_Table<> globals{};
     Function::Address_Table address_table{};
     std::string stack_frame_symbol{};
@@ -375,11 +375,11 @@ Instruction_PTR const& Object::get_ir_instructions() const
 {
     return pimpl->ir_instructions;
 }
-util::AST_Node& Object::get_hoisted_symbols()
+Symbols& Object::get_hoisted_symbols()
 {
     return pimpl->hoisted_symbols;
 }
-util::AST_Node const& Object::get_hoisted_symbols() const
+Symbols const& Object::get_hoisted_symbols() const
 {
     return pimpl->hoisted_symbols;
 }
@@ -674,20 +674,23 @@ Size Object::lvalue_size_at_temporary_object_address(LValue const& lvalue,
     auto rvalue = lvalue_at_temporary_object_address(lvalue, stack_frame);
     auto& locals = stack_frame->get_locals();
 
-    if (type::is_rvalue_data_type(rvalue) and
-        not type::is_rvalue_data_type_word(rvalue))
-        return type::get_size_from_rvalue_data_type(rvalue);
-    if (type::is_unary_expression(rvalue))
+    auto const& value = ir::value_of(rvalue);
+    if (value.is_literal() and value.type != ir::Value_Type::Word)
+        return std::get<2>(value.literal);
+    if (value.is_unary())
         return lvalue_size_at_temporary_object_address(
             type::get_unary_rvalue_reference(rvalue), stack_frame);
-    if (type::is_binary_expression(rvalue)) {
-        auto [left, right, op] = type::from_rvalue_binary_expression(rvalue);
-        if (type::is_rvalue_data_type(left) and
-            not type::is_rvalue_data_type_word(left))
-            return type::get_size_from_rvalue_data_type(left);
-        if (type::is_rvalue_data_type(right) and
-            not type::is_rvalue_data_type_word(right))
-            return type::get_size_from_rvalue_data_type(right);
+    if (value.is_binary()) {
+        auto const& left = ir::text_of(value.lhs);
+        auto const& right = ir::text_of(value.rhs);
+        auto const& left_value = ir::value_of(value.lhs);
+        auto const& right_value = ir::value_of(value.rhs);
+        if (left_value.is_literal() and
+            left_value.type != ir::Value_Type::Word)
+            return std::get<2>(left_value.literal);
+        if (right_value.is_literal() and
+            right_value.type != ir::Value_Type::Word)
+            return std::get<2>(right_value.literal);
         if (locals.is_defined(left) and not locals.is_pointer(left)) {
             auto data_type = locals.get_symbol_by_name(left);
             if (type::is_rvalue_data_type_word(data_type))
@@ -709,10 +712,9 @@ Size Object::lvalue_size_at_temporary_object_address(LValue const& lvalue,
                     locals.get_symbol_by_name(right));
         }
     }
-    if (type::is_temporary_data_type_binary_expression(rvalue)) {
-        auto [left, right, op] = type::from_rvalue_binary_expression(rvalue);
-        return lvalue_size_at_temporary_object_address(left, stack_frame);
-    }
+    if (type::is_temporary_data_type_binary_expression(rvalue))
+        return lvalue_size_at_temporary_object_address(
+            ir::text_of(value.lhs), stack_frame);
     if (locals.is_defined(rvalue)) {
         auto data_type = locals.get_symbol_by_name(rvalue);
         if (type::is_rvalue_data_type_word(data_type))
@@ -732,20 +734,22 @@ Size Object::get_size_of_temporary_binary_rvalue(RValue const& rvalue,
     Function_PTR const& stack_frame)
 {
     Size size = 0UL;
-    auto temp_side = type::is_temporary_operand_binary_expression(rvalue);
-    auto [left, right, _] = type::from_rvalue_binary_expression(rvalue);
+    auto const& value = ir::value_of(rvalue);
+    credence_assert(value.is_binary());
+    auto const& left = ir::text_of(value.lhs);
+    auto const& right = ir::text_of(value.rhs);
     if (type::is_temporary(left) and type::is_temporary(right))
         return lvalue_size_at_temporary_object_address(left, stack_frame);
-    if (temp_side == "left")
-        if (!type::is_rvalue_data_type(right))
+    if (type::is_temporary(left))
+        if (!ir::value_of(value.rhs).is_literal())
             size = lvalue_size_at_temporary_object_address(right, stack_frame);
         else
-            size = type::get_size_from_rvalue_data_type(right);
+            size = std::get<2>(ir::value_of(value.rhs).literal);
     else {
-        if (!type::is_rvalue_data_type(left))
+        if (!ir::value_of(value.lhs).is_literal())
             size = lvalue_size_at_temporary_object_address(left, stack_frame);
         else
-            size = type::get_size_from_rvalue_data_type(left);
+            size = std::get<2>(ir::value_of(value.lhs).literal);
     }
     credence_assert_nequal(size, 0UL);
     return size;
@@ -763,7 +767,7 @@ bool Object::stack_frame_contains_call_instruction(Label name,
         instructions.begin() + frame->get_address_location()[0],
         instructions.begin() + frame->get_address_location()[1],
         [&](ir::Quadruple const& quad) {
-            return std::get<0>(quad) == Instruction::CALL;
+            return ir::get<0>(quad) == Instruction::CALL;
         });
     return search != instructions.begin() + frame->get_address_location()[1];
 }
@@ -14,7 +14,7 @@
 #pragma once
 
 #include <array>             // for array
-#include <credence/ir/ita.h> // for Instructions
+#include <credence/ir/ita.h> // for Instructions, Symbols
 #include <credence/map.h>    // for Ordered_Map
 #include <credence/symbol.h> // for Symbol_Table
 #include <credence/types.h>  // for Parameters, Address, Data_Type, Label
@@ -276,8 +276,8 @@ class Object
     // Getters: IR and symbol tables
     Instruction_PTR& get_ir_instructions();
     Instruction_PTR const& get_ir_instructions() const;
-    util::AST_Node& get_hoisted_symbols();
-    util::AST_Node const& get_hoisted_symbols() const;
+    Symbols& get_hoisted_symbols();
+    Symbols const& get_hoisted_symbols() const;
     Symbol_Table<>& get_globals();
     Symbol_Table<> const& get_globals() const;
     Function::Address_Table& get_address_table();
@@ -0,0 +1,209 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/optimize.h>
+
+#include <credence/ir/cfg.h>       // for function_ranges
+#include <credence/ir/copies.h>    // for propagate_copies
+#include <credence/ir/dce.h>       // for eliminate_dead_code, remove_dead_code
+#include <credence/ir/gvn.h>       // for number_values
+#include <credence/ir/induction.h> // for reduce_induction_variables
+#include <credence/ir/inliner.h>   // for inline_calls
+#include <credence/ir/licm.h>      // for hoist_invariants
+#include <credence/ir/sccp.h>      // for propagate_constants, fold_branches
+#include <credence/ir/ssa.h>       // for SSA
+#include <credence/ir/tail.h>      // for eliminate_tail_recursion
+#include <credence/passes.h>       // for Scope
+#include <cstddef>                 // for size_t
+#include <deque>                   // for deque
+#include <string>                  // for string
+#include <utility>                 // for move, pair
+#include <vector>                  // for vector
+
+namespace credence::ir {
+
+namespace {
+
+/**
+ * @brief Put each function of a list back in place of its range, and keep
+ * the instructions between them as they are
+ */
+void splice(Instructions& instructions,
+    std::vector<std::pair<std::size_t, std::size_t>> const& ranges,
+    std::vector<Instructions> const& functions)
+{
+    Instructions spliced{ resource_of(instructions) };
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < ranges.size(); i++) {
+        auto [begin, end] = ranges[i];
+        spliced.insert(spliced.end(),
+            instructions.begin() + static_cast<std::ptrdiff_t>(next),
+            instructions.begin() + static_cast<std::ptrdiff_t>(begin));
+        spliced.insert(spliced.end(), functions[i].begin(), functions[i].end());
+        next = end;
+    }
+    spliced.insert(spliced.end(),
+        instructions.begin() + static_cast<std::ptrdiff_t>(next),
+        instructions.end());
+    instructions = std::move(spliced);
+}
+
+} // namespace
+
+/**
+ * @brief Run the enabled passes over each function of the ITA, in place
+ *
+ * The instructions between functions, e.g. the globals, are kept as they
+ * are, and each function is replaced by what the passes made of it.
+ */
+void optimize(Instructions& instructions)
+{
+    if (not optimize_options.any())
+        return;
+
+    if (optimize_options.inliner) {
+        passes::Scope inline_pass{ "inline" };
+        inline_pass.count("inlined",
+            inline_calls(instructions, optimize_options.inline_limit));
+    }
+
+    auto ranges = function_ranges(instructions);
+
+    if (optimize_options.tail) {
+        passes::Scope tail_pass{ "tail" };
+        std::size_t looped = 0;
+        std::vector<Instructions> functions{};
+        for (auto [begin, end] : ranges) {
+            functions.emplace_back(
+                instructions.begin() + static_cast<std::ptrdiff_t>(begin),
+                instructions.begin() + static_cast<std::ptrdiff_t>(end),
+                resource_of(instructions));
+            looped += eliminate_tail_recursion(functions.back());
+        }
+        splice(instructions, ranges, functions);
+        ranges = function_ranges(instructions);
+        tail_pass.count("looped", looped);
+    }
+    if (not optimize_options.in_ssa())
+        return;
+
+    passes::Scope ssa_pass{ "ssa" };
+    // a deque, as the graph of each holds the address of its instructions
+    std::deque<SSA> functions{};
+    for (auto [begin, end] : ranges)
+        functions.emplace_back(instructions, begin, end);
+    ssa_pass.count("functions", functions.size());
+    ssa_pass.finish();
+
+    if (optimize_options.sccp) {
+        passes::Scope sccp_pass{ "sccp" };
+        std::size_t folded = 0;
+        for (auto& ssa : functions)
+            folded += propagate_constants(ssa);
+        sccp_pass.count("folded", folded);
+    }
+
+    if (optimize_options.gvn) {
+        passes::Scope gvn_pass{ "gvn" };
+        std::size_t reused = 0;
+        for (auto& ssa : functions)
+            reused += number_values(ssa);
+        gvn_pass.count("reused", reused);
+    }
+
+    if (optimize_options.copies) {
+        passes::Scope copies_pass{ "copies" };
+        std::size_t dropped = 0;
+        std::vector<std::size_t> eliminated(functions.size(), 0);
+        for (std::size_t i = 0; i < functions.size(); i++) {
+            eliminated[i] = propagate_copies(functions[i]);
+            dropped += eliminated[i];
+        }
+        copies_pass.count("eliminated", dropped);
+        for (std::size_t i = 0; i < functions.size(); i++)
+            copies_pass.count(functions[i].cfg().name(), eliminated[i]);
+    }
+
+    // the quadruples dead code elimination drops from each function
+    std::vector<std::size_t> dead(functions.size(), 0);
+    if (optimize_options.dce) {
+        passes::Scope dce_pass{ "dce" };
+        std::size_t removed = 0;
+        for (std::size_t i = 0; i < functions.size(); i++) {
+            dead[i] = eliminate_dead_code(functions[i]);
+            removed += dead[i];
+        }
+        dce_pass.count("removed", removed);
+    }
+
+    std::vector<std::string> names{};
+    for (auto const& ssa : functions)
+        names.push_back(ssa.cfg().name());
+
+    passes::Scope destruct_pass{ "out-of-ssa" };
+    std::vector<Instructions> ordinary{};
+    ordinary.reserve(functions.size());
+    std::size_t quadruples = 0;
+    for (auto const& ssa : functions) {
+        ordinary.push_back(ssa.destruct());
+        quadruples += ordinary.back().size();
+    }
+    destruct_pass.count("quadruples", quadruples);
+    destruct_pass.finish();
+
+    if (optimize_options.sccp) {
+        passes::Scope fold_pass{ "fold-branches" };
+        std::size_t removed = 0;
+        for (auto& function : ordinary)
+            removed += fold_branches(function);
+        fold_pass.count("removed", removed);
+    }
+
+    if (optimize_options.licm) {
+        passes::Scope licm_pass{ "licm" };
+        std::size_t hoisted = 0;
+        for (auto& function : ordinary)
+            hoisted += hoist_invariants(function);
+        licm_pass.count("hoisted", hoisted);
+    }
+
+    if (optimize_options.iv) {
+        passes::Scope iv_pass{ "iv" };
+        Reduction reduction{};
+        for (auto& function : ordinary) {
+            auto reduced = reduce_induction_variables(function);
+            reduction.reduced += reduced.reduced;
+            reduction.removed += reduced.removed;
+        }
+        iv_pass.count("reduced", reduction.reduced);
+        iv_pass.count("removed", reduction.removed);
+    }
+
+    if (optimize_options.dce) {
+        passes::Scope blocks_pass{ "dead-blocks" };
+        std::size_t removed = 0;
+        for (std::size_t i = 0; i < ordinary.size(); i++) {
+            auto dropped = remove_dead_code(ordinary[i]);
+            removed += dropped;
+            dead[i] += dropped;
+        }
+        blocks_pass.count("removed", removed);
+        // and what both passes dropped, by function
+        for (std::size_t i = 0; i < ordinary.size(); i++)
+            blocks_pass.count(names[i], dead[i]);
+    }
+
+    splice(instructions, ranges, ordinary);
+}
+
+} // namespace credence::ir
@@ -0,0 +1,94 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/ir/quadruple.h> // for Instructions
+#include <cstddef>                 // for size_t
+
+/****************************************************************************
+ *
+ * Optimizer
+ *
+ * The passes over the ITA of a unit that run after it is built and before
+ * the table reads it, one function at a time. Each takes the ITA as it is
+ * and gives back ordinary ITA, so the table, -t ir, and both backends read
+ * the result as they would have read the ITA it was made from:
+ *
+ *    make_ita_instructions -> optimize -> Table -> x86_64 / arm64 / -t ir
+ *
+ * The passes to run are set once per process from the command line:
+ *
+ *    --inline replace each call of a small function by its body, before
+ *             the passes below, see credence/ir/inliner.h; -finline-limit
+ *             sets how small
+ *    --tail   turn each call of a function by itself in tail position
+ *             into a jump to its start, see credence/ir/tail.h
+ *    --ssa    take each function into SSA form and back, with no pass in
+ *             between, see credence/ir/ssa.h
+ *    --sccp   propagate and fold constants in SSA form, then drop the
+ *             branches they decide and the blocks left unreached, see
+ *             credence/ir/sccp.h
+ *    --gvn    reuse the first computation of each operation computed
+ *             twice with the same values, see credence/ir/gvn.h
+ *    --copies coalesce each temporary a copy reads into the copy, and
+ *             propagate the copies left, see credence/ir/copies.h
+ *    --licm   hoist the operations a while loop does not change to the
+ *             block before it, see credence/ir/licm.h
+ *    --iv     reduce the multiplies and shifts of the induction variables
+ *             of each loop to adds, see credence/ir/induction.h
+ *    --dce    drop the assignments nothing live reads, in SSA form, then
+ *             the code after a return, the blocks left unreached, and
+ *             the labels and locals left unused, see credence/ir/dce.h
+ *
+ * Each pass is timed on its own under --time-passes, over every function
+ * of the unit at once, and copies and dead-blocks report what --copies
+ * and --dce dropped from each function by its name.
+ *****************************************************************************/
+
+namespace credence::ir {
+
+struct Optimize_Options
+{
+    bool inliner{ false };
+    // the most quadruples of a function --inline replaces a call by
+    std::size_t inline_limit{ 8 };
+    bool tail{ false };
+    bool ssa{ false };
+    bool sccp{ false };
+    bool gvn{ false };
+    bool copies{ false };
+    bool licm{ false };
+    bool iv{ false };
+    bool dce{ false };
+
+    // whether any pass that runs while each function is taken into SSA
+    // form and back is on, as all but --inline and --tail are
+    bool in_ssa() const
+    {
+        return ssa or sccp or gvn or copies or licm or iv or dce;
+    }
+
+    bool any() const { return inliner or tail or in_ssa(); }
+};
+
+// Set by main from the command line; every pass is off by default, which
+// leaves the ITA as it was built.
+inline Optimize_Options optimize_options{};
+
+/**
+ * @brief Run the enabled passes over each function of the ITA, in place
+ */
+void optimize(Instructions& instructions);
+
+} // namespace credence::ir
@@ -0,0 +1,282 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/quadruple.h>
+
+#include <cctype>           // for isalnum, isalpha, isdigit
+#include <charconv>         // for from_chars
+#include <credence/types.h> // for is_rvalue_data_type, get_data_type_from...
+#include <functional>       // for hash
+#include <map>              // for map
+#include <string>           // for string
+#include <string_view>      // for string_view
+#include <system_error>     // for errc
+#include <tuple>            // for get
+#include <utility>          // for pair
+
+namespace credence::ir {
+
+namespace {
+
+/**
+ * @brief The number after a "_t" or "_L" prefix, if all the rest is digits
+ */
+std::pair<bool, std::uint32_t> numbered(std::string_view text,
+    std::string_view prefix)
+{
+    if (text.size() <= prefix.size() or not text.starts_with(prefix))
+        return { false, 0 };
+    std::uint32_t number = 0;
+    for (auto c : text.substr(prefix.size())) {
+        if (not std::isdigit(static_cast<unsigned char>(c)))
+            return { false, 0 };
+        number = number * 10 + static_cast<std::uint32_t>(c - '0');
+    }
+    return { true, number };
+}
+
+/**
+ * @brief Whether the text is a name, e.g. x, __main, or k.ll, as the lexer
+ * reads one
+ */
+bool is_symbol(std::string_view text)
+{
+    if (not std::isalpha(static_cast<unsigned char>(text.front())) and
+        text.front() != '_')
+        return false;
+    for (auto c : text)
+        if (not std::isalnum(static_cast<unsigned char>(c)) and c != '_' and
+            c != '.')
+            return false;
+    return true;
+}
+
+/**
+ * @brief The name of an SSA version, e.g. x of x#2, or empty if the text
+ * is not a version
+ */
+std::string_view version_of(std::string_view text)
+{
+    auto mark = text.rfind('#');
+    if (mark == std::string_view::npos or mark == 0 or mark + 1 == text.size())
+        return {};
+    for (auto c : text.substr(mark + 1))
+        if (not std::isdigit(static_cast<unsigned char>(c)))
+            return {};
+    auto name = text.substr(0, mark);
+    return is_symbol(name) ? name : std::string_view{};
+}
+
+std::pair<Operand_Kind, std::uint32_t> classify(std::string_view text)
+{
+    if (text.empty())
+        return { Operand_Kind::Empty, 0 };
+    // an SSA version, e.g. x#2 or _t5#1, is the kind of the name it is of
+    if (auto name = version_of(text); not name.empty())
+        return classify(name);
+    if (auto [temporary, number] = numbered(text, "_t"); temporary)
+        return { Operand_Kind::Temporary, number };
+    if (auto [label, number] = numbered(text, "_L"); label)
+        return { Operand_Kind::Label, number };
+    if (type::is_rvalue_data_type(std::string{ text }))
+        return { Operand_Kind::Literal, 0 };
+    if (is_symbol(text))
+        return { Operand_Kind::Symbol, 0 };
+    return { Operand_Kind::Expression, 0 };
+}
+
+Value_Type value_type_of(std::string_view type)
+{
+    static const std::map<std::string_view, Value_Type> types = {
+        { "null",   Value_Type::Null   },
+        { "word",   Value_Type::Word   },
+        { "byte",   Value_Type::Byte   },
+        { "int",    Value_Type::Int    },
+        { "long",   Value_Type::Long   },
+        { "float",  Value_Type::Float  },
+        { "double", Value_Type::Double },
+        { "bool",   Value_Type::Bool   },
+        { "char",   Value_Type::Char   },
+        { "string", Value_Type::String }
+    };
+    auto found = types.find(type);
+    return found == types.end() ? Value_Type::None : found->second;
+}
+
+/**
+ * @brief The numeric value of a literal, where it has one
+ */
+void read_number(Operand_Value& value)
+{
+    auto const& text = std::get<0>(value.literal);
+    auto const* end = text.data() + text.size();
+    switch (value.type) {
+        case Value_Type::Byte:
+        case Value_Type::Int:
+        case Value_Type::Long:
+        case Value_Type::Bool:
+            std::from_chars(text.data(), end, value.integer);
+            value.real = static_cast<double>(value.integer);
+            break;
+        case Value_Type::Float:
+        case Value_Type::Double:
+            std::from_chars(text.data(), end, value.real);
+            value.integer = static_cast<std::int64_t>(value.real);
+            break;
+        // a character is its code in quotes, e.g. '97'
+        case Value_Type::Char:
+            if (text.size() > 2 and text.front() == '\'')
+                std::from_chars(text.data() + 1, end - 1, value.integer);
+            value.real = static_cast<double>(value.integer);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief The unary operator an expression starts or ends with
+ *
+ * The same operator type::get_unary_operator finds, as a view of the
+ * operator list so that it outlives the text it was read from.
+ */
+std::string_view unary_operator_of(std::string_view text)
+{
+    for (std::string_view op : type::unary_operators)
+        if (text.find(op) != std::string_view::npos)
+            return op;
+    return {};
+}
+
+inline std::uint64_t hash_of(std::string_view text)
+{
+    return frontend::hir::mix_hash(std::hash<std::string_view>{}(text));
+}
+
+} // namespace
+
+Operand_Table::Operand_Table()
+{
+    intern("");
+}
+
+Operand_Table::Handle Operand_Table::intern(std::string_view text)
+{
+    auto hash = hash_of(text);
+    auto found = index_.find(
+        hash, [&](Handle handle) { return entries_[handle].text == text; });
+    if (found != frontend::hir::Handle_Index::empty_slot)
+        return found;
+
+    auto handle = static_cast<Handle>(entries_.size());
+    entries_.push_back(Entry{ std::string{ text }, {} });
+    index_.insert(hash, handle, [&](Handle h) {
+        return hash_of(entries_[h].text);
+    });
+    // the parts of an operand are shorter than it, so reading them here
+    // interns other entries and never this one again
+    auto value = read_value(entries_[handle].text);
+    entries_[handle].value = std::move(value);
+    return handle;
+}
+
+/**
+ * @brief Read the parts of an operand out of its text
+ *
+ * Each part is found by the same test in types.h the table and the
+ * backends made on the text before, so an operand means what it did.
+ */
+Operand_Value Operand_Table::read_value(std::string_view text)
+{
+    Operand_Value value{};
+    auto [kind, number] = classify(text);
+    value.kind = kind;
+    value.number = number;
+    if (kind == Operand_Kind::Empty)
+        return value;
+
+    auto rvalue = std::string{ text };
+
+    // "(20:int:4) / (5:int:4)" passes for a literal as well, so a literal
+    // still has its binary and unary parts read below
+    if (kind == Operand_Kind::Literal) {
+        value.literal = type::get_data_type_from_string(rvalue);
+        value.type = value_type_of(std::get<1>(value.literal));
+        read_number(value);
+    }
+
+    // a bare index, e.g. the 1 of v[1], is no literal but has its number
+    if (kind == Operand_Kind::Expression and
+        std::isdigit(static_cast<unsigned char>(text.front()))) {
+        auto [end, error] = std::from_chars(
+            text.data(), text.data() + text.size(), value.integer);
+        if (error == std::errc{} and end == text.data() + text.size())
+            value.real = static_cast<double>(value.integer);
+        else
+            value.integer = 0;
+    }
+
+    if (kind == Operand_Kind::Temporary or kind == Operand_Kind::Symbol)
+        value.shape = Lvalue_Shape::Scalar;
+
+    if (type::is_binary_expression(rvalue)) {
+        auto lhs = text.find_first_of(' ');
+        auto rhs = text.find_last_of(' ');
+        value.binary = text.substr(lhs + 1, rhs - lhs - 1);
+        value.lhs = intern(text.substr(0, lhs));
+        value.rhs = intern(text.substr(rhs + 1));
+        return value;
+    }
+
+    if (type::is_unary_expression(text))
+        value.unary = unary_operator_of(text);
+
+    if (text.ends_with("]") and text.find('[') != std::string_view::npos) {
+        auto open = text.find('[');
+        auto close = text.find(']');
+        value.shape = Lvalue_Shape::Offset;
+        value.base = intern(text.substr(0, open));
+        value.offset = intern(text.substr(open + 1, close - open - 1));
+    } else if (text.size() > 1 and text.front() == '*' and
+               is_symbol(text.substr(1))) {
+        value.shape = Lvalue_Shape::Dereference;
+        value.base = intern(text.substr(1));
+    }
+    return value;
+}
+
+namespace {
+
+// the table of the innermost Operand_Scope alive on this thread, if any
+thread_local Operand_Table* scoped_table = nullptr;
+
+} // namespace
+
+Operand_Table& operand_table()
+{
+    static thread_local Operand_Table table{};
+    return scoped_table ? *scoped_table : table;
+}
+
+Operand_Scope::Operand_Scope()
+    : previous_(scoped_table)
+{
+    scoped_table = &table_;
+}
+
+Operand_Scope::~Operand_Scope()
+{
+    scoped_table = previous_;
+}
+
+} // namespace credence::ir
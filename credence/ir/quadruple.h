@@ -0,0 +1,429 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <array>                         // for array
+#include <cstddef>                       // for size_t
+#include <cstdint>                       // for uint32_t, uint8_t
+#include <credence/error.h>              // for credence_assert_message
+#include <credence/frontend/hir/probe.h> // for Handle_Index
+#include <credence/types.h>              // for Data_Type
+#include <deque>                         // for deque, pmr::deque
+#include <list>                          // for pmr::list
+#include <memory_resource>               // for polymorphic_allocator, memory_...
+#include <string>                        // for string
+#include <string_view>                   // for string_view
+#include <tuple>                         // for tuple_size, tuple_element
+#include <type_traits>                   // for integral_constant
+
+/****************************************************************************
+ *
+ * Quadruple
+ *
+ * One ITA instruction: an opcode and up to three operands, each operand a
+ * 32-bit handle into the operand table. A quadruple is 16 bytes and is
+ * copied, compared, and stored without touching the heap:
+ *
+ *    _t5 = loop == (1:int:4);
+ *
+ *    op     MOV
+ *    [0]    handle of "_t5"                   temporary 5
+ *    [1]    handle of "loop == (1:int:4)"     expression
+ *    [2]    handle of ""                      empty
+ *
+ * The operand table interns each distinct operand once, and records what
+ * kind of operand it is while it does, so a temporary or a label is known
+ * by its number and does not have to be recognised from its text again:
+ *
+ *    temporary   _t<n>
+ *    label       _L<n>
+ *    literal     (value:type:size)
+ *    symbol      a name, e.g. x or __main
+ *    expression  anything else, e.g. "_t1 + _t2"
+ *
+ * A version of a name in SSA form, e.g. x#2 or _t5#1, is the kind of the
+ * name, see credence/ir/ssa.h.
+ *
+ * The same text always has the same handle, so two operands are equal when
+ * their handles are. The text of an operand is what -t ir prints and what
+ * the table and the backends read, and it lives as long as the table.
+ *
+ * The rest of what an operand is, is read out of its text once, when it is
+ * interned, into an Operand_Value:
+ *
+ *    (10:int:4)     literal, int, 10, 4 bytes
+ *    v[k]           offset lvalue, base v, offset k
+ *    *p             dereference lvalue, base p
+ *    _t1 + x        binary, lhs _t1, operator +, rhs x
+ *    -x             unary, operator -
+ *
+ * So the table, the type checker, and the backends ask for the value of an
+ * operand, which is a hash lookup, and do not split and copy its text into
+ * new strings each time they see it.
+ *
+ * The handles are how a quadruple is stored, and not yet what the IR is.
+ * get<N> gives back the text of an operand, and Table, Table_Accessor and
+ * the visitors and inserters of both backends still take their operands
+ * as strings from it, so the text is still read past the printer of -t
+ * ir. An expression such as "_t1 + x" is interned whole, with its parts
+ * read into its value, and the number of a temporary or a label is not
+ * yet the name any of them keys on. The text is kept as the one form
+ * every consumer already understands, so the handles could replace the
+ * strings of Quadruple without rewriting each reader at once; the
+ * readers move to value_of and kind_of one at a time.
+ *
+ * There is one operand table for the compilation and not one per function,
+ * as a handle is read where only the instruction is at hand, and
+ * instructions of one function are copied into another's list while the
+ * ITA is built. An Operand_Scope is made on the stack of the function that
+ * runs a compilation, e.g. ir::emit or x86_64::emit, and while it is alive
+ * its table is the operand table every handle on that thread is read
+ * from, so the table of one compilation is gone when it is done and the
+ * next does not grow it. Handles made with no scope alive are in the
+ * table of the thread, as before. The tables are per thread, so two
+ * compilations on two threads never share one.
+ *
+ * A quadruple does not carry the table its handles are from. A list built
+ * under one scope must not be read once the scope is gone, as its handles
+ * would index the table in scope then. In a DEBUG build a handle past the
+ * end of that table fails an assertion; a handle that lands inside it
+ * reads the wrong text, and is not caught.
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+enum class Instruction : std::uint8_t
+{
+    FUNC_START,
+    FUNC_END,
+    LABEL,
+    GOTO,
+    LOCL,
+    GLOBL,
+    IF,
+    JMP_E,
+    PUSH,
+    POP,
+    CALL,
+    CMP,
+    MOV,
+    RETURN,
+    LEAVE,
+    NOOP
+};
+
+enum class Operand_Kind : std::uint8_t
+{
+    Empty,
+    Temporary,
+    Label,
+    Literal,
+    Symbol,
+    Expression
+};
+
+/**
+ * @brief The place in storage an lvalue operand names
+ */
+enum class Lvalue_Shape : std::uint8_t
+{
+    None,
+    Scalar,      // x, _t5, _p1_1
+    Dereference, // *p
+    Offset       // v[k]
+};
+
+/**
+ * @brief The type of a literal operand
+ */
+enum class Value_Type : std::uint8_t
+{
+    None,
+    Null,
+    Word,
+    Byte,
+    Int,
+    Long,
+    Float,
+    Double,
+    Bool,
+    Char,
+    String
+};
+
+/**
+ * @brief An operand as its parts, read once from its text
+ *
+ * Handles name other operands in the same table, and the empty handle
+ * stands for a part the operand does not have.
+ */
+struct Operand_Value
+{
+    using Handle = std::uint32_t;
+
+    Operand_Kind kind{ Operand_Kind::Empty };
+    Lvalue_Shape shape{ Lvalue_Shape::None };
+    // the number of a temporary or a label, e.g. 5 of _t5
+    std::uint32_t number{ 0 };
+
+    // a literal, as its (value:type:size) tuple and as a number, and the
+    // number of a bare index, e.g. 1 of v[1]
+    Value_Type type{ Value_Type::None };
+    type::Data_Type literal{};
+    std::int64_t integer{ 0 };
+    double real{ 0 };
+
+    // the vector or pointer of v[k] and *p, and the k of v[k]
+    Handle base{ 0 };
+    Handle offset{ 0 };
+
+    // the operands and the operator of "lhs op rhs"
+    Handle lhs{ 0 };
+    Handle rhs{ 0 };
+    std::string_view binary{};
+
+    // the operator of a unary expression, e.g. "-" of -x or "*" of *p
+    std::string_view unary{};
+
+    bool is_literal() const { return kind == Operand_Kind::Literal; }
+    bool is_binary() const { return not binary.empty(); }
+    bool is_unary() const { return not unary.empty(); }
+};
+
+/**
+ * @brief Every distinct operand of every instruction, by handle
+ */
+class Operand_Table
+{
+  public:
+    using Handle = std::uint32_t;
+
+    // the empty operand, interned first so that a zeroed handle is empty
+    static constexpr Handle empty = 0;
+
+    Operand_Table();
+
+    Operand_Table(Operand_Table const&) = delete;
+    Operand_Table& operator=(Operand_Table const&) = delete;
+
+    /**
+     * @brief The handle of an operand, adding it if it is new
+     */
+    Handle intern(std::string_view text);
+
+    std::string const& text(Handle handle) const
+    {
+        return entry(handle).text;
+    }
+
+    Operand_Value const& value(Handle handle) const
+    {
+        return entry(handle).value;
+    }
+
+    Operand_Kind kind(Handle handle) const
+    {
+        return entry(handle).value.kind;
+    }
+
+    /**
+     * @brief The number of a temporary or a label, e.g. 5 of _t5
+     */
+    std::uint32_t number(Handle handle) const
+    {
+        return entry(handle).value.number;
+    }
+
+    std::size_t size() const { return entries_.size(); }
+
+  private:
+    struct Entry
+    {
+        std::string text;
+        Operand_Value value;
+    };
+
+    Operand_Value read_value(std::string_view text);
+
+    Entry const& entry(Handle handle) const
+    {
+#ifdef DEBUG
+        credence_assert_message(handle < entries_.size(),
+            "operand handle is not of the operand table in scope");
+#endif
+        return entries_[handle];
+    }
+
+    // a deque, so the text of an entry never moves once interned, and
+    // the views into it an Operand_Value holds stay valid
+    std::deque<Entry> entries_{};
+    frontend::hir::Handle_Index index_{};
+};
+
+/**
+ * @brief The operand table of the compilation in scope on this thread, or
+ * of the thread if there is none
+ */
+Operand_Table& operand_table();
+
+/**
+ * @brief The operand table of one compilation, the one operand_table()
+ * gives back while it is alive
+ */
+class Operand_Scope
+{
+  public:
+    Operand_Scope();
+    ~Operand_Scope();
+
+    Operand_Scope(Operand_Scope const&) = delete;
+    Operand_Scope& operator=(Operand_Scope const&) = delete;
+
+  private:
+    Operand_Table table_{};
+    Operand_Table* previous_;
+};
+
+/**
+ * @brief An opcode and three operand handles
+ */
+struct Quadruple
+{
+    using Handle = Operand_Table::Handle;
+
+    Instruction op{ Instruction::NOOP };
+    std::array<Handle, 3> operands{ Operand_Table::empty,
+        Operand_Table::empty,
+        Operand_Table::empty };
+
+    bool operator==(Quadruple const&) const = default;
+};
+
+static_assert(sizeof(Quadruple) == 16);
+
+// allocated from the resource each is given, the Arena of the compilation
+// for the lists it builds, see credence/arena.h
+using Instructions = std::pmr::deque<Quadruple>;
+
+// the lists the ITA builds a function from, statement by statement, which
+// are only ever appended to one another and read front to back, so each
+// is spliced into the next in constant time; the function is laid out as
+// Instructions once it is whole, for the passes that read by position
+using Instruction_List = std::pmr::list<Quadruple>;
+
+/**
+ * @brief The resource a list was given, for the lists rebuilt from it
+ */
+inline std::pmr::memory_resource* resource_of(Instructions const& instructions)
+{
+    return instructions.get_allocator().resource();
+}
+
+/**
+ * @brief Create a quadruple from an opcode and up to three operands
+ */
+inline Quadruple make_quadruple(Instruction op,
+    std::string_view s1 = "",
+    std::string_view s2 = "",
+    std::string_view s3 = "")
+{
+    auto& table = operand_table();
+    return Quadruple{ op,
+        { table.intern(s1), table.intern(s2), table.intern(s3) } };
+}
+
+/**
+ * @brief The opcode, or the text of operand I, of a quadruple
+ *
+ * get<0> is the opcode and get<1> to get<3> the operands, in the order
+ * make_quadruple takes them, so a quadruple still decomposes as the tuple
+ * it once was:
+ *
+ *    auto [op, lhs, rhs, _] = quadruple;
+ */
+template<std::size_t I>
+constexpr decltype(auto) get(Quadruple const& quadruple)
+{
+    static_assert(I < 4, "a quadruple has an opcode and three operands");
+    if constexpr (I == 0)
+        return quadruple.op;
+    else
+        return static_cast<std::string const&>(
+            operand_table().text(quadruple.operands[I - 1]));
+}
+
+/**
+ * @brief The kind of operand I of a quadruple
+ */
+template<std::size_t I>
+Operand_Kind kind_of(Quadruple const& quadruple)
+{
+    static_assert(I > 0 and I < 4, "operands are numbered 1 to 3");
+    return operand_table().kind(quadruple.operands[I - 1]);
+}
+
+/**
+ * @brief The value of operand I of a quadruple
+ */
+template<std::size_t I>
+Operand_Value const& value_of(Quadruple const& quadruple)
+{
+    static_assert(I > 0 and I < 4, "operands are numbered 1 to 3");
+    return operand_table().value(quadruple.operands[I - 1]);
+}
+
+/**
+ * @brief The value of an operand by its text, interning it if it is new
+ */
+inline Operand_Value const& value_of(std::string_view text)
+{
+    auto& table = operand_table();
+    return table.value(table.intern(text));
+}
+
+/**
+ * @brief The value of an operand handle, e.g. the lhs of a binary value
+ */
+inline Operand_Value const& value_of(Operand_Table::Handle handle)
+{
+    return operand_table().value(handle);
+}
+
+/**
+ * @brief The text of an operand handle
+ */
+inline std::string const& text_of(Operand_Table::Handle handle)
+{
+    return operand_table().text(handle);
+}
+
+} // namespace credence::ir
+
+template<>
+struct std::tuple_size<credence::ir::Quadruple>
+    : std::integral_constant<std::size_t, 4>
+{};
+
+template<>
+struct std::tuple_element<0, credence::ir::Quadruple>
+{
+    using type = credence::ir::Instruction;
+};
+
+template<std::size_t I>
+struct std::tuple_element<I, credence::ir::Quadruple>
+{
+    using type = std::string const&;
+};
@@ -0,0 +1,758 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/sccp.h>
+
+#include <algorithm>             // for find
+#include <cmath>                 // for isfinite
+#include <credence/ir/cfg.h>     // for CFG, Block_Index
+#include <credence/ir/operand.h> // for literal_to_string, TYPE_LITERAL
+#include <credence/types.h>      // for relation_binary_operators
+#include <cstdint>               // for int64_t, uint64_t, int32_t
+#include <limits>                // for numeric_limits
+#include <optional>              // for optional, nullopt
+#include <string>                // for string
+#include <string_view>           // for string_view
+#include <unordered_map>         // for unordered_map
+#include <utility>               // for pair, move
+#include <vector>                // for vector
+
+namespace credence::ir {
+
+namespace {
+
+using Handle = Operand_Table::Handle;
+
+/**
+ * @brief A literal as the value it holds, for the operations a constant
+ * may be folded by
+ */
+struct Constant
+{
+    Handle literal{ Operand_Table::empty };
+    Value_Type type{ Value_Type::None };
+    std::int64_t integer{ 0 };
+    double real{ 0 };
+
+    bool is_real() const
+    {
+        return type == Value_Type::Float or type == Value_Type::Double;
+    }
+    bool truth() const { return is_real() ? real != 0 : integer != 0; }
+};
+
+/**
+ * @brief What is known of a version: nothing yet, the one constant it
+ * holds, or that it holds more than one
+ */
+struct Lattice
+{
+    enum class State : std::uint8_t
+    {
+        Top,
+        Constant,
+        Bottom
+    };
+
+    State state{ State::Top };
+    Constant constant{};
+
+    static Lattice of(Constant const& constant)
+    {
+        return Lattice{ State::Constant, constant };
+    }
+    static Lattice bottom() { return Lattice{ State::Bottom, {} }; }
+
+    bool is_top() const { return state == State::Top; }
+    bool is_constant() const { return state == State::Constant; }
+    bool is_bottom() const { return state == State::Bottom; }
+
+    // one literal has one handle, so two constants are equal when their
+    // literals are, and (1:int:4) and (1:long:8) are not
+    bool operator==(Lattice const& other) const
+    {
+        return state == other.state and
+               constant.literal == other.constant.literal;
+    }
+};
+
+Lattice meet(Lattice const& a, Lattice const& b)
+{
+    if (a.is_top())
+        return b;
+    if (b.is_top() or a == b)
+        return a;
+    return Lattice::bottom();
+}
+
+/**
+ * @brief An int wraps in 32 bits and a long in 64, as the backends
+ * compute them
+ */
+std::int64_t wrap(std::uint64_t bits, Value_Type type)
+{
+    if (type == Value_Type::Long)
+        return static_cast<std::int64_t>(bits);
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(bits));
+}
+
+/**
+ * @brief The constant an operand is a literal of, or none if it is not a
+ * literal a constant can be folded from
+ */
+std::optional<Constant> constant_of(Handle operand)
+{
+    auto const& value = value_of(operand);
+    if (not value.is_literal() or value.is_binary())
+        return std::nullopt;
+    switch (value.type) {
+        case Value_Type::Int:
+        case Value_Type::Long:
+        case Value_Type::Bool:
+        case Value_Type::Char:
+            return Constant{ operand,
+                value.type,
+                wrap(static_cast<std::uint64_t>(value.integer),
+                    value.type == Value_Type::Long ? Value_Type::Long
+                                                   : Value_Type::Int),
+                value.real };
+        case Value_Type::Float:
+        case Value_Type::Double:
+            return Constant{ operand, value.type, value.integer, value.real };
+        default:
+            return std::nullopt;
+    }
+}
+
+Lattice make_integer(std::int64_t integer, Value_Type type)
+{
+    auto& table = operand_table();
+    auto name = type == Value_Type::Long ? "long" : "int";
+    operand::Literal literal =
+        type == Value_Type::Long
+            ? operand::Literal{ static_cast<long>(integer),
+                  operand::TYPE_LITERAL.at(name) }
+            : operand::Literal{ static_cast<int>(integer),
+                  operand::TYPE_LITERAL.at(name) };
+    auto handle = table.intern(operand::literal_to_string(literal));
+    return Lattice::of(*constant_of(handle));
+}
+
+/**
+ * @brief A float or double constant, if its literal prints back to the
+ * same value, which the literal of a computed value may not
+ */
+Lattice make_real(double real, Value_Type type)
+{
+    if (not std::isfinite(real))
+        return Lattice::bottom();
+    auto& table = operand_table();
+    operand::Literal literal =
+        type == Value_Type::Float
+            ? operand::Literal{ static_cast<float>(real),
+                  operand::TYPE_LITERAL.at("float") }
+            : operand::Literal{ real, operand::TYPE_LITERAL.at("double") };
+    auto handle = table.intern(operand::literal_to_string(literal));
+    auto constant = constant_of(handle);
+    if (not constant.has_value())
+        return Lattice::bottom();
+    bool exact = type == Value_Type::Float
+                     ? static_cast<float>(constant->real) ==
+                           static_cast<float>(real)
+                     : constant->real == real;
+    return exact ? Lattice::of(*constant) : Lattice::bottom();
+}
+
+/**
+ * @brief The type two operands of a binary operation are computed in
+ */
+Value_Type promote(Value_Type lhs, Value_Type rhs)
+{
+    for (auto type :
+        { Value_Type::Double, Value_Type::Float, Value_Type::Long })
+        if (lhs == type or rhs == type)
+            return type;
+    return Value_Type::Int;
+}
+
+bool is_relation(std::string_view op)
+{
+    for (std::string_view relation : type::relation_binary_operators)
+        if (op == relation)
+            return true;
+    return false;
+}
+
+Lattice fold_relation(std::string_view op, Constant const& a, Constant const& b)
+{
+    if (op == "&&")
+        return make_integer(a.truth() and b.truth(), Value_Type::Int);
+    if (op == "||")
+        return make_integer(a.truth() or b.truth(), Value_Type::Int);
+    auto type = promote(a.type, b.type);
+    auto compare = [&](auto x, auto y) {
+        if (op == "==")
+            return x == y;
+        if (op == "!=")
+            return x != y;
+        if (op == "<")
+            return x < y;
+        if (op == ">")
+            return x > y;
+        if (op == "<=")
+            return x <= y;
+        return x >= y;
+    };
+    if (type == Value_Type::Double)
+        return make_integer(compare(a.real, b.real), Value_Type::Int);
+    if (type == Value_Type::Float)
+        return make_integer(compare(static_cast<float>(a.real),
+                                static_cast<float>(b.real)),
+            Value_Type::Int);
+    return make_integer(compare(a.integer, b.integer), Value_Type::Int);
+}
+
+Lattice fold_real(std::string_view op,
+    Constant const& a,
+    Constant const& b,
+    Value_Type type)
+{
+    double x = a.real, y = b.real, result = 0;
+    if (type == Value_Type::Float) {
+        auto f = static_cast<float>(x), g = static_cast<float>(y);
+        switch (op.front()) {
+            case '+':
+                result = f + g;
+                break;
+            case '-':
+                result = f - g;
+                break;
+            case '*':
+                result = f * g;
+                break;
+            case '/':
+                if (g == 0)
+                    return Lattice::bottom();
+                result = f / g;
+                break;
+            default:
+                return Lattice::bottom();
+        }
+        return make_real(result, type);
+    }
+    switch (op.front()) {
+        case '+':
+            result = x + y;
+            break;
+        case '-':
+            result = x - y;
+            break;
+        case '*':
+            result = x * y;
+            break;
+        case '/':
+            if (y == 0)
+                return Lattice::bottom();
+            result = x / y;
+            break;
+        default:
+            return Lattice::bottom();
+    }
+    return make_real(result, type);
+}
+
+Lattice fold_integer(std::string_view op,
+    Constant const& a,
+    Constant const& b,
+    Value_Type type)
+{
+    auto x = a.integer, y = b.integer;
+    auto ux = static_cast<std::uint64_t>(x), uy = static_cast<std::uint64_t>(y);
+    auto width = type == Value_Type::Long ? 64 : 32;
+    auto minimum = type == Value_Type::Long
+                       ? std::numeric_limits<std::int64_t>::min()
+                       : std::numeric_limits<std::int32_t>::min();
+    if (op == "<<" or op == ">>") {
+        if (y < 0 or y >= width)
+            return Lattice::bottom();
+        if (op == "<<")
+            return make_integer(wrap(ux << y, type), type);
+        // the backends shift right logically, shr and lsr, at the width
+        // of the operand
+        auto bits = type == Value_Type::Long ? ux : ux & 0xffffffffULL;
+        return make_integer(wrap(bits >> y, type), type);
+    }
+    switch (op.front()) {
+        case '+':
+            return make_integer(wrap(ux + uy, type), type);
+        case '-':
+            return make_integer(wrap(ux - uy, type), type);
+        case '*':
+            return make_integer(wrap(ux * uy, type), type);
+        case '/':
+        case '%':
+            if (y == 0 or (x == minimum and y == -1))
+                return Lattice::bottom();
+            return make_integer(op.front() == '/' ? x / y : x % y, type);
+        case '&':
+            return make_integer(x & y, type);
+        case '|':
+            return make_integer(x | y, type);
+        case '^':
+            return make_integer(x ^ y, type);
+        default:
+            return Lattice::bottom();
+    }
+}
+
+Lattice fold_binary(std::string_view op, Lattice const& a, Lattice const& b)
+{
+    if (a.is_bottom() or b.is_bottom())
+        return Lattice::bottom();
+    if (a.is_top() or b.is_top())
+        return Lattice{};
+    if (is_relation(op))
+        return fold_relation(op, a.constant, b.constant);
+    auto type = promote(a.constant.type, b.constant.type);
+    if (type == Value_Type::Float or type == Value_Type::Double)
+        return fold_real(op, a.constant, b.constant, type);
+    return fold_integer(op, a.constant, b.constant, type);
+}
+
+Lattice fold_unary(std::string_view op, Lattice const& a)
+{
+    if (not a.is_constant())
+        return a;
+    auto const& x = a.constant;
+    if (op == "!")
+        return make_integer(not x.truth(), Value_Type::Int);
+    auto type = x.type == Value_Type::Long ? Value_Type::Long : Value_Type::Int;
+    if (x.is_real()) {
+        if (op == "-")
+            return make_real(-x.real, x.type);
+        if (op == "+")
+            return a;
+        return Lattice::bottom();
+    }
+    if (op == "-")
+        return make_integer(
+            wrap(0 - static_cast<std::uint64_t>(x.integer), type), type);
+    if (op == "+")
+        return make_integer(x.integer, type);
+    if (op == "~")
+        return make_integer(wrap(~static_cast<std::uint64_t>(x.integer), type),
+            type);
+    return Lattice::bottom();
+}
+
+/**
+ * @brief Whether a JMP_E on a constant to a case literal jumps, or none
+ * if the two cannot be compared
+ */
+std::optional<bool> jumps(Constant const& value, Constant const& label)
+{
+    if (value.is_real() or label.is_real())
+        return std::nullopt;
+    return value.integer == label.integer;
+}
+
+constexpr auto empty = Operand_Table::empty;
+
+/**
+ * @brief The propagation over one function in SSA form
+ *
+ * Two work lists, one of the edges found to be taken and one of the
+ * instructions and phis that read a version whose value was lowered.
+ * Each version is lowered at most twice, so each instruction is visited
+ * a bounded number of times, and the whole is linear in the size of the
+ * function.
+ */
+class Propagation
+{
+  public:
+    explicit Propagation(SSA& ssa);
+
+    std::size_t run();
+
+  private:
+    struct Site
+    {
+        Block_Index block;
+        std::size_t index;
+        bool phi;
+    };
+
+    Lattice value(Handle operand) const;
+    Lattice evaluate(Handle operand) const;
+    Lattice evaluate(Quadruple const& quadruple) const;
+
+    void lower(Handle version, Lattice const& value);
+    void take(Block_Index from, Block_Index to);
+    void visit_phi(Block_Index block, std::size_t index);
+    void visit(Block_Index block, std::size_t instruction);
+    void visit_branch(Block_Index block, Quadruple const& tail);
+
+    Handle substitute(Handle operand) const;
+    std::size_t rewrite();
+
+  private:
+    SSA& ssa_;
+    CFG const& cfg_;
+    std::unordered_map<Handle, Lattice> values_{};
+    std::unordered_map<Handle, std::vector<Site>> uses_{};
+    std::vector<bool> executable_{};
+    // whether the edge from each predecessor of a block is taken, in the
+    // order of the block's predecessors
+    std::vector<std::vector<bool>> taken_{};
+    std::vector<std::pair<Block_Index, Block_Index>> edges_{};
+    std::vector<Site> sites_{};
+};
+
+Propagation::Propagation(SSA& ssa)
+    : ssa_(ssa)
+    , cfg_(ssa.cfg())
+{
+    auto size = cfg_.size();
+    executable_.assign(size, false);
+    taken_.resize(size);
+    for (Block_Index block = 0; block < size; block++)
+        taken_[block].assign(cfg_[block].predecessors.size(), false);
+
+    auto const& instructions = ssa_.instructions();
+    for (auto block : cfg_.order()) {
+        auto const& phis = ssa_.phis(block);
+        for (std::size_t i = 0; i < phis.size(); i++)
+            for (auto argument : phis[i].arguments)
+                if (argument != empty)
+                    uses_[argument].push_back(Site{ block, i, true });
+        for (auto i = cfg_[block].begin; i < cfg_[block].end; i++)
+            detail::for_each_read(instructions[i], [&](Handle name) {
+                if (ssa_.variable_of(name) != name)
+                    uses_[name].push_back(Site{ block, i, false });
+            });
+    }
+}
+
+/**
+ * @brief The lattice value of a name or a literal
+ *
+ * A name that is not a version may change where the function cannot see
+ * it, and a name that is its own version 0 holds what it held on entry,
+ * so neither is a constant.
+ */
+Lattice Propagation::value(Handle operand) const
+{
+    if (auto constant = constant_of(operand); constant.has_value())
+        return Lattice::of(*constant);
+    if (ssa_.variable_of(operand) == operand)
+        return Lattice::bottom();
+    auto found = values_.find(operand);
+    return found == values_.end() ? Lattice{} : found->second;
+}
+
+/**
+ * @brief The lattice value of the text of an operand, e.g. "x#2 + _t5#1"
+ */
+Lattice Propagation::evaluate(Handle operand) const
+{
+    auto& table = operand_table();
+    auto const& operand_value = table.value(operand);
+    if (operand_value.is_binary())
+        return fold_binary(operand_value.binary,
+            evaluate(operand_value.lhs),
+            evaluate(operand_value.rhs));
+    if (operand_value.is_literal() or
+        operand_value.shape == Lvalue_Shape::Scalar)
+        return value(operand);
+
+    std::string_view text = table.text(operand);
+    // "CMP x" is the truth of x that a branch reads
+    if (text.starts_with("CMP ")) {
+        auto compared = value(table.intern(text.substr(4)));
+        if (not compared.is_constant())
+            return compared;
+        return make_integer(compared.constant.truth(), Value_Type::Int);
+    }
+    auto op = operand_value.unary;
+    if (op == "-" or op == "+" or op == "~" or op == "!") {
+        if (not text.starts_with(op))
+            return Lattice::bottom();
+        auto rest = text.substr(op.size());
+        while (not rest.empty() and rest.front() == ' ')
+            rest.remove_prefix(1);
+        return fold_unary(op, evaluate(table.intern(rest)));
+    }
+    return Lattice::bottom();
+}
+
+/**
+ * @brief The lattice value of the right-hand side of a MOV
+ *
+ * An increment or decrement in place, e.g. x = ++x, is not folded.
+ */
+Lattice Propagation::evaluate(Quadruple const& quadruple) const
+{
+    if (quadruple.operands[2] != empty)
+        return Lattice::bottom();
+    return evaluate(quadruple.operands[1]);
+}
+
+void Propagation::lower(Handle version, Lattice const& value)
+{
+    auto& current = values_[version];
+    auto lowered = meet(current, value);
+    if (lowered == current)
+        return;
+    current = lowered;
+    auto found = uses_.find(version);
+    if (found != uses_.end())
+        sites_.insert(sites_.end(), found->second.begin(), found->second.end());
+}
+
+void Propagation::take(Block_Index from, Block_Index to)
+{
+    edges_.emplace_back(from, to);
+}
+
+void Propagation::visit_phi(Block_Index block, std::size_t index)
+{
+    auto const& phi = ssa_.phis(block)[index];
+    auto const& taken = taken_[block];
+    Lattice merged{};
+    for (std::size_t edge = 0; edge < phi.arguments.size(); edge++)
+        if (taken[edge] and phi.arguments[edge] != empty)
+            merged = meet(merged, value(phi.arguments[edge]));
+    lower(phi.result, merged);
+}
+
+/**
+ * @brief Take the edges out of a block its last instruction can take
+ */
+void Propagation::visit_branch(Block_Index block, Quadruple const& tail)
+{
+    auto const& b = cfg_[block];
+    auto target = [&]() -> Block_Index {
+        for (auto successor : b.successors) {
+            auto const& head = ssa_.instructions()[cfg_[successor].begin];
+            if (head.op == Instruction::LABEL and
+                head.operands[0] == tail.operands[2])
+                return successor;
+        }
+        return null_block_index;
+    };
+    auto take_one = [&](bool jump) {
+        auto to = jump ? target() : block + 1;
+        if (to != null_block_index and
+            std::ranges::find(b.successors, to) != b.successors.end())
+            take(block, to);
+    };
+
+    if (tail.op == Instruction::IF) {
+        auto predicate = evaluate(tail.operands[0]);
+        if (predicate.is_top())
+            return;
+        if (predicate.is_constant()) {
+            take_one(predicate.constant.truth());
+            return;
+        }
+    } else if (tail.op == Instruction::JMP_E) {
+        auto predicate = evaluate(tail.operands[0]);
+        auto label = constant_of(tail.operands[1]);
+        if (predicate.is_top())
+            return;
+        if (predicate.is_constant() and label.has_value()) {
+            if (auto jump = jumps(predicate.constant, *label);
+                jump.has_value()) {
+                take_one(*jump);
+                return;
+            }
+        }
+    }
+    for (auto successor : b.successors)
+        take(block, successor);
+}
+
+void Propagation::visit(Block_Index block, std::size_t instruction)
+{
+    auto const& quadruple = ssa_.instructions()[instruction];
+    if (auto name = detail::assigned(quadruple);
+        name != empty and ssa_.variable_of(name) != name)
+        lower(name, evaluate(quadruple));
+    if (instruction + 1 == cfg_[block].end)
+        visit_branch(block, quadruple);
+}
+
+/**
+ * @brief Propagate to a fixed point, then write the constants found into
+ * the function and give the number of operands folded
+ */
+std::size_t Propagation::run()
+{
+    executable_[cfg_.entry()] = true;
+    for (std::size_t i = 0; i < ssa_.phis(cfg_.entry()).size(); i++)
+        visit_phi(cfg_.entry(), i);
+    for (auto i = cfg_[cfg_.entry()].begin; i < cfg_[cfg_.entry()].end; i++)
+        visit(cfg_.entry(), i);
+
+    while (not edges_.empty() or not sites_.empty()) {
+        while (not edges_.empty()) {
+            auto [from, to] = edges_.back();
+            edges_.pop_back();
+            auto const& predecessors = cfg_[to].predecessors;
+            auto edge = static_cast<std::size_t>(
+                std::ranges::find(predecessors, from) - predecessors.begin());
+            if (taken_[to][edge])
+                continue;
+            taken_[to][edge] = true;
+            for (std::size_t i = 0; i < ssa_.phis(to).size(); i++)
+                visit_phi(to, i);
+            if (executable_[to])
+                continue;
+            executable_[to] = true;
+            for (auto i = cfg_[to].begin; i < cfg_[to].end; i++)
+                visit(to, i);
+        }
+        while (not sites_.empty()) {
+            auto site = sites_.back();
+            sites_.pop_back();
+            if (not executable_[site.block])
+                continue;
+            if (site.phi)
+                visit_phi(site.block, site.index);
+            else
+                visit(site.block, site.index);
+        }
+    }
+    return rewrite();
+}
+
+/**
+ * @brief The literal of a name that is a constant, or the name
+ *
+ * The name a RET gives back is held with the space after it, e.g. "y ",
+ * as operand_to_string writes an lvalue.
+ */
+Handle Propagation::substitute(Handle operand) const
+{
+    auto& table = operand_table();
+    auto name = operand;
+    if (auto text = table.text(operand); text.ends_with(' '))
+        name = table.intern(text.substr(0, text.size() - 1));
+    if (table.value(name).shape != Lvalue_Shape::Scalar)
+        return operand;
+    auto known = value(name);
+    return known.is_constant() ? known.constant.literal : operand;
+}
+
+/**
+ * @brief Write the constants into the reached blocks
+ *
+ * Only where the ITA already holds a literal: the whole right-hand side
+ * of a MOV, a side of a binary operation, and the operand of a branch or
+ * a return. A name in v[k], *p, or a unary operation that is not folded
+ * as a whole is left as it is.
+ */
+std::size_t Propagation::rewrite()
+{
+    auto& table = operand_table();
+    auto& instructions = ssa_.instructions();
+    std::size_t folded = 0;
+    for (auto block : cfg_.order()) {
+        if (not executable_[block])
+            continue;
+        for (auto i = cfg_[block].begin; i < cfg_[block].end; i++) {
+            auto& quadruple = instructions[i];
+            switch (quadruple.op) {
+                case Instruction::MOV: {
+                    if (quadruple.operands[2] != empty)
+                        break;
+                    auto rhs = quadruple.operands[1];
+                    if (auto known = evaluate(rhs); known.is_constant()) {
+                        if (rhs != known.constant.literal) {
+                            quadruple.operands[1] = known.constant.literal;
+                            folded++;
+                        }
+                        break;
+                    }
+                    auto const& rvalue = table.value(rhs);
+                    if (not rvalue.is_binary())
+                        break;
+                    auto lhs = substitute(rvalue.lhs);
+                    auto rhs_side = substitute(rvalue.rhs);
+                    if (lhs == rvalue.lhs and rhs_side == rvalue.rhs)
+                        break;
+                    std::string text = table.text(lhs);
+                    text.append(" ").append(rvalue.binary).append(" ");
+                    text.append(table.text(rhs_side));
+                    quadruple.operands[1] = table.intern(text);
+                    folded++;
+                    break;
+                }
+                case Instruction::IF:
+                case Instruction::JMP_E:
+                case Instruction::RETURN:
+                    if (auto literal = substitute(quadruple.operands[0]);
+                        literal != quadruple.operands[0]) {
+                        quadruple.operands[0] = literal;
+                        folded++;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    return folded;
+}
+
+} // namespace
+
+/**
+ * @brief Propagate the constants of a function in SSA form into the
+ * instructions that read them, and give the number of operands folded
+ */
+std::size_t propagate_constants(SSA& ssa)
+{
+    return Propagation{ ssa }.run();
+}
+
+/**
+ * @brief Turn each branch of a function on a literal into a GOTO, or drop
+ * it, and drop the blocks no path reaches; give the quadruples removed
+ */
+std::size_t fold_branches(Instructions& function)
+{
+    Instructions folded{ resource_of(function) };
+    for (auto const& quadruple : function) {
+        std::optional<bool> jump{};
+        auto predicate = constant_of(quadruple.operands[0]);
+        if (quadruple.op == Instruction::IF and predicate.has_value())
+            jump = predicate->truth();
+        if (quadruple.op == Instruction::JMP_E and predicate.has_value())
+            if (auto label = constant_of(quadruple.operands[1]);
+                label.has_value())
+                jump = jumps(*predicate, *label);
+        if (not jump.has_value()) {
+            folded.push_back(quadruple);
+            continue;
+        }
+        if (*jump)
+            folded.push_back(
+                Quadruple{ Instruction::GOTO, { quadruple.operands[2] } });
+    }
+    auto removed = function.size() - folded.size();
+    function = std::move(folded);
+    return removed + remove_unreachable_blocks(function);
+}
+
+} // namespace credence::ir
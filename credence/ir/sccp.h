@@ -0,0 +1,67 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/ir/quadruple.h> // for Instructions
+#include <credence/ir/ssa.h>       // for SSA
+#include <cstddef>                 // for size_t
+
+/****************************************************************************
+ *
+ * Sparse conditional constant propagation
+ *
+ * Wegman and Zadeck's propagation over one function in SSA form. Each
+ * version starts unknown, and is lowered to the one constant it holds, or
+ * to not a constant, as the instructions that assign it are reached. A
+ * block is reached only by an edge a branch can take, so a branch on a
+ * constant reaches one arm and the versions of the other are never seen:
+ *
+ *    auto x, y;             x#1 = (1:int:4);          x#1 = (1:int:4);
+ *    x = 1;                 _t5#1 = x#1 > (0:int:4);  _t5#1 = (1:int:4);
+ *    if (x > 0)             IF _t5#1 GOTO _L4;        GOTO _L4;
+ *      y = 2;               y#1 = (3:int:4); ...      _L4:
+ *    else                   _L4:                      y#2 = (2:int:4);
+ *      y = 3;               y#2 = (2:int:4);          ...
+ *    return(y + x);         _t6#1 = y#3 + x#1;        _t6#1 = (3:int:4);
+ *
+ * An operation is evaluated as the backends would at run time: int in 32
+ * bits and long in 64, both wrapping, float and double in their own
+ * precision, and a char, a bool, or a relation as an int. A division by
+ * zero, a shift past the width, or a float whose literal would not print
+ * back to the same value is not folded.
+ *
+ * propagate_constants() writes what it found into the SSA form: the
+ * right-hand side of an assignment that is a constant becomes its literal,
+ * and a constant name read by a binary operation, a branch, or a return
+ * becomes its literal. fold_branches() then takes the ordinary ITA the
+ * form gives back and turns each branch on a literal into a GOTO, or
+ * drops it, and drops the blocks no path reaches any longer.
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+/**
+ * @brief Propagate the constants of a function in SSA form into the
+ * instructions that read them, and give the number of operands folded
+ */
+std::size_t propagate_constants(SSA& ssa);
+
+/**
+ * @brief Turn each branch of a function on a literal into a GOTO, or drop
+ * it, and drop the blocks no path reaches; give the quadruples removed
+ */
+std::size_t fold_branches(Instructions& function);
+
+} // namespace credence::ir
@@ -0,0 +1,786 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/ssa.h>
+
+#include <algorithm>               // for find, find_if, none_of
+#include <cctype>                  // for isalnum, isalpha, isdigit
+#include <credence/arena.h>        // for Arena
+#include <credence/ir/ita.h>       // for make_ita_instructions, emit_to
+#include <credence/ir/optimize.h>  // for optimize
+#include <credence/ir/quadruple.h> // for Operand_Scope
+#include <credence/ir/table.h>     // for Table
+#include <credence/passes.h>       // for Scope
+#include <cstdint>                 // for uint32_t, uint64_t, int64_t
+#include <map>                     // for map
+#include <string>                  // for string, to_string
+#include <string_view>             // for string_view
+#include <utility>                 // for pair, swap
+#include <vector>                  // for vector
+
+namespace credence::ir {
+
+using detail::assigned;
+using detail::for_each_name;
+using detail::is_in_place_update;
+using detail::reads;
+using detail::replace_names;
+
+namespace {
+
+using Handle = Operand_Table::Handle;
+using Copies = std::vector<std::pair<Handle, Handle>>;
+
+constexpr bool is_terminator(Instruction op)
+{
+    return op == Instruction::GOTO or op == Instruction::IF or
+           op == Instruction::JMP_E or op == Instruction::LEAVE;
+}
+
+/**
+ * @brief The copies of one edge in an order that reads each source before
+ * it is assigned, with a temporary to break a cycle, e.g. a swap
+ */
+Copies sequence_copies(Copies pending, std::uint32_t& temporaries)
+{
+    auto& table = operand_table();
+    Copies ordered{};
+    while (not pending.empty()) {
+        auto ready = std::ranges::find_if(pending, [&](auto const& copy) {
+            return std::ranges::none_of(pending, [&](auto const& other) {
+                return other.second == copy.first;
+            });
+        });
+        if (ready != pending.end()) {
+            ordered.push_back(*ready);
+            pending.erase(ready);
+            continue;
+        }
+        auto saved = pending.front().first;
+        auto temporary =
+            table.intern("_t" + std::to_string(++temporaries));
+        ordered.emplace_back(temporary, saved);
+        for (auto& copy : pending)
+            if (copy.second == saved)
+                copy.second = temporary;
+    }
+    return ordered;
+}
+
+using Bits = std::vector<std::uint64_t>;
+
+inline bool test(Bits const& bits, std::uint32_t i)
+{
+    return (bits[i / 64] >> (i % 64)) & 1u;
+}
+
+inline void set(Bits& bits, std::uint32_t i)
+{
+    bits[i / 64] |= std::uint64_t{ 1 } << (i % 64);
+}
+
+} // namespace
+
+/**
+ * @brief The index past a literal that starts at text[i], whose value may
+ * be a string or a character with any text in its quotes
+ */
+std::size_t detail::past_literal(std::string_view text, std::size_t i)
+{
+    char quote = 0;
+    for (i++; i < text.size(); i++) {
+        auto c = text[i];
+        if (quote != 0) {
+            if (c == '\\')
+                i++;
+            else if (c == quote)
+                quote = 0;
+        } else if (c == '"' or c == '\'')
+            quote = c;
+        else if (c == ')')
+            return i + 1;
+    }
+    return i;
+}
+
+/**
+ * @brief Whether operand k, 0 to 2, of an instruction is read by it
+ *
+ * A name on the left of a MOV is assigned and not read, but the k and p
+ * of v[k] and *p on the left are read, to find where to store.
+ */
+bool detail::reads(Quadruple const& quadruple, std::size_t k)
+{
+    switch (quadruple.op) {
+        case Instruction::MOV:
+            return k > 0 or
+                   operand_table().value(quadruple.operands[0]).shape !=
+                       Lvalue_Shape::Scalar;
+        case Instruction::IF:
+        case Instruction::JMP_E:
+        case Instruction::PUSH:
+        case Instruction::RETURN:
+            return k == 0;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief The name an instruction assigns, or empty
+ */
+Handle detail::assigned(Quadruple const& quadruple)
+{
+    if (quadruple.op == Instruction::MOV and
+        operand_table().value(quadruple.operands[0]).shape ==
+            Lvalue_Shape::Scalar)
+        return quadruple.operands[0];
+    return Operand_Table::empty;
+}
+
+/**
+ * @brief Whether an operand is an increment or decrement, e.g. "++ x",
+ * which changes the name in it where it is read
+ *
+ * The temporary of _t5 = ++ x is assigned, but x is changed as well and
+ * by no MOV of its own, so x has no version for it.
+ */
+bool detail::is_in_place_update(Handle operand)
+{
+    auto op = operand_table().value(operand).unary;
+    return op == "++" or op == "--";
+}
+
+/**
+ * @brief Take a function, from its LABEL to its EndFunc, into SSA form
+ */
+SSA::SSA(Instructions const& instructions, std::size_t begin, std::size_t end)
+    : instructions_(instructions.begin() + static_cast<std::ptrdiff_t>(begin),
+          instructions.begin() + static_cast<std::ptrdiff_t>(end),
+          resource_of(instructions))
+{
+    cfg_ = CFG::build(instructions_, 0, instructions_.size());
+    phis_.resize(cfg_.size());
+    variables_ = detail::scalar_names(instructions_);
+    place_phis();
+    rename();
+}
+
+/**
+ * @brief The scalars a function owns, which no instruction can reach but
+ * by name
+ */
+std::unordered_set<Operand_Table::Handle> detail::scalar_names(
+    Instructions const& function)
+{
+    auto& table = operand_table();
+    std::unordered_set<Handle> variables{};
+    std::vector<Handle> reached{};
+
+    // the parameters that are not pointers, from the label, e.g. __f(x,*y)
+    std::string_view label = table.text(function.front().operands[0]);
+    if (auto open = label.find('('); open != std::string_view::npos) {
+        auto parameters = label.substr(open + 1, label.rfind(')') - open - 1);
+        while (not parameters.empty()) {
+            auto comma = parameters.find(',');
+            auto parameter = parameters.substr(0, comma);
+            if (not parameter.empty() and parameter.front() != '*')
+                variables.insert(table.intern(parameter));
+            if (comma == std::string_view::npos)
+                break;
+            parameters.remove_prefix(comma + 1);
+        }
+    }
+
+    for (auto const& quadruple : function) {
+        auto lhs = quadruple.operands[0];
+        if (quadruple.op == Instruction::LOCL and
+            table.value(lhs).shape == Lvalue_Shape::Scalar)
+            variables.insert(lhs);
+        if (quadruple.op == Instruction::MOV and
+            table.kind(lhs) == Operand_Kind::Temporary)
+            variables.insert(lhs);
+        if (quadruple.op == Instruction::GLOBL)
+            reached.push_back(lhs);
+        if (quadruple.op == Instruction::LABEL)
+            continue;
+        // a vector v[k], a pointer *p, or an address "& x" may be read or
+        // changed through another name, and a name in "++ x" is changed
+        // where it is read, so none of them is ever split
+        for (auto operand : quadruple.operands) {
+            std::string_view text = table.text(operand);
+            bool in_place = is_in_place_update(operand);
+            for_each_name(text, [&](std::size_t begin, std::size_t end) {
+                if (in_place or (end < text.size() and text[end] == '[') or
+                    (begin > 0 and text[begin - 1] == '*') or
+                    (begin == 2 and text.starts_with("& ")))
+                    reached.push_back(
+                        table.intern(text.substr(begin, end - begin)));
+            });
+        }
+    }
+    for (auto name : reached)
+        variables.erase(name);
+    return variables;
+}
+
+/**
+ * @brief Place a phi for each name on the dominance frontier of each
+ * block that assigns it
+ *
+ * The frontiers are found by Cooper, Harvey and Kennedy's walk up the
+ * dominator tree from each predecessor of a join, and only a name read in
+ * a block before the block assigns it can need a phi at all.
+ */
+void SSA::place_phis()
+{
+    auto& table = operand_table();
+    auto size = cfg_.size();
+
+    std::vector<std::vector<Block_Index>> frontier(size);
+    for (auto block : cfg_.order()) {
+        auto const& predecessors = cfg_[block].predecessors;
+        if (predecessors.size() < 2)
+            continue;
+        for (auto predecessor : predecessors) {
+            if (not cfg_.reachable(predecessor))
+                continue;
+            for (auto runner = predecessor; runner != cfg_[block].dominator;
+                runner = cfg_[runner].dominator) {
+                auto& blocks = frontier[runner];
+                if (blocks.empty() or blocks.back() != block)
+                    blocks.push_back(block);
+            }
+        }
+    }
+
+    // the names read before they are assigned in some block, in the order
+    // they are first read, and the blocks that assign each name
+    std::vector<Handle> live_across{};
+    std::unordered_set<Handle> seen{};
+    std::unordered_map<Handle, std::vector<Block_Index>> assigned_in{};
+    std::unordered_set<Handle> killed{};
+    for (auto block : cfg_.order()) {
+        killed.clear();
+        for (auto i = cfg_[block].begin; i < cfg_[block].end; i++) {
+            auto const& quadruple = instructions_[i];
+            for (std::size_t k = 0; k < 3; k++) {
+                if (not reads(quadruple, k))
+                    continue;
+                std::string_view text = table.text(quadruple.operands[k]);
+                for_each_name(text, [&](std::size_t begin, std::size_t end) {
+                    auto name = table.intern(text.substr(begin, end - begin));
+                    if (is_variable(name) and not killed.contains(name) and
+                        seen.insert(name).second)
+                        live_across.push_back(name);
+                });
+            }
+            if (auto name = assigned(quadruple); is_variable(name)) {
+                killed.insert(name);
+                auto& blocks = assigned_in[name];
+                if (blocks.empty() or blocks.back() != block)
+                    blocks.push_back(block);
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> placed(size, 0), queued(size, 0);
+    std::uint32_t iteration = 0;
+    std::vector<Block_Index> work{};
+    for (auto name : live_across) {
+        iteration++;
+        work = assigned_in[name];
+        for (auto block : work)
+            queued[block] = iteration;
+        while (not work.empty()) {
+            auto block = work.back();
+            work.pop_back();
+            for (auto join : frontier[block]) {
+                if (placed[join] == iteration)
+                    continue;
+                placed[join] = iteration;
+                phis_[join].push_back(Phi{ name,
+                    name,
+                    std::vector<Handle>(cfg_[join].predecessors.size(),
+                        Operand_Table::empty) });
+                if (queued[join] != iteration) {
+                    queued[join] = iteration;
+                    work.push_back(join);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Number the versions of each name by a walk of the dominator tree
+ *
+ * Each assignment and phi makes a new version, which is the one in scope
+ * in the blocks the block dominates until another is made, and the one a
+ * phi of a successor takes for the edge from the block.
+ */
+void SSA::rename()
+{
+    auto& table = operand_table();
+    auto size = cfg_.size();
+
+    std::vector<std::vector<Block_Index>> children(size);
+    for (auto block : cfg_.order())
+        if (block != cfg_.entry())
+            children[cfg_[block].dominator].push_back(block);
+
+    std::unordered_map<Handle, std::vector<Handle>> scope{};
+    std::unordered_map<Handle, std::uint32_t> count{};
+    auto current = [&](Handle name) {
+        auto found = scope.find(name);
+        return found == scope.end() or found->second.empty()
+                   ? name
+                   : found->second.back();
+    };
+    auto read = [&](Handle operand) {
+        return replace_names(operand, [&](std::string_view text) {
+            auto name = table.intern(text);
+            if (not is_variable(name))
+                return Operand_Table::empty;
+            auto version = current(name);
+            return version == name ? Operand_Table::empty : version;
+        });
+    };
+
+    struct Frame
+    {
+        Block_Index block;
+        std::size_t child{ 0 };
+        // the names the block made a version of, to put out of scope
+        std::vector<Handle> defined{};
+    };
+    auto visit = [&](Frame& frame) {
+        auto define = [&](Handle name) {
+            auto version = table.intern(
+                table.text(name) + "#" + std::to_string(++count[name]));
+            versions_.emplace(version, name);
+            scope[name].push_back(version);
+            frame.defined.push_back(name);
+            return version;
+        };
+        auto const& block = cfg_[frame.block];
+        for (auto& phi : phis_[frame.block])
+            phi.result = define(phi.variable);
+        for (auto i = block.begin; i < block.end; i++) {
+            auto& quadruple = instructions_[i];
+            for (std::size_t k = 0; k < 3; k++)
+                if (reads(quadruple, k))
+                    quadruple.operands[k] = read(quadruple.operands[k]);
+            if (auto name = assigned(quadruple); is_variable(name))
+                quadruple.operands[0] = define(name);
+        }
+        for (auto successor : block.successors) {
+            auto const& predecessors = cfg_[successor].predecessors;
+            auto edge = static_cast<std::size_t>(
+                std::ranges::find(predecessors, frame.block) -
+                predecessors.begin());
+            for (auto& phi : phis_[successor])
+                phi.arguments[edge] = current(phi.variable);
+        }
+    };
+
+    std::vector<Frame> stack{};
+    stack.push_back(Frame{ .block = cfg_.entry() });
+    visit(stack.back());
+    while (not stack.empty()) {
+        auto& frame = stack.back();
+        if (frame.child < children[frame.block].size()) {
+            auto child = children[frame.block][frame.child++];
+            stack.push_back(Frame{ .block = child });
+            visit(stack.back());
+            continue;
+        }
+        for (auto name : frame.defined)
+            scope[name].pop_back();
+        stack.pop_back();
+    }
+}
+
+/**
+ * @brief The function in ordinary ITA, without phis or versions
+ *
+ * The versions are coalesced into classes that share a name: first the
+ * result and arguments of each phi, then the versions of each name with
+ * the name itself, each time unless two of the versions interfere. Two
+ * versions interfere when one is live where the other is assigned, which
+ * in SSA form is only when the assignment of one dominates the other, so
+ * it is a dominance test and a read of the liveness of one block. A class
+ * with a name in it takes that name, and any other a new temporary, and a
+ * phi whose argument and result are in different classes is a copy on the
+ * edge of the argument.
+ */
+Instructions SSA::destruct() const
+{
+    auto& table = operand_table();
+    auto const& blocks = cfg_.blocks();
+    auto size = cfg_.size();
+    constexpr auto empty = Operand_Table::empty;
+    constexpr auto none = 0xFFFFFFFFu;
+
+    // each version, and each name as its version 0, by a dense number
+    std::vector<Handle> values{};
+    std::unordered_map<Handle, std::uint32_t> number{};
+    // where each is assigned, a name on entry to the function and a phi
+    // at the top of its block, before the first instruction
+    std::vector<std::pair<Block_Index, std::int64_t>> defined_at{};
+    std::vector<std::vector<std::pair<Block_Index, std::size_t>>> uses{};
+    auto value_of = [&](Handle operand) {
+        auto name = variable_of(operand);
+        if (name == operand and not is_variable(operand))
+            return none;
+        for (auto value : { name, operand }) {
+            if (number.contains(value))
+                continue;
+            number.emplace(value, static_cast<std::uint32_t>(values.size()));
+            values.push_back(value);
+            defined_at.emplace_back(cfg_.entry(), -2);
+            uses.emplace_back();
+        }
+        return number[operand];
+    };
+    auto for_each_value = [&](Handle operand, auto&& f) {
+        std::string_view text = table.text(operand);
+        for_each_name(text, [&](std::size_t begin, std::size_t end) {
+            auto value =
+                value_of(table.intern(text.substr(begin, end - begin)));
+            if (value != none)
+                f(value);
+        });
+    };
+
+    std::vector<Bits> used(size), killed(size), phi_out(size);
+    auto const& order = cfg_.order();
+    for (auto block : order) {
+        for (auto const& phi : phis_[block]) {
+            defined_at[value_of(phi.result)] = { block, -1 };
+            for (auto argument : phi.arguments)
+                if (argument != empty)
+                    value_of(argument);
+        }
+        for (auto i = blocks[block].begin; i < blocks[block].end; i++) {
+            auto const& quadruple = instructions_[i];
+            for (std::size_t k = 0; k < 3; k++)
+                if (reads(quadruple, k))
+                    for_each_value(quadruple.operands[k], [&](auto value) {
+                        uses[value].emplace_back(block, i);
+                    });
+            if (auto name = assigned(quadruple); name != empty) {
+                if (auto value = value_of(name); value != none)
+                    defined_at[value] = { block, static_cast<std::int64_t>(i) };
+            }
+        }
+    }
+
+    // the liveness of each value at the edges of each block, where the
+    // argument of a phi is read at the end of its predecessor
+    auto words = (values.size() + 63) / 64;
+    for (auto block : order) {
+        used[block].assign(words, 0);
+        killed[block].assign(words, 0);
+        phi_out[block].assign(words, 0);
+    }
+    for (auto block : order) {
+        for (auto const& phi : phis_[block]) {
+            set(killed[block], number[phi.result]);
+            auto const& predecessors = blocks[block].predecessors;
+            for (std::size_t edge = 0; edge < predecessors.size(); edge++)
+                if (phi.arguments[edge] != empty)
+                    set(phi_out[predecessors[edge]],
+                        number[phi.arguments[edge]]);
+        }
+        for (auto i = blocks[block].begin; i < blocks[block].end; i++) {
+            auto const& quadruple = instructions_[i];
+            for (std::size_t k = 0; k < 3; k++)
+                if (reads(quadruple, k))
+                    for_each_value(quadruple.operands[k], [&](auto value) {
+                        if (not test(killed[block], value))
+                            set(used[block], value);
+                    });
+            if (auto name = assigned(quadruple); name != empty)
+                if (auto found = number.find(name); found != number.end())
+                    set(killed[block], found->second);
+        }
+    }
+    std::vector<Bits> live_in(size, Bits(words, 0)),
+        live_out(size, Bits(words, 0));
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (auto block = order.rbegin(); block != order.rend(); block++) {
+            auto out = phi_out[*block];
+            for (auto successor : blocks[*block].successors)
+                for (std::size_t w = 0; w < words; w++)
+                    out[w] |= live_in[successor][w];
+            auto in = used[*block];
+            for (std::size_t w = 0; w < words; w++)
+                in[w] |= out[w] & ~killed[*block][w];
+            if (in != live_in[*block] or out != live_out[*block]) {
+                live_in[*block] = std::move(in);
+                live_out[*block] = std::move(out);
+                changed = true;
+            }
+        }
+    }
+
+    auto dominates = [&](std::uint32_t a, std::uint32_t b) {
+        auto [a_block, a_index] = defined_at[a];
+        auto [b_block, b_index] = defined_at[b];
+        return a_block == b_block ? a_index <= b_index
+                                  : cfg_.dominates(a_block, b_block);
+    };
+    // whether a is live just after b is assigned
+    auto live_after = [&](std::uint32_t a, std::uint32_t b) {
+        auto [block, index] = defined_at[b];
+        if (test(live_out[block], a))
+            return true;
+        return std::ranges::any_of(uses[a], [&](auto const& use) {
+            return use.first == block and
+                   static_cast<std::int64_t>(use.second) > index;
+        });
+    };
+    auto interfere = [&](std::uint32_t a, std::uint32_t b) {
+        // two phis of a block, or two names on entry, are assigned at once
+        if (defined_at[a] == defined_at[b])
+            return true;
+        if (dominates(a, b))
+            return live_after(a, b);
+        if (dominates(b, a))
+            return live_after(b, a);
+        return false;
+    };
+
+    // the classes of values that share a name, by union and find
+    std::vector<std::uint32_t> parent(values.size());
+    std::vector<std::vector<std::uint32_t>> members(values.size());
+    std::vector<Handle> named(values.size(), empty);
+    for (std::uint32_t value = 0; value < values.size(); value++) {
+        parent[value] = value;
+        members[value] = { value };
+        if (variable_of(values[value]) == values[value])
+            named[value] = values[value];
+    }
+    auto find = [&](std::uint32_t value) {
+        while (parent[value] != value)
+            value = parent[value] = parent[parent[value]];
+        return value;
+    };
+    auto coalesce = [&](std::uint32_t a, std::uint32_t b) {
+        auto x = find(a), y = find(b);
+        if (x == y or (named[x] != empty and named[y] != empty))
+            return;
+        for (auto m : members[x])
+            for (auto n : members[y])
+                if (interfere(m, n))
+                    return;
+        if (members[x].size() < members[y].size())
+            std::swap(x, y);
+        parent[y] = x;
+        members[x].insert(
+            members[x].end(), members[y].begin(), members[y].end());
+        members[y].clear();
+        if (named[x] == empty)
+            named[x] = named[y];
+    };
+    for (auto block : order)
+        for (auto const& phi : phis_[block])
+            for (auto argument : phi.arguments)
+                if (argument != empty)
+                    coalesce(number[phi.result], number[argument]);
+    for (std::uint32_t value = 0; value < values.size(); value++)
+        coalesce(number[variable_of(values[value])], value);
+
+    auto temporaries = last_number(instructions_, Operand_Kind::Temporary);
+    std::vector<Handle> name_of(values.size(), empty);
+    for (std::uint32_t value = 0; value < values.size(); value++) {
+        auto root = find(value);
+        if (named[root] == empty)
+            named[root] = table.intern("_t" + std::to_string(++temporaries));
+        name_of[value] = named[root];
+    }
+
+    std::unordered_map<Handle, Handle> renamed{};
+    auto rename = [&](Handle operand) {
+        if (auto found = renamed.find(operand); found != renamed.end())
+            return found->second;
+        auto name = replace_names(operand, [&](std::string_view text) {
+            auto found = number.find(table.intern(text));
+            return found == number.end() ? empty : name_of[found->second];
+        });
+        renamed.emplace(operand, name);
+        return name;
+    };
+
+    std::map<std::pair<Block_Index, Block_Index>, Copies> copies{};
+    for (auto block : order) {
+        auto const& predecessors = blocks[block].predecessors;
+        for (auto const& phi : phis_[block]) {
+            for (std::size_t edge = 0; edge < predecessors.size(); edge++) {
+                if (phi.arguments[edge] == empty)
+                    continue;
+                auto to = rename(phi.result);
+                auto from = rename(phi.arguments[edge]);
+                if (to != from)
+                    copies[{ predecessors[edge], block }].emplace_back(
+                        to, from);
+            }
+        }
+    }
+
+    Instructions function{ resource_of(instructions_) };
+    // the copies of the taken edge of a branch, each in a block of its
+    // own that jumps on to where the branch went, after the last block
+    Instructions edges{ resource_of(instructions_) };
+    auto labels = last_number(instructions_, Operand_Kind::Label);
+    auto insert_copies = [&](Instructions& to,
+                             Block_Index from,
+                             Block_Index into) {
+        auto found = copies.find({ from, into });
+        if (found == copies.end())
+            return;
+        for (auto [lhs, rhs] : sequence_copies(found->second, temporaries))
+            to.push_back(Quadruple{ Instruction::MOV, { lhs, rhs, empty } });
+    };
+
+    for (Block_Index block = 0; block < size; block++) {
+        auto const& b = blocks[block];
+        if (block == cfg_.exit())
+            function.insert(function.end(), edges.begin(), edges.end());
+        auto tail = instructions_[b.end - 1];
+        auto last = is_terminator(tail.op) ? b.end - 1 : b.end;
+        for (auto i = b.begin; i < last; i++) {
+            auto quadruple = instructions_[i];
+            // an instruction a pass dropped in the form
+            if (quadruple.op == Instruction::NOOP)
+                continue;
+            for (auto& operand : quadruple.operands)
+                operand = rename(operand);
+            // a copy between versions that now share a name
+            if (quadruple.op == Instruction::MOV and
+                quadruple.operands[0] == quadruple.operands[1] and
+                quadruple.operands[2] == empty and
+                instructions_[i].operands[0] != instructions_[i].operands[1])
+                continue;
+            function.push_back(quadruple);
+        }
+        auto fallthrough = [&] {
+            if (std::ranges::find(b.successors, block + 1) !=
+                b.successors.end())
+                insert_copies(function, block, block + 1);
+        };
+        if (last == b.end) {
+            fallthrough();
+            continue;
+        }
+        for (auto& operand : tail.operands)
+            operand = rename(operand);
+        if (tail.op == Instruction::GOTO) {
+            for (auto successor : b.successors)
+                insert_copies(function, block, successor);
+        } else if (tail.op == Instruction::IF or
+                   tail.op == Instruction::JMP_E) {
+            for (auto successor : b.successors) {
+                auto const& head = instructions_[blocks[successor].begin];
+                if (head.op != Instruction::LABEL or
+                    head.operands[0] != tail.operands[2] or
+                    not copies.contains({ block, successor }))
+                    continue;
+                auto label = table.intern("_L" + std::to_string(++labels));
+                edges.push_back(Quadruple{ Instruction::LABEL, { label } });
+                insert_copies(edges, block, successor);
+                edges.push_back(
+                    Quadruple{ Instruction::GOTO, { tail.operands[2] } });
+                tail.operands[2] = label;
+            }
+        }
+        function.push_back(tail);
+        if (tail.op == Instruction::IF or tail.op == Instruction::JMP_E)
+            fallthrough();
+    }
+    return function;
+}
+
+/**
+ * @brief Print a function in SSA form, each phi at the top of its block
+ *
+ *    _L2:
+ *        x#2 = PHI(x#1, x#3);
+ *        _t5#1 = x#2 < (5:int:4);
+ *
+ * An argument of a predecessor that cannot be reached is a "-".
+ */
+void dump(std::ostream& os, SSA const& ssa)
+{
+    auto& table = operand_table();
+    auto const& cfg = ssa.cfg();
+    for (Block_Index block = 0; block < cfg.size(); block++) {
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++) {
+            auto const& quadruple = ssa.instructions()[i];
+            detail::emit_to(os, quadruple, true);
+            if (i != cfg[block].begin)
+                continue;
+            for (auto const& phi : ssa.phis(block)) {
+                os << "    " << table.text(phi.result) << " = PHI(";
+                for (std::size_t edge = 0; edge < phi.arguments.size();
+                    edge++) {
+                    if (edge > 0)
+                        os << ", ";
+                    os << (phi.arguments[edge] == Operand_Table::empty
+                               ? std::string{ "-" }
+                               : table.text(phi.arguments[edge]));
+                }
+                os << ");" << std::endl;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Build the ITA and the table of a unit and print each function in
+ * SSA form, as -t ssa does
+ */
+void emit_ssa(std::ostream& os,
+    Symbols const& symbols,
+    frontend::hir::Unit const& unit)
+{
+    Arena arena{};
+    Operand_Scope operands{};
+
+    passes::Scope ita_pass{ "ita" };
+    auto [globals, instructions] =
+        ir::make_ita_instructions(unit, symbols, arena.resource());
+    ita_pass.count("quadruples", instructions.size());
+    ita_pass.finish();
+
+    ir::optimize(instructions);
+
+    passes::Scope table_pass{ "table" };
+    auto table = ir::Table{ symbols, instructions, globals };
+    table.build_from_ir_instructions();
+    table_pass.count("quadruples", table.get_table_instructions()->size());
+    table_pass.finish();
+
+    passes::Scope emit_pass{ "emit" };
+    std::size_t functions = 0;
+    for (auto [begin, end] : function_ranges(*table.get_table_instructions())) {
+        SSA ssa{ *table.get_table_instructions(), begin, end };
+        dump(os, ssa);
+        functions++;
+    }
+    emit_pass.count("functions", functions);
+}
+
+} // namespace credence::ir
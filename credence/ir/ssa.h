@@ -0,0 +1,278 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/frontend/hir/hir.h> // for Unit
+#include <credence/ir/cfg.h>           // for CFG, Block_Index
+#include <credence/ir/quadruple.h>     // for Instructions, Operand_Table
+#include <credence/ir/symbols.h>       // for Symbols
+#include <cctype>                      // for isalnum, isalpha, isdigit
+#include <cstddef>                     // for size_t
+#include <ostream>                     // for ostream
+#include <string>                      // for string
+#include <string_view>                 // for string_view
+#include <unordered_map>               // for unordered_map
+#include <unordered_set>               // for unordered_set
+#include <vector>                      // for vector
+
+/****************************************************************************
+ *
+ * Static single assignment form
+ *
+ * One function of the ITA with each scalar it assigns split into a version
+ * per assignment, so every name has one definition and a pass reads what
+ * a use means from the instruction that defines it and not by a walk over
+ * every path that reaches it. Where the versions of a name from different
+ * paths meet, a phi at the top of the block picks the one of the edge the
+ * block was entered by:
+ *
+ *    main() {            __main():                __main():
+ *      auto x;            LOCL x;                  LOCL x;
+ *      x = 1;             x = (1:int:4);           x#1 = (1:int:4);
+ *      while (x < 5)     _L2:                     _L2:
+ *        x = x + 1;                                x#2 = PHI(x#1, x#3);
+ *    }                    _t5 = x < (5:int:4);     _t5#1 = x#2 < (5:int:4);
+ *                         ...                      ...
+ *                         x = _t6;                 x#3 = _t6#1;
+ *
+ * A version is the name and a number, e.g. x#2 or _t5#1, and is an operand
+ * of the same kind as its name. The name itself is version 0, the value it
+ * holds on entry, e.g. a parameter or a local not yet assigned. A name may
+ * have a '.' in it, e.g. k.ll, but never a '#', so a version is not read
+ * as another name.
+ *
+ * The names that are split are the scalars the function owns, which no
+ * instruction can reach but by name:
+ *
+ *    LOCL x         a local scalar
+ *    __f(x,y)       a parameter that is not a pointer
+ *    _t5            a temporary
+ *
+ * and of those not one that is a vector, is dereferenced, or has its
+ * address taken, as a store through a pointer may change it unseen, nor
+ * one changed in place by an increment or decrement, e.g. _t5 = ++ x, as
+ * the MOV assigns _t5 and not x. Globals, pointers, vectors, and the _p
+ * temporaries of a call keep the name they have.
+ *
+ * Phis are placed on the dominance frontiers of the blocks that assign a
+ * name, for the names that are read in a block other than the one that
+ * assigned them, and the versions are numbered by a walk of the dominator
+ * tree. A block that cannot be reached keeps the names it had.
+ *
+ * destruct() is the way back: the versions whose lifetimes do not overlap
+ * share a name, the name they came from where it is free, and a phi whose
+ * result and arguments could not share one is a copy at the end of each
+ * predecessor, or on an edge of its own where the predecessor branches.
+ * So a function taken into the form and back with nothing in between is
+ * the instructions it was.
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+namespace detail {
+
+/**
+ * @brief The index past a literal that starts at text[i], whose value may
+ * be a string or a character with any text in its quotes
+ */
+std::size_t past_literal(std::string_view text, std::size_t i);
+
+/**
+ * @brief Call f with the [begin, end) of each name in the text of an
+ * operand, and the version of the name with it, e.g. x#2 in "x#2 + _t5#1"
+ */
+template<typename F>
+void for_each_name(std::string_view text, F&& f)
+{
+    auto is_digit = [](char c) {
+        return std::isdigit(static_cast<unsigned char>(c));
+    };
+    std::size_t i = 0;
+    while (i < text.size()) {
+        auto c = static_cast<unsigned char>(text[i]);
+        if (c == '(') {
+            i = past_literal(text, i);
+            continue;
+        }
+        if (not std::isalpha(c) and c != '_') {
+            i++;
+            continue;
+        }
+        auto begin = i;
+        while (i < text.size() and
+               (std::isalnum(static_cast<unsigned char>(text[i])) or
+                   text[i] == '_' or text[i] == '.'))
+            i++;
+        if (i + 1 < text.size() and text[i] == '#' and is_digit(text[i + 1]))
+            for (i++; i < text.size() and is_digit(text[i]); i++)
+                ;
+        f(begin, i);
+    }
+}
+
+/**
+ * @brief Whether operand k, 0 to 2, of an instruction is read by it
+ */
+bool reads(Quadruple const& quadruple, std::size_t k);
+
+/**
+ * @brief The name an instruction assigns, or empty
+ */
+Operand_Table::Handle assigned(Quadruple const& quadruple);
+
+/**
+ * @brief Whether an operand is an increment or decrement, e.g. "++ x",
+ * which changes the name in it where it is read
+ */
+bool is_in_place_update(Operand_Table::Handle operand);
+
+/**
+ * @brief Call f with the handle of each name an instruction reads
+ */
+template<typename F>
+void for_each_read(Quadruple const& quadruple, F&& f)
+{
+    auto& table = operand_table();
+    for (std::size_t k = 0; k < 3; k++) {
+        if (not reads(quadruple, k))
+            continue;
+        std::string_view text = table.text(quadruple.operands[k]);
+        for_each_name(text, [&](std::size_t begin, std::size_t end) {
+            f(table.intern(text.substr(begin, end - begin)));
+        });
+    }
+}
+
+/**
+ * @brief The scalars a function owns, from its LABEL to its EndFunc, that
+ * no instruction can reach but by name: the names SSA form splits
+ */
+std::unordered_set<Operand_Table::Handle> scalar_names(
+    Instructions const& function);
+
+/**
+ * @brief An operand with each name in it replaced by the operand f gives
+ * for the name, or the operand itself where f gives empty for all of them
+ */
+template<typename F>
+Operand_Table::Handle replace_names(Operand_Table::Handle operand, F&& f)
+{
+    auto& table = operand_table();
+    std::string_view text = table.text(operand);
+    std::string replaced{};
+    std::size_t last = 0;
+    for_each_name(text, [&](std::size_t begin, std::size_t end) {
+        auto replacement = f(text.substr(begin, end - begin));
+        if (replacement == Operand_Table::empty)
+            return;
+        replaced.append(text.substr(last, begin - last));
+        replaced.append(table.text(replacement));
+        last = end;
+    });
+    if (last == 0)
+        return operand;
+    replaced.append(text.substr(last));
+    return table.intern(replaced);
+}
+
+} // namespace detail
+
+struct Phi
+{
+    using Handle = Operand_Table::Handle;
+
+    // the name the phi merges versions of
+    Handle variable{ Operand_Table::empty };
+    Handle result{ Operand_Table::empty };
+    // one version per predecessor of the block, in the order of the
+    // block's predecessors, and empty for a predecessor never reached
+    std::vector<Handle> arguments{};
+};
+
+class SSA
+{
+  public:
+    using Handle = Operand_Table::Handle;
+
+    /**
+     * @brief Take a function, from its LABEL to its EndFunc, into SSA form
+     */
+    SSA(Instructions const& instructions, std::size_t begin, std::size_t end);
+
+    // the graph holds the address of the instructions it was built over
+    SSA(SSA const&) = delete;
+    SSA& operator=(SSA const&) = delete;
+
+    /**
+     * @brief The instructions of the function, with versioned operands
+     */
+    Instructions const& instructions() const { return instructions_; }
+    Instructions& instructions() { return instructions_; }
+
+    CFG const& cfg() const { return cfg_; }
+
+    std::vector<Phi> const& phis(Block_Index block) const
+    {
+        return phis_[block];
+    }
+    std::vector<Phi>& phis(Block_Index block) { return phis_[block]; }
+
+    /**
+     * @brief Whether a name was split into versions
+     */
+    bool is_variable(Handle name) const { return variables_.contains(name); }
+
+    /**
+     * @brief The name a version is of, or the operand itself if it is not
+     * a version
+     */
+    Handle variable_of(Handle operand) const
+    {
+        auto found = versions_.find(operand);
+        return found == versions_.end() ? operand : found->second;
+    }
+
+    /**
+     * @brief The function in ordinary ITA, without phis or versions
+     */
+    Instructions destruct() const;
+
+  private:
+    void place_phis();
+    void rename();
+
+  private:
+    Instructions instructions_;
+    CFG cfg_{};
+    std::vector<std::vector<Phi>> phis_{};
+    std::unordered_set<Handle> variables_{};
+    // each version, to the name it is a version of
+    std::unordered_map<Handle, Handle> versions_{};
+};
+
+/**
+ * @brief Print a function in SSA form, each phi at the top of its block
+ */
+void dump(std::ostream& os, SSA const& ssa);
+
+/**
+ * @brief Build the ITA and the table of a unit and print each function in
+ * SSA form, as -t ssa does
+ */
+void emit_ssa(std::ostream& os,
+    Symbols const& symbols,
+    frontend::hir::Unit const& unit);
+
+} // namespace credence::ir
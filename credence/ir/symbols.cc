@@ -13,34 +13,19 @@
 
 #include <credence/ir/symbols.h>
 
-#include <string> // for string
+#include <easyjson.h>  // for JSON, object
+#include <functional>  // for hash
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <utility>     // for move
 
 /****************************************************************************
  *
  * Hoisted symbol table
  *
- * The name to shape map that the object table and the backends read while
- * placing storage. It is a boundary format and not a working structure, and
- * its entire contract is four operations:
- *
- *    dump_keys()   every declared name
- *    ["type"]      what kind of storage the name needs
- *    ["size"]      how many elements a vector holds
- *    has_key()     whether a name was declared at all
- *
- * Keeping it in this form lets the standard library add its own names to it
- * without reaching into the string arena of the frontend, and a change to
- * the passes above shows up in code generation as a difference in
- * instructions and not a difference in format.
- *
- * The shapes a name may take:
- *
- *    function_definition   a function defined in this unit
- *    vector_definition     a vector defined at file scope, with a size
- *    vector_lvalue         a vector declared inside a function, with a size
- *    indirect_lvalue       a pointer
- *    lvalue                a scalar
- *    label                 a goto target
+ * A flat array of symbols and an open addressing index from the hash of a
+ * name to its place in the array. See symbols.h for what the shapes mean
+ * and how the standard library is laid under the table of a unit.
  *
  *****************************************************************************/
 
@@ -57,23 +42,24 @@ namespace {
  * declared inside a function, since the object table tells the two apart by
  * where it meets them and not by what they are called.
  */
-std::string_view shape_of(hir::Symbol const& symbol)
+Shape shape_of(hir::Symbol const& symbol)
 {
     switch (symbol.storage) {
         case hir::Storage::Function:
-            return "function_definition";
+            return Shape::Function_Definition;
         case hir::Storage::Vector:
-            return symbol.depth == 0 ? "vector_definition" : "vector_lvalue";
+            return symbol.depth == 0 ? Shape::Vector_Definition
+                                     : Shape::Vector_Lvalue;
         case hir::Storage::Label:
-            return "label";
+            return Shape::Label;
         default:
             break;
     }
 
     if (symbol.indirect)
-        return "indirect_lvalue";
+        return Shape::Indirect_Lvalue;
 
-    return "lvalue";
+    return Shape::Lvalue;
 }
 
 /**
@@ -101,14 +87,72 @@ bool ends_with_return(hir::Unit const& unit, hir::Node_Index definition)
     return unit.nodes[last].type == hir::Type::Return;
 }
 
+inline std::uint64_t hash_of(std::string_view name)
+{
+    return hir::mix_hash(std::hash<std::string_view>{}(name));
+}
+
 } // namespace
 
-util::AST_Node hoisted_symbols(hir::Unit const& unit)
+std::string_view shape_name(Shape shape)
 {
-    auto table = util::AST::object();
+    switch (shape) {
+        case Shape::Function_Definition:
+            return "function_definition";
+        case Shape::Vector_Definition:
+            return "vector_definition";
+        case Shape::Vector_Lvalue:
+            return "vector_lvalue";
+        case Shape::Indirect_Lvalue:
+            return "indirect_lvalue";
+        case Shape::Label:
+            return "label";
+        default:
+            return "lvalue";
+    }
+}
+
+Symbol_Index Symbols::add(Symbol symbol)
+{
+    auto hash = hash_of(symbol.name);
+    auto found = index_.find(hash, [&](std::uint32_t index) {
+        return symbols_[index].name == symbol.name;
+    });
+    if (found != hir::Handle_Index::empty_slot)
+        return found;
+
+    auto index = static_cast<Symbol_Index>(symbols_.size());
+    symbols_.emplace_back(std::move(symbol));
+    index_.insert(hash, index, [&](std::uint32_t i) {
+        return hash_of(symbols_[i].name);
+    });
+    return index;
+}
+
+Symbol_Index Symbols::index_of(std::string_view name) const
+{
+    auto found = index_.find(hash_of(name), [&](std::uint32_t index) {
+        return symbols_[index].name == name;
+    });
+    return found == hir::Handle_Index::empty_slot ? null_symbol_index
+                                                    : found;
+}
+
+Symbol const* Symbols::find(std::string_view name) const
+{
+    if (layer_ != nullptr)
+        if (auto const* symbol = layer_->find(name))
+            return symbol;
+    auto index = index_of(name);
+    return index == null_symbol_index ? nullptr : &symbols_[index];
+}
+
+Symbols hoisted_symbols(hir::Unit const& unit)
+{
+    Symbols table{};
 
     for (auto const& symbol : unit.symbol_table.symbols()) {
-        auto name = std::string{ unit.string(symbol.name) };
+        auto name = unit.string(symbol.name);
         if (name.empty())
             continue;
 
@@ -116,19 +160,10 @@ util::AST_Node hoisted_symbols(hir::Unit const& unit)
         if (symbol.assumed)
             continue;
 
-        auto shape = shape_of(symbol);
-
-        // a name declared in more than one scope keeps the first shape it
-        // was given, which is the one the object table placed storage for
-        if (table.has_key(name))
-            continue;
-
-        table[name] = util::AST::object();
-        auto& entry = table[name];
-        entry["type"] = std::string{ shape };
-
-        if (symbol.storage == hir::Storage::Vector)
-            entry["size"] = static_cast<long>(symbol.count);
+        table.add(Symbol{ .name = std::string{ name },
+            .shape = shape_of(symbol),
+            .size = symbol.storage == hir::Storage::Vector ? symbol.count
+                                                           : 0 });
     }
 
     // a call reads this to know whether the name leaves a value behind
@@ -138,13 +173,29 @@ util::AST_Node hoisted_symbols(hir::Unit const& unit)
         if (!ends_with_return(unit, definition))
             continue;
         auto span = unit.nodes[definition].data.span;
-        auto name = std::string{ unit.symbol_name(
-            unit.nodes[unit.extra[span.start]].data.symbol) };
-        if (table.has_key(name))
-            table[name]["void"] = false;
+        auto index = table.index_of(unit.symbol_name(
+            unit.nodes[unit.extra[span.start]].data.symbol));
+        if (index != null_symbol_index)
+            table[index].returns = true;
     }
 
     return table;
 }
 
+util::AST_Node to_json(Symbols const& symbols)
+{
+    auto table = util::AST::object();
+    symbols.for_each([&](Symbol const& symbol) {
+        table[symbol.name] = util::AST::object();
+        auto& entry = table[symbol.name];
+        entry["type"] = std::string{ shape_name(symbol.shape) };
+        if (symbol.shape == Shape::Vector_Definition or
+            symbol.shape == Shape::Vector_Lvalue)
+            entry["size"] = static_cast<long>(symbol.size);
+        if (symbol.returns)
+            entry["void"] = false;
+    });
+    return table;
+}
+
 } // namespace credence::ir
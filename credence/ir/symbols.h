@@ -13,27 +13,28 @@
 
 #pragma once
 
-#include <credence/frontend/hir/hir.h> // for Unit
-#include <credence/util.h>             // for AST_Node
-#include <easyjson.h>                  // for JSON, object
+#include <credence/frontend/hir/hir.h>   // for Unit
+#include <credence/frontend/hir/probe.h> // for Handle_Index
+#include <credence/util.h>               // for AST_Node
+#include <cstddef>                       // for size_t
+#include <cstdint>                       // for uint32_t, uint8_t
+#include <string>                        // for string
+#include <string_view>                   // for string_view
+#include <vector>                        // for vector
 
 /****************************************************************************
  *
  * Hoisted symbol table
  *
- * The name to shape map that the object table and the backends read while
- * placing storage. It is a boundary format and not a working structure, and
- * its entire contract is four operations:
+ * The name to shape table that the ITA, the object table, and the backends
+ * read while placing storage and resolving calls. Each name is a Symbol in
+ * a flat array, addressed by its Symbol_Index, and found by name through
+ * an open addressing hash index, so a query is one probe and not a walk of
+ * string keyed objects:
  *
- *    dump_keys()   every declared name
- *    ["type"]      what kind of storage the name needs
- *    ["size"]      how many elements a vector holds
- *    has_key()     whether a name was declared at all
- *
- * Keeping it in this form lets the standard library add its own names to it
- * without reaching into the string arena of the frontend, and a change to
- * the passes above shows up in code generation as a difference in
- * instructions and not a difference in format.
+ *    find(name)       the symbol a name was declared as, or nullptr
+ *    contains(name)   whether a name was declared at all
+ *    for_each(f)      every declared name, in the order it was added
  *
  * The shapes a name may take:
  *
@@ -44,13 +45,126 @@
  *    lvalue                a scalar
  *    label                 a goto target
  *
+ * The standard library and the syscalls of a platform are a table of their
+ * own, built once per platform and shared read-only by every unit compiled
+ * for it. The table of a unit is laid over it, and the names of the layer
+ * are found first, as the standard library has always had the last word
+ * on the names it defines:
+ *
+ *    layer   printf, putchar, write, exit, ...   (shared, read-only)
+ *    unit    main, x, v, mess, ...               (appended per unit)
+ *
+ * to_json writes the table in the form -s prints, and is not read back.
+ *
  *****************************************************************************/
 
 namespace credence::ir {
 
+enum class Shape : std::uint8_t
+{
+    Function_Definition,
+    Vector_Definition,
+    Vector_Lvalue,
+    Indirect_Lvalue,
+    Lvalue,
+    Label
+};
+
+/**
+ * @brief The name of a shape, e.g. "vector_lvalue", as -s prints it
+ */
+std::string_view shape_name(Shape shape);
+
+using Symbol_Index = std::uint32_t;
+
+constexpr Symbol_Index null_symbol_index = 0xFFFFFFFFu;
+
+struct Symbol
+{
+    std::string name{};
+    Shape shape{ Shape::Lvalue };
+
+    // the declared length of a vector, and zero elsewhere
+    std::uint32_t size{ 0 };
+
+    // a function of this unit whose body ends with a return, so a call
+    // to it leaves a value behind
+    bool returns{ false };
+};
+
+class Symbols
+{
+  public:
+    Symbols() = default;
+
+    /**
+     * @brief Add a symbol, unless its name is already in this table
+     *
+     * A name declared in more than one scope keeps the first shape it was
+     * given, which is the one the object table placed storage for.
+     */
+    Symbol_Index add(Symbol symbol);
+
+    /**
+     * @brief The index of a name in this table, not the layer below it
+     */
+    Symbol_Index index_of(std::string_view name) const;
+
+    /**
+     * @brief The symbol of a name, in the layer first, or nullptr
+     */
+    Symbol const* find(std::string_view name) const;
+
+    bool contains(std::string_view name) const
+    {
+        return find(name) != nullptr;
+    }
+
+    Symbol const& operator[](Symbol_Index index) const
+    {
+        return symbols_[index];
+    }
+    Symbol& operator[](Symbol_Index index) { return symbols_[index]; }
+
+    /**
+     * @brief Lay this table over a read-only one, e.g. the standard library
+     */
+    void layer_over(Symbols const& layer) { layer_ = &layer; }
+    Symbols const* layer() const { return layer_; }
+
+    /**
+     * @brief Each symbol a name finds, the layer's first
+     */
+    template<typename F>
+    void for_each(F&& f) const
+    {
+        if (layer_ != nullptr)
+            layer_->for_each(f);
+        for (auto const& symbol : symbols_)
+            if (layer_ == nullptr or not layer_->contains(symbol.name))
+                f(symbol);
+    }
+
+    /**
+     * @brief The number of symbols in this table, not the layer below it
+     */
+    std::size_t size() const { return symbols_.size(); }
+    bool empty() const { return symbols_.empty() and layer_ == nullptr; }
+
+  private:
+    std::vector<Symbol> symbols_{};
+    frontend::hir::Handle_Index index_{};
+    Symbols const* layer_{ nullptr };
+};
+
 /**
  * @brief Build the hoisted symbol table of a lowered unit
  */
-util::AST_Node hoisted_symbols(frontend::hir::Unit const& unit);
+Symbols hoisted_symbols(frontend::hir::Unit const& unit);
+
+/**
+ * @brief The table as the JSON object -s prints
+ */
+util::AST_Node to_json(Symbols const& symbols);
 
 } // namespace credence::ir
@@ -13,29 +13,33 @@
 
 #include <credence/ir/table.h>
 
-#include <array>                 // for array
-#include <credence/error.h>      // for credence_assert
-#include <credence/ir/checker.h> // for Type_Checker
-#include <credence/ir/ita.h>     // for Instruction, Quadruple, emit
-#include <credence/ir/object.h>  // for Object, Function, LValue
-#include <credence/ir/operand.h> // for operand_to_string
-#include <credence/map.h>        // for Ordered_Map
-#include <credence/symbol.h>     // for Symbol_Table
-#include <credence/types.h>      // for get_data_type_from_string
-#include <credence/util.h>       // for contains, AST_Node, str_trim_ws
-#include <cstddef>               // for size_t
-#include <deque>                 // for deque
-#include <easyjson.h>            // for JSON
-#include <fmt/format.h>          // for format
-#include <limits>                // for numeric_limits
-#include <map>                   // for operator!=
-#include <matchit.h>             // for pattern, PatternHelper, Patt...
-#include <optional>              // for optional
-#include <string>                // for basic_string, char_traits
-#include <string_view>           // for basic_string_view, string_view
-#include <tuple>                 // for get, tuple, operator==
-#include <utility>               // for pair, get
-#include <vector>                // for vector
+#include <array>                   // for array
+#include <credence/arena.h>        // for Arena
+#include <credence/error.h>        // for credence_assert
+#include <credence/ir/checker.h>   // for Type_Checker
+#include <credence/ir/ita.h>       // for Instruction, Quadruple, emit
+#include <credence/ir/object.h>    // for Object, Function, LValue
+#include <credence/ir/operand.h>   // for operand_to_string
+#include <credence/ir/optimize.h>  // for optimize
+#include <credence/ir/quadruple.h> // for Operand_Scope
+#include <credence/map.h>          // for Ordered_Map
+#include <credence/passes.h>       // for Scope
+#include <credence/symbol.h>       // for Symbol_Table
+#include <credence/types.h>        // for get_data_type_from_string
+#include <credence/util.h>         // for contains, AST_Node, str_trim_ws
+#include <cstddef>                 // for size_t
+#include <deque>                   // for deque
+#include <easyjson.h>              // for JSON
+#include <fmt/format.h>            // for format
+#include <limits>                  // for numeric_limits
+#include <map>                     // for operator!=
+#include <matchit.h>               // for pattern, PatternHelper, Patt...
+#include <optional>                // for optional
+#include <string>                  // for basic_string, char_traits
+#include <string_view>             // for basic_string_view, string_view
+#include <tuple>                   // for get, tuple, operator==
+#include <utility>                 // for pair, get
+#include <vector>                  // for vector
 
 /****************************************************************************
  * Table
@@ -74,13 +78,30 @@ namespace m = matchit;
  * and to an std::ostream Passes the global symbols from the ITA object
  */
 void emit(std::ostream& os,
-    util::AST_Node const& symbols,
+    Symbols const& symbols,
     frontend::hir::Unit const& unit)
 {
-    auto [globals, instructions] = ir::make_ita_instructions(unit, symbols);
+    // the instruction lists of this compilation are allocated from here
+    Arena arena{};
+    Operand_Scope operands{};
+
+    passes::Scope ita_pass{ "ita" };
+    auto [globals, instructions] =
+        ir::make_ita_instructions(unit, symbols, arena.resource());
+    ita_pass.count("quadruples", instructions.size());
+    ita_pass.finish();
+
+    ir::optimize(instructions);
+
+    passes::Scope table_pass{ "table" };
     auto table = ir::Table{ symbols, instructions, globals };
     table.build_from_ir_instructions();
+    table_pass.count("quadruples", table.get_table_instructions()->size());
+    table_pass.finish();
+
+    passes::Scope emit_pass{ "emit" };
     detail::emit(os, *table.get_table_instructions());
+    emit_pass.count("quadruples", table.get_table_instructions()->size());
 }
 
 /**
@@ -90,23 +111,29 @@ void Table::build_from_ir_instructions()
 {
     bool skip = false;
     Instruction last_instruction = Instruction::NOOP;
+    auto& instructions = *instructions_;
+    std::size_t size = instructions.size();
 
     build_vector_definitions_from_symbols();
     build_vector_definitions_from_globals();
 
-    for (instruction_index = 0; instruction_index < instructions_->size();
-        instruction_index++) {
-        auto instruction = instructions_->at(instruction_index);
-        m::match(std::get<Instruction>(instruction))(
+    // a redundant GOTO is dropped as the instructions are read, and the
+    // ones after it are moved down over it, so each instruction moves at
+    // most once and instruction_index is its address in the final list
+    instruction_index = 0;
+    for (std::size_t next = 0; next < size; next++, instruction_index++) {
+        auto instruction = instructions[next];
+        instructions[instruction_index] = instruction;
+        m::match(ir::get<0>(instruction))(
             m::pattern | Instruction::FUNC_START =
                 [&] {
                     from_func_start_ita_instruction(
-                        std::get<1>(instructions_->at(instruction_index - 1)));
+                        ir::get<1>(instructions.at(instruction_index - 1)));
                 },
             m::pattern | Instruction::FUNC_END =
                 [&] { from_func_end_ita_instruction(); },
             m::pattern | Instruction::GLOBL =
-                [&] { from_globl_ita_instruction(std::get<1>(instruction)); },
+                [&] { from_globl_ita_instruction(ir::get<1>(instruction)); },
             m::pattern | Instruction::LOCL =
                 [&] { from_locl_ita_instruction(instruction); },
             m::pattern | Instruction::RETURN =
@@ -114,7 +141,7 @@ void Table::build_from_ir_instructions()
             m::pattern |
                 Instruction::PUSH = [&] { from_push_instruction(instruction); },
             m::pattern | Instruction::CALL =
-                [&] { from_call_ita_instruction(std::get<1>(instruction)); },
+                [&] { from_call_ita_instruction(ir::get<1>(instruction)); },
             m::pattern |
                 Instruction::POP = [&] { from_pop_instruction(instruction); },
             m::pattern | Instruction::MOV =
@@ -127,11 +154,16 @@ void Table::build_from_ir_instructions()
                         skip = true;
                 });
         if (skip) {
-            instructions_->erase(instructions_->begin() + instruction_index);
+            // the instruction after a dropped GOTO takes its address and
+            // is passed over, as it was when the GOTO was erased in place
             skip = false;
+            if (++next == size)
+                break;
+            instructions[instruction_index] = instructions[next];
         }
-        last_instruction = std::get<Instruction>(instruction);
+        last_instruction = ir::get<0>(instruction);
     }
+    instructions.resize(instruction_index);
 }
 
 /**
@@ -139,20 +171,18 @@ void Table::build_from_ir_instructions()
  */
 void Table::build_vector_definitions_from_symbols()
 {
-    auto& hoisted_symbols = objects_->get_hoisted_symbols();
-    auto keys = hoisted_symbols.dump_keys();
-    for (LValue const& key : keys) {
-        auto symbol_type = hoisted_symbols[key]["type"].to_string();
-        if (symbol_type == "vector_lvalue") {
-            auto size =
-                static_cast<std::size_t>(hoisted_symbols[key]["size"].to_int());
-            if (size > object::Vector::max_size)
-                throw_object_type_error("stack overflow", key);
-            if (!objects_->get_vectors().contains(key))
-                objects_->get_vectors()[key] = std::make_shared<object::Vector>(
-                    object::Vector{ key, size });
-        }
-    }
+    auto const& hoisted_symbols = objects_->get_hoisted_symbols();
+    hoisted_symbols.for_each([&](Symbol const& symbol) {
+        if (symbol.shape != Shape::Vector_Lvalue)
+            return;
+        auto const& key = symbol.name;
+        auto size = static_cast<std::size_t>(symbol.size);
+        if (size > object::Vector::max_size)
+            throw_object_type_error("stack overflow", key);
+        if (!objects_->get_vectors().contains(key))
+            objects_->get_vectors()[key] =
+                std::make_shared<object::Vector>(object::Vector{ key, size });
+    });
 }
 
 /**
@@ -160,10 +190,10 @@ void Table::build_vector_definitions_from_symbols()
  */
 void Table::from_locl_ita_instruction(Quadruple const& instruction)
 {
-    auto label = std::get<1>(instruction);
+    auto label = ir::get<1>(instruction);
     auto frame = objects_->get_stack_frame();
-    if (std::get<1>(instruction).starts_with("*")) {
-        label = std::get<1>(instruction);
+    if (ir::get<1>(instruction).starts_with("*")) {
+        label = ir::get<1>(instruction);
         frame->get_locals().set_symbol_by_name(label.substr(1), "NULL");
     } else
         frame->get_locals().set_symbol_by_name(
@@ -175,7 +205,7 @@ void Table::from_locl_ita_instruction(Quadruple const& instruction)
  */
 void Table::from_return_instruction(Quadruple const& instruction)
 {
-    auto return_rvalue = util::str_trim_ws(std::get<1>(instruction));
+    auto return_rvalue = util::str_trim_ws(ir::get<1>(instruction));
     auto frame = objects_->get_stack_frame();
     if (frame->get_ret().has_value())
         throw_object_type_error("invalid return statement", return_rvalue);
@@ -229,7 +259,7 @@ void Table::from_call_ita_instruction(Label const& label)
  */
 void Table::from_label_ita_instruction(Quadruple const& instruction)
 {
-    Label label = std::get<1>(instruction);
+    Label label = ir::get<1>(instruction);
     if (objects_->is_stack_frame()) {
         auto frame = objects_->get_stack_frame();
         if (frame->get_labels().contains(label))
@@ -254,14 +284,15 @@ void Table::from_label_ita_instruction(Quadruple const& instruction)
  */
 void Table::from_mov_ita_instruction(Quadruple const& instruction)
 {
-    LValue lhs = std::get<1>(instruction);
+    LValue const& lhs = ir::get<1>(instruction);
     auto rvalue = get_rvalue_from_mov_qaudruple(instruction);
     RValue rhs = rvalue.first;
     auto frame = objects_->get_stack_frame();
 
     auto type_checker = Type_Checker{ objects_, frame };
 
-    if (lhs.starts_with("_t") or lhs.starts_with("_p")) {
+    if (ir::kind_of<1>(instruction) == Operand_Kind::Temporary or
+        lhs.starts_with("_p")) {
         from_temporary_assignment(lhs, rhs);
         return;
     }
@@ -275,22 +306,26 @@ void Table::from_mov_ita_instruction(Quadruple const& instruction)
         from_pointer_or_vector_assignment(lhs, rhs);
         return;
     }
-    if (objects_->get_hoisted_symbols().has_key(rhs)) {
+    if (objects_->get_hoisted_symbols().contains(rhs)) {
         from_scaler_symbol_assignment(lhs, rhs);
         return;
     }
 
     type::Data_Type rvalue_symbol = type::NULL_RVALUE_LITERAL;
 
-    if (type::is_unary_expression(rhs))
+    auto const& value = ir::value_of(rhs);
+
+    if (value.is_unary())
         rvalue_symbol = from_rvalue_unary_expression(
             lhs, rhs, type::get_unary_operator(rhs));
 
-    if (type::is_binary_expression(rhs))
+    if (value.is_binary())
         rvalue_symbol = type::Data_Type{ rhs, "word", sizeof(void*) };
 
     if (rvalue_symbol == type::NULL_RVALUE_LITERAL and rvalue.second.empty())
-        rvalue_symbol = type::get_data_type_from_string(rhs);
+        rvalue_symbol = value.is_literal()
+                            ? value.literal
+                            : type::get_data_type_from_string(rhs);
     if (rvalue_symbol == type::NULL_RVALUE_LITERAL and
         type::is_unary_expression(rvalue.second))
         rvalue_symbol = from_rvalue_unary_expression(lhs, rhs, rvalue.second);
@@ -508,7 +543,7 @@ void Table::from_func_end_ita_instruction()
  */
 void Table::from_push_instruction(Quadruple const& instruction)
 {
-    RValue operand = std::get<1>(instruction);
+    RValue operand = ir::get<1>(instruction);
     auto frame = objects_->get_stack_frame();
     if (objects_->is_stack_frame()) {
         temporary_parameter_stack.emplace_back(operand);
@@ -521,7 +556,7 @@ void Table::from_push_instruction(Quadruple const& instruction)
  */
 void Table::from_pop_instruction(Quadruple const& instruction)
 {
-    auto operand = std::stoul(std::get<1>(instruction));
+    auto operand = std::stoul(ir::get<1>(instruction));
     auto pop_size = operand / sizeof(void*);
     credence_assert(pop_size <= objects_->get_stack().size());
 }
@@ -631,10 +666,8 @@ void Table::from_temporary_assignment(LValue const& lhs, LValue const& rhs)
     frame->get_temporary()[lhs] = rhs;
     if (lhs.starts_with("_p"))
         frame->get_locals().set_symbol_by_name(lhs, rhs);
-    if (type::is_rvalue_data_type(rhs)) {
-        auto data_type = type::get_data_type_from_string(rhs);
-        insert_address_storage_rvalue(data_type);
-    }
+    if (auto const& value = ir::value_of(rhs); value.is_literal())
+        insert_address_storage_rvalue(value.literal);
 }
 
 /**
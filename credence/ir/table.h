@@ -55,7 +55,7 @@
 namespace credence::ir {
 
 void emit(std::ostream& os,
-    util::AST_Node const& symbols,
+    Symbols const& symbols,
     frontend::hir::Unit const& unit);
 
 class Table
@@ -66,16 +66,16 @@ class Table
     ~Table() = default;
 
 #ifdef CREDENCE_TEST
-    explicit Table(util::AST_Node const& symbols)
+    explicit Table(Symbols const& symbols)
     {
         objects_ = std::make_shared<object::Object>(object::Object{});
-        objects_->get_hoisted_symbols() = std::move(symbols);
+        objects_->get_hoisted_symbols() = symbols;
         instructions_ = std::make_shared<ir::Instructions>();
         objects_->get_ir_instructions() = instructions_;
         objects_->get_globals() = Symbol_Table<>{};
     }
 #endif
-    explicit Table(util::AST_Node symbols,
+    explicit Table(Symbols symbols,
         Instructions& instructions,
         Symbol_Table<> const& globals)
     {
@@ -135,8 +135,7 @@ class Table
             symbol,
             location,
             type_,
-            objects_->get_stack_frame()->get_symbol(),
-            objects_->get_hoisted_symbols());
+            objects_->get_stack_frame()->get_symbol());
     }
 
   CREDENCE_PRIVATE_UNLESS_TESTED:
@@ -0,0 +1,258 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/ir/tail.h>
+
+#include <credence/ir/cfg.h> // for last_number
+#include <credence/ir/ssa.h> // for scalar_names
+#include <credence/util.h>   // for str_trim_ws
+#include <optional>          // for optional, nullopt
+#include <string>            // for string, to_string
+#include <string_view>       // for string_view
+#include <unordered_map>     // for unordered_map
+#include <unordered_set>     // for unordered_set
+#include <utility>           // for move
+#include <vector>            // for vector
+
+namespace credence::ir {
+
+namespace {
+
+using Handle = Operand_Table::Handle;
+
+constexpr auto empty = Operand_Table::empty;
+
+/**
+ * @brief A call of the function by itself in tail position
+ */
+struct Tail_Call
+{
+    // the first PUSH of the call, and the end of its block
+    std::size_t begin{ 0 };
+    std::size_t end{ 0 };
+    // the MOV that assigns each argument, by parameter
+    std::vector<std::size_t> arguments{};
+};
+
+/**
+ * @brief Whether the path from a call, from the quadruple after the read
+ * of its RET, returns its value and does nothing else
+ *
+ * The path may copy the value to a temporary or a scalar of the function
+ * in the block of the call, where no other path sees the copy, and then
+ * pass labels and jumps alone.
+ */
+bool returns_value(Instructions const& function,
+    std::size_t at,
+    Handle result,
+    std::unordered_set<Handle> const& scalars,
+    std::unordered_map<Handle, std::size_t> const& labels)
+{
+    auto& table = operand_table();
+    std::unordered_set<Handle> held{};
+    if (result != empty)
+        held.insert(result);
+    std::unordered_set<std::size_t> visited{};
+    bool in_block = true;
+    while (at < function.size() and visited.insert(at).second) {
+        auto const& quadruple = function[at];
+        auto lhs = quadruple.operands[0];
+        switch (quadruple.op) {
+            case Instruction::MOV:
+                if (not in_block or quadruple.operands[2] != empty or
+                    not held.contains(quadruple.operands[1]) or
+                    (table.kind(lhs) != Operand_Kind::Temporary and
+                        not scalars.contains(lhs)))
+                    return false;
+                held.insert(lhs);
+                at++;
+                break;
+            case Instruction::LABEL:
+                in_block = false;
+                at++;
+                break;
+            case Instruction::GOTO: {
+                auto label = labels.find(lhs);
+                if (label == labels.end())
+                    return false;
+                in_block = false;
+                at = label->second;
+                break;
+            }
+            case Instruction::RETURN:
+                // the name a RET gives back is held with the space after
+                // it, e.g. "r ", as operand_to_string writes an lvalue
+                return result == empty
+                           ? lhs == empty
+                           : held.contains(table.intern(
+                                 util::str_trim_ws(std::string{
+                                     table.text(lhs) })));
+            case Instruction::LEAVE:
+                return result == empty;
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief The first call of the function by itself in tail position, from
+ * the end of its declarations, if there is one
+ */
+std::optional<Tail_Call> find_tail_call(Instructions const& function,
+    std::string_view name,
+    std::size_t arity,
+    std::size_t declarations,
+    std::unordered_set<Handle> const& scalars)
+{
+    auto& table = operand_table();
+    auto returned = table.intern("RET");
+    std::unordered_map<Handle, std::size_t> labels{};
+    for (std::size_t i = 0; i < function.size(); i++)
+        if (function[i].op == Instruction::LABEL)
+            labels.emplace(function[i].operands[0], i);
+
+    for (std::size_t i = declarations + arity; i < function.size(); i++) {
+        if (function[i].op != Instruction::CALL or
+            table.text(function[i].operands[0]) != name)
+            continue;
+        // one PUSH for each parameter just before the CALL, then its POP
+        // and the read of its RET
+        std::size_t pushed = 0;
+        while (pushed < i - declarations and
+               function[i - pushed - 1].op == Instruction::PUSH)
+            pushed++;
+        if (pushed != arity)
+            continue;
+        auto next = i + 1;
+        if (next < function.size() and function[next].op == Instruction::POP)
+            next++;
+        Handle result = empty;
+        if (next < function.size() and
+            function[next].op == Instruction::MOV and
+            function[next].operands[1] == returned and
+            function[next].operands[2] == empty)
+            result = function[next++].operands[0];
+        if (not returns_value(function, next, result, scalars, labels))
+            continue;
+
+        // each argument is pushed as a _p name assigned it before
+        Tail_Call call{ i - arity, next, {} };
+        for (std::size_t k = 0; k < arity; k++) {
+            auto pushed_name = function[i - 1 - k].operands[0];
+            std::size_t j = i - arity;
+            while (j > declarations and
+                   not(function[j - 1].op == Instruction::MOV and
+                       function[j - 1].operands[0] == pushed_name))
+                j--;
+            if (j == declarations or function[j - 1].operands[2] != empty or
+                not table.text(pushed_name).starts_with("_p"))
+                break;
+            call.arguments.push_back(j - 1);
+        }
+        if (call.arguments.size() != arity)
+            continue;
+        while (call.end < function.size() and
+               function[call.end].op != Instruction::LABEL)
+            call.end++;
+        return call;
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+/**
+ * @brief Replace each call of a function by itself in tail position, from
+ * its LABEL to its EndFunc, with a jump to its start, and give the number
+ * of calls replaced
+ *
+ * The function is searched again after each call is replaced, as the
+ * replacement moves the quadruples after it.
+ */
+std::size_t eliminate_tail_recursion(Instructions& function)
+{
+    auto& table = operand_table();
+    std::string_view label = table.text(function.front().operands[0]);
+    auto open = label.find('(');
+    if (not label.starts_with("__") or open == std::string_view::npos)
+        return 0;
+    auto name = label.substr(2, open - 2);
+
+    // the parameters, from the label, and each must be a scalar that is
+    // the frame's own
+    auto scalars = detail::scalar_names(function);
+    std::vector<Handle> parameters{};
+    auto list = label.substr(open + 1, label.rfind(')') - open - 1);
+    while (not list.empty()) {
+        auto comma = list.find(',');
+        auto parameter = table.intern(list.substr(0, comma));
+        if (not scalars.contains(parameter))
+            return 0;
+        parameters.push_back(parameter);
+        if (comma == std::string_view::npos)
+            break;
+        list.remove_prefix(comma + 1);
+    }
+
+    std::size_t declarations = 2;
+    while (declarations < function.size() and
+           (function[declarations].op == Instruction::LOCL or
+               function[declarations].op == Instruction::GLOBL)) {
+        if (function[declarations].op == Instruction::LOCL and
+            not scalars.contains(function[declarations].operands[0]))
+            return 0;
+        declarations++;
+    }
+
+    std::size_t replaced = 0;
+    Handle start = empty;
+    for (;;) {
+        auto call = find_tail_call(
+            function, name, parameters.size(), declarations, scalars);
+        if (not call.has_value())
+            break;
+        auto temporaries = last_number(function, Operand_Kind::Temporary);
+        Instructions looped{ resource_of(function) };
+        std::vector<Handle> arguments{};
+        for (auto at : call->arguments) {
+            arguments.push_back(
+                table.intern("_t" + std::to_string(++temporaries)));
+            function[at].operands[0] = arguments.back();
+        }
+        for (std::size_t i = 0; i < function.size(); i++) {
+            if (i == declarations and start == empty) {
+                start = table.intern("_L" +
+                    std::to_string(
+                        last_number(function, Operand_Kind::Label) + 1));
+                looped.push_back(Quadruple{ Instruction::LABEL, { start } });
+            }
+            if (i == call->begin) {
+                for (std::size_t k = 0; k < parameters.size(); k++)
+                    looped.push_back(Quadruple{
+                        Instruction::MOV, { parameters[k], arguments[k] } });
+                looped.push_back(Quadruple{ Instruction::GOTO, { start } });
+            }
+            if (i < call->begin or i >= call->end)
+                looped.push_back(function[i]);
+        }
+        // the label is in place from the first call on
+        declarations += replaced == 0 ? 1 : 0;
+        function = std::move(looped);
+        replaced++;
+    }
+    return replaced;
+}
+
+} // namespace credence::ir
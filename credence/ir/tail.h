@@ -0,0 +1,68 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/ir/quadruple.h> // for Instructions
+#include <cstddef>                 // for size_t
+
+/****************************************************************************
+ *
+ * Tail recursion
+ *
+ * A call of a function by itself is a new stack frame in the backends at
+ * each depth, however deep the recursion goes. A call in tail position -
+ * one whose value the function returns and nothing else, or after which
+ * it returns nothing and does nothing - is instead its arguments assigned
+ * to the parameters and a jump to a label after the declarations, so the
+ * recursion is a loop in the one frame:
+ *
+ *    __count(n,s):                    __count(n,s):
+ *     BeginFunc ;                      BeginFunc ;
+ *        LOCL r;                          LOCL r;
+ *        ...                          _L9:
+ *        _p3_1 = _t6;                     ...
+ *        _p4_2 = _t7;                     _t10 = _t6;
+ *        PUSH _p4_2;           ->         _t11 = _t7;
+ *        PUSH _p3_1;                      n = _t10;
+ *        CALL count;                      s = _t11;
+ *        POP 16;                          GOTO _L9;
+ *        _t8 = RET;
+ *        r = _t8;
+ *        GOTO _L2;
+ *    ...
+ *    _L2:
+ *        RET r;
+ *
+ * A call is in tail position where the path from it copies its value and
+ * passes labels and jumps alone to a RET of that value, or, for a call
+ * whose value is not read, to a RET of nothing or the LEAVE.
+ *
+ * The arguments are each evaluated where they were, into a temporary, and
+ * assigned to the parameters after all of them, as a new frame would see
+ * them. A function with a pointer parameter, or a parameter or local that
+ * a pointer, a vector or an address may reach, keeps its calls, as each
+ * frame would have had its own.
+ *
+ *****************************************************************************/
+
+namespace credence::ir {
+
+/**
+ * @brief Replace each call of a function by itself in tail position, from
+ * its LABEL to its EndFunc, with a jump to its start, and give the number
+ * of calls replaced
+ */
+std::size_t eliminate_tail_recursion(Instructions& function);
+
+} // namespace credence::ir
@@ -19,7 +19,7 @@
 #include <credence/ir/operators.h> // for Operator, operator_to_s...
 #include <credence/symbol.h>       // for Symbol_Table
 #include <credence/types.h>        // for is_temporary
-#include <credence/util.h>         // for AST_Node, overload
+#include <credence/util.h>         // for overload
 #include <deque>                   // for deque
 #include <easyjson.h>              // for JSON
 #include <fmt/base.h>              // for copy
@@ -110,11 +110,11 @@ void Temporary::binary_operands_balanced_temporary_stack(operators::Operator op)
     instructions.emplace_back(temp_rhs);
 
     temporary_stack.emplace(
-        make_binary_temporary_string(lhs.first, op, std::get<1>(temp_rhs)));
+        make_binary_temporary_string(lhs.first, op, ir::get<1>(temp_rhs)));
     // an lvalue at the end of a call stack
     if (operand1->index() == 6 and operand_stack.size() == 0) {
         auto temp_lhs = ir::make_temporary(temporary_index,
-            make_binary_temporary_string(lhs.first, op, std::get<1>(temp_rhs)));
+            make_binary_temporary_string(lhs.first, op, ir::get<1>(temp_rhs)));
         instructions.emplace_back(temp_lhs);
     }
 }
@@ -158,7 +158,7 @@ void Temporary::binary_operands_unbalanced_temporary_stack(
                 Quadruple last_lvalue =
                     instructions[instructions.size() - last_index];
                 // backtrack the instruction stack and grab the last lvalue
-                while (std::get<0>(last_lvalue) != Instruction::MOV and
+                while (ir::get<0>(last_lvalue) != Instruction::MOV and
                        last_index < instructions.size()) {
                     last_lvalue =
                         instructions[instructions.size() - last_index];
@@ -166,17 +166,17 @@ void Temporary::binary_operands_unbalanced_temporary_stack(
                 }
                 auto operand_temp = ir::make_temporary(temporary_index,
                     make_binary_temporary_string(
-                        std::get<1>(last_lvalue), op, std::get<1>(last)));
+                        ir::get<1>(last_lvalue), op, ir::get<1>(last)));
                 instructions.emplace_back(operand_temp);
-                temporary_stack.emplace(std::get<1>(operand_temp));
+                temporary_stack.emplace(ir::get<1>(operand_temp));
             },
         m::pattern | 1 =
             [&] {
                 auto operand_temp = ir::make_temporary(temporary_index,
                     make_binary_temporary_string(
-                        rhs_lvalue, op, std::get<1>(last)));
+                        rhs_lvalue, op, ir::get<1>(last)));
                 instructions.emplace_back(operand_temp);
-                temporary_stack.emplace(std::get<1>(operand_temp));
+                temporary_stack.emplace(ir::get<1>(operand_temp));
             }
 
     );
@@ -235,7 +235,7 @@ void Temporary::assignment_operands_to_temporary_stack()
                 if (instructions.size() > 1) {
                     auto last = instructions[instructions.size() - 1];
                     instructions.emplace_back(make_quadruple(
-                        Instruction::MOV, lhs_expression, std::get<1>(last)));
+                        Instruction::MOV, lhs_expression, ir::get<1>(last)));
                 }
             },
         m::pattern | m::ds(m::_ >= 2, m::_ == 0) =
@@ -279,7 +279,7 @@ void Temporary::from_push_operands_to_temporary_instructions()
  * @brief Construct temporary lvalues from function call
  */
 void Temporary::from_call_operands_to_temporary_instructions(
-    util::AST_Node const& details)
+    Symbols const& details)
 {
     auto op = operators::Operator::U_CALL;
     std::string symbol{};
@@ -290,7 +290,7 @@ void Temporary::from_call_operands_to_temporary_instructions(
         auto temp_rhs = ir::make_temporary(temporary_index, rhs);
         instructions.emplace_back(temp_rhs);
         temporary_stack.emplace(
-            make_unary_temporary_string(op, std::get<1>(temp_rhs)));
+            make_unary_temporary_string(op, ir::get<1>(temp_rhs)));
         instructions.emplace_back(make_quadruple(Instruction::CALL, rhs));
         temporary_stack.emplace(rhs);
     } else {
@@ -300,7 +300,7 @@ void Temporary::from_call_operands_to_temporary_instructions(
             auto temp_rhs = ir::make_temporary(temporary_index, rhs);
             instructions.emplace_back(temp_rhs);
             temporary_stack.emplace(
-                make_unary_temporary_string(op, std::get<1>(temp_rhs)));
+                make_unary_temporary_string(op, ir::get<1>(temp_rhs)));
             symbol = rhs;
             instructions.emplace_back(make_quadruple(Instruction::CALL, rhs));
             temporary_stack.emplace(rhs);
@@ -322,13 +322,12 @@ void Temporary::from_call_operands_to_temporary_instructions(
             "",
             ""));
     // does this function have a return value?
-    if (symbol == "getchar" or
-        (details.has_key(symbol) and not details[symbol]["void"].is_null() and
-            details[symbol]["void"].to_bool() == false)) {
+    auto const* called = details.find(symbol);
+    if (symbol == "getchar" or (called != nullptr and called->returns)) {
         auto call_return = ir::make_temporary(temporary_index, "RET");
         instructions.emplace_back(call_return);
         if (operand_stack.size() >= 1) {
-            temporary_stack.emplace(std::get<1>(call_return));
+            temporary_stack.emplace(ir::get<1>(call_return));
         }
     }
     parameters_size = 0;
@@ -371,7 +370,7 @@ void Temporary::unary_operand_to_temporary_stack(operators::Operator op)
                 auto unary = ir::make_temporary(
                     temporary_index, make_unary_temporary_string(op, operand1));
                 temporary_stack.emplace(
-                    make_unary_temporary_string(op, std::get<1>(unary)));
+                    make_unary_temporary_string(op, ir::get<1>(unary)));
             },
         m::pattern | m::_ =
             [&] {
@@ -387,7 +386,7 @@ void Temporary::unary_operand_to_temporary_stack(operators::Operator op)
                         auto last_expression =
                             ir::make_temporary(temporary_index, operand1);
                         instructions.emplace_back(last_expression);
-                        temporary_stack.emplace(std::get<1>(last_expression));
+                        temporary_stack.emplace(ir::get<1>(last_expression));
                     }
                 }
                 auto rhs =
@@ -415,7 +414,7 @@ void Temporary::unary_operand_to_temporary_stack(operators::Operator op)
                                     make_unary_temporary_string(op, rhs.first));
                                 instructions.emplace_back(operand_temp);
                                 temporary_stack.emplace(
-                                    std::get<1>(operand_temp));
+                                    ir::get<1>(operand_temp));
                             }
                         },
                     m::pattern | m::_ =
@@ -424,7 +423,7 @@ void Temporary::unary_operand_to_temporary_stack(operators::Operator op)
                             auto unary = ir::make_temporary(temporary_index,
                                 make_unary_temporary_string(op, rhs.first));
                             instructions.emplace_back(unary);
-                            temporary_stack.emplace(std::get<1>(unary));
+                            temporary_stack.emplace(ir::get<1>(unary));
                         }
 
                 );
@@ -531,7 +530,7 @@ void Temporary::binary_operands_to_temporary_stack(Operator op)
                                     make_binary_temporary_string(
                                         lhs_name.first, op, rhs_name.first));
                                 operand::Operand::LValue temp_lvalue =
-                                    std::make_pair(std::get<1>(operand_temp),
+                                    std::make_pair(ir::get<1>(operand_temp),
                                         operand::NULL_LITERAL);
                                 operand_stack.emplace(
                                     operand::make_value_type_pointer(
@@ -556,7 +555,7 @@ void Temporary::binary_operands_to_temporary_stack(Operator op)
  * Construct a set of ita instructions from an expression queue.
  */
 Instructions queue_to_ita_instructions(Queue const& queue,
-    util::AST_Node const& details,
+    Symbols const& details,
     int* temporary_index)
 {
     using namespace credence::operators;
@@ -655,7 +654,7 @@ Instructions queue_to_ita_instructions(Queue const& queue,
  */
 Expression_Instructions hir_to_ita_instructions(frontend::hir::Unit const& unit,
     frontend::hir::Node_Index node,
-    util::AST_Node const& details,
+    Symbols const& details,
     int* temporary_index,
     int* identifier_index)
 {
@@ -18,8 +18,9 @@
 #include <credence/ir/operand.h>       // for Datatype, Size
 #include <credence/ir/operators.h>     // for Operator
 #include <credence/ir/queue.h>         // for Queue
+#include <credence/ir/symbols.h>       // for Symbols
 #include <credence/symbol.h>           // for Symbol_Table
-#include <credence/util.h>             // for AST_Node, range_contains
+#include <credence/util.h>             // for range_contains
 #include <initializer_list>            // for initializer_list
 #include <ostream>                     // for ostream
 #include <stack>                       // for stack
@@ -131,7 +132,7 @@ class Temporary
 
   public:
     void from_call_operands_to_temporary_instructions(
-        util::AST_Node const& details);
+        Symbols const& details);
     void from_push_operands_to_temporary_instructions();
 
     Temporary_Instructions instruction_temporary_from_expression_operand(
@@ -164,12 +165,12 @@ constexpr bool is_in_place_unary_operator(operators::Operator op)
 inline std::ostream* queue_dump_stream = nullptr;
 
 Instructions queue_to_ita_instructions(Queue const& queue,
-    util::AST_Node const& details,
+    Symbols const& details,
     int* temporary_index);
 
 Expression_Instructions hir_to_ita_instructions(frontend::hir::Unit const& unit,
     frontend::hir::Node_Index node,
-    util::AST_Node const& details,
+    Symbols const& details,
     int* temporary_index,
     int* identifier_index);
 
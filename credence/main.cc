@@ -16,11 +16,17 @@
 #include <credence/frontend/hir/hir.h>        // for Unit
 #include <credence/frontend/hir/serialize.h>  // for dump
 #include <credence/frontend/serialize.h>      // for dump
-#include <credence/ir/symbols.h>              // for hoisted_symbols
+#include <credence/frontend/source.h>         // for Source
+#include <credence/ir/cfg.h>                  // for emit_cfg
+#include <credence/ir/optimize.h>             // for optimize_options
+#include <credence/ir/ssa.h>                  // for emit_ssa
+#include <credence/ir/symbols.h>              // for Symbols, hoisted_symbols
 #include <credence/ir/table.h>                // for emit
 #include <credence/ir/temporary.h>            // for queue_dump_stream
+#include <credence/passes.h>                  // for Report, Scope
 #include <credence/target/arm64/generator.h>  // for emit
 #include <credence/target/common/assembly.h>  // for Arch_Type
+#include <credence/target/common/options.h>   // for target_options
 #include <credence/target/common/runtime.h>   // for add_stdlib_functions_t...
 #include <credence/target/x86_64/generator.h> // for emit
 #include <credence/util.h>                    // for AST_Node, sv, AST, cap...
@@ -71,7 +77,7 @@ namespace {
 struct Frontend
 {
     credence::frontend::Program program;
-    credence::util::AST_Node symbols;
+    credence::ir::Symbols symbols;
 };
 
 } // namespace
@@ -79,7 +85,7 @@ struct Frontend
 /**
  * @brief Build the frontend, reporting anything it rejected
  */
-Frontend build_frontend(std::string source)
+Frontend build_frontend(credence::frontend::Source source)
 {
     auto program = credence::frontend::compile(std::move(source));
     credence::frontend::report(std::cerr, program);
@@ -87,7 +93,10 @@ Frontend build_frontend(std::string source)
     if (program.failed())
         exit(1);
 
+    credence::passes::Scope hoist_pass{ "hoist" };
     auto symbols = credence::ir::hoisted_symbols(program.unit);
+    hoist_pass.count("symbols", program.unit.symbol_table.symbols().size());
+    hoist_pass.finish();
     return Frontend{ std::move(program), std::move(symbols) };
 }
 
@@ -99,7 +108,7 @@ int main(int argc, const char* argv[])
         options.show_positional_help();
         // clang-format off
         options.add_options()
-            ("t,target", "Target [ast, hir, ir, arm64, x86_64]",
+            ("t,target", "Target [ast, hir, ir, cfg, ssa, arm64, x86_64]",
                 cxxopts::value<std::string>()->default_value("ir"))
             ("s,symbols", "[Debug] Dump symbol table",
                 cxxopts::value<bool>()->default_value("false"))
@@ -111,10 +120,42 @@ int main(int argc, const char* argv[])
                 cxxopts::value<bool>()->default_value("false"))
             ("l,linear", "[Debug] Dump the hir target in the linear form the IR reads",
                 cxxopts::value<bool>()->default_value("false"))
+            ("g,graphviz", "[Debug] Dump the cfg target as Graphviz dot",
+                cxxopts::value<bool>()->default_value("false"))
+            ("inline", "Inline calls of small functions",
+                cxxopts::value<bool>()->default_value("false"))
+            ("finline-limit", "The most quadruples of a function --inline inlines",
+                cxxopts::value<std::size_t>()->default_value("8"))
+            ("tail", "Turn self-recursive calls in tail position into loops",
+                cxxopts::value<bool>()->default_value("false"))
+            ("ssa", "[Debug] Take each function into SSA form and back before the table",
+                cxxopts::value<bool>()->default_value("false"))
+            ("sccp", "Propagate and fold constants, and drop the branches they decide",
+                cxxopts::value<bool>()->default_value("false"))
+            ("gvn", "Reuse operations already computed on the same values",
+                cxxopts::value<bool>()->default_value("false"))
+            ("copies", "Coalesce temporaries into the copies that read them",
+                cxxopts::value<bool>()->default_value("false"))
+            ("licm", "Hoist loop-invariant operations out of while loops",
+                cxxopts::value<bool>()->default_value("false"))
+            ("iv", "Reduce multiplies of loop induction variables to adds",
+                cxxopts::value<bool>()->default_value("false"))
+            ("dce", "Drop dead code, unreached blocks, and unused locals",
+                cxxopts::value<bool>()->default_value("false"))
+            ("regalloc", "Keep scalar locals in callee-saved registers",
+                cxxopts::value<bool>()->default_value("false"))
+            ("peephole", "Rewrite short instruction sequences by pattern",
+                cxxopts::value<bool>()->default_value("false"))
+            ("slots", "Share stack slots of locals whose lifetimes do not overlap",
+                cxxopts::value<bool>()->default_value("false"))
+            ("leaf", "Drop the frame pointer of functions that call nothing",
+                cxxopts::value<bool>()->default_value("false"))
+            ("time-passes", "[Debug] Report time, allocations, and output of each pass to stderr [table, json]",
+                cxxopts::value<std::string>()->implicit_value("table"))
             ("o,output", "Output file",
                 cxxopts::value<std::string>()->default_value("stdout"))
             ("h,help", "Print usage")
-            ("source-code", "B Source file", cxxopts::value<std::string>());
+            ("source-code", "B Source file, or - for stdin", cxxopts::value<std::string>());
         // clang-format on
         options.parse_positional({ "source-code" });
 
@@ -129,20 +170,57 @@ int main(int argc, const char* argv[])
         bool no_stdlib = result["nostdlib"].as<bool>();
         bool verbose = result["verbose"].as<bool>();
         bool linear = result["linear"].as<bool>();
+        bool graphviz = result["graphviz"].as<bool>();
 
         if (result["dump-queue"].as<bool>())
             credence::ir::queue_dump_stream = &std::cout;
+        credence::ir::optimize_options.inliner = result["inline"].as<bool>();
+        credence::ir::optimize_options.inline_limit =
+            result["finline-limit"].as<std::size_t>();
+        credence::ir::optimize_options.tail = result["tail"].as<bool>();
+        credence::ir::optimize_options.ssa = result["ssa"].as<bool>();
+        credence::ir::optimize_options.sccp = result["sccp"].as<bool>();
+        credence::ir::optimize_options.gvn = result["gvn"].as<bool>();
+        credence::ir::optimize_options.copies = result["copies"].as<bool>();
+        credence::ir::optimize_options.licm = result["licm"].as<bool>();
+        credence::ir::optimize_options.iv = result["iv"].as<bool>();
+        credence::ir::optimize_options.dce = result["dce"].as<bool>();
+        credence::target::common::target_options.regalloc =
+            result["regalloc"].as<bool>();
+        credence::target::common::target_options.peephole =
+            result["peephole"].as<bool>();
+        credence::target::common::target_options.slots =
+            result["slots"].as<bool>();
+        credence::target::common::target_options.leaf =
+            result["leaf"].as<bool>();
+
+        credence::passes::Report report{};
+        std::string time_passes{};
+        if (result.count("time-passes")) {
+            time_passes = result["time-passes"].as<std::string>();
+            if (time_passes != "table" and time_passes != "json") {
+                std::cerr << "Credence :: Invalid time-passes format \""
+                          << time_passes << "\", expected table or json"
+                          << std::endl;
+                return 1;
+            }
+            credence::passes::active_report = &report;
+        }
 
-        auto source = credence::util::read_file_from_path(
+        credence::passes::Scope read_pass{ "read" };
+        auto source = credence::frontend::Source::from_path(
             result["source-code"].as<std::string>());
+        read_pass.count("bytes", source.size());
+        read_pass.finish();
 
-        auto frontend = build_frontend(source);
+        auto frontend = build_frontend(std::move(source));
         auto& unit = frontend.program.unit;
         auto& symbols = frontend.symbols;
 
         // Populate the symbol table with standard library functions
         auto os_type = credence::target::common::assembly::get_os_type();
-        if (target == "x86_64" or target == "ir")
+        if (target == "x86_64" or target == "ir" or target == "cfg" or
+            target == "ssa")
             credence::target::common::runtime::add_stdlib_functions_to_symbols(
                 symbols,
                 os_type,
@@ -154,7 +232,8 @@ int main(int argc, const char* argv[])
                 credence::target::common::assembly::Arch_Type::ARM64);
 
         if (result["symbols"].count() and target != "ast" and target != "hir")
-            std::cout << "> Symbol Table:" << std::endl << symbols << std::endl;
+            std::cout << "> Symbol Table:" << std::endl
+                      << credence::ir::to_json(symbols) << std::endl;
 
         std::ostringstream out_to{};
 
@@ -163,6 +242,8 @@ int main(int argc, const char* argv[])
                 m::or_(sv("x86_64"), sv("arm64")) = [&] { return "bs"; },
             m::pattern | sv("ast") = [&] { return "bast"; },
             m::pattern | sv("hir") = [&] { return "bhir"; },
+            m::pattern | sv("cfg") = [&] { return graphviz ? "dot" : "bcfg"; },
+            m::pattern | sv("ssa") = [&] { return "bssa"; },
             m::pattern | m::_ = [&] { return "bo"; });
 
         m::match(target)(
@@ -178,11 +259,17 @@ int main(int argc, const char* argv[])
                 },
             m::pattern |
                 "ir" = [&]() { credence::ir::emit(out_to, symbols, unit); },
+            m::pattern | "cfg" =
+                [&]() {
+                    credence::ir::emit_cfg(out_to, symbols, unit, graphviz);
+                },
+            m::pattern |
+                "ssa" = [&]() { credence::ir::emit_ssa(out_to, symbols, unit); },
             m::pattern | "ast" =
                 [&]() {
                     if (result["symbols"].count())
                         out_to << "> Symbol Table:" << std::endl
-                               << symbols << std::endl;
+                               << credence::ir::to_json(symbols) << std::endl;
                     credence::frontend::ast::dump(out_to,
                         frontend.program.tree,
                         { .indices = verbose, .positions = verbose });
@@ -191,7 +278,7 @@ int main(int argc, const char* argv[])
                 [&]() {
                     if (result["symbols"].count())
                         out_to << "> Symbol Table:" << std::endl
-                               << symbols << std::endl;
+                               << credence::ir::to_json(symbols) << std::endl;
                     if (linear) {
                         for (auto definition : unit.definitions)
                             credence::frontend::hir::dump_linear(
@@ -210,6 +297,11 @@ int main(int argc, const char* argv[])
         credence::util::write_to_file_from_string_stream(
             output, out_to, extension);
 
+        if (time_passes == "json")
+            report.dump_json(std::cerr);
+        else if (time_passes == "table")
+            report.dump_table(std::cerr);
+
     } catch (cxxopts::exceptions::option_has_no_value const&) {
         std::cout << "Credence :: See \"--help\" for usage overview"
                   << std::endl;
@@ -0,0 +1,235 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/passes.h>
+
+#include <algorithm>    // for max
+#include <atomic>       // for atomic, memory_order_relaxed
+#include <cstdlib>      // for malloc, free
+#include <fmt/format.h> // for format
+#include <new>          // for bad_alloc, get_new_handler
+#include <ostream>      // for ostream
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+/****************************************************************************
+ *
+ * Pass timing and memory report
+ *
+ * The counting allocator is a replacement of the global operator new and
+ * delete. Array and nothrow forms forward to these by default, so every
+ * allocation the compiler makes is seen once. An allocation is counted
+ * only while a Report is active, and the counters are relaxed atomics, as
+ * only their difference across a scope is ever read. As the standard asks
+ * of a replacement, a failed allocation calls the new handler until it
+ * succeeds or there is none to call.
+ *
+ *****************************************************************************/
+
+namespace credence::passes {
+
+namespace {
+
+std::atomic<std::uint64_t> allocations_seen{ 0 };
+std::atomic<std::uint64_t> bytes_seen{ 0 };
+
+/**
+ * @brief A string as a JSON string literal, with its quotes
+ *
+ * Names and count keys are chosen by the stages, and a stage may key a
+ * count by a name from the source, so both are escaped as any other text.
+ */
+std::string json_string(std::string_view text)
+{
+    std::string quoted{ "\"" };
+    for (auto c : text) {
+        switch (c) {
+            case '"':
+                quoted += "\\\"";
+                break;
+            case '\\':
+                quoted += "\\\\";
+                break;
+            case '\n':
+                quoted += "\\n";
+                break;
+            case '\t':
+                quoted += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    quoted += fmt::format(
+                        "\\u{:04x}", static_cast<unsigned char>(c));
+                else
+                    quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+} // namespace
+
+std::uint64_t allocation_count()
+{
+    return allocations_seen.load(std::memory_order_relaxed);
+}
+
+std::uint64_t allocated_bytes()
+{
+    return bytes_seen.load(std::memory_order_relaxed);
+}
+
+Scope::Scope(std::string_view name)
+    : report_(active_report)
+{
+    if (report_ == nullptr)
+        return;
+    record_.name = name;
+    allocations_ = allocation_count();
+    bytes_ = allocated_bytes();
+    cpu_ = std::clock();
+    wall_ = std::chrono::steady_clock::now();
+}
+
+Scope::~Scope()
+{
+    finish();
+}
+
+void Scope::count(std::string_view what, std::size_t value)
+{
+    if (report_ != nullptr)
+        record_.counts.emplace_back(std::string{ what }, value);
+}
+
+void Scope::finish()
+{
+    if (report_ == nullptr)
+        return;
+    auto wall = std::chrono::steady_clock::now();
+    auto cpu = std::clock();
+
+    record_.wall_ms =
+        std::chrono::duration<double, std::milli>(wall - wall_).count();
+    record_.cpu_ms = 1000.0 * static_cast<double>(cpu - cpu_) / CLOCKS_PER_SEC;
+    record_.allocations = allocation_count() - allocations_;
+    record_.allocated_bytes = allocated_bytes() - bytes_;
+
+    report_->add(std::move(record_));
+    report_ = nullptr;
+}
+
+void Report::dump_table(std::ostream& os) const
+{
+    std::size_t width = 4;
+    for (auto const& record : records_)
+        width = std::max(width, record.name.size());
+
+    os << fmt::format("{:<{}}  {:>10}  {:>10}  {:>9}  {:>12}  {}\n",
+        "pass",
+        width,
+        "wall ms",
+        "cpu ms",
+        "allocs",
+        "bytes",
+        "counts");
+
+    Record total{};
+    total.name = "total";
+    for (auto const& record : records_) {
+        std::string counts{};
+        for (auto const& [what, value] : record.counts)
+            counts += fmt::format(
+                "{}{}={}", counts.empty() ? "" : " ", what, value);
+        os << fmt::format("{:<{}}  {:>10.3f}  {:>10.3f}  {:>9}  {:>12}  {}\n",
+            record.name,
+            width,
+            record.wall_ms,
+            record.cpu_ms,
+            record.allocations,
+            record.allocated_bytes,
+            counts);
+        total.wall_ms += record.wall_ms;
+        total.cpu_ms += record.cpu_ms;
+        total.allocations += record.allocations;
+        total.allocated_bytes += record.allocated_bytes;
+    }
+
+    os << fmt::format("{:<{}}  {:>10.3f}  {:>10.3f}  {:>9}  {:>12}\n",
+        total.name,
+        width,
+        total.wall_ms,
+        total.cpu_ms,
+        total.allocations,
+        total.allocated_bytes);
+}
+
+void Report::dump_json(std::ostream& os) const
+{
+    os << "{\"passes\": [";
+    for (std::size_t i = 0; i < records_.size(); ++i) {
+        auto const& record = records_[i];
+        os << (i == 0 ? "\n  " : ",\n  ");
+        os << fmt::format(
+            "{{\"name\": {}, \"wall_ms\": {:.6f}, \"cpu_ms\": {:.6f}, "
+            "\"allocations\": {}, \"allocated_bytes\": {}, \"counts\": {{",
+            json_string(record.name),
+            record.wall_ms,
+            record.cpu_ms,
+            record.allocations,
+            record.allocated_bytes);
+        for (std::size_t j = 0; j < record.counts.size(); ++j)
+            os << fmt::format("{}{}: {}",
+                j == 0 ? "" : ", ",
+                json_string(record.counts[j].first),
+                record.counts[j].second);
+        os << "}}";
+    }
+    os << "\n]}\n";
+}
+
+} // namespace credence::passes
+
+#if !defined(CREDENCE_TEST)
+
+void* operator new(std::size_t size)
+{
+    // a plain load while no Report is active, as main sets it once before
+    // the compilation starts
+    if (credence::passes::active_report != nullptr) {
+        credence::passes::allocations_seen.fetch_add(
+            1, std::memory_order_relaxed);
+        credence::passes::bytes_seen.fetch_add(
+            size, std::memory_order_relaxed);
+    }
+    for (;;) {
+        if (void* memory = std::malloc(size == 0 ? 1 : size))
+            return memory;
+        auto handler = std::get_new_handler();
+        if (handler == nullptr)
+            throw std::bad_alloc{};
+        handler();
+    }
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+#endif
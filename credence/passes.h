@@ -0,0 +1,145 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <chrono>      // for steady_clock
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t
+#include <ctime>       // for clock_t
+#include <iosfwd>      // for ostream
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <utility>     // for pair
+#include <vector>      // for vector
+
+/****************************************************************************
+ *
+ * Pass timing and memory report
+ *
+ * Each stage of the compiler opens a passes::Scope over the work it does.
+ * While a Report is active the scope measures, from the moment it opens to
+ * the moment it closes:
+ *
+ *    wall         steady clock time
+ *    cpu          process CPU time
+ *    allocations  the number of operator new calls, and the bytes asked for
+ *    counts       what the stage produced: tokens, nodes, quadruples, ...
+ *
+ * With no active Report a scope is one null pointer check, and so is each
+ * allocation, so the stages are instrumented unconditionally and pay no
+ * more than that outside --time-passes.
+ *
+ * Example:
+ *
+ *   $ credence --time-passes -t x86_64 program.b
+ *
+ *   pass               wall ms    cpu ms   allocs     bytes  counts
+ *   parse                0.412     0.409      318     21504  tokens=812 ...
+ *   lower                0.201     0.199      204     18432  hir_nodes=...
+ *   ...
+ *
+ * Allocations are counted by a replacement of the global operator new in
+ * passes.cc, which the test suite leaves out so that sanitizers keep their
+ * own. There they read zero.
+ *
+ *****************************************************************************/
+
+namespace credence::passes {
+
+/**
+ * @brief What one stage cost and produced
+ */
+struct Record
+{
+    std::string name;
+    double wall_ms{ 0 };
+    double cpu_ms{ 0 };
+    std::uint64_t allocations{ 0 };
+    std::uint64_t allocated_bytes{ 0 };
+    std::vector<std::pair<std::string, std::size_t>> counts{};
+};
+
+/**
+ * @brief Every stage recorded during one compilation, in the order run
+ */
+class Report
+{
+  public:
+    void add(Record record) { records_.push_back(std::move(record)); }
+
+    std::vector<Record> const& records() const { return records_; }
+
+    /**
+     * @brief Write the report as an aligned table, one stage per line
+     */
+    void dump_table(std::ostream& os) const;
+
+    /**
+     * @brief Write the report as one JSON object
+     */
+    void dump_json(std::ostream& os) const;
+
+  private:
+    std::vector<Record> records_{};
+};
+
+// When set, every passes::Scope records into this report and each
+// allocation is counted. Off (nullptr) by default, which makes a scope
+// free.
+inline Report* active_report = nullptr;
+
+/**
+ * @brief The number of global operator new calls so far, while a Report
+ * was active
+ */
+std::uint64_t allocation_count();
+
+/**
+ * @brief The bytes asked of the global operator new so far, while a
+ * Report was active
+ */
+std::uint64_t allocated_bytes();
+
+/**
+ * @brief Measure one stage from construction to finish() or destruction
+ */
+class Scope
+{
+  public:
+    explicit Scope(std::string_view name);
+    ~Scope();
+
+    Scope(Scope const&) = delete;
+    Scope& operator=(Scope const&) = delete;
+
+    /**
+     * @brief Attach an element count the stage produced
+     */
+    void count(std::string_view what, std::size_t value);
+
+    /**
+     * @brief Stop the clocks and record the stage now, and not at scope exit
+     */
+    void finish();
+
+  private:
+    Report* report_;
+    Record record_{};
+    std::chrono::steady_clock::time_point wall_{};
+    std::clock_t cpu_{ 0 };
+    std::uint64_t allocations_{ 0 };
+    std::uint64_t bytes_{ 0 };
+};
+
+} // namespace credence::passes
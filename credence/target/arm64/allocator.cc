@@ -0,0 +1,241 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include "allocator.h"
+
+#include "assembly.h"                         // for Instruction, Register
+#include "memory.h"                           // for Memory_Accessor, gener...
+#include "stack.h"                            // for Stack
+#include <credence/target/common/allocator.h> // for Intervals, linear_scan
+#include <credence/target/common/types.h>     // for Stack_Offset
+#include <cstddef>                            // for size_t
+#include <map>                                // for map
+#include <set>                                // for set
+#include <string>                             // for basic_string, string
+#include <tuple>                              // for get
+#include <utility>                            // for pair
+#include <variant>                            // for get, holds_alternative
+#include <vector>                             // for vector
+
+namespace credence::target::arm64 {
+
+namespace {
+
+using Offset = assembly::Stack::Offset;
+using common::allocator::Loops;
+using Operand_Size = assembly::Operand_Size;
+
+constexpr bool is_branch_mnemonic(Mnemonic mnemonic)
+{
+    switch (mnemonic) {
+        case Mnemonic::b:
+        case Mnemonic::b_eq:
+        case Mnemonic::b_ne:
+        case Mnemonic::b_lt:
+        case Mnemonic::b_le:
+        case Mnemonic::b_gt:
+        case Mnemonic::b_ge:
+        case Mnemonic::cbz:
+        case Mnemonic::cbnz:
+        case Mnemonic::tbz:
+        case Mnemonic::tbnz:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief The general purpose registers an ldr or str may name, but not
+ * the stack pointer, the zero registers, or the frame and link registers
+ */
+constexpr bool is_general_purpose_register(Register device)
+{
+    switch (device) {
+        case Register::sp:
+        case Register::xzr:
+        case Register::wsp:
+        case Register::wzr:
+        case Register::x29:
+        case Register::x30:
+        case Register::w29:
+        case Register::w30:
+            return false;
+        default:
+            return assembly::is_doubleword_register(device) or
+                   assembly::is_word_register(device);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Keep the scalar stack slots of the function inserted from the
+ * instruction index begin in callee-saved registers, and give back the
+ * registers the function must save
+ */
+memory::registers::general_purpose allocate_registers(
+    memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin)
+{
+    auto& instructions = accessor->instruction_accessor->get_instructions();
+    auto& stack = accessor->stack;
+    auto& flag_accessor = accessor->flag_accessor;
+    auto& table = accessor->table_accessor.get_table();
+    auto frame = table->get_functions().at(name);
+    std::size_t end = instructions.size();
+
+    // the offsets of a frame with callee saved tokens are moved by the
+    // visitor and emitter, so its slots stay where they are
+    if (not frame->get_tokens().empty())
+        return {};
+
+    // the labels of the function, and the epilogue from _L1 to the next
+    std::map<std::string, std::size_t> labels{};
+    std::size_t epilogue = end;
+    std::size_t epilogue_end = end;
+    for (std::size_t i = begin; i < end; i++) {
+        if (not std::holds_alternative<Label>(instructions[i]))
+            continue;
+        auto const& label = std::get<Label>(instructions[i]);
+        if (epilogue < i and epilogue_end == end)
+            epilogue_end = i;
+        if (label == "_L1")
+            epilogue = i;
+        labels[assembly::make_label(label, name)] = i;
+    }
+
+    Loops loops{};
+    for (std::size_t i = begin; i < end; i++) {
+        if (not std::holds_alternative<assembly::Instruction>(instructions[i]))
+            continue;
+        auto const& [mnemonic, s0, s1, s2, s3] =
+            std::get<assembly::Instruction>(instructions[i]);
+        if (not is_branch_mnemonic(mnemonic))
+            continue;
+        for (auto const* operand : { &s0, &s1, &s2 }) {
+            if (not std::holds_alternative<Immediate>(*operand))
+                continue;
+            auto const& to = std::get<0>(std::get<Immediate>(*operand));
+            if (labels.contains(to) and labels.at(to) <= i)
+                loops.emplace_back(labels.at(to), i);
+        }
+    }
+
+    // the slots of the vectors of the frame, each from its base offset
+    // through its elements either side of it
+    std::vector<std::pair<Offset, Offset>> vectors{};
+    for (auto const& [vector_name, vector] : table->get_vectors())
+        if (stack->contains(vector_name) and
+            stack->is_allocated(vector_name)) {
+            auto base = stack->get(vector_name).first;
+            auto size = stack->get_stack_size_from_table_vector(*vector);
+            vectors.emplace_back(base, size);
+        }
+
+    // the locals whose address is taken
+    std::set<std::string> pointers{};
+    for (auto const& pointer : frame->get_pointers())
+        pointers.insert(
+            pointer.starts_with("&") ? pointer.substr(1) : pointer);
+
+    auto is_register_slot = [&](Offset slot) {
+        auto lvalue = stack->get_lvalue_from_offset(slot);
+        if (lvalue.empty() or lvalue.starts_with("__") or lvalue == "argc" or
+            lvalue == "argv" or table->get_vectors().contains(lvalue) or
+            pointers.contains(lvalue))
+            return false;
+        for (auto [base, size] : vectors)
+            if (slot + size >= base and slot <= base + size)
+                return false;
+        auto size = stack->get_operand_size_from_offset(slot);
+        return size == Operand_Size::Word or size == Operand_Size::Doubleword;
+    };
+
+    auto is_register_use = [&](std::size_t index, Offset slot) {
+        auto const& [mnemonic, s0, s1, s2, s3] =
+            std::get<assembly::Instruction>(instructions[index]);
+        if (mnemonic != Mnemonic::ldr and mnemonic != Mnemonic::str)
+            return false;
+        if (flag_accessor.get_instruction_flags_at_index(index) != 0)
+            return false;
+        if (index >= epilogue and index < epilogue_end)
+            return false;
+        if (not std::holds_alternative<Register>(s0) or
+            not std::holds_alternative<Offset>(s1) or
+            not std::holds_alternative<std::monostate>(s2) or
+            not std::holds_alternative<std::monostate>(s3))
+            return false;
+        auto device = std::get<Register>(s0);
+        if (not is_general_purpose_register(device))
+            return false;
+        // the w or x view of the load or store is the size of the slot
+        auto size = assembly::is_doubleword_register(device)
+                        ? Operand_Size::Doubleword
+                        : Operand_Size::Word;
+        return size == stack->get_operand_size_from_offset(slot);
+    };
+
+    common::allocator::Intervals intervals{};
+    std::set<Offset> kept{};
+    for (std::size_t i = begin; i < end; i++) {
+        if (not std::holds_alternative<assembly::Instruction>(instructions[i]))
+            continue;
+        auto const& [mnemonic, s0, s1, s2, s3] =
+            std::get<assembly::Instruction>(instructions[i]);
+        for (auto const* operand : { &s0, &s1, &s2, &s3 }) {
+            if (not std::holds_alternative<Offset>(*operand))
+                continue;
+            auto slot = std::get<Offset>(*operand);
+            if (kept.contains(slot))
+                continue;
+            if (not is_register_slot(slot) or not is_register_use(i, slot)) {
+                kept.insert(slot);
+                intervals.erase(slot);
+                continue;
+            }
+            common::allocator::add_use_to_interval(intervals, slot, i, loops);
+        }
+    }
+
+    auto assigned = common::allocator::linear_scan(
+        intervals, loops, memory::registers::callee_saved_doubleword);
+
+    // ldr Rt, [sp, #N] is mov Rt, Rs and str Rt, [sp, #N] is mov Rs, Rt
+    for (auto const& [slot, doubleword] : assigned) {
+        auto device =
+            stack->get_operand_size_from_offset(slot) == Operand_Size::Word
+                ? assembly::get_word_register_from_doubleword(doubleword)
+                : doubleword;
+        for (auto index : intervals.at(slot).uses) {
+            auto& [mnemonic, s0, s1, s2, s3] =
+                std::get<assembly::Instruction>(instructions[index]);
+            if (mnemonic == Mnemonic::ldr)
+                s1 = device;
+            else {
+                s1 = s0;
+                s0 = device;
+            }
+            mnemonic = Mnemonic::mov;
+        }
+    }
+
+    // main never returns, so only the other functions save what they use
+    if (name == "main")
+        return {};
+    return common::allocator::get_saved_registers(
+        assigned, memory::registers::callee_saved_doubleword);
+}
+
+} // namespace credence::target::arm64
@@ -0,0 +1,71 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "memory.h"             // for Memory_Access, general_purpose
+#include <credence/ir/object.h> // for Label
+#include <cstddef>              // for size_t
+
+/****************************************************************************
+ *
+ * ARM64 Register Allocator
+ *
+ * The device accessor keeps the locals of a frame without calls in x9 to
+ * x18, but once a frame calls a function those caller-saved registers do
+ * not survive the call, so each local is given a stack slot and loaded to
+ * and stored from a scratch register at each use. Once the instructions
+ * of such a function are inserted, and while the stack still describes
+ * its frame, the slots of its scalar locals are given the callee-saved
+ * registers x20 to x28 by linear scan, see
+ * credence/target/common/allocator.h:
+ *
+ *   B code:                         Before:
+ *     f(n) {                          ldr w10, [sp, #20]
+ *       auto i;                       add w10, w10, #1
+ *       i = n;                        str w10, [sp, #20]
+ *       while (i < 10) {              bl g
+ *         i = i + 1;
+ *         g(i);                     After:
+ *       }                             mov w10, w20
+ *     }                               add w10, w10, #1
+ *                                     mov w20, w10
+ *                                     bl g
+ *
+ * A slot is given a register only if each instruction that uses it is an
+ * ldr or str of a general purpose register of its own size, so the w or
+ * x view of the register is kept. A slot is kept on the stack if its
+ * address is taken, if it is a vector or an element of one, if it is argc
+ * or argv, or if the epilogue after _L1 uses it, as the emitter moves the
+ * epilogue to the end of the function. x19 holds argc and argv and is not
+ * allocated.
+ *
+ * Each function but main saves the registers it was given in pairs before
+ * its prologue and restores them before it returns, which the emitter
+ * writes from the registers given back here.
+ *
+ *****************************************************************************/
+
+namespace credence::target::arm64 {
+
+/**
+ * @brief Keep the scalar stack slots of the function inserted from the
+ * instruction index begin in callee-saved registers, and give back the
+ * registers the function must save
+ */
+memory::registers::general_purpose allocate_registers(
+    memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin);
+
+} // namespace credence::target::arm64
@@ -19,10 +19,11 @@
 #include <credence/types.h>                  // for RValue, get_type_from_r...
 #include <credence/util.h>                   // for STRINGIFY, range_contains
 #include <cstddef>                           // for size_t
-#include <deque>                             // for deque
+#include <deque>                             // for deque, pmr::deque
 #include <fmt/format.h>                      // for format
 #include <initializer_list>                  // for initializer_list
 #include <matchit.h>                         // for pattern, PatternHelper
+#include <memory_resource>                   // for polymorphic_allocator
 #include <ostream>                           // for basic_ostream, operator<<
 #include <sstream>                           // for ostream
 #include <string>                            // for basic_string, char_traits
@@ -1448,7 +1449,8 @@ using Instruction = common::Mnemonic_4ARY<Mnemonic, Register>;
 using Literal_Type = std::variant<type::semantic::RValue, float, double>;
 using Data_Pair = std::pair<Directive, Literal_Type>;
 using Directives = std::deque<std::variant<Label, Data_Pair>>;
-using Instructions = std::deque<common::Instruction_4ARY<Mnemonic, Register>>;
+using Instructions =
+    std::pmr::deque<common::Instruction_4ARY<Mnemonic, Register>>;
 using Instruction_Pair = common::Instruction_Pair<Storage, Instructions>;
 using Immediate = common::Immediate;
 using Directive_Pair = std::pair<std::string, Directives>;
@@ -18,18 +18,26 @@
 #include "flags.h"                           // for ARM64_Instruction_Flag
 #include "inserter.h"                        // for Instruction, Instructio...
 #include "memory.h"                          // for Memory_Accessor, Addres...
+#include "peephole.h"                        // for rewrite_instructions
 #include "stack.h"                           // for Stack
+#include <credence/arena.h>                  // for Arena
 #include <credence/error.h>                  // for credence_assert, creden...
 #include <credence/ir/ita.h>                 // for make_ita_instructions
 #include <credence/ir/object.h>              // for Function, Object, RValue
+#include <credence/ir/optimize.h>            // for optimize
+#include <credence/ir/quadruple.h>           // for Operand_Scope
 #include <credence/ir/table.h>               // for Table
+#include <credence/passes.h>                 // for Scope
 #include <credence/symbol.h>                 // for Symbol_Table
 #include <credence/target/common/accessor.h> // for Buffer_Accessor
 #include <credence/target/common/assembly.h> // for direct_immediate, u32_i...
+#include <credence/target/common/options.h>  // for target_options
 #include <credence/target/common/runtime.h>  // for get_library_symbols
 #include <credence/types.h>                  // for get_value_from_rvalue_d...
 #include <credence/util.h>                   // for sv, AST_Node, get_numbe...
+#include <algorithm>                         // for reverse
 #include <cstddef>                           // for size_t
+#include <deque>                             // for deque
 #include <easyjson.h>                        // for JSON
 #include <fmt/base.h>                        // for copy
 #include <fmt/compile.h>                     // for format, operator""_cf
@@ -38,6 +46,7 @@
 #include <memory>                            // for make_shared, shared_ptr
 #include <ostream>                           // for basic_ostream, operator<<
 #include <ostream>                           // for ostream
+#include <string>                            // for basic_string, string
 #include <string_view>                       // for basic_string_view, oper...
 #include <tuple>                             // for get, tuple
 #include <utility>                           // for get, pair
@@ -111,17 +120,31 @@ namespace m = matchit;
  * @brief Assembly Emitter Factory
  */
 void emit(std::ostream& os,
-    util::AST_Node& symbols,
+    ir::Symbols& symbols,
     frontend::hir::Unit const& unit,
     bool no_stdlib)
 {
-    auto [globals, instructions] = ir::make_ita_instructions(unit, symbols);
+    // the instruction lists of this compilation are allocated from here
+    Arena arena{};
+    ir::Operand_Scope operands{};
+
+    passes::Scope ita_pass{ "ita" };
+    auto [globals, instructions] =
+        ir::make_ita_instructions(unit, symbols, arena.resource());
+    ita_pass.count("quadruples", instructions.size());
+    ita_pass.finish();
+
+    ir::optimize(instructions);
+
+    passes::Scope table_pass{ "table" };
     auto table = std::make_shared<ir::Table>(
         ir::Table{ symbols, instructions, globals });
     table->build_from_ir_instructions();
+    table_pass.count("quadruples", table->get_table_instructions()->size());
+    table_pass.finish();
     auto stack = std::make_shared<assembly::Stack>();
     auto accessor = std::make_shared<memory::Memory_Accessor>(
-        table->get_table_object(), stack);
+        table->get_table_object(), stack, arena.resource());
     auto emitter = Assembly_Emitter{ accessor };
     emitter.text_.test_no_stdlib = no_stdlib;
     emitter.emit(os);
@@ -133,10 +156,27 @@ void emit(std::ostream& os,
 void Assembly_Emitter::emit(std::ostream& os)
 {
     data_.set_data_section();
+
+    passes::Scope insert_pass{ "insert" };
     auto inserter = Instruction_Inserter{ accessor_ };
-    inserter.from_ir_instructions(ir_instructions_);
+    inserter.from_ir_instructions(*ir_instructions_);
+    auto instructions = accessor_->instruction_accessor->size();
+    insert_pass.count("instructions", instructions);
+    insert_pass.finish();
+
+    if (common::target_options.peephole) {
+        passes::Scope peephole_pass{ "peephole" };
+        for (auto const& [pattern, hits] : rewrite_instructions(accessor_))
+            peephole_pass.count(pattern, hits);
+        peephole_pass.count("removed",
+            instructions - accessor_->instruction_accessor->size());
+        instructions = accessor_->instruction_accessor->size();
+    }
+
+    passes::Scope emit_pass{ "emit" };
     text_.emit_text_section(os);
     data_.emit_data_section(os);
+    emit_pass.count("instructions", instructions);
 }
 
 /**
@@ -611,9 +651,8 @@ void Text_Emitter::emit_assembly_label(std::ostream& os,
 {
     auto& table = accessor_->table_accessor.get_table();
     // function labels
-    if (table->get_hoisted_symbols().has_key(s) and
-        table->get_hoisted_symbols()[s]["type"].to_string() ==
-            "function_definition") {
+    auto const* symbol = table->get_hoisted_symbols().find(s);
+    if (symbol != nullptr and symbol->shape == ir::Shape::Function_Definition) {
         // callee saved registers are saved as "tokens" on the frame object
         if (!accessor_->get_frame_in_memory()
                 .get_stack_frame(s)
@@ -638,6 +677,7 @@ void Text_Emitter::emit_assembly_label(std::ostream& os,
             assembly::newline(os, 2);
         os << assembly::make_label(s) << ":";
         assembly::newline(os, 1);
+        emit_saved_registers(os, Mnemonic::stp);
         return;
     }
     // branch labels
@@ -725,6 +765,9 @@ void Text_Emitter::emit_assembly_instruction(std::ostream& os,
                                             std::get<Immediate>(src4)) == "0x0")
         set_alignment_flag_inline(Align_S3_Folded, index);
 
+    if (mnemonic == Mnemonic::ret)
+        emit_saved_registers(os, Mnemonic::ldp);
+
     os << assembly::tabwidth(4) << mnemonic;
 
     storage_emitter.emit(os, src1, mnemonic, Storage_Emitter::Source::s_0);
@@ -742,6 +785,36 @@ void Text_Emitter::emit_assembly_instruction(std::ostream& os,
         assembly::newline(os, 1);
 }
 
+/**
+ * @brief Emit the stp of each pair of registers the frame saves before its
+ * prologue, or the ldp of each in reverse before it returns
+ */
+void Text_Emitter::emit_saved_registers(std::ostream& os, Mnemonic mnemonic)
+{
+    if (not accessor_->saved_registers.contains(frame_))
+        return;
+    auto const& saved = accessor_->saved_registers.at(frame_);
+    bool save = mnemonic == Mnemonic::stp;
+    std::deque<std::string> pairs{};
+    for (std::size_t i = 0; i < saved.size(); i += 2) {
+        // a lone register still takes 16 bytes to keep sp aligned
+        bool single = i + 1 == saved.size();
+        auto devices = assembly::register_as_string(saved[i]);
+        if (not single)
+            devices += ", " + assembly::register_as_string(saved[i + 1]);
+        pairs.emplace_back(fmt::format("{} {}, {}",
+            save ? (single ? "str" : "stp") : (single ? "ldr" : "ldp"),
+            devices,
+            save ? "[sp, #-16]!" : "[sp], #16"));
+    }
+    if (not save)
+        std::ranges::reverse(pairs);
+    for (auto const& pair : pairs) {
+        os << assembly::tabwidth(4) << pair;
+        assembly::newline(os, 1);
+    }
+}
+
 /**
  * @brief Emit the text instruction for either a label or mnemonic
  */
@@ -796,11 +869,11 @@ void Text_Emitter::emit_function_epilogue(std::ostream& os)
 void Text_Emitter::emit_text_section(std::ostream& os)
 {
     auto instructions_accessor = accessor_->instruction_accessor;
-    const Instructions instructions = instructions_accessor->get_instructions();
+    auto const& instructions = instructions_accessor->get_instructions();
     emit_text_directives(os);
     for (std::size_t index = 0; index < instructions_accessor->size(); index++)
         emit_text_instruction(os, instructions[index], index);
-    if (!return_instructions_.empty() and frame_ == "main")
+    if (!return_instructions_.empty())
         emit_function_epilogue(os);
 }
 
@@ -103,7 +103,7 @@ using Operand_Stack = std::deque<Storage>;
 }
 
 void emit(std::ostream& os,
-    util::AST_Node& symbols,
+    ir::Symbols& symbols,
     frontend::hir::Unit const& unit,
     bool no_stdlib);
 
@@ -216,6 +216,7 @@ class Text_Emitter
         bool set_label = true);
     void emit_function_epilogue(std::ostream& os);
     void emit_epilogue_jump(std::ostream& os);
+    void emit_saved_registers(std::ostream& os, Mnemonic mnemonic);
 
   public:
     bool test_no_stdlib{ false };
@@ -285,7 +286,7 @@ class Assembly_Emitter
         : accessor_(std::move(accessor))
     {
         ir_instructions_ =
-            *accessor_->table_accessor.get_table()->get_ir_instructions();
+            accessor_->table_accessor.get_table()->get_ir_instructions();
     }
 
   public:
@@ -295,7 +296,8 @@ class Assembly_Emitter
     memory::Memory_Access accessor_;
 
   private:
-    ir::Instructions ir_instructions_;
+    // the instructions of the table, shared rather than copied
+    ir::object::Instruction_PTR ir_instructions_;
 
     // clang-format off
   CREDENCE_PRIVATE_UNLESS_TESTED:
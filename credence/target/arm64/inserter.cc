@@ -101,14 +101,15 @@ void Bitwise_Operator_Inserter::get_operand_stack_from_temporary_lvalue(
     auto rvalue = table->lvalue_at_temporary_object_address(lvalue, frame);
     auto& locals = frame->get_locals();
 
-    if (type::is_unary_expression(rvalue))
+    if (is_unary_expression(rvalue))
         get_operand_stack_from_temporary_lvalue(
             type::get_unary_rvalue_reference(rvalue), stack);
-    if (type::is_binary_expression(rvalue)) {
-        auto [left, right, op] = type::from_rvalue_binary_expression(rvalue);
-        if (type::is_rvalue_data_type(left))
+    if (auto const& value = ir::value_of(rvalue); value.is_binary()) {
+        auto left = ir::text_of(value.lhs);
+        auto right = ir::text_of(value.rhs);
+        if (is_immediate(left))
             get_operand_stack_from_temporary_lvalue(left, stack);
-        if (type::is_rvalue_data_type(right))
+        if (is_immediate(right))
             get_operand_stack_from_temporary_lvalue(right, stack);
         if (locals.is_defined(left))
             stack.emplace_back(
@@ -117,8 +118,8 @@ void Bitwise_Operator_Inserter::get_operand_stack_from_temporary_lvalue(
             stack.emplace_back(
                 accessor_->device_accessor.get_operand_rvalue_device(right));
     }
-    if (type::is_rvalue_data_type(rvalue))
-        stack.emplace_back(type::get_data_type_from_string(rvalue));
+    if (is_immediate(rvalue))
+        stack.emplace_back(immediate_of(rvalue));
     if (locals.is_defined(rvalue))
         stack.emplace_back(
             accessor_->device_accessor.get_operand_rvalue_device(rvalue));
@@ -130,7 +131,6 @@ void Bitwise_Operator_Inserter::get_operand_stack_from_temporary_lvalue(
 void Bitwise_Operator_Inserter::from_bitwise_temporary_expression(
     RValue const& rvalue)
 {
-    credence_assert(type::is_binary_expression(rvalue));
     auto frame = accessor_->get_frame_in_memory().get_stack_frame();
     auto& instructions = accessor_->instruction_accessor->get_instructions();
     auto& immediate_stack = accessor_->address_accessor.immediate_stack;
@@ -142,8 +142,11 @@ void Bitwise_Operator_Inserter::from_bitwise_temporary_expression(
     Storage rhs_s{};
 
     Operand_Inserter operand_inserter{ accessor_ };
-    auto expression = type::from_rvalue_binary_expression(rvalue);
-    auto [lhs, rhs, op] = expression;
+    auto const& expression = ir::value_of(rvalue);
+    credence_assert(expression.is_binary());
+    auto const& lhs = ir::text_of(expression.lhs);
+    auto const& rhs = ir::text_of(expression.rhs);
+    auto op = std::string{ expression.binary };
     auto immediate = false;
     auto is_address = [&](RValue const& rvalue) {
         return devices.is_lvalue_allocated_in_memory(rvalue);
@@ -268,7 +271,7 @@ void Instruction_Inserter::setup_stack_frame_in_function(
     int index)
 {
     auto stack_frame = accessor_->get_frame_in_memory();
-    auto symbol = std::get<1>(ir_instructions.at(index - 1));
+    auto symbol = ir::get<1>(ir_instructions.at(index - 1));
     auto name = type::get_label_as_human_readable(symbol);
     stack_frame.set_stack_frame(name);
     accessor_->device_accessor.set_current_frame_symbol(name);
@@ -344,7 +347,7 @@ common::Stack_Offset Unary_Operator_Inserter::from_lvalue_address_of_expression(
     auto& instruction_accessor = accessor_->instruction_accessor;
     auto& address_space = accessor_->address_accessor;
 
-    credence_assert(type::is_unary_expression(expr));
+    credence_assert(is_unary_expression(expr));
 
     auto op = type::get_unary_operator(expr);
     RValue rvalue = type::get_unary_rvalue_reference(expr);
@@ -387,7 +390,7 @@ void Instruction_Inserter::from_ir_instructions(
         auto inst = ir_instructions[index];
         ir_visitor.set_iterator_index(index);
         accessor_->table_accessor.set_ir_iterator_index(index);
-        ir::Instruction ita_inst = std::get<0>(inst);
+        ir::Instruction ita_inst = ir::get<0>(inst);
         m::match(ita_inst)(
             m::pattern | ir::Instruction::FUNC_START =
                 [&] {
@@ -427,7 +430,6 @@ void Instruction_Inserter::from_ir_instructions(
 void Binary_Operator_Inserter::from_binary_operator_expression(
     RValue const& rvalue)
 {
-    credence_assert(type::is_binary_expression(rvalue));
     auto& instructions = accessor_->instruction_accessor->get_instructions();
     auto& table_accessor = accessor_->table_accessor;
     auto& addresses = accessor_->address_accessor;
@@ -439,8 +441,11 @@ void Binary_Operator_Inserter::from_binary_operator_expression(
     Storage rhs_s{};
 
     Operand_Inserter operand_inserter{ accessor_ };
-    auto expression = type::from_rvalue_binary_expression(rvalue);
-    auto [lhs, rhs, op] = expression;
+    auto const& expression = ir::value_of(rvalue);
+    credence_assert(expression.is_binary());
+    auto const& lhs = ir::text_of(expression.lhs);
+    auto const& rhs = ir::text_of(expression.rhs);
+    auto op = std::string{ expression.binary };
     auto immediate = false;
     auto is_address = [&](RValue const& rvalue) {
         return devices.is_lvalue_allocated_in_memory(rvalue);
@@ -649,7 +654,7 @@ Operand_Size Unary_Operator_Inserter::get_operand_size_from_lvalue_reference(
     auto& instructions = accessor_->instruction_accessor->get_instructions();
     auto is_vector = [&](RValue const& rvalue) {
         return accessor_->table_accessor.get_table()->get_vectors().contains(
-            type::from_lvalue_offset(rvalue));
+            vector_of_offset(rvalue));
     };
     auto is_address = [&](RValue const& rvalue) {
         return accessor_->device_accessor.is_lvalue_allocated_in_memory(rvalue);
@@ -669,7 +674,7 @@ Operand_Size Unary_Operator_Inserter::get_operand_size_from_lvalue_reference(
             },
         m::pattern | m::_ =
             [&] {
-                auto immediate = type::get_data_type_from_string(lvalue);
+                auto immediate = immediate_of(lvalue);
                 return assembly::get_operand_size_from_data_type(immediate);
             });
 }
@@ -689,7 +694,7 @@ Storage Unary_Operator_Inserter::get_temporary_storage_from_temporary_expansion(
 Storage Unary_Operator_Inserter::insert_from_unary_operator_rvalue(
     RValue const& expr)
 {
-    credence_assert(type::is_unary_expression(expr));
+    credence_assert(is_unary_expression(expr));
     auto instruction_accessor = accessor_->instruction_accessor;
     auto& devices = accessor_->device_accessor;
     auto& instructions = instruction_accessor->get_instructions();
@@ -701,7 +706,7 @@ Storage Unary_Operator_Inserter::insert_from_unary_operator_rvalue(
     RValue rvalue = type::get_unary_rvalue_reference(expr);
     auto is_vector = [&](RValue const& rvalue) {
         return accessor_->table_accessor.get_table()->get_vectors().contains(
-            type::from_lvalue_offset(rvalue));
+            vector_of_offset(rvalue));
     };
     auto is_address = [&](RValue const& rvalue) {
         return accessor_->device_accessor.is_lvalue_allocated_in_memory(rvalue);
@@ -732,7 +737,7 @@ Storage Unary_Operator_Inserter::insert_from_unary_operator_rvalue(
 
         m::pattern | m::_ =
             [&] {
-                auto immediate = type::get_data_type_from_string(rvalue);
+                auto immediate = immediate_of(rvalue);
                 storage =
                     get_temporary_storage_from_temporary_expansion(rvalue);
                 insert_from_unary_operator_operands(op, storage, immediate);
@@ -856,7 +861,7 @@ void Expression_Inserter::insert_from_address_of_rvalue(RValue const& rvalue)
     auto& table = accessor_->table_accessor.get_table();
     auto& instructions = instruction_accessor->get_instructions();
     if (accessor_->table_accessor.next_ir_instruction_is_assignment()) {
-        auto lvalue = std::get<1>(table->get_ir_instructions()->at(
+        auto lvalue = ir::get<1>(table->get_ir_instructions()->at(
             accessor_->table_accessor.get_index() + 1));
         auto lhs_s = accessor_->device_accessor.get_device_by_lvalue(lvalue);
         accessor_->address_accessor.address_ir_assignment = true;
@@ -916,9 +921,9 @@ void Expression_Inserter::insert_from_temporary_rvalue(RValue const& rvalue)
     m::match(rvalue)(
         m::pattern | m::app(type::is_bitwise_binary_expression, true) =
             [&] { bitwise_inserter.from_bitwise_temporary_expression(rvalue); },
-        m::pattern | m::app(type::is_binary_expression, true) =
+        m::pattern | m::app(is_binary_expression, true) =
             [&] { binary_inserter.from_binary_operator_expression(rvalue); },
-        m::pattern | m::app(type::is_unary_expression, true) =
+        m::pattern | m::app(is_unary_expression, true) =
             [&] {
                 if (type::is_address_of_expression(rvalue)) {
                     insert_from_address_of_rvalue(rvalue);
@@ -926,7 +931,7 @@ void Expression_Inserter::insert_from_temporary_rvalue(RValue const& rvalue)
                 }
                 unary_inserter.insert_from_unary_operator_rvalue(rvalue);
             },
-        m::pattern | m::app(type::is_rvalue_data_type, true) =
+        m::pattern | m::app(is_immediate, true) =
             [&] {
                 Storage immediate =
                     operand_inserter.get_operand_storage_from_rvalue(rvalue);
@@ -1077,10 +1082,10 @@ void Operand_Inserter::insert_from_binary_operands(
                                             ->get_ir_instructions();
                 auto ir_index = accessor_->table_accessor.get_index();
                 if (ir_instructions->size() > ir_index and
-                    std::get<0>(ir_instructions->at(ir_index + 1)) ==
+                    ir::get<0>(ir_instructions->at(ir_index + 1)) ==
                         ir::Instruction::IF) {
                     auto label = assembly::make_label(
-                        std::get<3>(ir_instructions->at(ir_index + 1)),
+                        ir::get<3>(ir_instructions->at(ir_index + 1)),
                         stack_frame_.symbol);
                     assembly::inserter(instructions,
                         relational.from_relational_expression_operands(
@@ -1094,10 +1099,10 @@ void Operand_Inserter::insert_from_binary_operands(
                                             ->get_ir_instructions();
                 auto ir_index = accessor_->table_accessor.get_index();
                 if (ir_instructions->size() > ir_index and
-                    std::get<0>(ir_instructions->at(ir_index + 1)) ==
+                    ir::get<0>(ir_instructions->at(ir_index + 1)) ==
                         ir::Instruction::IF) {
                     auto label = assembly::make_label(
-                        std::get<3>(ir_instructions->at(ir_index + 1)),
+                        ir::get<3>(ir_instructions->at(ir_index + 1)),
                         stack_frame_.symbol);
                     assembly::inserter(instructions,
                         relational.from_relational_expression_operands(
@@ -1227,7 +1232,7 @@ void Operand_Inserter::insert_from_mnemonic_operand(LValue const& lhs,
     m::match(rhs)(
         m::pattern | m::app(is_immediate, true) =
             [&] {
-                auto imm = type::get_data_type_from_string(rhs);
+                auto imm = immediate_of(rhs);
                 auto [lhs_storage, storage_inst] =
                     accessor_->address_accessor
                         .get_arm64_lvalue_and_insertion_instructions(
@@ -1250,12 +1255,12 @@ void Operand_Inserter::insert_from_mnemonic_operand(LValue const& lhs,
                 else
                     arm64_add__asm(instructions, mov, lhs_storage, imm);
             },
-        m::pattern | m::app(type::is_binary_expression, true) =
+        m::pattern | m::app(is_binary_expression, true) =
             [&] {
                 auto binary_inserter = Binary_Operator_Inserter{ accessor_ };
                 binary_inserter.from_binary_operator_expression(rhs);
             },
-        m::pattern | m::app(type::is_unary_expression, true) =
+        m::pattern | m::app(is_unary_expression, true) =
             [&] {
                 auto unary_inserter = Unary_Operator_Inserter{ accessor_ };
 
@@ -1309,7 +1314,7 @@ void Operand_Inserter::insert_from_mnemonic_operand(LValue const& lhs,
                         auto acc =
                             accumulator.get_accumulator_register_from_size(
                                 size);
-                        if (!type::is_unary_expression(lhs))
+                        if (!is_unary_expression(lhs))
                             accessor_->device_accessor.insert_lvalue_to_device(
                                 lhs);
                         auto [lhs_storage, storage_inst] =
@@ -1370,7 +1375,7 @@ Storage Operand_Inserter::get_operand_storage_from_immediate(
     RValue const& rvalue)
 {
     Storage storage{};
-    auto immediate = type::get_data_type_from_string(rvalue);
+    auto immediate = immediate_of(rvalue);
     auto type = type::get_type_from_rvalue_data_type(immediate);
     if (type == "string") {
         storage = assembly::make_asciz_immediate(accessor_->address_accessor
@@ -1391,7 +1396,7 @@ Storage Operand_Inserter::get_operand_storage_from_immediate(
         return storage;
     }
 
-    storage = type::get_data_type_from_string(rvalue);
+    storage = immediate_of(rvalue);
     return storage;
 }
 
@@ -1417,7 +1422,7 @@ Storage Operand_Inserter::get_operand_storage_from_parameter(
             if (!is_vector_offset(rvalue))
                 common::runtime::throw_runtime_error(
                     "invalid argv access, argv is a vector to strings", rvalue);
-            auto offset = type::from_decay_offset(rvalue);
+            auto offset = offset_of(rvalue);
             if (!util::is_numeric(offset) and
                 not accessor_->address_accessor.is_lvalue_storage_type(
                     offset, "int"))
@@ -1461,12 +1466,12 @@ Storage Operand_Inserter::get_operand_storage_from_rvalue(RValue const& rvalue)
 
 #endif
 
-    if (type::is_unary_expression(rvalue)) {
+    if (is_unary_expression(rvalue)) {
         auto unary_inserter = Unary_Operator_Inserter{ accessor_ };
         return unary_inserter.insert_from_unary_operator_rvalue(rvalue);
     }
 
-    if (type::is_rvalue_data_type(rvalue))
+    if (is_immediate(rvalue))
         return get_operand_storage_from_immediate(rvalue);
 
     auto& instructions = accessor_->instruction_accessor->get_instructions();
@@ -1501,12 +1506,12 @@ Storage Operand_Inserter::get_operand_storage_from_rvalue_no_instructions(
 
 #endif
 
-    if (type::is_unary_expression(rvalue)) {
+    if (is_unary_expression(rvalue)) {
         auto unary_inserter = Unary_Operator_Inserter{ accessor_ };
         return unary_inserter.insert_from_unary_operator_rvalue(rvalue);
     }
 
-    if (type::is_rvalue_data_type(rvalue))
+    if (is_immediate(rvalue))
         return get_operand_storage_from_immediate(rvalue);
 
     auto& instructions = accessor_->instruction_accessor->get_instructions();
@@ -1553,8 +1558,8 @@ Invocation_Inserter::get_operands_storage_from_argument_stack()
                         rvalue);
             if (is_variant(Register, operand) and
                 std::get<Register>(operand) == Register::x15) {
-                auto lhs = type::from_lvalue_offset(rvalue);
-                auto offset = type::from_decay_offset(rvalue);
+                auto lhs = vector_of_offset(rvalue);
+                auto offset = offset_of(rvalue);
                 auto vector = table->get_vectors().at(lhs);
                 auto vector_s =
                     accessor_->stack->get_stack_offset_from_table_vector_index(
@@ -1598,10 +1603,16 @@ void Invocation_Inserter::insert_from_user_defined_function(
         auto argument = stack_frame_.argument_stack.at(i);
         auto arg_type = type::get_type_from_rvalue_data_type(argument);
         auto arg_register = assembly::get_register_from_integer_argument(i);
-        if (type::from_lvalue_offset(argument) == "argv") {
-            auto offset = type::from_lvalue_offset(argument);
+        if (vector_of_offset(argument) == "argv") {
+            auto offset = offset_of(argument);
+            if (!util::is_numeric(offset))
+                throw_compiletime_error(
+                    fmt::format("invalid argv access, argv offset '{}' is not "
+                                "a constant",
+                        offset),
+                    argument);
             auto argv_address = accessor_->stack->get("argv").first;
-            auto offset_integer = type::integral_from_type_ulint(offset);
+            auto offset_integer = ir::value_of(offset).integer;
             auto argv_offset =
                 direct_immediate(fmt::format("[x10, #{}]", 8 * offset_integer));
             arm64_add__asm(instructions, ldr, x10, argv_address);
@@ -1828,7 +1839,7 @@ void Operand_Inserter::insert_from_string_address_operand(
     auto instruction_accessor = accessor_->instruction_accessor;
     auto& instructions = instruction_accessor->get_instructions();
     auto expression_inserter = Expression_Inserter{ accessor_ };
-    auto imm = type::get_data_type_from_string(rhs);
+    auto imm = immediate_of(rhs);
     expression_inserter.insert_from_string(
         type::get_value_from_rvalue_data_type(imm));
     if (is_variant(assembly::Stack::Offset, storage)) {
@@ -136,8 +136,7 @@ using ARM64_Operand_Inserter =
 
 inline auto get_rvalue_pair_as_immediate(RValue const& lhs, RValue const& rhs)
 {
-    return std::make_pair(type::get_data_type_from_string(lhs),
-        type::get_data_type_from_string(rhs));
+    return std::make_pair(immediate_of(lhs), immediate_of(rhs));
 }
 
 /**
@@ -0,0 +1,116 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include "leaf.h"
+
+#include "assembly.h"                     // for Instruction, Register
+#include "flags.h"                        // for ARM64_Instruction_Flag
+#include "memory.h"                       // for Memory_Accessor
+#include <credence/target/common/flags.h> // for Instruction_Flag
+#include <credence/target/common/leaf.h>  // for remove_instructions
+#include <credence/target/common/types.h> // for Stack_Offset, Label
+#include <string>                         // for basic_string, string
+#include <tuple>                          // for get
+#include <variant>                        // for get, holds_alternative
+#include <vector>                         // for vector
+
+namespace credence::target::arm64 {
+
+namespace {
+
+// the flags of an instruction the emitter writes an offset of the frame
+// into
+constexpr common::flag::flags frame_flags =
+    detail::flags::Align_Folded | detail::flags::Align_SP |
+    detail::flags::Align_SP_Folded | detail::flags::Align_S3_Folded |
+    detail::flags::Align_SP_Local | detail::flags::Align_S2_Folded |
+    detail::flags::Vector_Storage | common::flag::Align;
+
+constexpr bool is_register(Storage const& storage, Register device)
+{
+    return std::holds_alternative<Register>(storage) and
+           std::get<Register>(storage) == device;
+}
+
+/**
+ * @brief Whether a storage device is a stack slot, the stack pointer, the
+ * frame record, or an address from sp
+ */
+bool is_frame_storage(Storage const& storage)
+{
+    if (std::holds_alternative<common::Stack_Offset>(storage))
+        return true;
+    if (std::holds_alternative<Immediate>(storage))
+        return std::get<0>(std::get<Immediate>(storage)).find("sp") !=
+               std::string::npos;
+    return is_register(storage, Register::sp) or
+           is_register(storage, Register::x29) or
+           is_register(storage, Register::x30) or
+           is_register(storage, Register::w29) or
+           is_register(storage, Register::w30);
+}
+
+} // namespace
+
+/**
+ * @brief Drop the frame record of the leaf function inserted from the
+ * instruction index begin if it never reads sp, and give back whether it
+ * did
+ */
+bool elide_stack_frame(memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin)
+{
+    auto& instructions = accessor->instruction_accessor->get_instructions();
+    auto& table = accessor->table_accessor.get_table();
+    if (name == "main" or
+        table->stack_frame_contains_call_instruction(
+            name, *table->get_ir_instructions()))
+        return false;
+
+    std::vector<bool> removed(instructions.size(), false);
+    for (std::size_t i = begin; i < instructions.size(); i++) {
+        if (not std::holds_alternative<assembly::Instruction>(instructions[i]))
+            continue;
+        auto const& [mnemonic, s0, s1, s2, s3] =
+            std::get<assembly::Instruction>(instructions[i]);
+        bool is_record = is_register(s0, Register::x29) and
+                         is_register(s1, Register::x30);
+        bool is_prologue =
+            (i == begin and mnemonic == Mnemonic::stp and is_record) or
+            (i == begin + 1 and mnemonic == Mnemonic::mov and
+                is_register(s0, Register::x29) and
+                is_register(s1, Register::sp));
+        bool is_epilogue = mnemonic == Mnemonic::ldp and is_record;
+        if (is_prologue or is_epilogue) {
+            removed[i] = true;
+            continue;
+        }
+        auto flags =
+            accessor->flag_accessor.get_instruction_flags_at_index(i);
+        if (flags & frame_flags)
+            return false;
+        for (auto const* operand : { &s0, &s1, &s2, &s3 })
+            if (is_frame_storage(*operand))
+                return false;
+    }
+    if (begin + 1 >= removed.size() or not removed[begin] or
+        not removed[begin + 1])
+        return false;
+
+    common::leaf::remove_instructions(
+        instructions, accessor->flag_accessor, removed);
+    return true;
+}
+
+} // namespace credence::target::arm64
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "memory.h"             // for Memory_Access
+#include <credence/ir/object.h> // for Label
+#include <cstddef>              // for size_t
+
+/****************************************************************************
+ *
+ * ARM64 Leaf Functions
+ *
+ * A function that calls nothing never overwrites x30 with a bl, so it
+ * needs no frame record to return. The locals of a frame without calls
+ * are kept in x9 - x18 before the stack is used, so a leaf often never
+ * reads sp at all, and then its frame record is dropped. See
+ * credence/target/common/leaf.h:
+ *
+ *   Before:                           After:
+ *     stp x29, x30, [sp, #-16]!         mov w9, w0
+ *     mov x29, sp                       mul w8, w9, w9
+ *     mov w9, w0                        mov w0, w8
+ *     mul w8, w9, w9                    ret
+ *     mov w0, w8
+ *     ldp x29, x30, [sp], #16
+ *     ret
+ *
+ * The emitter writes the offsets of the frame from the flags of each
+ * instruction, so a leaf whose instructions take a stack slot, an address
+ * from sp, or a flag the emitter aligns by the frame keeps its frame
+ * record and the sp-relative addresses it already has. main is left as
+ * it is, as it keeps argc and argv from the frame.
+ *
+ *****************************************************************************/
+
+namespace credence::target::arm64 {
+
+/**
+ * @brief Drop the frame record of the leaf function inserted from the
+ * instruction index begin if it never reads sp, and give back whether it
+ * did
+ */
+bool elide_stack_frame(memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin);
+
+} // namespace credence::target::arm64
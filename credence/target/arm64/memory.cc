@@ -167,9 +167,9 @@ constexpr bool arm64_is_binary_data_type_expression(Immediate const& immediate)
     if (util::substring_count_of(rvalue, " ") != 2)
         return false;
     auto test = type::from_rvalue_binary_expression(rvalue);
-    if (!type::is_rvalue_data_type(std::get<0>(test)))
+    if (!is_immediate(std::get<0>(test)))
         return false;
-    if (!type::is_rvalue_data_type(std::get<1>(test)))
+    if (!is_immediate(std::get<1>(test)))
         return false;
     return true;
 }
@@ -212,8 +212,8 @@ Register Accumulator_Accessor::get_accumulator_register_from_size(
 Device_Accessor::Device Device_Accessor::get_operand_rvalue_device(
     RValue const& rvalue)
 {
-    if (type::is_rvalue_data_type(rvalue))
-        return type::get_data_type_from_string(rvalue);
+    if (is_immediate(rvalue))
+        return immediate_of(rvalue);
     else if (is_lvalue_allocated_in_memory(rvalue))
         return get_device_by_lvalue(rvalue);
     else {
@@ -243,8 +243,8 @@ Address_Accessor::get_lvalue_address_and_from_unary_and_vectors(
     std::size_t instruction_index)
 {
     auto vector_accessor = Vector_Accessor{ table_ };
-    auto lhs = type::from_lvalue_offset(lvalue);
-    auto offset = type::from_decay_offset(lvalue);
+    auto lhs = vector_of_offset(lvalue);
+    auto offset = offset_of(lvalue);
     auto& inst = instructions.second;
     m::match(lvalue)(
         m::pattern | m::app(is_global_vector, true) =
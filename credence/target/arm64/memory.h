@@ -28,6 +28,7 @@
 #include <deque>                                // for deque
 #include <functional>                           // for function
 #include <memory>                               // for shared_ptr, make_shared
+#include <memory_resource>                      // for memory_resource, get_de...
 #include <set>                                  // for set
 #include <string>                               // for basic_string, string
 #include <utility>                              // for move
@@ -52,6 +53,8 @@
  *   x9 - x18 = If there are no function calls in a stack frame, local scope
  *             variables are stored in x9-x18, after which the stack is used
  *   x19      = The argc, argv scratch register
+ *   x20 - x28 = Callee-saved, scalar locals of frames with function calls
+ *              with --regalloc, see allocator.h
  *
  *   Vectors and vector offsets will always be on the stack
  *
@@ -78,10 +81,15 @@ using Directives = assembly::Directives;
 /**
  * Short-form helpers for matchit predicate pattern matching
  */
+using common::memory::immediate_of;
+using common::memory::is_binary_expression;
 using common::memory::is_immediate;
 using common::memory::is_parameter;
 using common::memory::is_temporary;
+using common::memory::is_unary_expression;
 using common::memory::is_vector_offset;
+using common::memory::offset_of;
+using common::memory::vector_of_offset;
 
 namespace memory {
 
@@ -135,6 +143,20 @@ const general_purpose available_word_argument = { Register::w0,
     Register::w7,
     Register::x8 };
 
+// the callee-saved registers the register allocator hands out, x19 holds
+// argc and argv
+const general_purpose callee_saved_doubleword = {
+    Register::x20,
+    Register::x21,
+    Register::x22,
+    Register::x23,
+    Register::x24,
+    Register::x25,
+    Register::x26,
+    Register::x27,
+    Register::x28,
+};
+
 } // namespace registers
 
 using Memory_Access = std::shared_ptr<Memory_Accessor>;
@@ -209,7 +231,9 @@ struct Accumulator_Accessor : public ARM64_Accumulator_Accessor
 };
 
 struct Instruction_Accessor : public ARM64_Instruction_Accessor
-{};
+{
+    using ARM64_Instruction_Accessor::ARM64_Instruction_Accessor;
+};
 
 struct Register_Accessor : public ARM64_Register_Accessor
 {
@@ -368,7 +392,9 @@ class Memory_Accessor final : public ARM64_Memory_Accessor
   public:
     Memory_Accessor() = delete;
 
-    explicit Memory_Accessor(Table_Pointer table, Stack_Pointer stack_pointer)
+    explicit Memory_Accessor(Table_Pointer table,
+        Stack_Pointer stack_pointer,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
         : ARM64_Memory_Accessor(table)
         , table_(std::move(table))
         , stack(std::move(stack_pointer))
@@ -378,7 +404,8 @@ class Memory_Accessor final : public ARM64_Memory_Accessor
         , register_accessor{ &signal_register }
         , address_accessor{ table_, stack, flag_accessor, register_accessor }
     {
-        instruction_accessor = std::make_shared<detail::Instruction_Accessor>();
+        instruction_accessor =
+            std::make_shared<detail::Instruction_Accessor>(resource);
     }
 
   public:
@@ -412,6 +439,8 @@ class Memory_Accessor final : public ARM64_Memory_Accessor
         get_frame_in_memory(),
         stack };
     Instruction_Pointer instruction_accessor{};
+    // the callee-saved registers each function saves, see allocator.h
+    Ordered_Map<Label, registers::general_purpose> saved_registers{};
 };
 
 } // namespace memory
@@ -0,0 +1,228 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include "peephole.h"
+
+#include "assembly.h"                        // for Instruction, Register
+#include "memory.h"                          // for Memory_Accessor
+#include <credence/target/common/peephole.h> // for Pattern, Window, Hits
+#include <credence/target/common/types.h>    // for Stack_Offset, Label
+#include <functional>                        // for function
+#include <string>                            // for basic_string, string
+#include <string_view>                       // for string_view
+#include <tuple>                             // for get
+#include <variant>                           // for get, holds_alternative
+#include <vector>                            // for vector
+
+namespace credence::target::arm64 {
+
+namespace {
+
+using Entry = assembly::Instructions::value_type;
+using Window = common::peephole::Window<Entry>;
+using Offset = common::Stack_Offset;
+using common::peephole::is_integer_immediate;
+
+/**
+ * @brief Whether the instruction of the window is the mnemonic
+ */
+bool is_mnemonic(Window& window, std::size_t k, Mnemonic mnemonic)
+{
+    return window.is<assembly::Instruction>(k) and
+           std::get<0>(window.get<assembly::Instruction>(k)) == mnemonic;
+}
+
+/**
+ * @brief Whether two storage devices are registers of the same width
+ */
+constexpr bool is_same_width(Storage const& lhs, Storage const& rhs)
+{
+    return std::holds_alternative<Register>(lhs) and
+           std::holds_alternative<Register>(rhs) and
+           assembly::is_doubleword_register(std::get<Register>(lhs)) ==
+               assembly::is_doubleword_register(std::get<Register>(rhs));
+}
+
+/**
+ * @brief Whether an ldr or str is of a register and a stack slot alone
+ */
+bool is_slot_transfer(Window& window, std::size_t k, Mnemonic mnemonic)
+{
+    if (not is_mnemonic(window, k, mnemonic))
+        return false;
+    auto const& [m, s0, s1, s2, s3] = window.get<assembly::Instruction>(k);
+    return std::holds_alternative<Register>(s0) and
+           std::holds_alternative<Offset>(s1) and
+           std::holds_alternative<std::monostate>(s2) and
+           std::holds_alternative<std::monostate>(s3);
+}
+
+bool self_move(Window& window)
+{
+    if (not is_mnemonic(window, 0, Mnemonic::mov))
+        return false;
+    auto const& [mnemonic, s0, s1, s2, s3] =
+        window.get<assembly::Instruction>(0);
+    if (not std::holds_alternative<Register>(s0) or
+        not std::holds_alternative<Register>(s1) or
+        std::get<Register>(s0) != std::get<Register>(s1) or
+        not assembly::is_doubleword_register(std::get<Register>(s0)))
+        return false;
+    window.remove(0);
+    return true;
+}
+
+bool store_reload(Window& window)
+{
+    if (not is_slot_transfer(window, 0, Mnemonic::str) or
+        not is_slot_transfer(window, 1, Mnemonic::ldr))
+        return false;
+    auto const& [m0, value, store, u0, v0] =
+        window.get<assembly::Instruction>(0);
+    auto& [m1, reload, slot, u1, v1] = window.get<assembly::Instruction>(1);
+    if (std::get<Offset>(store) != std::get<Offset>(slot) or
+        not is_same_width(value, reload))
+        return false;
+    if (std::get<Register>(value) == std::get<Register>(reload) and
+        assembly::is_doubleword_register(std::get<Register>(value)))
+        window.remove(1);
+    else {
+        m1 = Mnemonic::mov;
+        slot = value;
+    }
+    return true;
+}
+
+bool load_store(Window& window)
+{
+    if (not is_slot_transfer(window, 0, Mnemonic::ldr) or
+        not is_slot_transfer(window, 1, Mnemonic::str))
+        return false;
+    auto const& [m0, load, slot, u0, v0] = window.get<assembly::Instruction>(0);
+    auto const& [m1, value, store, u1, v1] =
+        window.get<assembly::Instruction>(1);
+    if (std::get<Offset>(slot) != std::get<Offset>(store) or
+        std::get<Register>(load) != std::get<Register>(value))
+        return false;
+    window.remove(1);
+    return true;
+}
+
+bool jump_to_next(Window& window)
+{
+    if (not is_mnemonic(window, 0, Mnemonic::b) or not window.is<Label>(1))
+        return false;
+    auto const& [mnemonic, s0, s1, s2, s3] =
+        window.get<assembly::Instruction>(0);
+    if (not std::holds_alternative<Immediate>(s0))
+        return false;
+    auto const& to = std::get<0>(std::get<Immediate>(s0));
+    if (to != assembly::make_label(window.get<Label>(1), window.scope))
+        return false;
+    window.remove(0);
+    return true;
+}
+
+bool add_zero(Window& window)
+{
+    if (not is_mnemonic(window, 0, Mnemonic::add) and
+        not is_mnemonic(window, 0, Mnemonic::sub))
+        return false;
+    auto& [mnemonic, s0, s1, s2, s3] = window.get<assembly::Instruction>(0);
+    if (not is_same_width(s0, s1) or not is_integer_immediate(s2, "0") or
+        not std::holds_alternative<std::monostate>(s3))
+        return false;
+    mnemonic = Mnemonic::mov;
+    s2 = std::monostate{};
+    return true;
+}
+
+/**
+ * @brief Rewrite a mul by the scratch register the mov before it sets to
+ * the multiplier
+ */
+bool mul_by(Window& window, std::string_view multiplier)
+{
+    if (not is_mnemonic(window, 0, Mnemonic::mov) or
+        not is_mnemonic(window, 1, Mnemonic::mul))
+        return false;
+    auto const& [m0, scratch, value, u0, v0] =
+        window.get<assembly::Instruction>(0);
+    auto& [m1, s0, s1, s2, s3] = window.get<assembly::Instruction>(1);
+    if (not std::holds_alternative<Register>(scratch) or
+        not is_integer_immediate(value, multiplier) or
+        not std::holds_alternative<Register>(s2) or
+        std::get<Register>(s2) != std::get<Register>(scratch) or
+        not is_same_width(s0, s1))
+        return false;
+    if (multiplier == "1") {
+        m1 = Mnemonic::mov;
+        s2 = std::monostate{};
+    } else {
+        m1 = Mnemonic::add;
+        s2 = s1;
+    }
+    return true;
+}
+
+bool mul_one(Window& window)
+{
+    return mul_by(window, "1");
+}
+
+bool mul_two(Window& window)
+{
+    return mul_by(window, "2");
+}
+
+} // namespace
+
+/**
+ * @brief Rewrite instructions by the peephole patterns, where is_function
+ * tells the labels of functions from those in them, and give back the hits
+ * of each
+ */
+common::peephole::Hits rewrite_instructions(
+    assembly::Instructions& instructions,
+    common::Flag_Accessor& flag_accessor,
+    std::function<bool(Label const&)> const& is_function)
+{
+    static std::vector<common::peephole::Pattern<Entry>> const patterns = {
+        { "self-move",    1, self_move    },
+        { "store-reload", 2, store_reload },
+        { "load-store",   2, load_store   },
+        { "jump-to-next", 2, jump_to_next },
+        { "add-zero",     1, add_zero     },
+        { "mul-one",      2, mul_one      },
+        { "mul-two",      2, mul_two      },
+    };
+    return common::peephole::rewrite_instructions(
+        instructions, flag_accessor, patterns, is_function);
+}
+
+/**
+ * @brief Rewrite the instructions of the unit by the peephole patterns,
+ * and give back the hits of each
+ */
+common::peephole::Hits rewrite_instructions(memory::Memory_Access& accessor)
+{
+    auto& table = accessor->table_accessor.get_table();
+    return rewrite_instructions(
+        accessor->instruction_accessor->get_instructions(),
+        accessor->flag_accessor,
+        [&](Label const& label) {
+            return table->get_functions().contains(label);
+        });
+}
+
+} // namespace credence::target::arm64
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "assembly.h"                        // for Instructions
+#include "memory.h"                          // for Memory_Access
+#include <credence/target/common/flags.h>    // for Flag_Accessor
+#include <credence/target/common/peephole.h> // for Hits
+#include <credence/target/common/types.h>    // for Label
+#include <functional>                        // for function
+
+/****************************************************************************
+ *
+ * ARM64 Peephole Optimizer
+ *
+ * The patterns of the peephole pass over ARM64 instructions, see
+ * credence/target/common/peephole.h:
+ *
+ *   self-move      mov x9, x9                ->
+ *   store-reload   str w10, [sp, #20]        -> str w10, [sp, #20]
+ *                  ldr w11, [sp, #20]           mov w11, w10
+ *   load-store     ldr w10, [sp, #20]        -> ldr w10, [sp, #20]
+ *                  str w10, [sp, #20]
+ *   jump-to-next   b ._L2__f                 -> ._L2__f:
+ *                  ._L2__f:
+ *   add-zero       add w8, w9, #0            -> mov w8, w9
+ *   mul-one        mov w7, #1                -> mov w7, #1
+ *                  mul w8, w9, w7               mov w8, w9
+ *   mul-two        mov w7, #2                -> mov w7, #2
+ *                  mul w8, w9, w7               add w8, w9, w9
+ *
+ * A write to a w register clears the upper half of its x register, so
+ * only x register self-moves are dropped. The mov of the multiplier to
+ * the scratch register is kept, as x7 is also an argument register. Only
+ * the adds and subs forms of add and sub set the status flags, and mul
+ * never does, so no pattern has to look for what reads them.
+ *
+ *****************************************************************************/
+
+namespace credence::target::arm64 {
+
+/**
+ * @brief Rewrite instructions by the peephole patterns, where is_function
+ * tells the labels of functions from those in them, and give back the hits
+ * of each
+ */
+common::peephole::Hits rewrite_instructions(
+    assembly::Instructions& instructions,
+    common::Flag_Accessor& flag_accessor,
+    std::function<bool(Label const&)> const& is_function);
+
+/**
+ * @brief Rewrite the instructions of the unit by the peephole patterns,
+ * and give back the hits of each
+ */
+common::peephole::Hits rewrite_instructions(memory::Memory_Access& accessor);
+
+} // namespace credence::target::arm64
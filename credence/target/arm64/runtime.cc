@@ -210,9 +210,15 @@ bool Library_Call_Inserter::try_insert_operand_from_argv_rvalue(
     try {
         auto& locals = accessor_->get_frame_in_memory().argument_stack;
         if (stack_frame_.symbol == "main" and
-            type::from_lvalue_offset(locals.at(index)) == "argv") {
-            auto offset = type::from_decay_offset(locals.at(index));
-            auto offset_integer = type::integral_from_type_ulint(offset);
+            vector_of_offset(locals.at(index)) == "argv") {
+            auto offset = offset_of(locals.at(index));
+            if (!util::is_numeric(offset))
+                throw_compiletime_error(
+                    fmt::format("invalid argv access, argv offset '{}' is not "
+                                "a constant",
+                        offset),
+                    locals.at(index));
+            auto offset_integer = ir::value_of(offset).integer;
             auto argv_offset = direct_immediate(
                 fmt::format("[x19, #{}]", (8 * offset_integer)));
             auto storage =
@@ -109,15 +109,15 @@ void Syscall_Invocation_Inserter::make_syscall(
     common::memory::Locals& argument_stack)
 {
 #if defined(__linux__)
-    auto syscall_list = target::common::syscall_ns::get_syscall_list(
+    auto const& syscall_list = target::common::syscall_ns::get_syscall_list(
         target::common::assembly::OS_Type::Linux,
         target::common::assembly::Arch_Type::ARM64);
 #elif defined(__APPLE__) || defined(__bsdi__)
-    auto syscall_list = target::common::syscall_ns::get_syscall_list(
+    auto const& syscall_list = target::common::syscall_ns::get_syscall_list(
         target::common::assembly::OS_Type::BSD,
         target::common::assembly::Arch_Type::ARM64);
 #elif defined(_WIN32) || defined(_WIN64)
-    auto syscall_list = target::common::syscall_ns::get_syscall_list(
+    auto const& syscall_list = target::common::syscall_ns::get_syscall_list(
         target::common::assembly::OS_Type::Linux,
         target::common::assembly::Arch_Type::ARM64);
 #endif
@@ -13,6 +13,7 @@
 
 #include "visitor.h"
 
+#include "allocator.h"                       // for allocate_registers
 #include "assembly.h"                        // for Register, Mnemonic, arm...
 #include "credence/error.h"                  // for credence_assert
 #include "credence/map.h"                    // for Ordered_Map
@@ -23,10 +24,12 @@
 #include "credence/types.h"                  // for from_lvalue_offset, get...
 #include "flags.h"                           // for set_alignment_flag
 #include "inserter.h"                        // for Expression_Inserter
+#include "leaf.h"                            // for elide_stack_frame
 #include "memory.h"                          // for Memory_Accessor, Instru...
 #include "stack.h"                           // for Stack
 #include "syscall.h"                         // for exit_syscall
 #include <credence/ir/object.h>              // for Object, Function, Label
+#include <credence/target/common/options.h>  // for target_options
 #include <credence/target/common/runtime.h>  // for is_stdlib_function, is_...
 #include <deque>                             // for deque
 #include <matchit.h>                         // for Wildcard, App, Ds, app
@@ -101,6 +104,7 @@ void IR_Instruction_Visitor::from_func_start_ita(Label const& name)
         accessor_->stack->allocate(16);
     }
     table->reset_frame_calls();
+    function_index_ = instructions.size();
     set_alignment_flag(Align_SP);
     arm64_add__asm(instructions, stp, x29, x30, alignment__integer());
     if (name == "main" and
@@ -142,6 +146,13 @@ void IR_Instruction_Visitor::from_func_start_ita(Label const& name)
 void IR_Instruction_Visitor::from_func_end_ita()
 {
     accessor_->register_accessor.reset_available_registers();
+    if (common::target_options.regalloc) {
+        auto const& name = stack_frame_.symbol;
+        accessor_->saved_registers.insert(
+            name, allocate_registers(accessor_, name, function_index_));
+    }
+    if (common::target_options.leaf)
+        elide_stack_frame(accessor_, stack_frame_.symbol, function_index_);
     accessor_->stack->set_stack_frame_allocation_size(stack_frame_.symbol);
     accessor_->stack->clear();
 }
@@ -173,7 +184,7 @@ void IR_Instruction_Visitor::from_mov_ita(ir::Quadruple const& inst)
 
     m::match(lhs, rhs)(
         m::pattern | m::ds(m::app(is_parameter, true), m::_) = [&] {},
-        m::pattern | m::ds(m::app(type::is_temporary, true), m::_) =
+        m::pattern | m::ds(m::app(is_temporary, true), m::_) =
             [&] {
                 expression_inserter.insert_lvalue_at_temporary_object_address(
                     lhs);
@@ -217,8 +228,7 @@ void IR_Instruction_Visitor::from_mov_ita(ir::Quadruple const& inst)
         arm64_add__asm(instructions, str, stack_register, stack_address);
     }
 
-    if (!type::is_temporary(lhs) and
-        not accessor_->register_accessor.stack.empty())
+    if (!is_temporary(lhs) and not accessor_->register_accessor.stack.empty())
         accessor_->register_accessor.stack.clear();
 }
 
@@ -247,7 +257,7 @@ void IR_Instruction_Visitor::from_push_ita(ir::Quadruple const& inst)
     auto& table = accessor_->table_accessor.get_table();
     auto frame = stack_frame_.get_stack_frame();
     stack_frame_.argument_stack.emplace_front(
-        table->lvalue_at_temporary_object_address(std::get<1>(inst), frame));
+        table->lvalue_at_temporary_object_address(ir::get<1>(inst), frame));
 }
 
 /**
@@ -298,7 +308,7 @@ void IR_Instruction_Visitor::from_label_ita(ir::Quadruple const& inst)
 {
     auto& instructions = accessor_->instruction_accessor->get_instructions();
     instructions.emplace_back(
-        type::get_label_as_human_readable(std::get<1>(inst)));
+        type::get_label_as_human_readable(ir::get<1>(inst)));
 }
 
 /**
@@ -351,7 +361,7 @@ void IR_Instruction_Visitor::from_call_ita(ir::Quadruple const& inst)
     auto instruction_accessor = accessor_->instruction_accessor;
     auto inserter = Invocation_Inserter{ accessor_ };
 
-    auto function_name = type::get_label_as_human_readable(std::get<1>(inst));
+    auto function_name = type::get_label_as_human_readable(ir::get<1>(inst));
 
     auto is_syscall_function = [&](Label const& label) {
 #if defined(__linux__)
@@ -413,7 +423,7 @@ void IR_Instruction_Visitor::from_call_ita(ir::Quadruple const& inst)
 void IR_Instruction_Visitor::from_goto_ita(ir::Quadruple const& inst)
 {
     auto label = common::assembly::make_direct_immediate(
-        assembly::make_label(std::get<1>(inst), stack_frame_.symbol));
+        assembly::make_label(ir::get<1>(inst), stack_frame_.symbol));
     auto instruction_accessor = accessor_->instruction_accessor;
     auto& instructions = instruction_accessor->get_instructions();
     // make_direct_immediate copies the view into the owning string of
@@ -428,7 +438,7 @@ void IR_Instruction_Visitor::from_goto_ita(ir::Quadruple const& inst)
  */
 void IR_Instruction_Visitor::from_locl_ita(ir::Quadruple const& inst)
 {
-    auto locl_lvalue = std::get<1>(inst);
+    auto locl_lvalue = ir::get<1>(inst);
     auto& table = accessor_->table_accessor.get_table();
     auto& stack = accessor_->stack;
     auto is_vector = [&](RValue const& rvalue) {
@@ -438,7 +448,7 @@ void IR_Instruction_Visitor::from_locl_ita(ir::Quadruple const& inst)
         m::pattern | m::app(type::is_dereference_expression, true) =
             [&] {
                 auto lvalue =
-                    type::get_unary_rvalue_reference(std::get<1>(inst));
+                    type::get_unary_rvalue_reference(ir::get<1>(inst));
                 accessor_->device_accessor.insert_lvalue_to_device(
                     lvalue, Operand_Size::Doubleword);
             },
@@ -470,7 +480,7 @@ void IR_Instruction_Visitor::from_jmp_e_ita(ir::Quadruple const& inst)
             .get_arm64_lvalue_and_insertion_instructions(
                 of_comparator, instructions.size(), accessor_->device_accessor)
             .first;
-    auto with_rvalue_storage = type::get_data_type_from_string(with);
+    auto with_rvalue_storage = ir::value_of<3>(inst).literal;
     auto jump_label = assembly::make_label(jump, stack_frame_.symbol);
     auto comparator_instructions = assembly::r_eq(
         of_rvalue_storage, with_rvalue_storage, jump_label, Register::w8);
@@ -113,6 +113,8 @@ class IR_Instruction_Visitor final : public ARM64_IR_Visitor
 
   private:
     std::size_t iterator_index_{ 0 };
+    // the index of the prologue of the function being inserted
+    std::size_t function_index_{ 0 };
 
   private:
     memory::Memory_Access accessor_;
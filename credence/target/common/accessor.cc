@@ -17,6 +17,7 @@
 #include <credence/ir/ita.h>                    // for Instruction
 #include <credence/ir/object.h>                 // for Object, Function
 #include <credence/ir/operand.h>                // for is_integer_string
+#include <credence/ir/quadruple.h>              // for kind_of, Operand_Kind
 #include <credence/target/common/memory.h>      // for is_vector_offset
 #include <credence/target/common/stack_frame.h> // for Stack_Frame, Locals
 #include <credence/types.h>                     // for get_size_from_rvalue...
@@ -26,7 +27,6 @@
 #include <map>                                  // for map
 #include <matchit.h>                            // for Or, match, or_, pattern
 #include <string>                               // for basic_string, char_t...
-#include <tuple>                                // for get, tuple
 
 /****************************************************************************
  *
@@ -130,19 +130,18 @@ Size Buffer_Accessor::get_size_of_return_string(Stack_Frame const& stack_frame)
         if (last_stack_frame->get_locals().is_pointer(
                 tail_frame->get_ret()->first)) {
             return type::get_size_from_rvalue_data_type(
-                type::get_data_type_from_string(
-                    last_stack_frame->get_locals().get_pointer_by_name(
-                        tail_frame->get_ret()->first)));
+                immediate_of(last_stack_frame->get_locals().get_pointer_by_name(
+                    tail_frame->get_ret()->first)));
         }
-        if (type::is_rvalue_data_type(tail_frame->get_ret()->first))
+        if (is_immediate(tail_frame->get_ret()->first))
             return type::get_size_from_rvalue_data_type(
-                type::get_data_type_from_string(tail_frame->get_ret()->first));
+                immediate_of(tail_frame->get_ret()->first));
         return type::get_size_from_rvalue_data_type(
             last_stack_frame->get_locals().get_symbol_by_name(
                 tail_frame->get_ret()->first));
     }
     return type::get_size_from_rvalue_data_type(
-        type::get_data_type_from_string(tail_frame->get_ret()->first));
+        immediate_of(tail_frame->get_ret()->first));
 }
 
 Size Buffer_Accessor::get_size_in_local_address(LValue const& lvalue,
@@ -153,8 +152,7 @@ Size Buffer_Accessor::get_size_in_local_address(LValue const& lvalue,
     if (locals.is_pointer(lvalue) and
         type::is_rvalue_data_type_string(locals.get_pointer_by_name(lvalue))) {
         return type::get_size_from_rvalue_data_type(
-            type::get_data_type_from_string(
-                locals.get_pointer_by_name(lvalue)));
+            immediate_of(locals.get_pointer_by_name(lvalue)));
     }
     if (locals.is_pointer(lvalue)) {
         auto rvalue_address = ir::object::get_rvalue_at_lvalue_object_storage(
@@ -169,7 +167,7 @@ Size Buffer_Accessor::get_size_in_local_address(LValue const& lvalue,
             pimpl->table->get_functions().contains(stack_frame.tail));
         auto tail_frame = pimpl->table->get_functions().at(stack_frame.tail);
         return type::get_size_from_rvalue_data_type(
-            type::get_data_type_from_string(tail_frame->get_ret()->first));
+            immediate_of(tail_frame->get_ret()->first));
     }
     return type::get_size_from_rvalue_data_type(local_symbol);
 }
@@ -181,14 +179,14 @@ Size Buffer_Accessor::get_size_of_string_lvalue_buffer_address(
     LValue const& lvalue,
     Stack_Frame const& stack_frame)
 {
-    auto lhs = type::from_lvalue_offset(lvalue);
-    auto offset = type::from_decay_offset(lvalue);
+    auto lhs = vector_of_offset(lvalue);
+    auto offset = offset_of(lvalue);
     auto& vectors = pimpl->table->get_vectors();
     auto frame = stack_frame.get_stack_frame();
 
     Operand_Lambda is_global_vector = [&](RValue const& rvalue) {
         auto& table = pimpl->table;
-        auto rvalue_reference = type::from_lvalue_offset(rvalue);
+        auto rvalue_reference = vector_of_offset(rvalue);
         return table->get_vectors().contains(rvalue_reference) and
                table->get_globals().is_pointer(rvalue_reference);
     };
@@ -233,7 +231,7 @@ Size Buffer_Accessor::get_size_of_string_lvalue_buffer_address(
 
     if (is_immediate(lvalue))
         return type::get_size_from_rvalue_data_type(
-            type::get_data_type_from_string(lvalue));
+            immediate_of(lvalue));
     else
         return type::get_size_from_rvalue_data_type(
             ir::object::get_rvalue_at_lvalue_object_storage(
@@ -249,12 +247,12 @@ void Buffer_Accessor::set_buffer_size_from_syscall(std::string_view routine,
     credence_assert(!argument_stack.empty());
     namespace m = matchit;
     m::match(routine)(m::pattern | m::or_(sv("read")) = [&] {
-        auto argument = argument_stack.back();
-        if (credence::util::is_numeric(argument))
-            pimpl->read_bytes_cache_ = std::stoul(argument);
-        else if (type::is_rvalue_data_type_a_type(argument, "int"))
+        auto const& rvalue = argument_stack.back();
+        auto const& argument = ir::value_of(rvalue);
+        if (credence::util::is_numeric(rvalue) or
+            (argument.is_literal() and argument.type == ir::Value_Type::Int))
             pimpl->read_bytes_cache_ =
-                std::stoul(type::get_value_from_rvalue_data_type(argument));
+                static_cast<std::size_t>(argument.integer);
     });
 }
 
@@ -328,17 +326,19 @@ void Table_Accessor::set_ir_iterator_index(unsigned int index_)
 }
 bool Table_Accessor::is_ir_instruction_temporary()
 {
-    return type::is_temporary(
-        std::get<1>(pimpl->table_->get_ir_instructions()->at(pimpl->index)));
+    return ir::kind_of<1>(pimpl->table_->get_ir_instructions()->at(
+               pimpl->index)) == ir::Operand_Kind::Temporary;
 }
 
 LValue Table_Accessor::get_last_lvalue_assignment(unsigned int index_)
 {
     for (; index_ > 0; index_--) {
         auto ir_inst = pimpl->table_->get_ir_instructions()->at(index_);
-        auto lvalue = std::get<1>(ir_inst);
-        if (std::get<0>(ir_inst) == ir::Instruction::MOV and
-            pimpl->table_->local_contains(lvalue) and
+        if (ir::get<0>(ir_inst) != ir::Instruction::MOV or
+            ir::kind_of<1>(ir_inst) == ir::Operand_Kind::Temporary)
+            continue;
+        auto const& lvalue = ir::get<1>(ir_inst);
+        if (pimpl->table_->local_contains(lvalue) and
             not lvalue.starts_with("_p") and not lvalue.starts_with("_t")) {
             return lvalue;
         }
@@ -348,31 +348,31 @@ LValue Table_Accessor::get_last_lvalue_assignment(unsigned int index_)
 
 std::string Table_Accessor::get_ir_instruction_lvalue()
 {
-    return std::get<1>(pimpl->table_->get_ir_instructions()->at(pimpl->index));
+    return ir::get<1>(pimpl->table_->get_ir_instructions()->at(pimpl->index));
 }
 bool Table_Accessor::last_ir_instruction_is_assignment()
 {
     if (pimpl->index < 1)
         return false;
     auto last = pimpl->table_->get_ir_instructions()->at(pimpl->index - 1);
-    return std::get<0>(last) == ir::Instruction::MOV and
-           not type::is_temporary(std::get<1>(last));
+    return ir::get<0>(last) == ir::Instruction::MOV and
+           ir::kind_of<1>(last) != ir::Operand_Kind::Temporary;
 }
 bool Table_Accessor::next_ir_instruction_is_temporary()
 {
     if (pimpl->table_->get_ir_instructions()->size() < pimpl->index + 1)
         return false;
     auto next = pimpl->table_->get_ir_instructions()->at(pimpl->index + 1);
-    return std::get<0>(next) == ir::Instruction::MOV and
-           type::is_temporary(std::get<1>(next));
+    return ir::get<0>(next) == ir::Instruction::MOV and
+           ir::kind_of<1>(next) == ir::Operand_Kind::Temporary;
 }
 bool Table_Accessor::next_ir_instruction_is_assignment()
 {
     if (pimpl->table_->get_ir_instructions()->size() < pimpl->index + 1)
         return false;
     auto last = pimpl->table_->get_ir_instructions()->at(pimpl->index + 1);
-    return std::get<0>(last) == ir::Instruction::MOV and
-           not type::is_temporary(std::get<1>(last));
+    return ir::get<0>(last) == ir::Instruction::MOV and
+           ir::kind_of<1>(last) != ir::Operand_Kind::Temporary;
 }
 Table_Pointer& Table_Accessor::get_table()
 {
@@ -417,7 +417,7 @@ void Vector_Accessor<Entry>::type_check_invalid_vector_symbol(
     LValue const& vector,
     RValue const& offset)
 {
-    if (!table_->get_hoisted_symbols().has_key(offset) and
+    if (!table_->get_hoisted_symbols().contains(offset) and
         not operand::is_integer_string(offset))
         throw_compiletime_error(
             fmt::format("Invalid index '{}' on vector lvalue", offset), vector);
@@ -463,14 +463,14 @@ auto Vector_Accessor<Entry>::get_offset_address(LValue const& lvalue,
 {
     auto frame = table_->get_stack_frame();
     auto& vectors = table_->get_vectors();
-    auto vector = type::from_lvalue_offset(lvalue);
+    auto vector = vector_of_offset(lvalue);
 
     type_check_invalid_vector_symbol(vector, offset);
 
     if (!is_vector_offset(lvalue))
         return get_offset_from_trivial_vector(vector);
 
-    if (table_->get_hoisted_symbols().has_key(offset))
+    if (table_->get_hoisted_symbols().contains(offset))
         return get_offset_from_hoisted_symbols(vector, offset);
 
     if (operand::is_integer_string(offset))
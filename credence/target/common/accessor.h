@@ -23,6 +23,7 @@
 #include <cstddef>              // for size_t
 #include <deque>                // for deque
 #include <memory>               // for shared_ptr, unique_ptr
+#include <memory_resource>      // for memory_resource, get_default_re...
 #include <string>               // for basic_string, char_traits, string
 #include <string_view>          // for basic_string_view, operator==, strin...
 #include <utility>              // for pair
@@ -147,6 +148,16 @@ struct Table_Accessor
 template<Deque_T T>
 struct Instruction_Accessor
 {
+    /**
+     * @brief The list the backend emits into, allocated from resource,
+     * e.g. the Arena of the compilation, see credence/arena.h
+     */
+    explicit Instruction_Accessor(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : instructions_(resource)
+    {
+    }
+
     T& get_instructions() { return instructions_; }
 
     auto push(T& instruction) { instructions_.emplace_back(instruction); }
@@ -159,7 +170,7 @@ struct Instruction_Accessor
     std::size_t size() { return instructions_.size(); }
 
   private:
-    T instructions_{};
+    T instructions_;
 };
 
 /**
@@ -0,0 +1,73 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/target/common/allocator.h>
+
+#include <algorithm> // for max, min
+#include <cstddef>   // for size_t
+
+namespace credence::target::common::allocator {
+
+/**
+ * @brief Ten times the cost for each loop the instruction index is in
+ */
+std::size_t get_cost_from_index(Loops const& loops, std::size_t index)
+{
+    std::size_t cost = 1;
+    std::size_t depth = 0;
+    for (auto [label, jump] : loops)
+        if (label <= index and index <= jump and depth++ < 6)
+            cost *= 10;
+    return cost;
+}
+
+/**
+ * @brief Extend an interval over each loop that overlaps it, until none
+ * is left to add
+ */
+void extend_interval_over_loops(Interval& interval, Loops const& loops)
+{
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto [label, jump] : loops) {
+            if (label > interval.end or jump < interval.start)
+                continue;
+            if (label < interval.start or jump > interval.end) {
+                interval.start = std::min(interval.start, label);
+                interval.end = std::max(interval.end, jump);
+                changed = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Add the use of a slot at an instruction index to its interval
+ */
+void add_use_to_interval(Intervals& intervals,
+    Stack_Offset slot,
+    std::size_t index,
+    Loops const& loops)
+{
+    auto& interval = intervals[slot];
+    if (interval.uses.empty()) {
+        interval.slot = slot;
+        interval.start = index;
+    }
+    interval.end = index;
+    interval.uses.push_back(index);
+    interval.cost += get_cost_from_index(loops, index);
+}
+
+} // namespace credence::target::common::allocator
@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>                      // for find, min_element, sort
+#include <credence/target/common/types.h> // for Stack_Offset, Enum_T
+#include <cstddef>                        // for size_t
+#include <deque>                          // for deque
+#include <map>                            // for map
+#include <utility>                        // for pair
+#include <vector>                         // for vector
+
+/****************************************************************************
+ *
+ * Linear Scan
+ *
+ * The platform-independent half of the register allocators of
+ * credence/target/x86_64/allocator.h and credence/target/arm64/allocator.h.
+ * Each platform finds the stack slots of a function it can keep in a
+ * register, their uses, and its loops, by instruction index, and rewrites
+ * the slots by the registers given back here.
+ *
+ * The live interval of a slot spans its first use to its last, and each
+ * loop - a jump back to a label before it - that overlaps the interval,
+ * until none is left to add. The intervals are scanned by start, and when
+ * each register is taken, the interval with the lowest cost keeps its
+ * slot, where a use in a loop costs ten times the cost of a use outside
+ * it.
+ *
+ *****************************************************************************/
+
+namespace credence::target::common::allocator {
+
+// the label index and jump index of each jump back to a label before it
+using Loops = std::vector<std::pair<std::size_t, std::size_t>>;
+
+/**
+ * @brief The live interval of a stack slot over the instruction indices
+ */
+struct Interval
+{
+    Stack_Offset slot{ 0 };
+    std::size_t start{ 0 };
+    std::size_t end{ 0 };
+    std::size_t cost{ 0 };
+    std::vector<std::size_t> uses{};
+};
+
+using Intervals = std::map<Stack_Offset, Interval>;
+
+std::size_t get_cost_from_index(Loops const& loops, std::size_t index);
+
+void extend_interval_over_loops(Interval& interval, Loops const& loops);
+
+void add_use_to_interval(Intervals& intervals,
+    Stack_Offset slot,
+    std::size_t index,
+    Loops const& loops);
+
+/**
+ * @brief Give each interval a register of the list or keep it on the stack
+ * by linear scan, where the interval of lowest cost keeps its slot
+ */
+template<Enum_T Register>
+std::map<Stack_Offset, Register> linear_scan(Intervals& intervals,
+    Loops const& loops,
+    std::deque<Register> free)
+{
+    std::vector<Interval*> order{};
+    for (auto& [slot, interval] : intervals) {
+        extend_interval_over_loops(interval, loops);
+        order.push_back(&interval);
+    }
+    std::ranges::sort(order, [](Interval const* lhs, Interval const* rhs) {
+        return lhs->start < rhs->start;
+    });
+
+    std::vector<Interval*> active{};
+    std::map<Stack_Offset, Register> assigned{};
+    for (auto* interval : order) {
+        std::erase_if(active, [&](Interval const* expired) {
+            if (expired->end >= interval->start)
+                return false;
+            free.push_front(assigned.at(expired->slot));
+            return true;
+        });
+        if (not free.empty()) {
+            assigned[interval->slot] = free.front();
+            free.pop_front();
+            active.push_back(interval);
+            continue;
+        }
+        if (active.empty())
+            continue;
+        auto spill = std::ranges::min_element(
+            active, [](Interval const* lhs, Interval const* rhs) {
+                return lhs->cost < rhs->cost;
+            });
+        if ((*spill)->cost >= interval->cost)
+            continue;
+        assigned[interval->slot] = assigned.at((*spill)->slot);
+        assigned.erase((*spill)->slot);
+        *spill = interval;
+    }
+    return assigned;
+}
+
+/**
+ * @brief The registers of the list a function was given, in the order of
+ * the list, and one more if that makes an odd number even
+ */
+template<Enum_T Register>
+std::deque<Register> get_saved_registers(
+    std::map<Stack_Offset, Register> const& assigned,
+    std::deque<Register> const& registers)
+{
+    std::deque<Register> saved{};
+    for (auto device : registers)
+        for (auto const& [slot, assigned_device] : assigned)
+            if (assigned_device == device) {
+                saved.push_back(device);
+                break;
+            }
+    if (saved.size() % 2 != 0)
+        for (auto device : registers)
+            if (std::ranges::find(saved, device) == saved.end()) {
+                saved.push_back(device);
+                break;
+            }
+    return saved;
+}
+
+} // namespace credence::target::common::allocator
@@ -16,6 +16,8 @@
 #include <credence/error.h>               // for credence_assert
 #include <credence/map.h>                 // for Ordered_Map
 #include <credence/target/common/types.h> // for Enum_T, Instructions
+#include <cstddef>                        // for size_t
+#include <vector>                         // for vector
 
 /****************************************************************************
  *
@@ -66,6 +68,25 @@ void Flag_Accessor::set_instruction_flag(flag::flags flags, unsigned int index)
         instruction_flag[index] |= flags;
 }
 
+/**
+ * @brief Drop the flags of each removed instruction index, and move the
+ * flags of each index after it down by the number removed before it
+ */
+void Flag_Accessor::remove_instruction_indices(std::vector<bool> const& removed)
+{
+    std::vector<unsigned int> before(removed.size() + 1, 0);
+    for (std::size_t i = 0; i < removed.size(); i++)
+        before[i + 1] = before[i] + (removed[i] ? 1 : 0);
+    Ordered_Map<unsigned int, flag::flags> moved{};
+    for (auto const& [index, flags] : instruction_flag) {
+        if (index < removed.size() and removed[index])
+            continue;
+        auto shift = index < removed.size() ? before[index] : before.back();
+        moved.insert(index - shift, flags);
+    }
+    instruction_flag = moved;
+}
+
 template<Enum_T Mnemonic_T, Enum_T Registers_T>
 void Flag_Accessor::set_load_address_from_previous_instruction(
     Instructions<Mnemonic_T, Registers_T>& instructions)
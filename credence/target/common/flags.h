@@ -15,6 +15,7 @@
 
 #include "types.h"        // for Enum_T, Instructions
 #include <credence/map.h> // for Ordered_Map
+#include <vector>          // for vector
 
 /****************************************************************************
  *
@@ -83,6 +84,7 @@ struct Flag_Accessor
             return 0;
         return instruction_flag.at(index);
     }
+    void remove_instruction_indices(std::vector<bool> const& removed);
 
   private:
     Ordered_Map<unsigned int, flag::flags> instruction_flag{};
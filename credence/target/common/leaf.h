@@ -0,0 +1,67 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/target/common/flags.h> // for Flag_Accessor
+#include <cstddef>                        // for size_t
+#include <utility>                        // for move
+#include <vector>                         // for vector
+
+/****************************************************************************
+ *
+ * Leaf Functions
+ *
+ * The platform-independent half of the frame elision of
+ * credence/target/x86_64/leaf.h and credence/target/arm64/leaf.h. A leaf
+ * function has no CALL in its IR, which is also how the standard library
+ * and the syscalls of the platform are reached, so no other frame is built
+ * on top of its own and its return address is never overwritten:
+ *
+ *   B code:                         Before:             After:
+ *     square(x) {                   square:             square:
+ *       return(x * x);                push rbp            mov eax, edi
+ *     }                               mov rbp, rsp        imul eax, edi
+ *                                     mov eax, edi        ret
+ *                                     imul eax, edi
+ *                                     pop rbp
+ *                                     ret
+ *
+ * Each platform checks each leaf once it is inserted, and removes the
+ * instructions of its prologue and epilogue here with their flags.
+ *
+ *****************************************************************************/
+
+namespace credence::target::common::leaf {
+
+/**
+ * @brief Drop the removed instructions, and move the flags of the
+ * instructions after each down with them
+ */
+template<typename Instructions>
+void remove_instructions(Instructions& instructions,
+    Flag_Accessor& flag_accessor,
+    std::vector<bool> const& removed)
+{
+    flag_accessor.remove_instruction_indices(removed);
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < instructions.size(); i++)
+        if (i >= removed.size() or not removed[i]) {
+            if (kept != i)
+                instructions[kept] = std::move(instructions[i]);
+            kept++;
+        }
+    instructions.erase(instructions.begin() + kept, instructions.end());
+}
+
+} // namespace credence::target::common::leaf
@@ -16,6 +16,7 @@
 #include "stack_frame.h"
 #include "types.h"
 
+#include <credence/ir/quadruple.h>
 #include <credence/types.h>
 #include <credence/util.h>
 #include <memory>
@@ -70,19 +71,37 @@ enum class Operand_Type
  */
 
 /**
- * @brief Check if an RValue is an immediate value
+ * @brief Check if an RValue is an immediate value, e.g. (10:int:4)
+ *
+ * Read from the interned operand and not split out of the text again.
+ */
+inline bool is_immediate(std::string const& rvalue)
+{
+    return ir::value_of(rvalue).is_literal();
+}
+
+/**
+ * @brief The immediate value of an RValue as its data type tuple
+ */
+inline type::Data_Type immediate_of(std::string const& rvalue)
+{
+    return ir::value_of(rvalue).literal;
+}
+
+/**
+ * @brief Check if an RValue is a temporary value, e.g. _t5
  */
-constexpr bool is_immediate(std::string const& rvalue)
+inline bool is_temporary(std::string const& rvalue)
 {
-    return type::is_rvalue_data_type(rvalue);
+    return ir::value_of(rvalue).kind == ir::Operand_Kind::Temporary;
 }
 
 /**
- * @brief Check if an RValue is a temporary value
+ * @brief Check if an RValue is a unary expression, e.g. -x or *p
  */
-constexpr bool is_temporary(std::string const& rvalue)
+inline bool is_unary_expression(std::string const& rvalue)
 {
-    return type::is_temporary(rvalue);
+    return ir::value_of(rvalue).is_unary();
 }
 
 /**
@@ -94,11 +113,47 @@ constexpr bool is_parameter(std::string const& rvalue)
 }
 
 /**
- * @brief Check if an RValue is a vector/array offset access
+ * @brief Check if an RValue is a vector/array offset access, e.g. v[k]
+ *
+ * Read from the interned operand and not split out of the text again.
+ */
+inline bool is_vector_offset(std::string const& rvalue)
+{
+    return ir::value_of(rvalue).shape == ir::Lvalue_Shape::Offset;
+}
+
+/**
+ * @brief The vector of a vector offset, e.g. v of v[k], or the rvalue
+ * itself where it is no offset
+ */
+inline std::string vector_of_offset(std::string const& rvalue)
+{
+    auto const& value = ir::value_of(rvalue);
+    if (value.shape != ir::Lvalue_Shape::Offset)
+        return rvalue;
+    return ir::text_of(value.base);
+}
+
+/**
+ * @brief The offset of a vector offset, e.g. k of v[k], or the rvalue
+ * itself where it is no offset
+ */
+inline std::string offset_of(std::string const& rvalue)
+{
+    auto const& value = ir::value_of(rvalue);
+    if (value.shape != ir::Lvalue_Shape::Offset)
+        return rvalue;
+    return ir::text_of(value.offset);
+}
+
+/**
+ * @brief Check if an RValue is a binary expression, e.g. "_t1 + x"
+ *
+ * Read from the interned operand and not split out of the text again.
  */
-constexpr bool is_vector_offset(std::string const& rvalue)
+inline bool is_binary_expression(std::string const& rvalue)
 {
-    return util::contains(rvalue, "[") and util::contains(rvalue, "]");
+    return ir::value_of(rvalue).is_binary();
 }
 
 } // namespace target::common::memory
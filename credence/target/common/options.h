@@ -0,0 +1,59 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+/****************************************************************************
+ *
+ * Target Options
+ *
+ * The passes over the machine code of a platform, after the inserter
+ * builds it and before the emitter writes it. Unlike the passes of
+ * credence/ir/optimize.h, these see registers and stack offsets:
+ *
+ *    Table -> Instruction_Inserter -> passes -> Text_Emitter
+ *
+ * Each pass is timed on its own under --time-passes, and --peephole
+ * reports the hits of each of its patterns by name.
+ *
+ * The passes to run are set once per process from the command line:
+ *
+ *    --regalloc keep the scalar locals of each function in callee-saved
+ *               registers rather than the stack, by linear scan, see
+ *               credence/target/common/allocator.h
+ *    --peephole rewrite short runs of instructions by a table of patterns
+ *               once the inserter has built them, see
+ *               credence/target/common/peephole.h
+ *    --slots    share the stack slots of the locals of each function
+ *               whose lifetimes do not overlap, on x86-64, see
+ *               credence/target/common/slots.h
+ *    --leaf     drop the frame pointer of each function that calls
+ *               nothing, see credence/target/common/leaf.h
+ *
+ *****************************************************************************/
+
+namespace credence::target::common {
+
+struct Target_Options
+{
+    bool regalloc{ false };
+    bool peephole{ false };
+    bool slots{ false };
+    bool leaf{ false };
+};
+
+// Set by main from the command line; every pass is off by default, which
+// leaves the machine code as the inserter built it.
+inline Target_Options target_options{};
+
+} // namespace credence::target::common
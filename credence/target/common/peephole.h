@@ -0,0 +1,199 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/target/common/flags.h> // for Flag_Accessor
+#include <credence/target/common/types.h> // for Label, Immediate
+#include <cstddef>                        // for size_t
+#include <functional>                     // for function
+#include <string_view>                    // for string_view
+#include <utility>                        // for pair
+#include <variant>                        // for holds_alternative, get
+#include <vector>                         // for vector
+
+/****************************************************************************
+ *
+ * Peephole Optimizer
+ *
+ * The platform-independent half of the peephole passes of
+ * credence/target/x86_64/peephole.h and credence/target/arm64/peephole.h,
+ * which run over the instructions of the unit once the inserter has built
+ * them and before the emitter writes them:
+ *
+ *    Instruction_Inserter -> peephole -> Text_Emitter
+ *
+ * Each platform gives a table of patterns, each a name, the number of
+ * instructions it looks at, and a rewrite of those instructions. The
+ * window of a pattern is the next instructions and labels not yet removed
+ * from each index, and the table is tried at each index until no pattern
+ * rewrites anything:
+ *
+ *   Before:                          After:
+ *     mov dword ptr [rbp - 4], eax     mov dword ptr [rbp - 4], eax
+ *     mov ecx, dword ptr [rbp - 4]     mov ecx, eax
+ *     jmp ._L3__main                 ._L3__main:
+ *   ._L3__main:
+ *
+ * A window in which any instruction carries a flag is left as it is, as
+ * the emitter reads the flags for what the operands alone do not say. A
+ * pattern may look past its window, e.g. for what reads the status flags
+ * an instruction sets, but only rewrites the window itself.
+ * Removed instructions are dropped at the end, and the flags of the
+ * instructions after each are moved down with them.
+ *
+ *****************************************************************************/
+
+namespace credence::target::common::peephole {
+
+/**
+ * @brief The instructions and labels a pattern looks at from one index
+ */
+template<typename Entry>
+struct Window
+{
+    std::vector<Entry*> entries{};
+    std::vector<std::size_t> indices{};
+    std::vector<bool>* removed{ nullptr };
+    // the function the window is in
+    Label scope{};
+    // the entry at an index of the instructions, or null past their end
+    std::function<Entry*(std::size_t)> entry_at{};
+
+    template<typename T>
+    constexpr bool is(std::size_t k) const
+    {
+        return std::holds_alternative<T>(*entries[k]);
+    }
+    template<typename T>
+    constexpr T& get(std::size_t k)
+    {
+        return std::get<T>(*entries[k]);
+    }
+    void remove(std::size_t k) { (*removed)[indices[k]] = true; }
+
+    /**
+     * @brief Call f with each entry not removed after the window, in order,
+     * until it gives back false
+     */
+    template<typename F>
+    void for_each_after(F&& f)
+    {
+        for (auto i = indices.back() + 1; Entry* entry = entry_at(i); i++)
+            if (not(*removed)[i] and not f(*entry))
+                return;
+    }
+};
+
+/**
+ * @brief A rewrite of a window of instructions, which is true if it
+ * changed them
+ */
+template<typename Entry>
+struct Pattern
+{
+    std::string_view name;
+    std::size_t window;
+    std::function<bool(Window<Entry>&)> rewrite;
+};
+
+// the number of times each pattern rewrote its window, in table order
+using Hits = std::vector<std::pair<std::string_view, std::size_t>>;
+
+/**
+ * @brief Whether a storage device is the int or long immediate value
+ */
+template<typename Storage>
+constexpr bool is_integer_immediate(Storage const& storage,
+    std::string_view value)
+{
+    if (not std::holds_alternative<Immediate>(storage))
+        return false;
+    auto const& [v_value, v_type, v_size] = std::get<Immediate>(storage);
+    return (v_type == "int" or v_type == "long") and v_value == value;
+}
+
+/**
+ * @brief Rewrite the instructions by the patterns until none match, drop
+ * the removed instructions and their flags, and give back the hits of
+ * each pattern
+ */
+template<typename Instructions, typename Entry>
+Hits rewrite_instructions(Instructions& instructions,
+    Flag_Accessor& flag_accessor,
+    std::vector<Pattern<Entry>> const& patterns,
+    std::function<bool(Label const&)> const& is_function)
+{
+    Hits hits{};
+    for (auto const& pattern : patterns)
+        hits.emplace_back(pattern.name, 0);
+    std::vector<bool> removed(instructions.size(), false);
+
+    auto get_window = [&](std::size_t index,
+                          std::size_t size,
+                          Label const& scope) {
+        Window<Entry> window{};
+        window.removed = &removed;
+        window.scope = scope;
+        window.entry_at = [&](std::size_t at) -> Entry* {
+            return at < instructions.size() ? &instructions[at] : nullptr;
+        };
+        for (auto i = index; i < instructions.size(); i++) {
+            if (window.entries.size() == size)
+                break;
+            if (removed[i])
+                continue;
+            if (flag_accessor.get_instruction_flags_at_index(i) != 0)
+                break;
+            window.entries.push_back(&instructions[i]);
+            window.indices.push_back(i);
+        }
+        return window;
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        Label scope{};
+        for (std::size_t i = 0; i < instructions.size(); i++) {
+            if (removed[i])
+                continue;
+            if (std::holds_alternative<Label>(instructions[i]) and
+                is_function(std::get<Label>(instructions[i])))
+                scope = std::get<Label>(instructions[i]);
+            for (std::size_t p = 0; p < patterns.size(); p++) {
+                if (removed[i])
+                    break;
+                auto window = get_window(i, patterns[p].window, scope);
+                if (window.entries.size() != patterns[p].window or
+                    not patterns[p].rewrite(window))
+                    continue;
+                hits[p].second++;
+                changed = true;
+            }
+        }
+    }
+
+    flag_accessor.remove_instruction_indices(removed);
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < instructions.size(); i++)
+        if (not removed[i]) {
+            if (kept != i)
+                instructions[kept] = std::move(instructions[i]);
+            kept++;
+        }
+    instructions.erase(instructions.begin() + kept, instructions.end());
+    return hits;
+}
+
+} // namespace credence::target::common::peephole
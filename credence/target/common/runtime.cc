@@ -13,18 +13,20 @@
 
 #include "runtime.h"
 
-#include "credence/ir/object.h" // for Function
-#include "easyjson.h"           // for JSON, object
-#include "stack_frame.h"        // for Stack_Frame
-#include "syscall.h"            // for get_platform_syscall_symbols
-#include "types.h"              // for Label
-#include <algorithm>            // for __find, find
-#include <array>                // for array
-#include <credence/error.h>     // for assert_equal_impl, credence_assert_e...
-#include <credence/types.h>     // for Label
-#include <credence/util.h>      // for AST_Node, AST, __source__
-#include <string>               // for basic_string, string, operator==
-#include <string_view>          // for basic_string_view
+#include "credence/ir/object.h"  // for Function
+#include "stack_frame.h"         // for Stack_Frame
+#include "syscall.h"             // for get_syscall_list
+#include "types.h"               // for Label
+#include <array>                 // for array
+#include <credence/error.h>      // for assert_equal_impl, credence_assert_e...
+#include <credence/ir/symbols.h> // for Symbols, Symbol, Shape
+#include <credence/types.h>      // for Label
+#include <credence/util.h>       // for __source__
+#include <map>                   // for map
+#include <string>                // for basic_string, string, operator==
+#include <string_view>           // for basic_string_view
+#include <tuple>                 // for tuple
+#include <utility>               // for move
 
 /****************************************************************************
  *
@@ -82,9 +84,7 @@ bool is_syscall_function(Label const& label,
     assembly::OS_Type os_type,
     assembly::Arch_Type arch_type)
 {
-    auto syscalls =
-        syscall_ns::get_platform_syscall_symbols(os_type, arch_type);
-    return std::ranges::find(syscalls, label) != syscalls.end();
+    return syscall_ns::get_syscall_list(os_type, arch_type).contains(label);
 }
 
 /**
@@ -93,8 +93,7 @@ bool is_syscall_function(Label const& label,
 
 bool is_library_function(Label const& label)
 {
-    auto lib = get_library_symbols();
-    return std::ranges::find(lib, label) != lib.end();
+    return library_list.contains(label);
 }
 
 std::pair<bool, bool> argc_argv_kernel_runtime_access(
@@ -142,20 +141,40 @@ std::vector<std::string> get_library_symbols()
 }
 
 /**
- * @brief Add the standard library and syscall routines to the hoisted
- * symbol table
+ * @brief The standard library and syscall routines of a platform
+ *
+ * Built once per platform, and laid under the hoisted symbol table of
+ * each unit compiled for it, rather than copied into every one.
  */
-void add_stdlib_functions_to_symbols(util::AST_Node& symbols,
-    assembly::OS_Type os_type,
+ir::Symbols const& get_stdlib_symbols(assembly::OS_Type os_type,
     assembly::Arch_Type arch_type,
     bool with_syscalls)
 {
-    auto libcalls = get_library_symbols();
-    for (auto const& f : libcalls)
+    using Platform = std::tuple<assembly::OS_Type, assembly::Arch_Type, bool>;
+    static std::map<Platform, ir::Symbols> layers{};
+    auto platform = Platform{ os_type, arch_type, with_syscalls };
+    if (auto layer = layers.find(platform); layer != layers.end())
+        return layer->second;
+
+    ir::Symbols symbols{};
+    for (auto const& f : get_library_symbols())
         detail::add_stdlib_function_to_table_symbols(
             f, symbols, os_type, arch_type);
     if (with_syscalls)
         detail::add_syscall_functions_to_symbols(symbols, os_type, arch_type);
+    return layers.emplace(platform, std::move(symbols)).first->second;
+}
+
+/**
+ * @brief Add the standard library and syscall routines to the hoisted
+ * symbol table
+ */
+void add_stdlib_functions_to_symbols(ir::Symbols& symbols,
+    assembly::OS_Type os_type,
+    assembly::Arch_Type arch_type,
+    bool with_syscalls)
+{
+    symbols.layer_over(get_stdlib_symbols(os_type, arch_type, with_syscalls));
 }
 
 /**
@@ -163,29 +182,28 @@ void add_stdlib_functions_to_symbols(util::AST_Node& symbols,
  */
 void detail::add_stdlib_function_to_table_symbols(
     std::string const& stdlib_function,
-    util::AST_Node& symbols,
+    ir::Symbols& symbols,
     assembly::OS_Type os_type,
     assembly::Arch_Type arch_type)
 {
     if (!is_stdlib_function(stdlib_function, os_type, arch_type))
         credence_error(
             fmt::format("Invalid stdlib function '{}'", stdlib_function));
-    symbols[stdlib_function] = util::AST::object();
-    symbols[stdlib_function]["type"] = "function_definition";
+    symbols.add(ir::Symbol{ .name = stdlib_function,
+        .shape = ir::Shape::Function_Definition });
 }
 
 /**
  * @brief Add a syscall routine to the hoisted symbol table
  */
-void detail::add_syscall_functions_to_symbols(util::AST_Node& symbols,
+void detail::add_syscall_functions_to_symbols(ir::Symbols& symbols,
     assembly::OS_Type os_type,
     assembly::Arch_Type arch_type)
 {
-    auto syscalls =
-        syscall_ns::get_platform_syscall_symbols(os_type, arch_type);
-    for (auto const& routine : syscalls)
+    for (auto const& [routine, _] :
+        syscall_ns::get_syscall_list(os_type, arch_type))
         add_stdlib_function_to_table_symbols(
-            routine, symbols, os_type, arch_type);
+            std::string{ routine }, symbols, os_type, arch_type);
 }
 
 }
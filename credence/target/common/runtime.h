@@ -13,23 +13,24 @@
 
 #pragma once
 
-#include "stack_frame.h"        // for Locals
-#include "types.h"              // for Enum_T, Label, Stack_Pointer, Storage_T
-#include <array>                // for array
-#include <credence/error.h>     // for compile_error_impl, throw_compiletim...
-#include <credence/ir/object.h> // for Object_PTR
-#include <credence/util.h>      // for AST_Node, __source__, range_contains
-#include <cstddef>              // for size_t
-#include <deque>                // for deque
-#include <easyjson.h>           // for object
-#include <fmt/format.h>         // for format
-#include <initializer_list>     // for initializer_list
-#include <map>                  // for map
-#include <source_location>      // for source_location
-#include <string>               // for basic_string, string, char_traits
-#include <string_view>          // for basic_string_view, string_view
-#include <utility>              // for pair
-#include <vector>               // for vector
+#include "stack_frame.h"         // for Locals
+#include "types.h"               // for Enum_T, Label, Stack_Pointer, Storage_T
+#include <array>                 // for array
+#include <credence/error.h>      // for compile_error_impl, throw_compiletim...
+#include <credence/ir/object.h>  // for Object_PTR
+#include <credence/ir/symbols.h> // for Symbols
+#include <credence/util.h>       // for AST_Node, __source__, range_contains
+#include <cstddef>               // for size_t
+#include <deque>                 // for deque
+#include <easyjson.h>            // for object
+#include <fmt/format.h>          // for format
+#include <initializer_list>      // for initializer_list
+#include <map>                   // for map
+#include <source_location>       // for source_location
+#include <string>                // for basic_string, string, char_traits
+#include <string_view>           // for basic_string_view, string_view
+#include <utility>               // for pair
+#include <vector>                // for vector
 
 /****************************************************************************
  *
@@ -125,17 +126,21 @@ inline void throw_runtime_error(std::string_view message,
 namespace detail {
 
 void add_stdlib_function_to_table_symbols(std::string const& stdlib_function,
-    util::AST_Node& symbols,
+    ir::Symbols& symbols,
     assembly::OS_Type os_type,
     assembly::Arch_Type arch_type);
 
-void add_syscall_functions_to_symbols(util::AST_Node& symbols,
+void add_syscall_functions_to_symbols(ir::Symbols& symbols,
     assembly::OS_Type os_type,
     assembly::Arch_Type arch_type);
 
 } // namespace detail
 
-void add_stdlib_functions_to_symbols(util::AST_Node& symbols,
+ir::Symbols const& get_stdlib_symbols(assembly::OS_Type os_type,
+    assembly::Arch_Type arch_type,
+    bool with_syscalls = true);
+
+void add_stdlib_functions_to_symbols(ir::Symbols& symbols,
     assembly::OS_Type os_type,
     assembly::Arch_Type arch_type,
     bool with_syscalls = true);
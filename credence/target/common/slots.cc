@@ -0,0 +1,105 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include <credence/target/common/slots.h>
+
+#include <algorithm>                       // for find_if, sort, any_of
+#include <credence/target/common/memory.h> // for align_up_to
+#include <cstddef>                         // for size_t
+
+namespace credence::target::common::slots {
+
+namespace {
+
+/**
+ * @brief The offset of a slot of a size and the end of its last interval
+ */
+struct Color
+{
+    Stack_Offset offset{ 0 };
+    Size size{ 0 };
+    std::size_t end{ 0 };
+};
+
+constexpr bool is_overlapping(Range const& lhs, Range const& rhs)
+{
+    return lhs.first < rhs.second and rhs.first < lhs.second;
+}
+
+/**
+ * @brief The lowest offset after the base aligned to the size whose bytes
+ * overlap neither the fixed bytes nor a color
+ */
+Stack_Offset get_free_offset(Size size,
+    std::vector<Range> const& fixed,
+    std::vector<Color> const& colors,
+    Stack_Offset base)
+{
+    auto offset = memory::align_up_to(base + size, size);
+    auto is_taken = [&](Range const& range) {
+        return std::ranges::any_of(fixed,
+                   [&](Range const& bytes) {
+                       return is_overlapping(range, bytes);
+                   }) or
+               std::ranges::any_of(colors, [&](Color const& color) {
+                   return is_overlapping(
+                       range, { color.offset - color.size, color.offset });
+               });
+    };
+    while (is_taken({ offset - size, offset }))
+        offset += size;
+    return offset;
+}
+
+} // namespace
+
+/**
+ * @brief Give each interval an offset after the base, shared by the
+ * intervals of the same size that do not overlap
+ */
+std::map<Stack_Offset, Stack_Offset> color_intervals(
+    allocator::Intervals& intervals,
+    std::map<Stack_Offset, Size> const& sizes,
+    std::vector<Range> const& fixed,
+    allocator::Loops const& loops,
+    Stack_Offset base)
+{
+    std::vector<allocator::Interval*> order{};
+    for (auto& [slot, interval] : intervals) {
+        allocator::extend_interval_over_loops(interval, loops);
+        order.push_back(&interval);
+    }
+    std::ranges::stable_sort(order,
+        [](allocator::Interval const* lhs, allocator::Interval const* rhs) {
+            return lhs->start < rhs->start;
+        });
+
+    std::vector<Color> colors{};
+    std::map<Stack_Offset, Stack_Offset> offsets{};
+    for (auto const* interval : order) {
+        auto size = sizes.at(interval->slot);
+        auto color = std::ranges::find_if(colors, [&](Color const& color) {
+            return color.size == size and color.end < interval->start;
+        });
+        if (color == colors.end()) {
+            colors.push_back(
+                { get_free_offset(size, fixed, colors, base), size, 0 });
+            color = colors.end() - 1;
+        }
+        color->end = interval->end;
+        offsets[interval->slot] = color->offset;
+    }
+    return offsets;
+}
+
+} // namespace credence::target::common::slots
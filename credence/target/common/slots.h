@@ -0,0 +1,70 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <credence/target/common/allocator.h> // for Intervals, Loops
+#include <credence/target/common/types.h>     // for Stack_Offset, Size
+#include <map>                                // for map
+#include <utility>                            // for pair
+#include <vector>                             // for vector
+
+/****************************************************************************
+ *
+ * Stack Slot Coloring
+ *
+ * The platform-independent half of the stack slot pass of
+ * credence/target/x86_64/allocator.h. The stack gives each local a new
+ * offset for the whole function, so the frame grows with the number of
+ * locals rather than the number live at once. Each platform finds the
+ * slots of a function it can move, their live intervals as in
+ * credence/target/common/allocator.h, and the bytes of the frame it
+ * cannot move, and rewrites the slots by the offsets given back here:
+ *
+ *   B code:                         Before:        After:
+ *     f(a) {                          [rbp - 4] x    [rbp - 4] x, z
+ *       auto x, y, z;                 [rbp - 8] y    [rbp - 8] y
+ *       x = a * 2;                    [rbp - 12] z
+ *       y = x + 10;
+ *       z = y - 5;
+ *       return(z);
+ *     }
+ *
+ * The intervals are colored by start, and each takes the first color of
+ * its own size whose last interval ended before it, or a new color at the
+ * lowest offset after the base aligned to its size that overlaps neither
+ * the fixed bytes nor another color. Only slots of the same size share an
+ * offset, so each is read and written as the size it was allocated as.
+ *
+ * An offset is the distance below the frame pointer of the last byte of a
+ * slot, so a slot of size s at offset n takes the bytes (n - s, n].
+ *
+ *****************************************************************************/
+
+namespace credence::target::common::slots {
+
+// the bytes (first, second] of the frame a slot takes
+using Range = std::pair<Stack_Offset, Stack_Offset>;
+
+/**
+ * @brief Give each interval an offset after the base, shared by the
+ * intervals of the same size that do not overlap
+ */
+std::map<Stack_Offset, Stack_Offset> color_intervals(
+    allocator::Intervals& intervals,
+    std::map<Stack_Offset, Size> const& sizes,
+    std::vector<Range> const& fixed,
+    allocator::Loops const& loops,
+    Stack_Offset base);
+
+} // namespace credence::target::common::slots
@@ -51,7 +51,7 @@ std::vector<std::string> get_platform_syscall_symbols(assembly::OS_Type os_type,
     assembly::Arch_Type arch_type)
 {
     std::vector<std::string> symbols{};
-    auto syscall_list = get_syscall_list(os_type, arch_type);
+    auto const& syscall_list = get_syscall_list(os_type, arch_type);
     // cppcheck-suppress[useStlAlgorithm,knownEmptyContainer]
     for (auto const& syscall : syscall_list) {
         // cppcheck-suppress[useStlAlgorithm,knownEmptyContainer]
@@ -19,7 +19,6 @@
 #include <cstddef>     // for size_t
 #include <deque>       // for deque
 #include <map>         // for map
-#include <matchit.h>   // for match
 #include <stdint.h>    // for uint32_t
 #include <string>      // for string
 #include <string_view> // for basic_string_view, string_view
@@ -998,48 +997,29 @@ const syscall_list_t syscall_list = arm64::bsd_ns::syscall_list;
 std::vector<std::string> get_platform_syscall_symbols(assembly::OS_Type os_type,
     assembly::Arch_Type arch_type);
 
-inline syscall_list_t get_syscall_list(assembly::OS_Type os_type,
+/**
+ * @brief The syscall table of a platform
+ *
+ * The table itself, and not a copy of it: the code generators ask for it
+ * on every call they lower, to tell a syscall from a function.
+ */
+inline syscall_list_t const& get_syscall_list(assembly::OS_Type os_type,
     assembly::Arch_Type arch_type)
 {
-    namespace m = matchit;
-    return m::match(os_type)(
-        m::pattern | assembly::OS_Type::BSD =
-            [&] {
-                return m::match(arch_type)(
-                    m::pattern | assembly::Arch_Type::ARM64 =
-                        [&] { return syscall_ns::arm64::bsd_ns::syscall_list; },
-                    m::pattern | assembly::Arch_Type::X8664 =
-                        [&] {
-                            return syscall_ns::x86_64::bsd_ns::syscall_list;
-                        },
-                    m::pattern | m::_ =
-                        [&] {
-                            credence_error("unsupported architecture");
-                            return common::syscall_ns::syscall_list_t{};
-                        });
-            },
-        m::pattern | assembly::OS_Type::Linux =
-            [&] {
-                return m::match(arch_type)(
-                    m::pattern | assembly::Arch_Type::ARM64 =
-                        [&] {
-                            return syscall_ns::arm64::linux_ns::syscall_list;
-                        },
-                    m::pattern | assembly::Arch_Type::X8664 =
-                        [&] {
-                            return syscall_ns::x86_64::linux_ns::syscall_list;
-                        },
-                    m::pattern | m::_ =
-                        [&] {
-                            credence_error("unsupported architecture");
-                            return common::syscall_ns::syscall_list_t{};
-                        });
-            },
-        m::pattern | m::_ =
-            [&] {
-                credence_error("unsupported architecture");
-                return common::syscall_ns::syscall_list_t{};
-            });
+    static const syscall_list_t unsupported{};
+    if (os_type == assembly::OS_Type::BSD) {
+        if (arch_type == assembly::Arch_Type::ARM64)
+            return syscall_ns::arm64::bsd_ns::syscall_list;
+        if (arch_type == assembly::Arch_Type::X8664)
+            return syscall_ns::x86_64::bsd_ns::syscall_list;
+    } else if (os_type == assembly::OS_Type::Linux) {
+        if (arch_type == assembly::Arch_Type::ARM64)
+            return syscall_ns::arm64::linux_ns::syscall_list;
+        if (arch_type == assembly::Arch_Type::X8664)
+            return syscall_ns::x86_64::linux_ns::syscall_list;
+    }
+    credence_error("unsupported architecture");
+    return unsupported;
 }
 
 } // namespace credence::target::arm64::syscall_ns
@@ -20,6 +20,7 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -158,7 +159,7 @@ template<typename T, typename M, typename R>
 concept Instruction_Input = std::same_as<T, Instruction_T<M, R>>;
 
 template<Enum_T M, Enum_T R>
-using Instructions = std::deque<Instruction_T<M, R>>;
+using Instructions = std::pmr::deque<Instruction_T<M, R>>;
 
 template<Enum_T T>
 constexpr T get_first_of_enum_t(int first = 0)
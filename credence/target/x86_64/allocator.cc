@@ -0,0 +1,404 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include "allocator.h"
+
+#include "assembly.h"                         // for Instruction, Register
+#include "inserter.h"                         // for get_operand_size_from_...
+#include "memory.h"                           // for Memory_Accessor, gener...
+#include "stack.h"                            // for Stack
+#include <algorithm>                          // for max
+#include <credence/target/common/allocator.h> // for Intervals, linear_scan
+#include <credence/target/common/flags.h>     // for Instruction_Flag
+#include <credence/target/common/slots.h>     // for Range, color_intervals
+#include <credence/target/common/types.h>     // for Stack_Offset
+#include <cstddef>                            // for size_t
+#include <map>                                // for map
+#include <set>                                // for set
+#include <string>                             // for basic_string, string
+#include <tuple>                              // for get
+#include <utility>                            // for pair
+#include <variant>                            // for get, holds_alternative
+#include <vector>                             // for vector
+
+namespace credence::target::x86_64 {
+
+namespace {
+
+using Offset = assembly::Stack::Offset;
+using common::allocator::Loops;
+
+// the flags of an instruction that reads a slot as an address, or through
+// one, or as a qword argument whatever its size
+constexpr common::flag::flags address_flags = common::flag::Address |
+                                              common::flag::Indirect |
+                                              common::flag::Indirect_Source |
+                                              common::flag::Argument |
+                                              common::flag::Load;
+
+/**
+ * @brief The mnemonics that take a register wherever they take a slot
+ */
+constexpr bool is_register_mnemonic(Mnemonic mnemonic)
+{
+    switch (mnemonic) {
+        case Mnemonic::mov:
+        case Mnemonic::mov_:
+        case Mnemonic::add:
+        case Mnemonic::sub:
+        case Mnemonic::imul:
+        case Mnemonic::idiv:
+        case Mnemonic::inc:
+        case Mnemonic::dec:
+        case Mnemonic::neg:
+        case Mnemonic::cmp:
+        case Mnemonic::and_:
+        case Mnemonic::or_:
+        case Mnemonic::xor_:
+        case Mnemonic::not_:
+        case Mnemonic::shl:
+        case Mnemonic::shr:
+            return true;
+        default:
+            return false;
+    }
+}
+
+constexpr bool is_jump_mnemonic(Mnemonic mnemonic)
+{
+    switch (mnemonic) {
+        case Mnemonic::goto_:
+        case Mnemonic::je:
+        case Mnemonic::jne:
+        case Mnemonic::jl:
+        case Mnemonic::jle:
+        case Mnemonic::jg:
+        case Mnemonic::jge:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief The dword register of a callee-saved qword register
+ */
+constexpr Register get_register_from_size(Register qword, Operand_Size size)
+{
+    if (size == Operand_Size::Qword)
+        return qword;
+    switch (qword) {
+        case Register::rbx:
+            return Register::ebx;
+        case Register::r12:
+            return Register::r12d;
+        case Register::r13:
+            return Register::r13d;
+        default:
+            return Register::r14d;
+    }
+}
+
+/**
+ * @brief The loops of the function inserted from an instruction index,
+ * and its epilogue from _L1 to the label after it
+ */
+struct Frame_Layout
+{
+    std::size_t end{ 0 };
+    std::size_t epilogue{ 0 };
+    std::size_t epilogue_end{ 0 };
+    Loops loops{};
+};
+
+Frame_Layout get_frame_layout(memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin)
+{
+    auto& instructions = accessor->instruction_accessor->get_instructions();
+    Frame_Layout layout{};
+    layout.end = instructions.size();
+    layout.epilogue = layout.end;
+    layout.epilogue_end = layout.end;
+
+    std::map<std::string, std::size_t> labels{};
+    for (std::size_t i = begin; i < layout.end; i++) {
+        if (not std::holds_alternative<Label>(instructions[i]))
+            continue;
+        auto const& label = std::get<Label>(instructions[i]);
+        if (layout.epilogue < i and layout.epilogue_end == layout.end)
+            layout.epilogue_end = i;
+        if (label == "_L1")
+            layout.epilogue = i;
+        labels[assembly::make_label(label, name)] = i;
+    }
+
+    for (std::size_t i = begin; i < layout.end; i++) {
+        if (not std::holds_alternative<assembly::Instruction>(instructions[i]))
+            continue;
+        auto const& [mnemonic, dest, src] =
+            std::get<assembly::Instruction>(instructions[i]);
+        if (not is_jump_mnemonic(mnemonic) or
+            not std::holds_alternative<Immediate>(dest))
+            continue;
+        auto const& to = std::get<0>(std::get<Immediate>(dest));
+        if (labels.contains(to) and labels.at(to) <= i)
+            layout.loops.emplace_back(labels.at(to), i);
+    }
+    return layout;
+}
+
+/**
+ * @brief The base offset of each vector of the frame and its size, each
+ * from its base offset down to its first element
+ */
+std::vector<std::pair<Offset, Offset>> get_frame_vectors(
+    memory::Memory_Access& accessor)
+{
+    auto& stack = accessor->stack;
+    std::vector<std::pair<Offset, Offset>> vectors{};
+    for (auto const& [vector_name, vector] :
+        accessor->table_accessor.get_table()->get_vectors())
+        if (stack->contains(vector_name) and
+            stack->is_allocated(vector_name)) {
+            auto base = stack->get(vector_name).first;
+            auto size = stack->get_stack_size_from_table_vector(*vector);
+            vectors.emplace_back(base, size);
+        }
+    return vectors;
+}
+
+/**
+ * @brief Whether a slot is a named local, and not a vector or an element
+ * of one
+ */
+bool is_local_slot(memory::Memory_Access& accessor,
+    std::vector<std::pair<Offset, Offset>> const& vectors,
+    Offset slot)
+{
+    auto lvalue = accessor->stack->get_lvalue_from_offset(slot);
+    if (lvalue.empty() or lvalue.starts_with("__internal") or
+        accessor->table_accessor.get_table()->get_vectors().contains(lvalue))
+        return false;
+    for (auto [base, size] : vectors)
+        if (slot <= base and slot + size > base)
+            return false;
+    return true;
+}
+
+/**
+ * @brief Whether an instruction reads or writes a slot as itself, as the
+ * size it was allocated as, and outside the epilogue
+ */
+bool is_local_use(memory::Memory_Access& accessor,
+    Frame_Layout const& layout,
+    std::size_t index,
+    Offset slot)
+{
+    auto& instructions = accessor->instruction_accessor->get_instructions();
+    auto& stack = accessor->stack;
+    auto const& [mnemonic, dest, src] =
+        std::get<assembly::Instruction>(instructions[index]);
+    auto flags = accessor->flag_accessor.get_instruction_flags_at_index(index);
+    if (flags & address_flags)
+        return false;
+    if (index >= layout.epilogue and index < layout.epilogue_end)
+        return false;
+    // the size the emitter reads the slot as
+    auto size = flags & common::flag::QWord_Dest
+                    ? Operand_Size::Qword
+                    : get_operand_size_from_storage(src, stack);
+    if (size == Operand_Size::Empty)
+        size = Operand_Size::Dword;
+    return size == stack->get_operand_size_from_offset(slot);
+}
+
+/**
+ * @brief The live intervals of the slots of a function that pass the
+ * check, and the slots that do not
+ */
+template<typename Check>
+std::pair<common::allocator::Intervals, std::set<Offset>> get_slot_intervals(
+    memory::Memory_Access& accessor,
+    Frame_Layout const& layout,
+    std::size_t begin,
+    Check const& is_candidate)
+{
+    auto& instructions = accessor->instruction_accessor->get_instructions();
+    common::allocator::Intervals intervals{};
+    std::set<Offset> kept{};
+    for (std::size_t i = begin; i < layout.end; i++) {
+        if (not std::holds_alternative<assembly::Instruction>(instructions[i]))
+            continue;
+        auto const& [mnemonic, dest, src] =
+            std::get<assembly::Instruction>(instructions[i]);
+        for (auto const* operand : { &dest, &src }) {
+            if (not std::holds_alternative<Offset>(*operand))
+                continue;
+            auto slot = std::get<Offset>(*operand);
+            if (kept.contains(slot))
+                continue;
+            if (not is_candidate(i, slot)) {
+                kept.insert(slot);
+                intervals.erase(slot);
+                continue;
+            }
+            common::allocator::add_use_to_interval(
+                intervals, slot, i, layout.loops);
+        }
+    }
+    return { intervals, kept };
+}
+
+} // namespace
+
+/**
+ * @brief Keep the scalar stack slots of the function inserted from the
+ * instruction index begin in callee-saved registers, and give back the
+ * registers the function must save
+ */
+memory::registers::general_purpose allocate_registers(
+    memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin)
+{
+    auto& instructions = accessor->instruction_accessor->get_instructions();
+    auto& stack = accessor->stack;
+    auto layout = get_frame_layout(accessor, name, begin);
+    auto vectors = get_frame_vectors(accessor);
+
+    auto is_register_slot = [&](std::size_t index, Offset slot) {
+        auto const& [mnemonic, dest, src] =
+            std::get<assembly::Instruction>(instructions[index]);
+        auto size = stack->get_operand_size_from_offset(slot);
+        return is_local_slot(accessor, vectors, slot) and
+               (size == Operand_Size::Dword or size == Operand_Size::Qword) and
+               is_register_mnemonic(mnemonic) and
+               is_local_use(accessor, layout, index, slot);
+    };
+    auto [intervals, kept] =
+        get_slot_intervals(accessor, layout, begin, is_register_slot);
+
+    auto assigned = common::allocator::linear_scan(intervals,
+        layout.loops,
+        memory::registers::callee_saved_qword_register);
+
+    for (auto const& [slot, qword] : assigned) {
+        auto device = get_register_from_size(
+            qword, stack->get_operand_size_from_offset(slot));
+        for (auto index : intervals.at(slot).uses) {
+            auto& [mnemonic, dest, src] =
+                std::get<assembly::Instruction>(instructions[index]);
+            for (auto* operand : { &dest, &src })
+                if (std::holds_alternative<Offset>(*operand) and
+                    std::get<Offset>(*operand) == slot)
+                    *operand = device;
+        }
+    }
+
+    // main never returns, so only the other functions save what they use
+    if (name == "main")
+        return {};
+    return common::allocator::get_saved_registers(
+        assigned, memory::registers::callee_saved_qword_register);
+}
+
+/**
+ * @brief Share the stack slots of the locals of the function inserted
+ * from the instruction index begin whose lifetimes do not overlap, and
+ * give back the bytes of the frame it no longer takes
+ */
+Size allocate_stack_slots(memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin,
+    Offset base)
+{
+    auto& instructions = accessor->instruction_accessor->get_instructions();
+    auto& stack = accessor->stack;
+    auto layout = get_frame_layout(accessor, name, begin);
+    auto vectors = get_frame_vectors(accessor);
+
+    auto is_stack_slot = [&](std::size_t index, Offset slot) {
+        return is_local_slot(accessor, vectors, slot) and
+               stack->get_operand_size_from_offset(slot) !=
+                   Operand_Size::Empty and
+               is_local_use(accessor, layout, index, slot);
+    };
+    auto [intervals, kept] =
+        get_slot_intervals(accessor, layout, begin, is_stack_slot);
+    if (intervals.empty())
+        return 0;
+
+    auto get_slot_size = [&](Offset slot) {
+        auto size = stack->get_operand_size_from_offset(slot);
+        // a spilled temporary has no address to say its size
+        if (size == Operand_Size::Empty)
+            size = Operand_Size::Qword;
+        return assembly::get_size_from_operand_size(size);
+    };
+
+    // the bytes of each address the pass does not move, and of each
+    // vector down to the base of the frame
+    std::vector<common::slots::Range> fixed{};
+    Offset extent = base;
+    auto add_fixed_slot = [&](Offset slot) {
+        auto size = get_slot_size(slot);
+        fixed.emplace_back(slot > size ? slot - size : 0, slot);
+        extent = std::max(extent, slot);
+    };
+    for (auto slot : stack->get_offsets())
+        if (not intervals.contains(slot))
+            add_fixed_slot(slot);
+    for (auto slot : kept)
+        add_fixed_slot(slot);
+    for (auto [vector_base, size] : vectors) {
+        fixed.emplace_back(base, vector_base);
+        extent = std::max(extent, vector_base);
+    }
+
+    std::map<Offset, Size> sizes{};
+    for (auto const& [slot, interval] : intervals)
+        sizes[slot] = get_slot_size(slot);
+    auto offsets = common::slots::color_intervals(
+        intervals, sizes, fixed, layout.loops, base);
+    for (auto const& [slot, offset] : offsets)
+        extent = std::max(extent, offset);
+    if (extent >= stack->get_size())
+        return 0;
+
+    std::set<std::size_t> uses{};
+    for (auto const& [slot, interval] : intervals)
+        uses.insert(interval.uses.begin(), interval.uses.end());
+    for (auto index : uses) {
+        auto& [mnemonic, dest, src] =
+            std::get<assembly::Instruction>(instructions[index]);
+        for (auto* operand : { &dest, &src })
+            if (std::holds_alternative<Offset>(*operand) and
+                offsets.contains(std::get<Offset>(*operand)))
+                *operand = offsets.at(std::get<Offset>(*operand));
+    }
+
+    // the lvalue of each slot is found before any is moved, as a slot may
+    // move to the offset another left
+    std::vector<std::pair<LValue, Offset>> moved{};
+    for (auto const& [slot, offset] : offsets)
+        moved.emplace_back(stack->get_lvalue_from_offset(slot), offset);
+    for (auto const& [lvalue, offset] : moved)
+        stack->set_address_from_offset(lvalue, offset);
+
+    auto saved = stack->get_size() - extent;
+    stack->set_size(extent);
+    return saved;
+}
+
+} // namespace credence::target::x86_64
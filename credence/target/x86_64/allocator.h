@@ -0,0 +1,98 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "memory.h"             // for Memory_Access, general_purpose
+#include <credence/ir/object.h> // for Label, Size
+#include <cstddef>              // for size_t
+
+/****************************************************************************
+ *
+ * x86-64 Register Allocator
+ *
+ * The inserter keeps each local in a stack slot, and takes a scratch
+ * register from rdi, r8, r9, rsi, rdx and rcx for each expression, so a
+ * local is read from and written back to memory at each use. Once the
+ * instructions of a function are inserted, and while the stack still
+ * describes its frame, the slots of its scalar locals are given the
+ * callee-saved registers the inserter never hands out by linear scan:
+ *
+ *   B code:                         Before:
+ *     main() {                        mov dword ptr [rbp - 4], 0
+ *       auto i;                     ._L2__main:
+ *       i = 0;                        mov eax, dword ptr [rbp - 4]
+ *       while (i < 10)                cmp eax, 10
+ *         i = i + 1;                  ...
+ *     }                               add dword ptr [rbp - 4], 1
+ *
+ *                                   After:
+ *                                     mov ebx, 0
+ *                                   ._L2__main:
+ *                                     mov eax, ebx
+ *                                     cmp eax, 10
+ *                                     ...
+ *                                     add ebx, 1
+ *
+ * The slots are scanned by the start of their live intervals over rbx,
+ * r12, r13 and r14, see credence/target/common/allocator.h, and when all
+ * four are taken, the interval with the lowest cost keeps its slot.
+ *
+ * A slot is kept on the stack if its address is taken, if it is a vector
+ * or an element of one, if an instruction reads it as a different size
+ * than its own, or if the epilogue after _L1 uses it, as the emitter
+ * moves the epilogue to the end of the function. r15 holds argc and argv,
+ * and the caller-saved registers are scratch for the inserter, syscalls
+ * and calls, so neither is allocated.
+ *
+ * Each function but main saves the registers it was given before its
+ * prologue and restores them before it returns, an even number of them to
+ * keep the stack aligned, which the emitter writes from the registers
+ * given back here.
+ *
+ * The stack gives each local a new offset for the whole function, so
+ * once the registers are given, the slots left of the same size whose
+ * live intervals do not overlap share an offset, see
+ * credence/target/common/slots.h. The slots of a function are moved
+ * within the bytes it allocated from the base offset the stack was at
+ * when it began, and the stack is set back to the last byte the function
+ * still takes, so the functions after it, and the frame size the emitter
+ * reads at the end, are smaller by the bytes it gave back. The same slots
+ * are kept where they are as for the registers, as are spilled
+ * temporaries, which have no address to say their size.
+ *
+ *****************************************************************************/
+
+namespace credence::target::x86_64 {
+
+/**
+ * @brief Keep the scalar stack slots of the function inserted from the
+ * instruction index begin in callee-saved registers, and give back the
+ * registers the function must save
+ */
+memory::registers::general_purpose allocate_registers(
+    memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin);
+
+/**
+ * @brief Share the stack slots of the locals of the function inserted
+ * from the instruction index begin whose lifetimes do not overlap, and
+ * give back the bytes of the frame it no longer takes
+ */
+Size allocate_stack_slots(memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin,
+    common::Stack_Offset base);
+
+} // namespace credence::target::x86_64
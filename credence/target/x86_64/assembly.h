@@ -19,11 +19,12 @@
 #include <credence/types.h>                  // for RValue, Type, get_type_...
 #include <credence/util.h>                   // for contains, STRINGIFY
 #include <cstddef>                           // for size_t
-#include <deque>                             // for deque
+#include <deque>                             // for deque, pmr::deque
 #include <fmt/format.h>                      // for format
 #include <initializer_list>                  // for initializer_list
 #include <map>                               // for map
 #include <matchit.h>                         // for pattern, Or, PatternHelper
+#include <memory_resource>                   // for polymorphic_allocator
 #include <ostream>                           // for basic_ostream, operator<<
 #include <sstream>                           // for ostream
 #include <string>                            // for basic_string, char_traits
@@ -637,7 +638,8 @@ using Instruction = common::Mnemonic_2ARY<Mnemonic, Register>;
 using Literal_Type = std::variant<type::semantic::RValue, float, double>;
 using Data_Pair = std::pair<Directive, Literal_Type>;
 using Directives = std::deque<std::variant<Label, Data_Pair>>;
-using Instructions = std::deque<common::Instruction_2ARY<Mnemonic, Register>>;
+using Instructions =
+    std::pmr::deque<common::Instruction_2ARY<Mnemonic, Register>>;
 using Instruction_Pair = common::Instruction_Pair<Storage, Instructions>;
 using Immediate = common::Immediate;
 using Directive_Pair = std::pair<std::string, Directives>;
@@ -17,15 +17,22 @@
 #include "credence/target/common/flags.h"    // for Instruction_Flag, flags
 #include "inserter.h"                        // for Instruction_Inserter
 #include "memory.h"                          // for Memory_Accessor, Addres...
+#include "peephole.h"                        // for rewrite_instructions
 #include "stack.h"                           // for Stack
+#include <algorithm>                         // for reverse
+#include <credence/arena.h>                  // for Arena
 #include <credence/error.h>                  // for credence_assert
 #include <credence/ir/ita.h>                 // for make_ita_instructions
 #include <credence/ir/object.h>              // for Object, Label, RValue
+#include <credence/ir/optimize.h>            // for optimize
+#include <credence/ir/quadruple.h>           // for Operand_Scope
 #include <credence/ir/table.h>               // for Table
+#include <credence/passes.h>                 // for Scope
 #include <credence/symbol.h>                 // for Symbol_Table
 #include <credence/target/common/accessor.h> // for Buffer_Accessor
 #include <credence/target/common/assembly.h> // for get_storage_as_string
 #include <credence/target/common/memory.h>   // for Operand_Type
+#include <credence/target/common/options.h>  // for target_options
 #include <credence/target/common/runtime.h>  // for get_library_symbols
 #include <credence/types.h>                  // for get_value_from_rvalue_d...
 #include <credence/util.h>                   // for is_variant, AST_Node
@@ -95,17 +102,31 @@ namespace m = matchit;
  * Emit a complete x86-64 program from an AST and symbols
  */
 void emit(std::ostream& os,
-    util::AST_Node& symbols,
+    ir::Symbols& symbols,
     frontend::hir::Unit const& unit,
     bool no_stdlib)
 {
-    auto [globals, instructions] = ir::make_ita_instructions(unit, symbols);
+    // the instruction lists of this compilation are allocated from here
+    Arena arena{};
+    ir::Operand_Scope operands{};
+
+    passes::Scope ita_pass{ "ita" };
+    auto [globals, instructions] =
+        ir::make_ita_instructions(unit, symbols, arena.resource());
+    ita_pass.count("quadruples", instructions.size());
+    ita_pass.finish();
+
+    ir::optimize(instructions);
+
+    passes::Scope table_pass{ "table" };
     auto table = std::make_shared<ir::Table>(
         ir::Table{ symbols, instructions, globals });
     table->build_from_ir_instructions();
+    table_pass.count("quadruples", table->get_table_instructions()->size());
+    table_pass.finish();
     auto stack = std::make_shared<assembly::Stack>();
     auto accessor = std::make_shared<memory::Memory_Accessor>(
-        table->get_table_object(), stack);
+        table->get_table_object(), stack, arena.resource());
     auto emitter = Assembly_Emitter{ accessor };
     emitter.text_.test_no_stdlib = no_stdlib;
     emitter.emit(os);
@@ -118,10 +139,27 @@ void Assembly_Emitter::emit(std::ostream& os)
 {
     emit_x86_64_assembly_intel_prologue(os);
     data_.set_data_section();
+
+    passes::Scope insert_pass{ "insert" };
     auto inserter = Instruction_Inserter{ accessor_ };
-    inserter.from_ir_instructions(ir_instructions_);
+    inserter.from_ir_instructions(*ir_instructions_);
+    auto instructions = accessor_->instruction_accessor->size();
+    insert_pass.count("instructions", instructions);
+    insert_pass.finish();
+
+    if (common::target_options.peephole) {
+        passes::Scope peephole_pass{ "peephole" };
+        for (auto const& [pattern, hits] : rewrite_instructions(accessor_))
+            peephole_pass.count(pattern, hits);
+        peephole_pass.count("removed",
+            instructions - accessor_->instruction_accessor->size());
+        instructions = accessor_->instruction_accessor->size();
+    }
+
+    passes::Scope emit_pass{ "emit" };
     text_.emit_text_section(os);
     data_.emit_data_section(os);
+    emit_pass.count("instructions", instructions);
 }
 
 /**
@@ -137,11 +175,13 @@ constexpr std::string emit_immediate_storage(Immediate const& immediate)
 }
 
 /**
- * @brief Emit a stack offset based on size, prefix, and instruction flags
+ * @brief Emit a stack offset based on size, prefix, and instruction flags,
+ * below the frame pointer or, in a leaf, the stack pointer
  */
 constexpr std::string emit_stack_storage(assembly::Stack::Offset offset,
     assembly::Operand_Size size,
-    common::flag::flags flags)
+    common::flag::flags flags,
+    std::string_view pointer)
 {
     using namespace fmt::literals;
     std::string as_str{};
@@ -149,9 +189,9 @@ constexpr std::string emit_stack_storage(assembly::Stack::Offset offset,
         size = Operand_Size::Qword;
     std::string prefix = memory::storage_prefix_from_operand_size(size);
     if (flags & common::flag::Address)
-        as_str = fmt::format("[rbp - {}]"_cf, offset);
+        as_str = fmt::format("[{} - {}]"_cf, pointer, offset);
     else
-        as_str = fmt::format("{} [rbp - {}]"_cf, prefix, offset);
+        as_str = fmt::format("{} [{} - {}]"_cf, prefix, pointer, offset);
     return as_str;
 }
 
@@ -407,6 +447,9 @@ std::string Storage_Emitter::get_storage_device_as_string(
         m::pattern | m::as<assembly::Stack::Offset>(s) =
             [&] {
                 // size = accessor_->stack->get_operand_size_from_offset(*s);
+                if (red_zone_.has_value())
+                    return emit_stack_storage(
+                        *s + 8 - *red_zone_, size, flags, "rsp");
                 return emit_stack_storage(*s, size, flags);
             },
         m::pattern | m::as<assembly::Register>(r) =
@@ -481,9 +524,8 @@ void Text_Emitter::emit_assembly_label(std::ostream& os,
 {
     auto& table = accessor_->table_accessor.get_table();
     // function labels
-    if (table->get_hoisted_symbols().has_key(s) and
-        table->get_hoisted_symbols()[s]["type"].to_string() ==
-            "function_definition") {
+    auto const* symbol = table->get_hoisted_symbols().find(s);
+    if (symbol != nullptr and symbol->shape == ir::Shape::Function_Definition) {
         // this is a new frame, emit the last frame function epilogue
         if (frame_ != s)
             emit_function_epilogue(os);
@@ -498,6 +540,7 @@ void Text_Emitter::emit_assembly_label(std::ostream& os,
             assembly::newline(os, 2);
         os << assembly::make_label(s) << ":";
         assembly::newline(os, 1);
+        emit_saved_registers(os, assembly::Mnemonic::push);
         return;
     }
     // branch labels
@@ -526,6 +569,8 @@ void Text_Emitter::emit_assembly_instruction(std::ostream& os,
     auto flags = accessor_->flag_accessor.get_instruction_flags_at_index(index);
     auto [mnemonic, dest, src] = s;
     auto storage_emitter = Storage_Emitter{ accessor_, index, src };
+    if (accessor_->leaf_frames.contains(frame_))
+        storage_emitter.set_red_zone(accessor_->leaf_frames.at(frame_));
     // The IR does not keep the epilogue at the end, we move it ourselves
     if (branch_ == "_L1" and label_size_ > 0) {
         return_instructions_.emplace_back(s);
@@ -535,6 +580,9 @@ void Text_Emitter::emit_assembly_instruction(std::ostream& os,
     if (flags & common::flag::Load and not is_variant(Register, src))
         mnemonic = assembly::Mnemonic::lea;
 
+    if (mnemonic == assembly::Mnemonic::ret)
+        emit_saved_registers(os, assembly::Mnemonic::pop);
+
     os << assembly::tabwidth(4) << mnemonic;
 
     storage_emitter.emit(os, dest, mnemonic, memory::Operand_Type::Destination);
@@ -543,6 +591,24 @@ void Text_Emitter::emit_assembly_instruction(std::ostream& os,
     assembly::newline(os, 1);
 }
 
+/**
+ * @brief Emit the push of each register the frame saves before its
+ * prologue, or the pop of each in reverse before it returns
+ */
+void Text_Emitter::emit_saved_registers(std::ostream& os,
+    assembly::Mnemonic mnemonic)
+{
+    if (not accessor_->saved_registers.contains(frame_))
+        return;
+    auto saved = accessor_->saved_registers.at(frame_);
+    if (mnemonic == assembly::Mnemonic::pop)
+        std::ranges::reverse(saved);
+    for (auto device : saved) {
+        os << assembly::tabwidth(4) << mnemonic << " " << device;
+        assembly::newline(os, 1);
+    }
+}
+
 /**
  * @brief Emit the text instruction for either a label or mnemonic
  */
@@ -594,7 +660,7 @@ void Text_Emitter::emit_text_section(std::ostream& os)
     emit_text_directives(os);
     for (std::size_t index = 0; index < instructions_accessor->size(); index++)
         emit_text_instruction(os, instructions[index], index);
-    if (!return_instructions_.empty() and frame_ == "main")
+    if (!return_instructions_.empty())
         emit_function_epilogue(os);
 }
 
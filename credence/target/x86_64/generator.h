@@ -20,10 +20,13 @@
 #include <credence/ir/ita.h>              // for Instructions
 #include <credence/ir/object.h>           // for Label, Object, RValue
 #include <credence/target/common/flags.h> // for flags
+#include <credence/target/common/types.h> // for Stack_Offset
 #include <credence/util.h>                // for AST_Node, CREDENCE_PRIVATE...
 #include <cstddef>                        // for size_t
+#include <optional>                       // for optional
 #include <ostream>                        // for ostream
 #include <string>                         // for basic_string, string
+#include <string_view>                    // for string_view
 #include <utility>                        // for move
 #include <variant>                        // for variant
 
@@ -73,7 +76,7 @@ namespace credence::target::x86_64 {
 using Instruction_Pair = assembly::Instruction_Pair;
 
 void emit(std::ostream& os,
-    util::AST_Node& symbols,
+    ir::Symbols& symbols,
     frontend::hir::Unit const& unit,
     bool no_stdlib);
 
@@ -82,7 +85,8 @@ constexpr std::string emit_immediate_storage(
 
 constexpr std::string emit_stack_storage(assembly::Stack::Offset offset,
     assembly::Operand_Size size,
-    common::flag::flags flags);
+    common::flag::flags flags,
+    std::string_view pointer = "rbp");
 
 constexpr std::string emit_register_storage(assembly::Register device,
     assembly::Operand_Size size,
@@ -114,6 +118,12 @@ class Storage_Emitter
 
     constexpr void reset_address_size() { address_size = Operand_Size::Empty; }
 
+    /**
+     * @brief Address stack slots from rsp in the red zone of a leaf, from
+     * the aligned base offset of its slots, see leaf.h
+     */
+    constexpr void set_red_zone(common::Stack_Offset base) { red_zone_ = base; }
+
     std::string get_storage_device_as_string(assembly::Storage const& storage,
         Operand_Size size);
 
@@ -128,6 +138,7 @@ class Storage_Emitter
 
   private:
     Operand_Size address_size = Operand_Size::Empty;
+    std::optional<common::Stack_Offset> red_zone_{};
     Storage& source_storage_;
 };
 
@@ -161,6 +172,7 @@ class Text_Emitter
         bool set_label = true);
     void emit_function_epilogue(std::ostream& os);
     void emit_epilogue_jump(std::ostream& os);
+    void emit_saved_registers(std::ostream& os, assembly::Mnemonic mnemonic);
 
   public:
     bool test_no_stdlib{ false };
@@ -222,7 +234,7 @@ class Assembly_Emitter
         : accessor_(std::move(accessor))
     {
         ir_instructions_ =
-            *accessor_->table_accessor.get_table()->get_ir_instructions();
+            accessor_->table_accessor.get_table()->get_ir_instructions();
     }
 
   public:
@@ -232,7 +244,8 @@ class Assembly_Emitter
     memory::Memory_Access accessor_;
 
   private:
-    ir::Instructions ir_instructions_;
+    // the instructions of the table, shared rather than copied
+    ir::object::Instruction_PTR ir_instructions_;
 
     // clang-format off
   CREDENCE_PRIVATE_UNLESS_TESTED:
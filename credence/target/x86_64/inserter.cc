@@ -101,7 +101,7 @@ void Instruction_Inserter::setup_stack_frame_in_function(
     int index)
 {
     auto stack_frame = accessor_->get_frame_in_memory();
-    auto symbol = std::get<1>(ir_instructions.at(index - 1));
+    auto symbol = ir::get<1>(ir_instructions.at(index - 1));
     auto name = type::get_label_as_human_readable(symbol);
     stack_frame.set_stack_frame(name);
     if (name == "main") {
@@ -129,7 +129,7 @@ void Instruction_Inserter::from_ir_instructions(
         auto inst = ir_instructions[index];
         ir_visitor.set_iterator_index(index);
         accessor_->table_accessor.set_ir_iterator_index(index);
-        ir::Instruction ita_inst = std::get<0>(inst);
+        ir::Instruction ita_inst = ir::get<0>(inst);
         m::match(ita_inst)(
             m::pattern | ir::Instruction::FUNC_START =
                 [&] {
@@ -252,7 +252,7 @@ Storage Operand_Inserter::get_operand_storage_from_parameter(
             if (!is_vector_offset(rvalue))
                 common::runtime::throw_runtime_error(
                     "invalid argv access, argv is a vector to strings", rvalue);
-            auto offset = type::from_decay_offset(rvalue);
+            auto offset = offset_of(rvalue);
             if (!util::is_numeric(offset) and
                 not accessor_->address_accessor.is_lvalue_storage_type(
                     offset, "int"))
@@ -261,7 +261,13 @@ Storage Operand_Inserter::get_operand_storage_from_parameter(
                         "invalid argv access, argv has malformed offset '{}'",
                         offset),
                     rvalue);
-            auto offset_integer = type::integral_from_type_ulint(offset) + 1;
+            if (!util::is_numeric(offset))
+                common::runtime::throw_runtime_error(
+                    fmt::format("invalid argv access, argv offset '{}' is not "
+                                "a constant",
+                        offset),
+                    rvalue);
+            auto offset_integer = ir::value_of(offset).integer + 1;
             return direct_immediate(
                 fmt::format("[r15 + 8 * {}]", offset_integer));
         }
@@ -308,7 +314,7 @@ Storage Operand_Inserter::get_operand_storage_from_immediate(
     RValue const& rvalue)
 {
     assembly::Storage storage{};
-    auto immediate = type::get_data_type_from_string(rvalue);
+    auto immediate = immediate_of(rvalue);
     auto type = type::get_type_from_rvalue_data_type(immediate);
     if (type == "string") {
         storage = assembly::make_asciz_immediate(accessor_->address_accessor
@@ -328,7 +334,7 @@ Storage Operand_Inserter::get_operand_storage_from_immediate(
                     type::get_value_from_rvalue_data_type(immediate)));
         return storage;
     }
-    storage = type::get_data_type_from_string(rvalue);
+    storage = immediate_of(rvalue);
     return storage;
 }
 
@@ -367,12 +373,12 @@ Storage Operand_Inserter::get_operand_storage_from_rvalue(RValue const& rvalue)
         return get_operand_storage_from_return();
 #endif
 
-    if (type::is_unary_expression(rvalue)) {
+    if (is_unary_expression(rvalue)) {
         auto unary_inserter = Unary_Operator_Inserter{ accessor_ };
         return unary_inserter.insert_from_unary_operator_rvalue(rvalue);
     }
 
-    if (type::is_rvalue_data_type(rvalue))
+    if (is_immediate(rvalue))
         return get_operand_storage_from_immediate(rvalue);
 
     auto [operand, operand_inst] =
@@ -524,7 +530,7 @@ void Operand_Inserter::insert_from_string_address_operand(LValue const& lhs,
     auto instruction_accessor = accessor_->instruction_accessor;
     auto& instructions = instruction_accessor->get_instructions();
     auto expression_inserter = Expression_Inserter{ accessor_ };
-    auto imm = type::get_data_type_from_string(rhs);
+    auto imm = immediate_of(rhs);
     expression_inserter.insert_from_string(
         type::get_value_from_rvalue_data_type(imm));
     if (is_variant(assembly::Stack::Offset, storage)) {
@@ -547,7 +553,7 @@ void Operand_Inserter::insert_from_float_address_operand(LValue const& lhs,
     auto instruction_accessor = accessor_->instruction_accessor;
     auto& instructions = instruction_accessor->get_instructions();
     auto expression_inserter = Expression_Inserter{ accessor_ };
-    auto imm = type::get_data_type_from_string(rhs);
+    auto imm = immediate_of(rhs);
     expression_inserter.insert_from_float(
         type::get_value_from_rvalue_data_type(imm));
     if (is_variant(assembly::Stack::Offset, storage)) {
@@ -570,7 +576,7 @@ void Operand_Inserter::insert_from_double_address_operand(LValue const& lhs,
     auto instruction_accessor = accessor_->instruction_accessor;
     auto& instructions = instruction_accessor->get_instructions();
     auto expression_inserter = Expression_Inserter{ accessor_ };
-    auto imm = type::get_data_type_from_string(rhs);
+    auto imm = immediate_of(rhs);
     expression_inserter.insert_from_double(
         type::get_value_from_rvalue_data_type(imm));
     if (is_variant(assembly::Stack::Offset, storage)) {
@@ -607,7 +613,7 @@ void Operand_Inserter::insert_from_mnemonic_operand(LValue const& lhs,
         // Translate from an immediate value assignment
         m::pattern | m::app(is_immediate, true) =
             [&] {
-                auto imm = type::get_data_type_from_string(rhs);
+                auto imm = immediate_of(rhs);
                 auto [lhs_storage, storage_inst] =
                     address_storage
                         .get_lvalue_address_and_insertion_instructions(
@@ -633,7 +639,7 @@ void Operand_Inserter::insert_from_mnemonic_operand(LValue const& lhs,
                         instructions, mov, lhs_storage, Register::rcx);
                 } else {
                     auto acc = accumulator.get_accumulator_register_from_size();
-                    if (!type::is_unary_expression(lhs))
+                    if (!is_unary_expression(lhs))
                         stack->set_address_from_accumulator(lhs, acc);
                     auto [lhs_storage, storage_inst] =
                         address_storage
@@ -655,7 +661,7 @@ void Operand_Inserter::insert_from_mnemonic_operand(LValue const& lhs,
                 x8664_add__asm(instructions, mov, lhs_storage, acc);
             },
         // Unary expression assignment, including pointers to an address
-        m::pattern | m::app(type::is_unary_expression, true) =
+        m::pattern | m::app(is_unary_expression, true) =
             [&] {
                 auto [lhs_storage, storage_inst] =
                     address_storage
@@ -667,7 +673,7 @@ void Operand_Inserter::insert_from_mnemonic_operand(LValue const& lhs,
                     unary_op, lhs_storage);
             },
         // Translate from binary expressions in the IR
-        m::pattern | m::app(type::is_binary_expression, true) =
+        m::pattern | m::app(is_binary_expression, true) =
             [&] { binary_inserter.from_binary_operator_expression(rhs); },
         m::pattern | m::_ = [&] { credence_error("unreachable"); });
 }
@@ -687,7 +693,7 @@ Storage Unary_Operator_Inserter::insert_from_unary_operator_rvalue(
     auto& table_accessor = accessor_->table_accessor;
     auto& register_accessor = accessor_->register_accessor;
 
-    credence_assert(type::is_unary_expression(expr));
+    credence_assert(is_unary_expression(expr));
 
     Storage storage{};
 
@@ -695,7 +701,7 @@ Storage Unary_Operator_Inserter::insert_from_unary_operator_rvalue(
     RValue rvalue = type::get_unary_rvalue_reference(expr);
     auto is_vector = [&](RValue const& rvalue) {
         return table_accessor.get_table()->get_vectors().contains(
-            type::from_lvalue_offset(rvalue));
+            vector_of_offset(rvalue));
     };
 
     if (stack->contains(rvalue)) {
@@ -729,7 +735,7 @@ Storage Unary_Operator_Inserter::insert_from_unary_operator_rvalue(
         accessor_->set_signal_register(Register::rax);
         insert_from_unary_operator_operands(op, storage, address);
     } else {
-        auto immediate = type::get_data_type_from_string(rvalue);
+        auto immediate = immediate_of(rvalue);
         auto size = assembly::get_operand_size_from_data_type(immediate);
         storage = table_accessor.next_ir_instruction_is_temporary() and
                           not table_accessor.last_ir_instruction_is_assignment()
@@ -791,7 +797,6 @@ void Expression_Inserter::insert_from_double(RValue const& str)
 void Binary_Operator_Inserter::from_binary_operator_expression(
     RValue const& rvalue)
 {
-    credence_assert(type::is_binary_expression(rvalue));
     auto& instructions = accessor_->instruction_accessor->get_instructions();
     auto& stack = accessor_->stack;
     auto& table_accessor = accessor_->table_accessor;
@@ -802,8 +807,11 @@ void Binary_Operator_Inserter::from_binary_operator_expression(
     Storage rhs_s{};
 
     Operand_Inserter operand_inserter{ accessor_ };
-    auto expression = type::from_rvalue_binary_expression(rvalue);
-    auto [lhs, rhs, op] = expression;
+    auto const& expression = ir::value_of(rvalue);
+    credence_assert(expression.is_binary());
+    auto const& lhs = ir::text_of(expression.lhs);
+    auto const& rhs = ir::text_of(expression.rhs);
+    auto op = std::string{ expression.binary };
     auto immediate = false;
     auto is_address = [&](RValue const& rvalue) {
         return accessor_->stack->is_allocated(rvalue);
@@ -966,10 +974,10 @@ void Operand_Inserter::insert_from_binary_operands(
             accessor_->table_accessor.get_table()->get_ir_instructions();
         auto ir_index = accessor_->table_accessor.get_index();
         if (ir_instructions->size() > ir_index and
-            std::get<0>(ir_instructions->at(ir_index + 1)) ==
+            ir::get<0>(ir_instructions->at(ir_index + 1)) ==
                 ir::Instruction::IF) {
             auto label = assembly::make_label(
-                std::get<3>(ir_instructions->at(ir_index + 1)),
+                ir::get<3>(ir_instructions->at(ir_index + 1)),
                 stack_frame_.symbol);
             assembly::inserter(instructions,
                 relational.from_relational_expression_operands(
@@ -1086,11 +1094,11 @@ void Expression_Inserter::insert_from_rvalue(RValue const& rvalue)
     };
 
     m::match(rvalue)(
-        m::pattern | m::app(type::is_binary_expression, true) =
+        m::pattern | m::app(is_binary_expression, true) =
             [&] { binary_inserter.from_binary_operator_expression(rvalue); },
-        m::pattern | m::app(type::is_unary_expression, true) =
+        m::pattern | m::app(is_unary_expression, true) =
             [&] { unary_inserter.insert_from_unary_operator_rvalue(rvalue); },
-        m::pattern | m::app(type::is_rvalue_data_type, true) =
+        m::pattern | m::app(is_immediate, true) =
             [&] {
                 Storage immediate =
                     operand_inserter.get_operand_storage_from_rvalue(rvalue);
@@ -121,8 +121,7 @@ assembly::Operand_Size get_operand_size_from_storage(
 
 inline auto get_rvalue_pair_as_immediate(RValue const& lhs, RValue const& rhs)
 {
-    return std::make_pair(type::get_data_type_from_string(lhs),
-        type::get_data_type_from_string(rhs));
+    return std::make_pair(immediate_of(lhs), immediate_of(rhs));
 }
 
 /**
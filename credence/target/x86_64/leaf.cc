@@ -0,0 +1,107 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include "leaf.h"
+
+#include "assembly.h"                     // for Instruction, Register
+#include "memory.h"                       // for Memory_Accessor
+#include "stack.h"                        // for Stack
+#include <credence/target/common/leaf.h>  // for remove_instructions
+#include <credence/target/common/types.h> // for Stack_Offset, Label
+#include <string>                         // for basic_string, string
+#include <tuple>                          // for get
+#include <variant>                        // for get, holds_alternative
+#include <vector>                         // for vector
+
+namespace credence::target::x86_64 {
+
+namespace {
+
+// the bytes below rsp the System V ABI keeps from signal handlers
+constexpr common::Stack_Offset red_zone_size = 128;
+
+constexpr bool is_register(Storage const& storage, Register device)
+{
+    return std::holds_alternative<Register>(storage) and
+           std::get<Register>(storage) == device;
+}
+
+/**
+ * @brief Whether a storage device is the frame or stack pointer, or an
+ * address from either
+ */
+bool is_frame_storage(Storage const& storage)
+{
+    if (std::holds_alternative<Immediate>(storage)) {
+        auto const& value = std::get<0>(std::get<Immediate>(storage));
+        return value.find("rbp") != std::string::npos or
+               value.find("rsp") != std::string::npos;
+    }
+    return is_register(storage, Register::rbp) or
+           is_register(storage, Register::rsp) or
+           is_register(storage, Register::ebp) or
+           is_register(storage, Register::esp);
+}
+
+} // namespace
+
+/**
+ * @brief Drop the frame pointer of the leaf function inserted from the
+ * instruction index begin if its slots fit in the red zone, and give back
+ * whether it did
+ */
+bool elide_stack_frame(memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin,
+    common::Stack_Offset base)
+{
+    auto& instructions = accessor->instruction_accessor->get_instructions();
+    auto& table = accessor->table_accessor.get_table();
+    if (name == "main" or
+        table->stack_frame_contains_call_instruction(
+            name, *table->get_ir_instructions()))
+        return false;
+    auto aligned_base = base / 16 * 16;
+    if (accessor->stack->get_size() + 8 - aligned_base > red_zone_size)
+        return false;
+
+    std::vector<bool> removed(instructions.size(), false);
+    for (std::size_t i = begin; i < instructions.size(); i++) {
+        if (not std::holds_alternative<assembly::Instruction>(instructions[i]))
+            continue;
+        auto const& [mnemonic, dest, src] =
+            std::get<assembly::Instruction>(instructions[i]);
+        bool is_prologue =
+            (i == begin and mnemonic == Mnemonic::push and
+                is_register(dest, Register::rbp)) or
+            (i == begin + 1 and mnemonic == Mnemonic::mov_ and
+                is_register(dest, Register::rbp) and
+                is_register(src, Register::rsp));
+        bool is_epilogue =
+            mnemonic == Mnemonic::pop and is_register(dest, Register::rbp);
+        if (is_prologue or is_epilogue)
+            removed[i] = true;
+        else if (is_frame_storage(dest) or is_frame_storage(src))
+            return false;
+    }
+    if (begin + 1 >= removed.size() or not removed[begin] or
+        not removed[begin + 1])
+        return false;
+
+    common::leaf::remove_instructions(
+        instructions, accessor->flag_accessor, removed);
+    accessor->leaf_frames.insert(name, aligned_base);
+    return true;
+}
+
+} // namespace credence::target::x86_64
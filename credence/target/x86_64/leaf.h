@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "memory.h"                       // for Memory_Access
+#include <credence/ir/object.h>           // for Label
+#include <credence/target/common/types.h> // for Stack_Offset
+#include <cstddef>                        // for size_t
+
+/****************************************************************************
+ *
+ * x86-64 Leaf Functions
+ *
+ * A function that calls nothing needs no frame pointer: the System V ABI
+ * keeps the 128 bytes below rsp, the red zone, from signal and interrupt
+ * handlers, so a leaf whose slots fit in it can address them from rsp
+ * without moving it. See credence/target/common/leaf.h:
+ *
+ *   Before:                           After:
+ *     push rbp                          mov dword ptr [rsp - 12], edi
+ *     mov rbp, rsp                      mov eax, dword ptr [rsp - 12]
+ *     mov dword ptr [rbp - 4], edi      ...
+ *     mov eax, dword ptr [rbp - 4]      ret
+ *     ...
+ *     pop rbp
+ *     ret
+ *
+ * The stack is not reset between functions, so the slots of a function
+ * are from the base offset it was at when the function began. The emitter
+ * moves each slot of a leaf up by the base aligned down to 16 bytes, and
+ * down by the 8 bytes of the rbp no longer pushed, which keeps each at
+ * the alignment it had from rbp. A function is left as it is if it is
+ * main, if any slot would be more than 128 bytes below rsp, or if any of
+ * its instructions reads rbp or rsp but the prologue and epilogue.
+ *
+ *****************************************************************************/
+
+namespace credence::target::x86_64 {
+
+/**
+ * @brief Drop the frame pointer of the leaf function inserted from the
+ * instruction index begin if its slots fit in the red zone, and give back
+ * whether it did
+ */
+bool elide_stack_frame(memory::Memory_Access& accessor,
+    Label const& name,
+    std::size_t begin,
+    common::Stack_Offset base);
+
+} // namespace credence::target::x86_64
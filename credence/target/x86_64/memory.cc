@@ -77,8 +77,8 @@ assembly::Storage Register_Accessor::get_register_for_binary_operator(
     // argc and argc storage resolution
     if (rvalue == "argc")
         return common::assembly::make_direct_immediate("[r15]");
-    if (type::from_lvalue_offset(rvalue) == "argv") {
-        auto offset = type::from_decay_offset(rvalue);
+    if (vector_of_offset(rvalue) == "argv") {
+        auto offset = offset_of(rvalue);
         if (!util::is_numeric(offset) and
             not address_accessor.is_lvalue_storage_type(offset, "int"))
             throw_compiletime_error(
@@ -86,12 +86,19 @@ assembly::Storage Register_Accessor::get_register_for_binary_operator(
                     "invalid argv access, argv has malformed offset '{}'",
                     offset),
                 rvalue);
-        auto offset_integer = type::integral_from_type_ulint(offset) + 1;
+        // the slot is addressed here, so its offset has to be a constant
+        if (!util::is_numeric(offset))
+            throw_compiletime_error(
+                fmt::format(
+                    "invalid argv access, argv offset '{}' is not a constant",
+                    offset),
+                rvalue);
+        auto offset_integer = ir::value_of(offset).integer + 1;
         return common::assembly::make_direct_immediate(
             fmt::format("[r15 + 8 * {}]", offset_integer));
     }
-    if (type::is_rvalue_data_type(rvalue))
-        return type::get_data_type_from_string(rvalue);
+    if (auto const& value = ir::value_of(rvalue); value.is_literal())
+        return value.literal;
 
     if (stack->contains(rvalue))
         return stack->get(rvalue).first;
@@ -129,8 +136,8 @@ Address_Accessor::get_lvalue_address_and_insertion_instructions(
 {
     auto vector_accessor = Vector_Accessor{ table_ };
     assembly::Instruction_Pair instructions{ Register::eax, {} };
-    auto lhs = type::from_lvalue_offset(lvalue);
-    auto offset = type::from_decay_offset(lvalue);
+    auto lhs = vector_of_offset(lvalue);
+    auto offset = offset_of(lvalue);
 
     if (type::is_dereference_expression(lvalue)) {
         auto storage =
@@ -16,6 +16,7 @@
 #include "assembly.h"                           // for Register, Operand_Size
 #include "stack.h"                              // for Stack
 #include <credence/ir/object.h>                 // for RValue, LValue, Object
+#include <credence/map.h>                       // for Ordered_Map
 #include <credence/target/common/accessor.h>    // for Accumulator_Accessor
 #include <credence/target/common/flags.h>       // for Flag_Accessor
 #include <credence/target/common/memory.h>      // for Operand_Type, is_imm...
@@ -26,6 +27,7 @@
 #include <functional>                           // for function
 #include <matchit.h>                            // for pattern, PatternHelper
 #include <memory>                               // for shared_ptr, make_shared
+#include <memory_resource>                      // for memory_resource, get_de...
 #include <string>                               // for basic_string, string
 #include <utility>                              // for move
 
@@ -80,10 +82,15 @@ using Directives = assembly::Directives;
  * Short-form helpers for matchit predicate pattern matching
  */
 // Re-export common predicates from common::memory
+using common::memory::immediate_of;
+using common::memory::is_binary_expression;
 using common::memory::is_immediate;
 using common::memory::is_parameter;
 using common::memory::is_temporary;
+using common::memory::is_unary_expression;
 using common::memory::is_vector_offset;
+using common::memory::offset_of;
+using common::memory::vector_of_offset;
 
 namespace memory {
 
@@ -106,6 +113,12 @@ const general_purpose available_dword_register = { Register::edi,
     Register::edx,
     Register::ecx };
 
+// never handed out by the inserter, see allocator.h
+const general_purpose callee_saved_qword_register = { Register::rbx,
+    Register::r12,
+    Register::r13,
+    Register::r14 };
+
 } // namespace registers
 
 using Memory_Access = std::shared_ptr<Memory_Accessor>;
@@ -224,7 +237,9 @@ struct Vector_Accessor : public X8664_Vector_Accessor
 };
 
 struct Instruction_Accessor : public X8664_Instruction_Accessor
-{};
+{
+    using X8664_Instruction_Accessor::X8664_Instruction_Accessor;
+};
 
 struct Register_Accessor
 {
@@ -276,7 +291,9 @@ class Memory_Accessor final : public X8664_Memory_Accessor
   public:
     Memory_Accessor() = delete;
 
-    explicit Memory_Accessor(Table_Pointer table, Stack_Pointer stack_pointer)
+    explicit Memory_Accessor(Table_Pointer table,
+        Stack_Pointer stack_pointer,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
         : X8664_Memory_Accessor(table)
         , table_(std::move(table))
         , stack(std::move(stack_pointer))
@@ -286,7 +303,8 @@ class Memory_Accessor final : public X8664_Memory_Accessor
         , address_accessor{ table_, stack, flag_accessor }
         , register_accessor{ &signal_register, address_accessor }
     {
-        instruction_accessor = std::make_shared<detail::Instruction_Accessor>();
+        instruction_accessor =
+            std::make_shared<detail::Instruction_Accessor>(resource);
     }
 
     constexpr void set_signal_register(Register signal_)
@@ -312,6 +330,11 @@ class Memory_Accessor final : public X8664_Memory_Accessor
     detail::Register_Accessor register_accessor{ &signal_register,
         address_accessor };
     Instruction_Pointer instruction_accessor{};
+    // the callee-saved registers each function saves, see allocator.h
+    Ordered_Map<Label, registers::general_purpose> saved_registers{};
+    // the aligned base offset of each leaf that addresses its slots from
+    // rsp in the red zone, see leaf.h
+    Ordered_Map<Label, common::Stack_Offset> leaf_frames{};
 };
 
 } // namespace memory
@@ -0,0 +1,299 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#include "peephole.h"
+
+#include "assembly.h"                        // for Instruction, Register
+#include "memory.h"                          // for Memory_Accessor
+#include <credence/target/common/peephole.h> // for Pattern, Window, Hits
+#include <credence/target/common/types.h>    // for Stack_Offset, Label
+#include <functional>                        // for function
+#include <string>                            // for basic_string, string
+#include <tuple>                             // for get
+#include <variant>                           // for get, holds_alternative
+#include <vector>                            // for vector
+
+namespace credence::target::x86_64 {
+
+namespace {
+
+using Entry = assembly::Instructions::value_type;
+using Window = common::peephole::Window<Entry>;
+using Offset = common::Stack_Offset;
+using common::peephole::is_integer_immediate;
+
+constexpr bool is_status_mnemonic(Mnemonic mnemonic)
+{
+    switch (mnemonic) {
+        case Mnemonic::je:
+        case Mnemonic::jne:
+        case Mnemonic::jl:
+        case Mnemonic::jle:
+        case Mnemonic::jg:
+        case Mnemonic::jge:
+        case Mnemonic::sete:
+        case Mnemonic::setne:
+        case Mnemonic::setl:
+        case Mnemonic::setg:
+        case Mnemonic::setle:
+        case Mnemonic::setge:
+            return true;
+        default:
+            return false;
+    }
+}
+
+constexpr bool is_status_setter(Mnemonic mnemonic)
+{
+    switch (mnemonic) {
+        case Mnemonic::imul:
+        case Mnemonic::sub:
+        case Mnemonic::add:
+        case Mnemonic::neg:
+        case Mnemonic::idiv:
+        case Mnemonic::inc:
+        case Mnemonic::dec:
+        case Mnemonic::cmp:
+        case Mnemonic::and_:
+        case Mnemonic::or_:
+        case Mnemonic::xor_:
+        case Mnemonic::shl:
+        case Mnemonic::shr:
+        // the status flags are not kept across a call, a syscall, or a
+        // return, so nothing after one reads the flags set before it
+        case Mnemonic::call:
+        case Mnemonic::syscall:
+        case Mnemonic::ret:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Whether two storage devices are the same register
+ */
+constexpr bool is_same_register(Storage const& lhs, Storage const& rhs)
+{
+    return std::holds_alternative<Register>(lhs) and
+           std::holds_alternative<Register>(rhs) and
+           std::get<Register>(lhs) == std::get<Register>(rhs);
+}
+
+/**
+ * @brief Whether two storage devices are the same stack slot
+ */
+constexpr bool is_same_slot(Storage const& lhs, Storage const& rhs)
+{
+    return std::holds_alternative<Offset>(lhs) and
+           std::holds_alternative<Offset>(rhs) and
+           std::get<Offset>(lhs) == std::get<Offset>(rhs);
+}
+
+/**
+ * @brief Whether the instruction of the window is a mov
+ */
+bool is_mov(Window& window, std::size_t k)
+{
+    return window.is<assembly::Instruction>(k) and
+           std::get<0>(window.get<assembly::Instruction>(k)) == Mnemonic::mov;
+}
+
+/**
+ * @brief Whether no instruction after the window reads the status flags
+ * its last instruction sets, before another sets them again
+ *
+ * A label may be jumped to from code that set the flags for what follows
+ * it, and a jmp leaves for code this does not see, so either ends the
+ * scan as though the flags were read.
+ */
+bool is_status_unread(Window& window)
+{
+    bool unread = true;
+    window.for_each_after([&](Entry const& entry) {
+        if (std::holds_alternative<Label>(entry)) {
+            unread = false;
+            return false;
+        }
+        if (not std::holds_alternative<assembly::Instruction>(entry))
+            return true;
+        auto mnemonic = std::get<0>(std::get<assembly::Instruction>(entry));
+        if (is_status_mnemonic(mnemonic) or mnemonic == Mnemonic::goto_) {
+            unread = false;
+            return false;
+        }
+        return not is_status_setter(mnemonic);
+    });
+    return unread;
+}
+
+bool self_move(Window& window)
+{
+    if (not is_mov(window, 0))
+        return false;
+    auto const& [mnemonic, dest, src] = window.get<assembly::Instruction>(0);
+    if (not is_same_register(dest, src) or
+        not assembly::is_qword_register(std::get<Register>(dest)))
+        return false;
+    window.remove(0);
+    return true;
+}
+
+bool store_reload(Window& window)
+{
+    if (not is_mov(window, 0) or not is_mov(window, 1))
+        return false;
+    auto const& [m0, store, value] = window.get<assembly::Instruction>(0);
+    auto& [m1, reload, slot] = window.get<assembly::Instruction>(1);
+    if (not is_same_slot(store, slot) or
+        not std::holds_alternative<Register>(value) or
+        not std::holds_alternative<Register>(reload))
+        return false;
+    auto from = std::get<Register>(value);
+    auto to = std::get<Register>(reload);
+    if (assembly::get_operand_size_from_register(from) !=
+        assembly::get_operand_size_from_register(to))
+        return false;
+    if (from == to and assembly::is_qword_register(to))
+        window.remove(1);
+    else
+        slot = from;
+    return true;
+}
+
+bool load_store(Window& window)
+{
+    if (not is_mov(window, 0) or not is_mov(window, 1))
+        return false;
+    auto const& [m0, load, slot] = window.get<assembly::Instruction>(0);
+    auto const& [m1, store, value] = window.get<assembly::Instruction>(1);
+    if (not is_same_slot(slot, store) or not is_same_register(load, value))
+        return false;
+    window.remove(1);
+    return true;
+}
+
+bool jump_to_next(Window& window)
+{
+    if (not window.is<assembly::Instruction>(0) or not window.is<Label>(1))
+        return false;
+    auto const& [mnemonic, dest, src] = window.get<assembly::Instruction>(0);
+    if (mnemonic != Mnemonic::goto_ or
+        not std::holds_alternative<Immediate>(dest))
+        return false;
+    auto const& to = std::get<0>(std::get<Immediate>(dest));
+    if (to != assembly::make_label(window.get<Label>(1), window.scope))
+        return false;
+    window.remove(0);
+    return true;
+}
+
+/**
+ * @brief Drop the arithmetic of the window that leaves its destination as
+ * it was, or make it a mov of a dword register to itself
+ *
+ * A write of a dword register clears the upper half of its qword
+ * register, so the arithmetic does too, and the mov keeps that.
+ */
+void drop_identity(Window& window)
+{
+    auto& [mnemonic, dest, src] = window.get<assembly::Instruction>(0);
+    if (std::holds_alternative<Register>(dest) and
+        assembly::is_dword_register(std::get<Register>(dest))) {
+        mnemonic = Mnemonic::mov;
+        src = dest;
+        return;
+    }
+    window.remove(0);
+}
+
+bool add_zero(Window& window)
+{
+    if (not window.is<assembly::Instruction>(0) or not is_status_unread(window))
+        return false;
+    auto const& [mnemonic, dest, src] = window.get<assembly::Instruction>(0);
+    if ((mnemonic != Mnemonic::add and mnemonic != Mnemonic::sub) or
+        not is_integer_immediate(src, "0"))
+        return false;
+    drop_identity(window);
+    return true;
+}
+
+bool mul_one(Window& window)
+{
+    if (not window.is<assembly::Instruction>(0) or not is_status_unread(window))
+        return false;
+    auto const& [mnemonic, dest, src] = window.get<assembly::Instruction>(0);
+    if (mnemonic != Mnemonic::imul or
+        not std::holds_alternative<Register>(dest) or
+        not is_integer_immediate(src, "1"))
+        return false;
+    drop_identity(window);
+    return true;
+}
+
+bool mul_two(Window& window)
+{
+    if (not window.is<assembly::Instruction>(0) or not is_status_unread(window))
+        return false;
+    auto& [mnemonic, dest, src] = window.get<assembly::Instruction>(0);
+    if (mnemonic != Mnemonic::imul or
+        not std::holds_alternative<Register>(dest) or
+        not is_integer_immediate(src, "2"))
+        return false;
+    mnemonic = Mnemonic::add;
+    src = dest;
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Rewrite instructions by the peephole patterns, where is_function
+ * tells the labels of functions from those in them, and give back the hits
+ * of each
+ */
+common::peephole::Hits rewrite_instructions(
+    assembly::Instructions& instructions,
+    common::Flag_Accessor& flag_accessor,
+    std::function<bool(Label const&)> const& is_function)
+{
+    static std::vector<common::peephole::Pattern<Entry>> const patterns = {
+        { "self-move",    1, self_move    },
+        { "store-reload", 2, store_reload },
+        { "load-store",   2, load_store   },
+        { "jump-to-next", 2, jump_to_next },
+        { "add-zero",     1, add_zero     },
+        { "mul-one",      1, mul_one      },
+        { "mul-two",      1, mul_two      },
+    };
+    return common::peephole::rewrite_instructions(
+        instructions, flag_accessor, patterns, is_function);
+}
+
+/**
+ * @brief Rewrite the instructions of the unit by the peephole patterns,
+ * and give back the hits of each
+ */
+common::peephole::Hits rewrite_instructions(memory::Memory_Access& accessor)
+{
+    auto& table = accessor->table_accessor.get_table();
+    return rewrite_instructions(
+        accessor->instruction_accessor->get_instructions(),
+        accessor->flag_accessor,
+        [&](Label const& label) {
+            return table->get_functions().contains(label);
+        });
+}
+
+} // namespace credence::target::x86_64
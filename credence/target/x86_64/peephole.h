@@ -0,0 +1,70 @@
+/*****************************************************************************
+ * Copyright (c) Jahan Addison
+ *
+ * This software is dual-licensed under the Apache License, Version 2.0 or
+ * the GNU General Public License, Version 3.0 or later.
+ *
+ * You may use this work, in part or in whole, under the terms of either
+ * license.
+ *
+ * See the LICENSE.Apache-v2 and LICENSE.GPL-v3 files in the project root
+ * for the full text of these licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "assembly.h"                        // for Instructions
+#include "memory.h"                          // for Memory_Access
+#include <credence/target/common/flags.h>    // for Flag_Accessor
+#include <credence/target/common/peephole.h> // for Hits
+#include <credence/target/common/types.h>    // for Label
+#include <functional>                        // for function
+
+/****************************************************************************
+ *
+ * x86-64 Peephole Optimizer
+ *
+ * The patterns of the peephole pass over x86-64 instructions, see
+ * credence/target/common/peephole.h:
+ *
+ *   self-move      mov rax, rax              ->
+ *   store-reload   mov [rbp - 4], eax        -> mov [rbp - 4], eax
+ *                  mov ecx, [rbp - 4]           mov ecx, eax
+ *   load-store     mov eax, [rbp - 4]        -> mov eax, [rbp - 4]
+ *                  mov [rbp - 4], eax
+ *   jump-to-next   jmp ._L2__main            -> ._L2__main:
+ *                  ._L2__main:
+ *   add-zero       add rax, 0                ->
+ *                  add eax, 0                -> mov eax, eax
+ *   mul-one        imul rax, 1               ->
+ *                  imul eax, 1               -> mov eax, eax
+ *   mul-two        imul eax, 2               -> add eax, eax
+ *
+ * A write of a dword register clears the upper half of its qword
+ * register, so only qword self-moves are dropped, and arithmetic that
+ * leaves a dword register as it was becomes a mov of it to itself. The
+ * arithmetic patterns change the status flags, so they are left as they
+ * are if a conditional jump or set reads the flags before another
+ * instruction sets them, or if a label or jmp comes first.
+ *
+ *****************************************************************************/
+
+namespace credence::target::x86_64 {
+
+/**
+ * @brief Rewrite instructions by the peephole patterns, where is_function
+ * tells the labels of functions from those in them, and give back the hits
+ * of each
+ */
+common::peephole::Hits rewrite_instructions(
+    assembly::Instructions& instructions,
+    common::Flag_Accessor& flag_accessor,
+    std::function<bool(Label const&)> const& is_function);
+
+/**
+ * @brief Rewrite the instructions of the unit by the peephole patterns,
+ * and give back the hits of each
+ */
+common::peephole::Hits rewrite_instructions(memory::Memory_Access& accessor);
+
+} // namespace credence::target::x86_64
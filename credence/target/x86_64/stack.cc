@@ -23,6 +23,7 @@
 #include <numeric>                        // for accumulate
 #include <string>                         // for basic_string, string, oper...
 #include <utility>                        // for pair
+#include <vector>                         // for vector
 
 /****************************************************************************
  *
@@ -208,6 +209,32 @@ class Stack::Stack_IMPL
         stack_address.insert(lvalue, { size, qword_size });
     }
 
+    /**
+     * @brief Move the address of an lvalue to another offset of its size
+     */
+    constexpr void set_address_from_offset(LValue const& lvalue,
+        Offset offset)
+    {
+        stack_address[lvalue].first = offset;
+    }
+
+    /**
+     * @brief Get and set the bytes allocated on the stack so far
+     */
+    constexpr Offset get_size() const { return size; }
+    constexpr void set_size(Offset offset) { size = offset; }
+
+    /**
+     * @brief Get the offset of each address on the stack
+     */
+    std::vector<Offset> get_offsets() const
+    {
+        std::vector<Offset> offsets{};
+        for (auto const& [lvalue, entry] : stack_address)
+            offsets.push_back(entry.first);
+        return offsets;
+    }
+
     /**
      * @brief Get the allocation size of the current frame, aligned up to 16
      * bytes
@@ -371,10 +398,26 @@ void Stack::set_address_from_address(LValue const& lvalue)
 {
     pimpl->set_address_from_address(lvalue);
 }
+void Stack::set_address_from_offset(LValue const& lvalue, Offset offset)
+{
+    pimpl->set_address_from_offset(lvalue, offset);
+}
+void Stack::set_size(Offset offset)
+{
+    pimpl->set_size(offset);
+}
 Size Stack::get_stack_frame_allocation_size()
 {
     return pimpl->get_stack_frame_allocation_size();
 }
+Stack::Offset Stack::get_size() const
+{
+    return pimpl->get_size();
+}
+std::vector<Stack::Offset> Stack::get_offsets() const
+{
+    return pimpl->get_offsets();
+}
 Size Stack::get_stack_offset_from_table_vector_index(LValue const& lvalue,
     std::string const& key,
     ir::object::Vector const& vector)
@@ -19,6 +19,7 @@
 #include <memory>                         // for unique_ptr
 #include <string>                         // for string
 #include <utility>                        // for pair
+#include <vector>                         // for vector
 
 /****************************************************************************
  *
@@ -93,10 +94,14 @@ class Stack : public common::detail::base_stack_pointer
         Size value_size,
         Operand_Size operand_size);
     void set_address_from_address(LValue const& lvalue);
+    void set_address_from_offset(LValue const& lvalue, Offset offset);
+    void set_size(Offset offset);
 
   public:
     Operand_Size get_operand_size_from_offset(Offset offset) const;
     Size get_stack_frame_allocation_size();
+    Offset get_size() const;
+    std::vector<Offset> get_offsets() const;
     Size get_stack_offset_from_table_vector_index(LValue const& lvalue,
         std::string const& key,
         ir::object::Vector const& vector);
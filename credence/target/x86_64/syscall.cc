@@ -163,15 +163,15 @@ void make_syscall(
 {
 
 #if defined(__linux__)
-    auto syscall_list = target::common::syscall_ns::get_syscall_list(
+    auto const& syscall_list = target::common::syscall_ns::get_syscall_list(
         target::common::assembly::OS_Type::Linux,
         target::common::assembly::Arch_Type::X8664);
 #elif defined(__APPLE__) || defined(__bsdi__)
-    auto syscall_list = target::common::syscall_ns::get_syscall_list(
+    auto const& syscall_list = target::common::syscall_ns::get_syscall_list(
         target::common::assembly::OS_Type::BSD,
         target::common::assembly::Arch_Type::X8664);
 #elif defined(_WIN32) || defined(_WIN64)
-    auto syscall_list = target::common::syscall_ns::get_syscall_list(
+    auto const& syscall_list = target::common::syscall_ns::get_syscall_list(
         target::common::assembly::OS_Type::Linux,
         target::common::assembly::Arch_Type::X8664);
 #endif
@@ -13,6 +13,7 @@
 
 #include "visitor.h"
 
+#include "allocator.h"                       // for allocate_registers, allo...
 #include "assembly.h"                        // for Register, Mnemonic, x86...
 #include "credence/error.h"                  // for credence_assert
 #include "credence/map.h"                    // for Ordered_Map
@@ -23,11 +24,13 @@
 #include "credence/target/common/types.h"    // for Table_Pointer
 #include "credence/types.h"                  // for from_lvalue_offset, get...
 #include "inserter.h"                        // for Expression_Inserter
+#include "leaf.h"                            // for elide_stack_frame
 #include "memory.h"                          // for Memory_Accessor, Instru...
 #include "stack.h"                           // for Stack
 #include "syscall.h"                         // for syscall
 #include <credence/ir/checker.h>             // for Type_Checker
 #include <credence/ir/object.h>              // for Object, Function, Label
+#include <credence/target/common/options.h>  // for target_options
 #include <credence/target/common/runtime.h>  // for is_stdlib_function, is_...
 #include <deque>                             // for deque
 #include <matchit.h>                         // for App, Wildcard, Ds, app
@@ -78,6 +81,8 @@ void IR_Instruction_Visitor::from_func_start_ita(Label const& name)
     stack_frame_.set_stack_frame(name);
     auto frame = table->get_functions()[name];
     auto& inst = instruction_accessor->get_instructions();
+    function_index_ = inst.size();
+    function_offset_ = accessor_->stack->get_size();
     // function prologue
     x8664_add__asm(inst, push, rbp);
     x8664_add__asm(inst, mov_, rbp, rsp);
@@ -105,6 +110,19 @@ void IR_Instruction_Visitor::from_func_end_ita()
         accessor_->flag_accessor.set_instruction_flag(
             common::flag::Align, instruction_accessor->size());
     }
+    // the stack is cleared at the next function, so allocate while it is
+    // still the stack of this one
+    if (common::target_options.regalloc) {
+        auto const& name = frame->get_symbol();
+        accessor_->saved_registers.insert(
+            name, allocate_registers(accessor_, name, function_index_));
+    }
+    if (common::target_options.slots)
+        allocate_stack_slots(
+            accessor_, frame->get_symbol(), function_index_, function_offset_);
+    if (common::target_options.leaf)
+        elide_stack_frame(
+            accessor_, frame->get_symbol(), function_index_, function_offset_);
     accessor_->register_accessor.reset_available_registers();
 }
 
@@ -115,7 +133,7 @@ void IR_Instruction_Visitor::from_func_end_ita()
  */
 void IR_Instruction_Visitor::from_locl_ita(ir::Quadruple const& inst)
 {
-    auto locl_lvalue = std::get<1>(inst);
+    auto locl_lvalue = ir::get<1>(inst);
     auto frame = stack_frame_.get_stack_frame();
     auto& table = accessor_->table_accessor.get_table();
     auto& stack = accessor_->stack;
@@ -140,7 +158,7 @@ void IR_Instruction_Visitor::from_locl_ita(ir::Quadruple const& inst)
         m::pattern | m::app(type::is_dereference_expression, true) =
             [&] {
                 auto lvalue =
-                    type::get_unary_rvalue_reference(std::get<1>(inst));
+                    type::get_unary_rvalue_reference(ir::get<1>(inst));
                 stack->set_address_from_address(lvalue);
             },
         // Allocate a vector (array), including all of its elements on
@@ -175,7 +193,7 @@ void IR_Instruction_Visitor::from_push_ita(ir::Quadruple const& inst)
     auto& table = accessor_->table_accessor.get_table();
     auto frame = stack_frame_.get_stack_frame();
     stack_frame_.argument_stack.emplace_front(
-        table->lvalue_at_temporary_object_address(std::get<1>(inst), frame));
+        table->lvalue_at_temporary_object_address(ir::get<1>(inst), frame));
 }
 
 /**
@@ -195,7 +213,7 @@ void IR_Instruction_Visitor::from_call_ita(ir::Quadruple const& inst)
 {
     auto instruction_accessor = accessor_->instruction_accessor;
     auto inserter = Invocation_Inserter{ accessor_ };
-    auto function_name = type::get_label_as_human_readable(std::get<1>(inst));
+    auto function_name = type::get_label_as_human_readable(ir::get<1>(inst));
     auto is_syscall_function = [&](Label const& label) {
 #if defined(__linux__)
         return common::runtime::is_syscall_function(label,
@@ -270,7 +288,7 @@ void IR_Instruction_Visitor::from_mov_ita(ir::Quadruple const& inst)
 
     m::match(lhs, rhs)(
         m::pattern | m::ds(m::app(is_parameter, true), m::_) = [] {},
-        m::pattern | m::ds(m::app(type::is_temporary, true), m::_) =
+        m::pattern | m::ds(m::app(is_temporary, true), m::_) =
             [&] {
                 expression_inserter.insert_lvalue_at_temporary_object_address(
                     lhs);
@@ -318,7 +336,7 @@ void IR_Instruction_Visitor::from_jmp_e_ita(ir::Quadruple const& inst)
                                  .get_lvalue_address_and_insertion_instructions(
                                      of_comparator, instructions.size())
                                  .first;
-    auto with_rvalue_storage = type::get_data_type_from_string(with);
+    auto with_rvalue_storage = ir::value_of<3>(inst).literal;
     auto jump_label = assembly::make_label(jump, stack_frame_.symbol);
     auto comparator_instructions = assembly::r_eq(
         of_rvalue_storage, with_rvalue_storage, jump_label, Register::eax);
@@ -331,7 +349,7 @@ void IR_Instruction_Visitor::from_jmp_e_ita(ir::Quadruple const& inst)
 void IR_Instruction_Visitor::from_goto_ita(ir::Quadruple const& inst)
 {
     auto label = direct_immediate(
-        assembly::make_label(std::get<1>(inst), stack_frame_.symbol));
+        assembly::make_label(ir::get<1>(inst), stack_frame_.symbol));
     auto instruction_accessor = accessor_->instruction_accessor;
     auto& instructions = instruction_accessor->get_instructions();
     // make_direct_immediate copies the view into the owning string of
@@ -386,7 +404,7 @@ void IR_Instruction_Visitor::from_label_ita(ir::Quadruple const& inst)
 {
     auto& instructions = accessor_->instruction_accessor->get_instructions();
     instructions.emplace_back(
-        type::get_label_as_human_readable(std::get<1>(inst)));
+        type::get_label_as_human_readable(ir::get<1>(inst)));
 }
 
 }
\ No newline at end of file
@@ -87,6 +87,10 @@ class IR_Instruction_Visitor final : public X8664_IR_Visitor
 
   private:
     std::size_t iterator_index_{ 0 };
+    // the index of the prologue of the function being inserted
+    std::size_t function_index_{ 0 };
+    // the bytes allocated on the stack before the function being inserted
+    common::Stack_Offset function_offset_{ 0 };
 
   private:
     memory::Memory_Access accessor_;
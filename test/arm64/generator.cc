@@ -86,7 +86,7 @@ inline void check_against_golden(std::string const& actual,
  */
 struct Fixture
 {
-    credence::util::AST_Node symbols;
+    credence::ir::Symbols symbols;
     credence::frontend::hir::Unit unit;
 };
 
@@ -165,6 +165,20 @@ inline Fixture parse_platform_fixture(std::string_view name)
             test, fixture.symbols, fixture.unit, true));  \
     } while (0)
 
+#define SETUP_ARM64_WITH_STDLIB_FIXTURE_SHOULD_THROW(path_name)             \
+    do {                                                                    \
+        using namespace credence::target::arm64;                            \
+        auto test = std::ostringstream{};                                   \
+        auto fixture = parse_platform_fixture(path_name);                   \
+        credence::target::common::runtime::add_stdlib_functions_to_symbols( \
+            fixture.symbols,                                                \
+            credence::target::common::assembly::OS_Type::Linux,             \
+            credence::target::common::assembly::Arch_Type::ARM64,           \
+            false);                                                         \
+        REQUIRE_THROWS(credence::target::arm64::emit(                       \
+            test, fixture.symbols, fixture.unit, false));                   \
+    } while (0)
+
 TEST_CASE("target/arm64: fixture: math_constant.b")
 {
 #if defined(__linux__) || defined(_WIN32) || defined(_WIN64)
@@ -520,4 +534,9 @@ TEST_CASE("target/arm64: fixture: argc_argv")
 #else
     SETUP_ARM64_WITH_STDLIB_FIXTURE_AND_TEST("argc_argv", "bsd", false);
 #endif
+}
+
+TEST_CASE("target/arm64: fixture: argv_offset")
+{
+    SETUP_ARM64_WITH_STDLIB_FIXTURE_SHOULD_THROW("argv_offset");
 }
\ No newline at end of file
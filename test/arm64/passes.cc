@@ -0,0 +1,161 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include "../common/emitted.h"               // for emitted, function_text
+#include <credence/target/arm64/generator.h> // for emit
+#include <credence/target/common/options.h>  // for Target_Options
+#include <cstddef>                           // for size_t
+#include <string>                            // for string
+
+/****************************************************************************
+ *
+ * ARM64 target passes
+ *
+ * Under --regalloc a local of a frame that calls has to be kept in a
+ * callee-saved register, read and written by the w view of its size, and
+ * a function has to save the x view of the registers it was given in
+ * pairs, with stp before its prologue and ldp before its ret. Under
+ * --leaf a function that calls nothing and never reads sp has to lose
+ * its frame record.
+ *
+ * The passes are checked by what the machine code they change must and
+ * must not hold, rather than against a golden file of it.
+ *
+ ****************************************************************************/
+
+using namespace credence::target;
+using credence::test::function_text;
+
+namespace {
+
+/**
+ * @brief The ARM64 machine code of a source under the target passes set
+ */
+std::string emitted(std::string const& source, common::Target_Options options)
+{
+    return credence::test::emitted(arm64::emit, source, options);
+}
+
+/**
+ * @brief Whether each line of the text that names a register is a save or
+ * restore of it
+ */
+bool is_only_saved(std::string const& text, std::string const& device)
+{
+    std::size_t line = 0;
+    while (line < text.size()) {
+        auto end = text.find('\n', line);
+        if (end == std::string::npos)
+            end = text.size();
+        auto instruction = text.substr(line, end - line);
+        if (instruction.find(device) != std::string::npos and
+            instruction.find("stp ") == std::string::npos and
+            instruction.find("ldp ") == std::string::npos)
+            return false;
+        line = end + 1;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("arm64/passes.cc: a local of a frame that calls is kept in the w "
+          "view of a callee-saved register")
+{
+    auto text = emitted("main() {\n  f(10);\n}\n"
+                        "g() {\n  return(1);\n}\n"
+                        "f(n) {\n  auto i;\n  i = 0;\n"
+                        "  while (i < 10) {\n    g();\n"
+                        "    i = i + 1;\n  }\n  return(n);\n}\n",
+        { .regalloc = true });
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+    CHECK(f.find("bl g") != std::string::npos);
+    CHECK(f.find("w20") != std::string::npos);
+    CHECK(f.find("ldr w20") == std::string::npos);
+    CHECK(f.find("str w20") == std::string::npos);
+    CHECK(is_only_saved(f, "x20"));
+}
+
+TEST_CASE("arm64/passes.cc: the registers a function was given are saved in "
+          "pairs with stp and restored with ldp")
+{
+    auto text = emitted("main() {\n  auto k;\n  k = 0;\n"
+                        "  while (k < 3) {\n    f(10);\n"
+                        "    k = k + 1;\n  }\n}\n"
+                        "g() {\n  return(1);\n}\n"
+                        "f(n) {\n  auto i;\n  i = 0;\n"
+                        "  while (i < 10) {\n    g();\n"
+                        "    i = i + 1;\n  }\n  return(n);\n}\n",
+        { .regalloc = true });
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+
+    // one register given is saved with the next, to keep sp aligned
+    auto save = f.find("stp x20, x21, [sp, #-16]!");
+    REQUIRE(save != std::string::npos);
+    CHECK(save < f.find("stp x29, x30"));
+    auto restore = f.find("ldp x20, x21, [sp], #16");
+    REQUIRE(restore != std::string::npos);
+    CHECK(restore > f.find("ldp x29, x30"));
+    CHECK(restore < f.find("ret"));
+    CHECK(f.find("str x20") == std::string::npos);
+
+    // main never returns, so saves nothing
+    CHECK(function_text(text, "_start").find("stp x20") == std::string::npos);
+}
+
+TEST_CASE("arm64/passes.cc: a leaf function loses its frame record")
+{
+    auto text = emitted("main() {\n  f(3);\n}\n"
+                        "f(x) {\n  auto y;\n  y = 3 * 3;\n  return(y);\n}\n",
+        { .leaf = true });
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+    CHECK(f.find("stp x29, x30") == std::string::npos);
+    CHECK(f.find("mov x29, sp") == std::string::npos);
+    CHECK(f.find("ldp x29, x30") == std::string::npos);
+    CHECK(f.find("ret") != std::string::npos);
+}
+
+TEST_CASE("arm64/passes.cc: a function that calls or takes a slot keeps its "
+          "frame record")
+{
+    auto text = emitted("main() {\n  f(3);\n  h(3);\n}\n"
+                        "g(x) {\n  return(x);\n}\n"
+                        "f(x) {\n  return(g(x));\n}\n"
+                        "h(a) {\n  auto v[4];\n  v[1] = 1;\n"
+                        "  return(a);\n}\n",
+        { .leaf = true });
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+    CHECK(f.find("stp x29, x30") != std::string::npos);
+    CHECK(f.find("ldp x29, x30") != std::string::npos);
+    CHECK(function_text(text, "g").find("stp x29, x30") == std::string::npos);
+    // a vector is addressed from the frame, so h has to keep it
+    CHECK(function_text(text, "h").find("stp x29, x30") != std::string::npos);
+}
+
+TEST_CASE("arm64/passes.cc: a leaf loses its frame record beside a function "
+          "that saves registers")
+{
+    auto text = emitted("main() {\n  f(10);\n}\n"
+                        "g(a) {\n  auto x;\n  x = 3 * 3;\n"
+                        "  return(x);\n}\n"
+                        "f(n) {\n  auto i;\n  i = 0;\n"
+                        "  while (i < 10) {\n    g(n);\n"
+                        "    i = i + 1;\n  }\n  return(n);\n}\n",
+        { .regalloc = true, .leaf = true });
+    auto g = function_text(text, "g");
+    REQUIRE_FALSE(g.empty());
+    CHECK(g.find("stp") == std::string::npos);
+    CHECK(g.find("sp") == std::string::npos);
+
+    // f calls, so keeps its frame record inside the pair it saves
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+    auto save = f.find("stp x20, x21, [sp, #-16]!");
+    REQUIRE(save != std::string::npos);
+    CHECK(save < f.find("stp x29, x30"));
+    CHECK(f.find("ldp x29, x30") < f.find("ldp x20, x21, [sp], #16"));
+    CHECK(f.find("ldp x20, x21") < f.find("ret"));
+}
@@ -0,0 +1,191 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <credence/target/arm64/assembly.h>  // for Instruction, Register
+#include <credence/target/arm64/peephole.h>  // for rewrite_instructions
+#include <credence/target/common/assembly.h> // for make_numeric_immediate
+#include <credence/target/common/flags.h>    // for Flag_Accessor
+#include <cstddef>                           // for size_t
+#include <string>                            // for string
+#include <string_view>                       // for string_view
+#include <variant>                           // for get, monostate
+
+/****************************************************************************
+ *
+ * ARM64 peephole patterns
+ *
+ * Each pattern has to rewrite the window it is made for and count it, and
+ * has to leave a window alone where the rewrite would change what the
+ * program does: a w register self-move, a transfer of two widths, or a
+ * multiply by a register the mov before it did not set.
+ *
+ ****************************************************************************/
+
+using namespace credence::target;
+using namespace credence::target::arm64;
+
+namespace {
+
+using Instructions = assembly::Instructions;
+using Label = common::Label;
+using Offset = common::Stack_Offset;
+
+constexpr auto none = std::monostate{};
+
+/**
+ * @brief Rewrite the instructions of the function f, and give back the
+ * hits of the pattern named
+ */
+std::size_t rewrite(Instructions& instructions, std::string_view pattern)
+{
+    common::Flag_Accessor flags{};
+    auto hits = rewrite_instructions(
+        instructions, flags, [](Label const& label) { return label == "f"; });
+    std::size_t count = 0;
+    for (auto const& [name, hit] : hits)
+        if (name == pattern)
+            count = hit;
+    return count;
+}
+
+assembly::Immediate integer(int value)
+{
+    return common::assembly::make_numeric_immediate(value);
+}
+
+assembly::Instruction const& instruction_at(Instructions const& instructions,
+    std::size_t index)
+{
+    return std::get<assembly::Instruction>(instructions[index]);
+}
+
+} // namespace
+
+TEST_CASE("arm64/peephole.cc: an x register self-move is dropped and a w "
+          "register one is kept")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{
+            Mnemonic::mov, Register::x9, Register::x9, none, none },
+        assembly::Instruction{
+            Mnemonic::mov, Register::w9, Register::w9, none, none },
+    };
+    CHECK(rewrite(instructions, "self-move") == 1);
+    REQUIRE(instructions.size() == 2);
+    CHECK(std::get<1>(instruction_at(instructions, 1)) ==
+          assembly::Storage{ Register::w9 });
+}
+
+TEST_CASE("arm64/peephole.cc: a reload of a slot just stored is a mov of "
+          "the register stored")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{
+            Mnemonic::str, Register::w10, Offset{ 20 }, none, none },
+        assembly::Instruction{
+            Mnemonic::ldr, Register::w11, Offset{ 20 }, none, none },
+        assembly::Instruction{
+            Mnemonic::str, Register::w10, Offset{ 24 }, none, none },
+        assembly::Instruction{
+            Mnemonic::ldr, Register::x11, Offset{ 24 }, none, none },
+    };
+    CHECK(rewrite(instructions, "store-reload") == 1);
+    REQUIRE(instructions.size() == 5);
+    CHECK(instruction_at(instructions, 2) ==
+          assembly::Instruction{
+              Mnemonic::mov, Register::w11, Register::w10, none, none });
+    CHECK(std::get<0>(instruction_at(instructions, 4)) == Mnemonic::ldr);
+}
+
+TEST_CASE("arm64/peephole.cc: a store of the register a slot was loaded "
+          "into is dropped")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{
+            Mnemonic::ldr, Register::w10, Offset{ 20 }, none, none },
+        assembly::Instruction{
+            Mnemonic::str, Register::w10, Offset{ 20 }, none, none },
+    };
+    CHECK(rewrite(instructions, "load-store") == 1);
+    CHECK(instructions.size() == 2);
+}
+
+TEST_CASE("arm64/peephole.cc: a branch to the next label is dropped")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::b,
+            common::assembly::make_direct_immediate(
+                assembly::make_label("_L2", "f")),
+            none,
+            none,
+            none },
+        Label{ "_L2" },
+    };
+    CHECK(rewrite(instructions, "jump-to-next") == 1);
+    REQUIRE(instructions.size() == 2);
+    CHECK(std::get<Label>(instructions[1]) == "_L2");
+}
+
+TEST_CASE("arm64/peephole.cc: an add of zero is a mov")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{
+            Mnemonic::add, Register::w8, Register::w9, integer(0), none },
+        assembly::Instruction{
+            Mnemonic::add, Register::w8, Register::x9, integer(0), none },
+    };
+    CHECK(rewrite(instructions, "add-zero") == 1);
+    CHECK(instruction_at(instructions, 1) ==
+          assembly::Instruction{
+              Mnemonic::mov, Register::w8, Register::w9, none, none });
+    CHECK(std::get<0>(instruction_at(instructions, 2)) == Mnemonic::add);
+}
+
+TEST_CASE("arm64/peephole.cc: a multiply by one is a mov and by two is an "
+          "add")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{
+            Mnemonic::mov, Register::w7, integer(1), none, none },
+        assembly::Instruction{
+            Mnemonic::mul, Register::w8, Register::w9, Register::w7, none },
+        assembly::Instruction{
+            Mnemonic::mov, Register::w7, integer(2), none, none },
+        assembly::Instruction{
+            Mnemonic::mul, Register::w8, Register::w9, Register::w7, none },
+    };
+    common::Flag_Accessor flags{};
+    auto hits = rewrite_instructions(
+        instructions, flags, [](Label const& label) { return label == "f"; });
+    for (auto const& [name, hit] : hits) {
+        if (name == "mul-one" or name == "mul-two")
+            CHECK(hit == 1);
+        else
+            CHECK(hit == 0);
+    }
+    CHECK(instruction_at(instructions, 2) ==
+          assembly::Instruction{
+              Mnemonic::mov, Register::w8, Register::w9, none, none });
+    CHECK(instruction_at(instructions, 4) ==
+          assembly::Instruction{
+              Mnemonic::add, Register::w8, Register::w9, Register::w9, none });
+}
+
+TEST_CASE("arm64/peephole.cc: a multiply by a register the mov before did "
+          "not set is kept")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{
+            Mnemonic::mov, Register::w7, integer(2), none, none },
+        assembly::Instruction{
+            Mnemonic::mul, Register::w8, Register::w9, Register::w10, none },
+    };
+    CHECK(rewrite(instructions, "mul-two") == 0);
+    CHECK(std::get<0>(instruction_at(instructions, 2)) == Mnemonic::mul);
+}
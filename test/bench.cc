@@ -0,0 +1,72 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <bench/bench.h>               // for Shape, generate, run
+#include <credence/frontend/compile.h> // for compile
+#include <sstream>                     // for ostringstream
+#include <string>                      // for string
+
+using namespace credence;
+
+TEST_CASE("bench.cc: the same shape and seed give the same program")
+{
+    bench::Shape shape{ .functions = 8 };
+    CHECK(bench::generate(shape) == bench::generate(shape));
+
+    auto other = shape;
+    other.seed = 2;
+    CHECK(bench::generate(shape) != bench::generate(other));
+}
+
+TEST_CASE("bench.cc: every dimension scales the program")
+{
+    bench::Shape shape{ .functions = 4 };
+    auto size = bench::generate(shape).size();
+
+    auto wider = [&](auto field) {
+        auto larger = shape;
+        larger.*field *= 4;
+        return bench::generate(larger).size() > size;
+    };
+    CHECK(wider(&bench::Shape::functions));
+    CHECK(wider(&bench::Shape::statements));
+    CHECK(wider(&bench::Shape::depth));
+    CHECK(wider(&bench::Shape::vectors));
+    CHECK(wider(&bench::Shape::strings));
+    CHECK(wider(&bench::Shape::arms));
+
+    auto bare = bench::generate(bench::Shape{
+        .functions = 4, .vectors = 0, .strings = 0, .arms = 0 });
+    CHECK(bare.find('[') == std::string::npos);
+    CHECK(bare.find('"') == std::string::npos);
+    CHECK(bare.find("switch") == std::string::npos);
+}
+
+TEST_CASE("bench.cc: generated programs pass the frontend")
+{
+    for (std::uint64_t seed = 1; seed <= 8; ++seed) {
+        auto program = frontend::compile(bench::generate(bench::Shape{
+            .functions = 6, .statements = 24, .depth = 4, .seed = seed }));
+        CHECK(program.diagnostics.empty());
+    }
+}
+
+TEST_CASE("bench.cc: a run reports every stage of the target")
+{
+    auto result = bench::run(bench::Shape{ .functions = 4 }, "x86_64", 3);
+
+    CHECK(result.repeat == 3);
+    CHECK(result.bytes == bench::generate(result.shape).size());
+    REQUIRE(result.stages.size() == 9);
+    CHECK(result.stages.front().name == "parse");
+    CHECK(result.stages.front().unit == "tokens");
+    CHECK(result.stages.back().name == "emit");
+    for (auto const& stage : result.stages) {
+        CHECK(stage.count > 0);
+        CHECK(stage.min_ms <= stage.median_ms);
+    }
+
+    auto json = std::ostringstream{};
+    bench::dump_json(json, { result }, "x86_64");
+    CHECK(json.str().find("\"name\": \"hoist\"") != std::string::npos);
+    CHECK(json.str().find("\"units_per_second\"") != std::string::npos);
+}
@@ -0,0 +1,136 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include <credence/target/common/allocator.h> // for linear_scan, Interval
+#include <cstddef>                            // for size_t
+#include <deque>                              // for deque
+#include <map>                                // for map
+
+/****************************************************************************
+ *
+ * Linear scan
+ *
+ * An interval has to hold its register over each loop it overlaps, nested
+ * or not, the interval of lowest cost has to keep its slot when each
+ * register is taken, and a register has to be free again once the
+ * interval that held it has ended, and only then.
+ *
+ ****************************************************************************/
+
+using namespace credence::target::common;
+
+namespace {
+
+enum class Device
+{
+    a,
+    b,
+    c
+};
+
+/**
+ * @brief An interval of a slot from start to end with no uses
+ */
+allocator::Interval interval_of(Stack_Offset slot,
+    std::size_t start,
+    std::size_t end,
+    std::size_t cost = 1)
+{
+    return allocator::Interval{ slot, start, end, cost, {} };
+}
+
+} // namespace
+
+TEST_CASE("allocator.cc: a use costs ten times more for each loop it is in")
+{
+    allocator::Loops loops{ { 5, 30 }, { 10, 20 } };
+    CHECK(allocator::get_cost_from_index(loops, 2) == 1);
+    CHECK(allocator::get_cost_from_index(loops, 25) == 10);
+    CHECK(allocator::get_cost_from_index(loops, 15) == 100);
+}
+
+TEST_CASE("allocator.cc: an interval is extended over each loop it overlaps")
+{
+    auto inner = interval_of(4, 12, 14);
+    allocator::extend_interval_over_loops(inner, { { 10, 20 }, { 5, 30 } });
+    CHECK(inner.start == 5);
+    CHECK(inner.end == 30);
+
+    auto outside = interval_of(8, 32, 40);
+    allocator::extend_interval_over_loops(outside, { { 10, 20 }, { 5, 30 } });
+    CHECK(outside.start == 32);
+    CHECK(outside.end == 40);
+}
+
+TEST_CASE("allocator.cc: an interval is extended until no loop it overlaps "
+          "is left")
+{
+    // the first loop only overlaps the interval once the second extends it
+    auto interval = interval_of(4, 15, 16);
+    allocator::extend_interval_over_loops(interval, { { 0, 10 }, { 8, 20 } });
+    CHECK(interval.start == 0);
+    CHECK(interval.end == 20);
+}
+
+TEST_CASE("allocator.cc: the interval of lowest cost keeps its slot")
+{
+    allocator::Intervals intervals{ { 4, interval_of(4, 0, 10, 1) },
+        { 8, interval_of(8, 2, 6, 10) },
+        { 12, interval_of(12, 3, 9, 5) } };
+    auto assigned = allocator::linear_scan(
+        intervals, {}, std::deque<Device>{ Device::a, Device::b });
+    CHECK_FALSE(assigned.contains(4));
+    CHECK(assigned.at(8) == Device::b);
+    CHECK(assigned.at(12) == Device::a);
+
+    // an interval that costs no more than any taken keeps its own slot
+    allocator::Intervals cheap{ { 4, interval_of(4, 0, 10, 5) },
+        { 8, interval_of(8, 2, 6, 5) } };
+    auto kept =
+        allocator::linear_scan(cheap, {}, std::deque<Device>{ Device::a });
+    CHECK(kept.at(4) == Device::a);
+    CHECK_FALSE(kept.contains(8));
+}
+
+TEST_CASE("allocator.cc: a register is free again after its interval ends")
+{
+    allocator::Intervals intervals{ { 4, interval_of(4, 0, 5) },
+        { 8, interval_of(8, 5, 7) },
+        { 12, interval_of(12, 6, 9) } };
+    auto assigned = allocator::linear_scan(
+        intervals, {}, std::deque<Device>{ Device::a, Device::b });
+    // the slot at 8 starts where the one at 4 ends, so both are live there
+    CHECK(assigned.at(4) == Device::a);
+    CHECK(assigned.at(8) == Device::b);
+    CHECK(assigned.at(12) == Device::a);
+}
+
+TEST_CASE("allocator.cc: an interval in a loop holds its register to the "
+          "jump back")
+{
+    allocator::Intervals intervals{ { 4, interval_of(4, 2, 3) },
+        { 8, interval_of(8, 6, 7) } };
+    auto free = std::deque<Device>{ Device::a };
+    auto looped = allocator::linear_scan(intervals, { { 1, 8 } }, free);
+    CHECK(looped.size() == 1);
+    CHECK(intervals.at(4).end == 8);
+
+    allocator::Intervals straight{ { 4, interval_of(4, 2, 3) },
+        { 8, interval_of(8, 6, 7) } };
+    auto shared = allocator::linear_scan(straight, {}, free);
+    CHECK(shared.at(4) == Device::a);
+    CHECK(shared.at(8) == Device::a);
+}
+
+TEST_CASE("allocator.cc: an odd number of saved registers is made even")
+{
+    std::deque<Device> registers{ Device::a, Device::b, Device::c };
+    std::map<Stack_Offset, Device> assigned{ { 4, Device::b } };
+    auto saved = allocator::get_saved_registers(assigned, registers);
+    REQUIRE(saved.size() == 2);
+    CHECK(saved[0] == Device::b);
+    CHECK(saved[1] == Device::a);
+
+    assigned[8] = Device::a;
+    CHECK(allocator::get_saved_registers(assigned, registers).size() == 2);
+    CHECK(allocator::get_saved_registers({}, registers).empty());
+}
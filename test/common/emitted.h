@@ -0,0 +1,79 @@
+#pragma once
+
+#include <credence/frontend/compile.h>      // for compile
+#include <credence/ir/optimize.h>           // for Optimize_Options
+#include <credence/ir/symbols.h>            // for hoisted_symbols
+#include <credence/target/common/options.h> // for Target_Options
+#include <cstddef>                          // for size_t
+#include <sstream>                          // for ostringstream
+#include <string>                           // for string
+
+/****************************************************************************
+ *
+ * Target test helpers
+ *
+ * The machine code of a source under the IR and target passes set, the
+ * text of one of its functions, and the count of what it holds, which the
+ * tests of the passes of both backends read.
+ *
+ ****************************************************************************/
+
+namespace credence::test {
+
+/**
+ * @brief The machine code emit gives of a source under the passes set,
+ * where emit is x86_64::emit or arm64::emit
+ */
+template<typename Emit>
+std::string emitted(Emit emit,
+    std::string const& source,
+    target::common::Target_Options options = {},
+    ir::Optimize_Options passes = {})
+{
+    // put back even when the source is rejected, so later cases run with
+    // every pass off
+    struct Restore
+    {
+        target::common::Target_Options target{
+            target::common::target_options
+        };
+        ir::Optimize_Options optimize{ ir::optimize_options };
+        ~Restore()
+        {
+            target::common::target_options = target;
+            ir::optimize_options = optimize;
+        }
+    } restore{};
+    target::common::target_options = options;
+    ir::optimize_options = passes;
+    auto program = frontend::compile(source);
+    auto symbols = ir::hoisted_symbols(program.unit);
+    std::ostringstream os{};
+    emit(os, symbols, program.unit, true);
+    return os.str();
+}
+
+/**
+ * @brief The text of the function of a name, from its label to the blank
+ * line after it
+ */
+inline std::string function_text(std::string const& text,
+    std::string const& name)
+{
+    auto begin = text.find("\n" + name + ":\n");
+    if (begin == std::string::npos)
+        return {};
+    return text.substr(begin, text.find("\n\n", begin + 1) - begin);
+}
+
+inline std::size_t occurrences(std::string const& text,
+    std::string const& what)
+{
+    std::size_t count = 0;
+    for (auto at = text.find(what); at != std::string::npos;
+        at = text.find(what, at + what.size()))
+        count++;
+    return count;
+}
+
+} // namespace credence::test
@@ -0,0 +1,85 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include <credence/target/common/allocator.h> // for Interval, Intervals
+#include <credence/target/common/slots.h>     // for color_intervals, Range
+#include <cstddef>                            // for size_t
+#include <map>                                // for map
+
+/****************************************************************************
+ *
+ * Stack slot coloring
+ *
+ * Slots of the same size whose intervals do not overlap have to share an
+ * offset, and an offset has to be aligned to its size and leave alone the
+ * bytes of a slot still live, of another size, and the fixed bytes of the
+ * frame, such as the range of a vector.
+ *
+ ****************************************************************************/
+
+using namespace credence::target::common;
+
+namespace {
+
+/**
+ * @brief An interval of a slot from start to end with no uses
+ */
+allocator::Interval interval_of(Stack_Offset slot,
+    std::size_t start,
+    std::size_t end)
+{
+    return allocator::Interval{ slot, start, end, 1, {} };
+}
+
+} // namespace
+
+TEST_CASE("slots.cc: two slots whose intervals do not overlap share an "
+          "offset")
+{
+    allocator::Intervals intervals{ { 4, interval_of(4, 0, 3) },
+        { 8, interval_of(8, 5, 9) },
+        { 12, interval_of(12, 10, 12) } };
+    auto offsets = slots::color_intervals(
+        intervals, { { 4, 4 }, { 8, 4 }, { 12, 4 } }, {}, {}, 0);
+    CHECK(offsets.at(4) == 4);
+    CHECK(offsets.at(8) == 4);
+    CHECK(offsets.at(12) == 4);
+}
+
+TEST_CASE("slots.cc: two slots live at once take their own offsets")
+{
+    // the slot at 8 starts where the one at 4 ends, so both are live there
+    allocator::Intervals intervals{ { 4, interval_of(4, 0, 5) },
+        { 8, interval_of(8, 5, 9) } };
+    auto offsets =
+        slots::color_intervals(intervals, { { 4, 4 }, { 8, 4 } }, {}, {}, 0);
+    CHECK(offsets.at(4) == 4);
+    CHECK(offsets.at(8) == 8);
+
+    // and so are two slots of a loop, to its jump back
+    allocator::Intervals looped{ { 4, interval_of(4, 2, 3) },
+        { 8, interval_of(8, 6, 7) } };
+    auto loop = slots::color_intervals(
+        looped, { { 4, 4 }, { 8, 4 } }, {}, { { 1, 8 } }, 0);
+    CHECK(loop.at(4) != loop.at(8));
+}
+
+TEST_CASE("slots.cc: only slots of the same size share an offset, each "
+          "aligned to its size")
+{
+    allocator::Intervals intervals{ { 4, interval_of(4, 0, 2) },
+        { 8, interval_of(8, 5, 9) } };
+    auto offsets =
+        slots::color_intervals(intervals, { { 4, 4 }, { 8, 8 } }, {}, {}, 0);
+    CHECK(offsets.at(4) == 4);
+    // the bytes (0, 8] overlap the dword at 4, so the qword takes (8, 16]
+    CHECK(offsets.at(8) == 16);
+}
+
+TEST_CASE("slots.cc: a slot is kept out of the fixed bytes of the frame")
+{
+    // the 16 bytes of a vector after a base of 8
+    allocator::Intervals intervals{ { 4, interval_of(4, 0, 2) } };
+    auto offsets = slots::color_intervals(
+        intervals, { { 4, 4 } }, { slots::Range{ 8, 24 } }, {}, 8);
+    CHECK(offsets.at(4) == 28);
+}
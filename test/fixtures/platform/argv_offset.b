@@ -0,0 +1,6 @@
+main(argc, argv) {
+  auto i;
+  i = 2;
+  printf("argv i: %s\n", argv[i]);
+
+}
@@ -1,8 +1,11 @@
 #include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
 
 #include <credence/frontend/compile.h>       // for compile
-#include <credence/frontend/hir/hir.h>       // for Unit
+#include <credence/frontend/hir/check.h>     // for check
+#include <credence/frontend/hir/hir.h>       // for Unit, lower
 #include <credence/frontend/hir/serialize.h> // for dump_linear
+#include <credence/frontend/parser.h>        // for Parser
+#include <chrono>                            // for steady_clock, duration
 #include <sstream>                           // for ostringstream
 #include <string>                            // for string
 
@@ -281,6 +284,114 @@ TEST_CASE("hir.cc: a closed scope keeps its symbols addressable")
     CHECK(symbols.lookup(0) == hir::null_symbol_index);
 }
 
+TEST_CASE("hir.cc: closing a scope restores the names it shadowed")
+{
+    hir::Symbol_Table symbols{};
+    auto global = symbols.declare(7, hir::type_word, hir::Storage::Global);
+
+    symbols.push_scope();
+    auto local = symbols.declare(7, hir::type_int, hir::Storage::Auto);
+    CHECK(local != global);
+    CHECK(symbols.lookup(7) == local);
+    CHECK(symbols.declared_in_current_scope(7));
+
+    symbols.push_scope();
+    auto inner = symbols.declare(7, hir::type_char, hir::Storage::Auto);
+    auto other = symbols.declare(8, hir::type_char, hir::Storage::Auto);
+    CHECK(symbols.lookup(7) == inner);
+    symbols.pop_scope();
+
+    CHECK(symbols.lookup(7) == local);
+    CHECK(symbols.lookup(8) == hir::null_symbol_index);
+    CHECK(symbols.at(other).type == hir::type_char);
+    symbols.pop_scope();
+
+    CHECK(symbols.lookup(7) == global);
+    CHECK_FALSE(symbols.declared_in_current_scope(8));
+}
+
+TEST_CASE("hir.cc: a local of one function is not visible in the next")
+{
+    hir::Symbol_Table symbols{};
+    symbols.push_scope();
+    symbols.declare(3, hir::type_word, hir::Storage::Auto);
+    symbols.pop_scope();
+
+    // a sibling scope at the same depth does not see it
+    symbols.push_scope();
+    CHECK(symbols.lookup(3) == hir::null_symbol_index);
+    auto redeclared = symbols.declare(3, hir::type_int, hir::Storage::Auto);
+    CHECK(symbols.at(redeclared).type == hir::type_int);
+    symbols.pop_scope();
+}
+
+TEST_CASE("hir.cc: the type table interns many vector lengths once each")
+{
+    hir::Type_Table types{};
+    auto primitives = types.size();
+    for (std::uint32_t count = 1; count <= 5000; ++count)
+        types.vector_of(hir::type_word, count);
+    CHECK(types.size() == primitives + 5000);
+
+    // asking again finds every one of them and adds nothing
+    for (std::uint32_t count = 1; count <= 5000; ++count)
+        CHECK(types.at(types.vector_of(hir::type_word, count)).count == count);
+    CHECK(types.size() == primitives + 5000);
+    CHECK(types.pointer_to(hir::type_int) == types.pointer_to(hir::type_int));
+}
+
+namespace {
+
+/**
+ * @brief A unit of `functions` definitions, each declaring three locals
+ *  and a vector of a length no other function uses
+ */
+std::string synthetic_unit(std::size_t functions)
+{
+    auto source = std::string{};
+    source.reserve(functions * 64);
+    for (std::size_t i = 0; i < functions; ++i) {
+        auto n = std::to_string(i);
+        source += "f" + n + "() {\n  auto a" + n + ", b" + n + ", v" + n +
+                  "[" + std::to_string(i + 1) + "];\n  a" + n + " = b" + n +
+                  " + v" + n + "[0];\n}\n";
+    }
+    return source;
+}
+
+} // namespace
+
+TEST_CASE("hir.cc: lowering and checking stay linear up to 1M symbols" *
+          doctest::skip())
+{
+    // run with --no-skip; each unit declares four symbols per function and
+    // one distinct vector type, so symbols and types grow together
+    double first = 0;
+    for (std::size_t functions : { 2500u, 25000u, 250000u }) {
+        auto tree =
+            credence::frontend::Parser::parse(synthetic_unit(functions));
+
+        auto start = std::chrono::steady_clock::now();
+        auto lowered = hir::lower(tree);
+        auto diagnostics = hir::check(lowered.unit);
+        auto elapsed = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start)
+                           .count();
+
+        auto symbols = lowered.unit.symbol_table.symbols().size();
+        auto per_symbol = elapsed / static_cast<double>(symbols);
+        MESSAGE(symbols << " symbols, " << lowered.unit.type_table.size()
+                        << " types: " << per_symbol << " ns per symbol");
+
+        CHECK(lowered.diagnostics.empty());
+        CHECK(diagnostics.empty());
+        if (first == 0)
+            first = per_symbol;
+        // a quadratic table would be ~100x slower per symbol by 1M
+        CHECK(per_symbol < first * 8);
+    }
+}
+
 /****************************************************************************
  *
  * Address resolution
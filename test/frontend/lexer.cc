@@ -0,0 +1,61 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include <credence/frontend/lexer.h> // for Lexer, Token, Token_Type
+#include <string>                    // for basic_string, string
+#include <vector>                    // for vector
+
+using credence::frontend::Lexer;
+using credence::frontend::Token_Type;
+
+TEST_CASE("frontend/lexer.cc: line and column across long whitespace runs")
+{
+    // runs longer than any SIMD block, with newlines inside and at the
+    // edges of a block
+    auto source = std::string(40, ' ') + "a" + std::string(33, '\n') +
+                  std::string(17, '\t') + "b\n" + std::string(64, ' ') +
+                  "\r\n  c";
+    auto lexer = Lexer{ source };
+    auto tokens = lexer.tokenize();
+
+    REQUIRE(tokens.size() == 4);
+    CHECK(tokens[0].lexeme == "a");
+    CHECK(tokens[0].line == 1);
+    CHECK(tokens[0].column == 41);
+    CHECK(tokens[1].lexeme == "b");
+    CHECK(tokens[1].line == 34);
+    CHECK(tokens[1].column == 18);
+    CHECK(tokens[2].lexeme == "c");
+    CHECK(tokens[2].line == 36);
+    CHECK(tokens[2].column == 3);
+    CHECK(tokens[3].type == Token_Type::END_OF_FILE);
+}
+
+TEST_CASE("frontend/lexer.cc: line comments are skipped up to the line end")
+{
+    auto source = std::string{ "// " } + std::string(100, 'x') +
+                  "\n  x = 1; // trailing\r\n// last line, no newline";
+    auto lexer = Lexer{ source };
+    auto tokens = lexer.tokenize();
+
+    REQUIRE(tokens.size() == 5);
+    CHECK(tokens[0].lexeme == "x");
+    CHECK(tokens[0].line == 2);
+    CHECK(tokens[0].column == 3);
+    CHECK(tokens[2].lexeme == "1");
+    CHECK(tokens[2].column == 7);
+    CHECK(tokens[3].type == Token_Type::SEMICOLON);
+    CHECK(tokens[4].type == Token_Type::END_OF_FILE);
+    CHECK(tokens[4].line == 3);
+}
+
+TEST_CASE("frontend/lexer.cc: a single slash is not a comment")
+{
+    auto lexer = Lexer{ "a / b /* c\n */ d" };
+    auto tokens = lexer.tokenize();
+
+    REQUIRE(tokens.size() == 5);
+    CHECK(tokens[1].type == Token_Type::SLASH);
+    CHECK(tokens[3].lexeme == "d");
+    CHECK(tokens[3].line == 2);
+    CHECK(tokens[3].column == 5);
+}
@@ -0,0 +1,100 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include <credence/frontend/lexer.h>  // for Lexer, Token_Type
+#include <credence/frontend/source.h> // for Source
+#include <credence/util.h>            // for STRINGIFY, read_file_from_path
+#include <filesystem>                 // for path, temp_directory_path
+#include <fstream>                    // for ofstream
+#include <sstream>                    // for istringstream
+#include <string>                     // for basic_string, string
+
+namespace fs = std::filesystem;
+
+using credence::frontend::Lexer;
+using credence::frontend::Source;
+using credence::frontend::Token_Type;
+
+#define ROOT_PATH STRINGIFY(ROOT_TEST_PATH)
+
+namespace {
+
+fs::path fixture_path(std::string_view name)
+{
+    fs::path root = ROOT_PATH;
+    if (const char* env_root = std::getenv("CREDENCE_TEST_ROOT"))
+        root = env_root;
+    return root.append("test/fixtures/language").append(name);
+}
+
+/**
+ * @brief Whether the padding past the end of a source is all NUL
+ */
+bool padded(Source const& source)
+{
+    for (std::size_t i = 0; i < Source::padding; ++i)
+        if (source.data()[source.size() + i] != '\0')
+            return false;
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("frontend/source.cc: a regular file is mapped and not copied")
+{
+    auto path = fixture_path("function_with_params.b");
+    auto source = Source::from_path(path.string());
+
+    CHECK(source.mapped());
+    CHECK(source.text() ==
+          credence::util::read_file_from_path(path.string()));
+    CHECK(padded(source));
+}
+
+TEST_CASE("frontend/source.cc: a file filling its last page is still padded")
+{
+    auto path = fs::temp_directory_path() / "credence_source_page.b";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << std::string(16384, ' ');
+    }
+    auto source = Source::from_path(path.string());
+
+    CHECK(source.mapped());
+    CHECK(source.size() == 16384);
+    CHECK(padded(source));
+    fs::remove(path);
+}
+
+TEST_CASE("frontend/source.cc: streams and empty files fall back to a buffer")
+{
+    auto stream = std::istringstream{ "main() {}" };
+    auto buffered = Source::from_stream(stream);
+    CHECK_FALSE(buffered.mapped());
+    CHECK(buffered.text() == "main() {}");
+    CHECK(padded(buffered));
+
+    auto path = fs::temp_directory_path() / "credence_source_empty.b";
+    std::ofstream{ path };
+    auto empty = Source::from_path(path.string());
+    CHECK_FALSE(empty.mapped());
+    CHECK(empty.size() == 0);
+    CHECK(padded(empty));
+    fs::remove(path);
+
+    CHECK_THROWS_AS(Source::from_path("/credence/no/such/file.b"),
+        fs::filesystem_error);
+}
+
+TEST_CASE("frontend/source.cc: the lexer scans a mapping in place")
+{
+    auto path = fixture_path("function_with_params.b");
+    auto source = Source::from_path(path.string());
+    auto text = source.text();
+    auto lexer = Lexer{ std::move(source) };
+    auto tokens = lexer.tokenize();
+
+    REQUIRE(tokens.size() > 1);
+    CHECK(tokens.front().lexeme.data() ==
+          text.data() + tokens.front().start_pos);
+    CHECK(tokens.back().type == Token_Type::END_OF_FILE);
+}
@@ -0,0 +1,221 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include "instructions.h"    // for instructions_of
+#include <credence/arena.h>  // for Arena
+#include <credence/ir/cfg.h> // for CFG, make_cfgs, remove_unreachable_b...
+#include <credence/ir/ita.h> // for make_ita_instructions
+#include <cstddef>           // for ptrdiff_t
+#include <sstream>           // for ostringstream
+#include <string>            // for string
+
+/****************************************************************************
+ *
+ * Control-flow graph
+ *
+ * Every pass that reasons about blocks reads them from here, so the edges
+ * have to be the jumps the ITA makes, and the trees and loops have to be
+ * the ones those edges imply, whatever order the ITA lays the blocks in.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+using credence::test::instructions_of;
+
+namespace {
+
+/**
+ * @brief The block whose instructions include the one printed as text
+ */
+ir::Block_Index block_of(ir::CFG const& cfg, std::string const& text)
+{
+    for (ir::Block_Index block = 0; block < cfg.size(); block++) {
+        for (auto i = cfg[block].begin; i < cfg[block].end; i++) {
+            std::ostringstream os{};
+            ir::detail::emit_to(os, cfg.instructions()[i]);
+            if (os.str().find(text) != std::string::npos)
+                return block;
+        }
+    }
+    return ir::null_block_index;
+}
+
+} // namespace
+
+TEST_CASE("cfg.cc: a function with no branches is a line of blocks")
+{
+    auto instructions =
+        instructions_of("main() {\n  auto x;\n  x = 1;\n}\n"
+                        "f() {\n  auto y;\n  y = 2;\n}\n");
+    auto cfgs = ir::make_cfgs(instructions);
+    REQUIRE(cfgs.size() == 2);
+
+    auto const& cfg = cfgs[0];
+    CHECK(cfg.name().starts_with("__main"));
+    CHECK(cfg[cfg.entry()].predecessors.empty());
+    CHECK(cfg[cfg.exit()].successors.empty());
+    CHECK(cfg.order().size() == cfg.size());
+    for (ir::Block_Index block = 0; block < cfg.size(); block++) {
+        CHECK(cfg.dominates(cfg.entry(), block));
+        CHECK(cfg.postdominates(cfg.exit(), block));
+    }
+    CHECK(cfg.loops().empty());
+}
+
+TEST_CASE("cfg.cc: an if and else join below both arms")
+{
+    auto instructions = instructions_of("main() {\n  auto x;\n  x = 1;\n"
+                                        "  if (x > 1) {\n    x = 2;\n"
+                                        "  } else {\n    x = 3;\n  }\n"
+                                        "  x = 4;\n}\n");
+    auto cfgs = ir::make_cfgs(instructions);
+    REQUIRE(cfgs.size() == 1);
+    auto const& cfg = cfgs[0];
+
+    auto test = block_of(cfg, "IF");
+    auto then = block_of(cfg, "x = (2:int:4)");
+    auto otherwise = block_of(cfg, "x = (3:int:4)");
+    auto join = block_of(cfg, "x = (4:int:4)");
+    REQUIRE(test != ir::null_block_index);
+    REQUIRE(join != ir::null_block_index);
+
+    CHECK(cfg[test].successors.size() == 2);
+    CHECK(cfg[join].predecessors.size() == 2);
+    CHECK(cfg.dominates(test, then));
+    CHECK(cfg.dominates(test, otherwise));
+    CHECK(cfg.dominates(test, join));
+    CHECK_FALSE(cfg.dominates(then, join));
+    CHECK(cfg.postdominates(join, then));
+    CHECK(cfg.postdominates(join, otherwise));
+    CHECK(cfg.postdominates(join, test));
+    CHECK(cfg.loops().empty());
+}
+
+TEST_CASE("cfg.cc: nested whiles are nested loops")
+{
+    auto instructions = instructions_of("main() {\n  auto i, j;\n  i = 0;\n"
+                                        "  while (i < 10) {\n    j = 0;\n"
+                                        "    while (j < 10) {\n"
+                                        "      j = j + 1;\n    }\n"
+                                        "    i = i + 1;\n  }\n}\n");
+    auto cfgs = ir::make_cfgs(instructions);
+    REQUIRE(cfgs.size() == 1);
+    auto const& cfg = cfgs[0];
+    REQUIRE(cfg.loops().size() == 2);
+
+    auto inner = block_of(cfg, "j = _t");
+    auto outer = block_of(cfg, "i = _t");
+    REQUIRE(inner != ir::null_block_index);
+    REQUIRE(outer != ir::null_block_index);
+    CHECK(cfg.loop_depth(inner) == 2);
+    CHECK(cfg.loop_depth(outer) == 1);
+    CHECK(cfg.loop_depth(cfg.entry()) == 0);
+
+    auto const& loop = cfg.loops()[cfg[inner].loop];
+    CHECK(loop.parent != ir::null_loop_index);
+    CHECK(cfg.loops()[loop.parent].depth == 1);
+    CHECK(cfg.dominates(cfg.loops()[loop.parent].header, loop.header));
+    CHECK(cfg.loops()[loop.parent].blocks.size() > loop.blocks.size());
+    CHECK_FALSE(loop.irreducible);
+}
+
+TEST_CASE("cfg.cc: a jump back to a label is a loop")
+{
+    auto instructions = instructions_of("main() {\n  auto x, y;\n  x = 0;\n"
+                                        "top:\n  y = 1;\n  x = x + 1;\n"
+                                        "  if (x < 10) {\n    goto top;\n  }\n"
+                                        "  y = 3;\n}\n");
+    auto cfgs = ir::make_cfgs(instructions);
+    REQUIRE(cfgs.size() == 1);
+    auto const& cfg = cfgs[0];
+    REQUIRE(cfg.loops().size() == 1);
+
+    auto header = block_of(cfg, "y = (1:int:4)");
+    auto after = block_of(cfg, "y = (3:int:4)");
+    REQUIRE(header != ir::null_block_index);
+    REQUIRE(after != ir::null_block_index);
+    CHECK(cfg.loops()[0].header == header);
+    CHECK_FALSE(cfg.loops()[0].irreducible);
+    CHECK(cfg.loop_depth(header) == 1);
+    CHECK(cfg.loop_depth(after) == 0);
+}
+
+TEST_CASE("cfg.cc: a cycle entered by a goto past its top is no loop")
+{
+    auto instructions = instructions_of("main() {\n  auto x, y;\n  x = 0;\n"
+                                        "  if (x > 5) {\n"
+                                        "    goto inside;\n  }\n"
+                                        "top:\n  y = 1;\n"
+                                        "inside:\n  y = 2;\n"
+                                        "  x = x + 1;\n"
+                                        "  if (x < 10) {\n    goto top;\n  }\n"
+                                        "  y = 3;\n}\n");
+    auto cfgs = ir::make_cfgs(instructions);
+    REQUIRE(cfgs.size() == 1);
+    auto const& cfg = cfgs[0];
+
+    auto top = block_of(cfg, "y = (1:int:4)");
+    auto inside = block_of(cfg, "y = (2:int:4)");
+    REQUIRE(top != ir::null_block_index);
+    REQUIRE(inside != ir::null_block_index);
+    CHECK(cfg.reachable(top));
+    CHECK(cfg.reachable(inside));
+    CHECK_FALSE(cfg.dominates(top, inside));
+    CHECK_FALSE(cfg.dominates(inside, top));
+    CHECK(cfg.loops().empty());
+    CHECK(cfg.loop_depth(top) == 0);
+    CHECK(cfg.loop_depth(inside) == 0);
+}
+
+TEST_CASE("cfg.cc: a block after a jump with no label is unreachable")
+{
+    auto instructions = instructions_of("main() {\n  auto x;\n  x = 1;\n"
+                                        "  goto done;\n  x = 2;\n"
+                                        "done:\n  x = 3;\n}\n");
+    auto cfgs = ir::make_cfgs(instructions);
+    REQUIRE(cfgs.size() == 1);
+    auto const& cfg = cfgs[0];
+
+    auto dead = block_of(cfg, "x = (2:int:4)");
+    REQUIRE(dead != ir::null_block_index);
+    CHECK_FALSE(cfg.reachable(dead));
+    CHECK_FALSE(cfg.dominates(cfg.entry(), dead));
+    CHECK(cfg.reachable(block_of(cfg, "x = (3:int:4)")));
+}
+
+TEST_CASE("cfg.cc: the blocks reached are kept in the memory of the function")
+{
+    auto instructions = instructions_of("main() {\n  auto x;\n  x = 1;\n"
+                                        "  goto done;\n  x = 2;\n"
+                                        "done:\n  x = 3;\n}\n");
+    auto ranges = ir::function_ranges(instructions);
+    REQUIRE(ranges.size() == 1);
+
+    credence::Arena arena{};
+    auto [begin, end] = ranges[0];
+    ir::Instructions function{
+        instructions.begin() + static_cast<std::ptrdiff_t>(begin),
+        instructions.begin() + static_cast<std::ptrdiff_t>(end),
+        arena.resource()
+    };
+    CHECK(ir::remove_unreachable_blocks(function) > 0);
+    CHECK(ir::resource_of(function) == arena.resource());
+}
+
+TEST_CASE("cfg.cc: a graph dumps as text and as dot")
+{
+    auto instructions = instructions_of("main() {\n  auto x;\n  x = 1;\n"
+                                        "  while (x < 3) {\n"
+                                        "    x = x + 1;\n  }\n}\n");
+    auto cfgs = ir::make_cfgs(instructions);
+    REQUIRE(cfgs.size() == 1);
+
+    std::ostringstream text{};
+    ir::dump(text, cfgs[0]);
+    CHECK(text.str().find("B0  succ") != std::string::npos);
+    CHECK(text.str().find("L0  header") != std::string::npos);
+
+    std::ostringstream dot{};
+    ir::dump(dot, cfgs[0], true);
+    CHECK(dot.str().starts_with("digraph"));
+    CHECK(dot.str().find("B0 -> B1;") != std::string::npos);
+}
@@ -0,0 +1,76 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include "instructions.h"       // for each_function
+#include <credence/ir/copies.h> // for propagate_copies
+#include <credence/ir/ssa.h>    // for SSA
+#include <cstddef>              // for size_t
+#include <string>               // for string
+
+/****************************************************************************
+ *
+ * Copy propagation and temporary coalescing
+ *
+ * The temporary of an assignment has to be folded into the name it is
+ * copied to, a chain of copies has to read the first, and what is left
+ * has to be the function it was, as the table reads it.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+using credence::test::each_function;
+
+namespace {
+
+/**
+ * @brief Each function of the ITA of a source with its copies dropped, as
+ * the text -t ir prints
+ */
+std::string propagated(std::string const& source)
+{
+    return each_function(source,
+        [](auto& instructions, std::size_t begin, std::size_t end) {
+            ir::SSA ssa{ instructions, begin, end };
+            ir::propagate_copies(ssa);
+            return ssa.destruct();
+        });
+}
+
+} // namespace
+
+TEST_CASE("copies.cc: the temporary of an assignment is coalesced into it")
+{
+    auto text = propagated("main() {\n  auto x;\n  x = 10;\n"
+                           "  while (x > 0) {\n    x = x - 1;\n  }\n"
+                           "  return(x);\n}\n");
+    CHECK(text.find("x = x - (1:int:4);") != std::string::npos);
+    CHECK(text.find("NOOP") == std::string::npos);
+}
+
+TEST_CASE("copies.cc: a chain of copies reads the first")
+{
+    auto text = propagated("f(a) {\n  auto x, y;\n  x = a;\n  y = x;\n"
+                           "  return(y);\n}\n"
+                           "main() {\n  return(f(1));\n}\n");
+    CHECK(text.find("RET a") != std::string::npos);
+    CHECK(text.find("RET y") == std::string::npos);
+}
+
+TEST_CASE("copies.cc: a copy is read through the loop it enters")
+{
+    auto text = propagated("f(a) {\n  auto x, i;\n  x = a;\n  i = 0;\n"
+                           "  while (i < x) {\n    i = i + 1;\n  }\n"
+                           "  return(i);\n}\n"
+                           "main() {\n  return(f(3));\n}\n");
+    CHECK(text.find("i < a") != std::string::npos);
+    CHECK(text.find("i < x") == std::string::npos);
+}
+
+TEST_CASE("copies.cc: an increment in place and the RET of a call keep "
+          "their names")
+{
+    auto text = propagated("g() {\n  return(1);\n}\n"
+                           "main() {\n  auto x, y;\n  x = g();\n"
+                           "  y = ++x;\n  return(x + y);\n}\n");
+    CHECK(text.find("x = ++x;") != std::string::npos);
+    CHECK(text.find(" = RET;") != std::string::npos);
+}
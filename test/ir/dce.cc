@@ -0,0 +1,101 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include "instructions.h"         // for each_function, instructions_of
+#include <credence/ir/dce.h>      // for eliminate_dead_code, remove...
+#include <credence/ir/optimize.h> // for optimize, optimize_options
+#include <credence/ir/ssa.h>      // for SSA
+#include <cstddef>                // for size_t
+#include <string>                 // for string
+#include <utility>                // for pair
+
+/****************************************************************************
+ *
+ * Dead code elimination
+ *
+ * What nothing live reads has to go, with the local it was the only use
+ * of, and what a branch, a call, or a loop still needs has to stay.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+using credence::test::each_function;
+using credence::test::instructions_of;
+using credence::test::text_of;
+
+namespace {
+
+/**
+ * @brief Each function of the ITA of a source with its dead code dropped,
+ * as the text -t ir prints, and the number of quadruples dropped
+ */
+std::pair<std::string, std::size_t> eliminated(std::string const& source)
+{
+    std::size_t removed = 0;
+    auto text = each_function(source,
+        [&](auto& instructions, std::size_t begin, std::size_t end) {
+            ir::SSA ssa{ instructions, begin, end };
+            removed += ir::eliminate_dead_code(ssa);
+            auto function = ssa.destruct();
+            removed += ir::remove_dead_code(function);
+            return function;
+        });
+    return { text, removed };
+}
+
+} // namespace
+
+TEST_CASE("dce.cc: an assignment nothing reads is dropped with its local")
+{
+    auto [text, removed] = eliminated("main() {\n  auto x, y;\n  x = 1;\n"
+                                      "  y = x * 2;\n  return(x);\n}\n");
+    CHECK(removed > 0);
+    CHECK(text.find("LOCL y;") == std::string::npos);
+    CHECK(text.find("* (2:int:4)") == std::string::npos);
+    CHECK(text.find("LOCL x;") != std::string::npos);
+    CHECK(text.find("RET x") != std::string::npos);
+}
+
+TEST_CASE("dce.cc: a call is kept when its result is not read")
+{
+    auto [text, removed] = eliminated("f() {\n  return(1);\n}\n"
+                                      "main() {\n  auto x;\n  x = f();\n"
+                                      "  return(0);\n}\n");
+    CHECK(text.find("CALL f;") != std::string::npos);
+    CHECK(text.find("LOCL x;") == std::string::npos);
+}
+
+TEST_CASE("dce.cc: the code a goto jumps over is dropped")
+{
+    auto [text, removed] = eliminated("f() {\n  return(1);\n}\n"
+                                      "main() {\n  goto done;\n  f();\n"
+                                      "done:\n  return(0);\n}\n");
+    CHECK(removed > 0);
+    CHECK(text.find("CALL f;") == std::string::npos);
+}
+
+TEST_CASE("dce.cc: a name a loop reads is kept")
+{
+    auto [text, removed] = eliminated("main() {\n  auto i, k;\n  i = 0;\n"
+                                      "  k = 0;\n  while (i < 10) {\n"
+                                      "    i = i + 1;\n  }\n"
+                                      "  return(i);\n}\n");
+    CHECK(text.find("LOCL k;") == std::string::npos);
+    CHECK(text.find("i + (1:int:4)") != std::string::npos);
+    CHECK(text.find("IF ") != std::string::npos);
+}
+
+TEST_CASE("dce.cc: an increment is kept under --sccp --dce")
+{
+    auto instructions = instructions_of("main() {\n  auto x, y;\n"
+                                        "  x = 1;\n  y = ++x + 1;\n"
+                                        "  return(x);\n}\n");
+    auto options = ir::optimize_options;
+    ir::optimize_options.sccp = true;
+    ir::optimize_options.dce = true;
+    ir::optimize(instructions);
+    ir::optimize_options = options;
+
+    auto text = text_of(instructions);
+    CHECK(text.find("LOCL y;") == std::string::npos);
+    CHECK(text.find("RET (1:int:4)") == std::string::npos);
+}
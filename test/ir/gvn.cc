@@ -0,0 +1,112 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include "../common/emitted.h" // for occurrences
+#include "instructions.h"      // for each_function
+#include <credence/ir/gvn.h>   // for number_values
+#include <credence/ir/ssa.h>   // for SSA
+#include <cstddef>             // for size_t
+#include <string>              // for string
+
+/****************************************************************************
+ *
+ * Value numbering
+ *
+ * An operation computed twice on the same values has to be read from the
+ * first, in either order of its operands where the order does not matter,
+ * and a load has to be computed again once a store may have changed what
+ * it reads, and only then.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+using credence::test::each_function;
+using credence::test::occurrences;
+
+namespace {
+
+/**
+ * @brief Each function of the ITA of a source with its values numbered,
+ * as the text -t ir prints
+ */
+std::string numbered(std::string const& source)
+{
+    return each_function(source,
+        [](auto& instructions, std::size_t begin, std::size_t end) {
+            ir::SSA ssa{ instructions, begin, end };
+            ir::number_values(ssa);
+            return ssa.destruct();
+        });
+}
+
+} // namespace
+
+TEST_CASE("gvn.cc: an operation on the same values is computed once")
+{
+    auto text = numbered("f(a, b) {\n  auto x, y;\n  x = a * b;\n"
+                         "  y = b * a;\n  return(x + y);\n}\n"
+                         "main() {\n  return(f(2, 3));\n}\n");
+    CHECK(occurrences(text, "a * b") + occurrences(text, "b * a") == 1);
+}
+
+TEST_CASE("gvn.cc: a load is computed again after a store to its vector")
+{
+    auto text = numbered("main() {\n  auto v[2], x, y;\n  v[0] = 1;\n"
+                         "  x = v[0];\n  v[1] = 2;\n  y = v[0];\n"
+                         "  return(x + y);\n}\n");
+    CHECK(occurrences(text, " = v[") == 2);
+}
+
+TEST_CASE("gvn.cc: a store to one vector leaves the loads of another")
+{
+    auto text = numbered("main() {\n  auto v[2], w[2], x, y;\n"
+                         "  v[0] = 1;\n  x = v[0];\n  w[0] = 2;\n"
+                         "  y = v[0];\n  return(x + y);\n}\n");
+    CHECK(occurrences(text, " = v[") == 1);
+}
+
+TEST_CASE("gvn.cc: an operation in a dominating block is reused in the "
+          "blocks it dominates and in no other")
+{
+    auto reused = numbered("f(a, b) {\n  auto x, y;\n  x = a * b;\n"
+                           "  y = 0;\n  if (a > 0) {\n    y = a * b;\n"
+                           "  }\n  return(x + y);\n}\n"
+                           "main() {\n  return(f(2, 3));\n}\n");
+    CHECK(occurrences(reused, "a * b") == 1);
+
+    auto siblings = numbered("f(a, b) {\n  auto x, y;\n  x = 0;\n"
+                             "  y = 0;\n  if (a > 0) {\n    x = a * b;\n"
+                             "  } else {\n    y = a * b;\n  }\n"
+                             "  return(x + y);\n}\n"
+                             "main() {\n  return(f(2, 3));\n}\n");
+    CHECK(occurrences(siblings, "a * b") == 2);
+}
+
+TEST_CASE("gvn.cc: a load is computed again after a call")
+{
+    auto text = numbered("g() {\n  return(1);\n}\n"
+                         "main() {\n  auto v[2], x, y;\n  v[0] = 1;\n"
+                         "  x = v[0];\n  g();\n  y = v[0];\n"
+                         "  return(x + y);\n}\n");
+    CHECK(occurrences(text, " = v[") == 2);
+}
+
+TEST_CASE("gvn.cc: a load is computed again after a store through a "
+          "pointer")
+{
+    auto text = numbered("main() {\n  auto v[2], w, p, x, y;\n"
+                         "  p = &w;\n  v[0] = 1;\n  x = v[0];\n"
+                         "  *p = 2;\n  y = v[0];\n  return(x + y);\n}\n");
+    CHECK(occurrences(text, " = v[") == 2);
+}
+
+TEST_CASE("gvn.cc: a load is computed again after a store to the name it "
+          "is indexed by")
+{
+    // the address of i is taken, so i is not split and both loads read
+    // the same v[i]
+    auto text = numbered("main() {\n  auto v[2], i, p, x, y;\n"
+                         "  p = &i;\n  v[0] = 1;\n  v[1] = 2;\n  i = 0;\n"
+                         "  x = v[i];\n  i = 1;\n  y = v[i];\n"
+                         "  return(x + y);\n}\n");
+    CHECK(occurrences(text, " = v[i]") == 2);
+}
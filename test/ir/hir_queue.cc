@@ -3,8 +3,8 @@
 #include <credence/frontend/compile.h> // for compile
 #include <credence/frontend/hir/hir.h> // for Unit
 #include <credence/ir/hir_queue.h>     // for queue_from_hir
+#include <credence/ir/symbols.h>       // for Symbols
 #include <credence/ir/temporary.h>     // for queue_to_ita_instructions
-#include <credence/util.h>             // for AST_Node
 #include <sstream>                     // for ostringstream
 #include <string>                      // for string
 
@@ -47,7 +47,7 @@ std::string through_hir(std::string const& source)
     auto queue = credence::ir::queue_from_hir(
         program.unit, found, &temporary_index, &identifier_index);
 
-    auto details = credence::util::AST_Node{};
+    auto details = credence::ir::Symbols{};
     auto instructions = credence::ir::queue_to_ita_instructions(
         queue, details, &temporary_index);
 
@@ -0,0 +1,96 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include "instructions.h"          // for each_function, function_of
+#include <credence/ir/induction.h> // for reduce_induction_variables
+#include <cstddef>                 // for size_t
+#include <string>                  // for string
+
+/****************************************************************************
+ *
+ * Induction variable strength reduction
+ *
+ * A multiply of an induction variable has to be computed once before the
+ * loop and stepped by an add in it, and a variable left to its test has to
+ * be replaced there by its product, but not where the variable is stepped
+ * by what is not a literal or the product would overflow an int.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+using credence::test::function_of;
+using credence::test::each_function;
+
+namespace {
+
+/**
+ * @brief Each function of the ITA of a source with its induction variables
+ * reduced, as the text -t ir prints
+ */
+std::string reduced(std::string const& source)
+{
+    return each_function(source,
+        [](auto& instructions, std::size_t begin, std::size_t end) {
+            auto function = function_of(instructions, begin, end);
+            ir::reduce_induction_variables(function);
+            return function;
+        });
+}
+
+} // namespace
+
+TEST_CASE("induction.cc: a multiply of an induction variable is stepped")
+{
+    auto text = reduced("f(n) {\n  auto i, s;\n  i = 0;\n  s = 0;\n"
+                        "  while (i < n) {\n    s = s + i * 8;\n"
+                        "    i = i + 1;\n  }\n  return(s);\n}\n"
+                        "main() {\n  return(f(3));\n}\n");
+    auto product = text.find("i * (8:int:4)");
+    REQUIRE(product != std::string::npos);
+    CHECK(product == text.rfind("i * (8:int:4)"));
+    CHECK(product < text.find("i < n"));
+    CHECK(text.find("+ (8:int:4)") > text.find("i < n"));
+}
+
+TEST_CASE("induction.cc: a variable left to its test is replaced in it")
+{
+    auto text = reduced("main() {\n  auto i, s;\n  i = 0;\n  s = 0;\n"
+                        "  while (i < 10) {\n    s = s + i * 4;\n"
+                        "    i = i + 1;\n  }\n  return(s);\n}\n");
+    CHECK(text.find("< (40:int:4)") != std::string::npos);
+    CHECK(text.find("i * (4:int:4)") == std::string::npos);
+    CHECK(text.find("i + (1:int:4)") == std::string::npos);
+}
+
+TEST_CASE("induction.cc: a variable stepped by what is not a literal is "
+          "not reduced")
+{
+    auto text = reduced("f(n, k) {\n  auto i, s;\n  i = 0;\n  s = 0;\n"
+                        "  while (i < n) {\n    s = s + i * 8;\n"
+                        "    i = i + k;\n  }\n  return(s);\n}\n"
+                        "main() {\n  return(f(3, 1));\n}\n");
+    auto product = text.find("i * (8:int:4)");
+    REQUIRE(product != std::string::npos);
+    CHECK(product > text.find("i < n"));
+    CHECK(text.find("+ (8:int:4)") == std::string::npos);
+}
+
+TEST_CASE("induction.cc: a stride or a test that would overflow an int is "
+          "left as it was")
+{
+    auto stride = reduced("f(n) {\n  auto i, s;\n  i = 0;\n  s = 0;\n"
+                          "  while (i < n) {\n"
+                          "    s = s + i * 1073741824;\n"
+                          "    i = i + 4;\n  }\n  return(s);\n}\n"
+                          "main() {\n  return(f(3));\n}\n");
+    auto product = stride.find("i * (1073741824:int:4)");
+    REQUIRE(product != std::string::npos);
+    CHECK(product > stride.find("i < n"));
+
+    auto test = reduced("main() {\n  auto i, s;\n  i = 0;\n  s = 0;\n"
+                        "  while (i < 1000000000) {\n"
+                        "    s = s + i * 4;\n    i = i + 1;\n  }\n"
+                        "  return(s);\n}\n");
+    CHECK(test.find("i < (1000000000:int:4)") != std::string::npos);
+    CHECK(test.find("i + (1:int:4)") != std::string::npos);
+    CHECK(test.find("+ (4:int:4)") > test.find("i < (1000000000:int:4)"));
+}
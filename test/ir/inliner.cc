@@ -0,0 +1,133 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include "../common/emitted.h"                // for emitted, function_text
+#include "instructions.h"                     // for instructions_of, text_of
+#include <credence/ir/inliner.h>              // for inline_calls
+#include <credence/target/x86_64/generator.h> // for emit
+#include <string>                             // for string
+
+/****************************************************************************
+ *
+ * Inliner
+ *
+ * A call of a small function that calls nothing, or nothing once its own
+ * calls are inlined, is its body in the caller, and a function that calls
+ * itself, directly or not, or is larger than the limit, is called as it
+ * was.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+using credence::test::instructions_of;
+using credence::test::function_text;
+using credence::test::text_of;
+
+namespace {
+
+/**
+ * @brief The ITA of a source with its small calls inlined, as the text -t
+ * ir prints, from the label of main
+ */
+std::string inlined(std::string const& source, std::size_t limit = 8)
+{
+    auto instructions = instructions_of(source);
+    ir::inline_calls(instructions, limit);
+    auto text = text_of(instructions);
+    return text.substr(text.find("__main("));
+}
+
+/**
+ * @brief The x86-64 machine code of main of a source with its small calls
+ * inlined
+ */
+std::string inlined_main(std::string const& source)
+{
+    auto text = credence::test::emitted(
+        credence::target::x86_64::emit, source, {}, { .inliner = true });
+    return function_text(text, "_start");
+}
+
+} // namespace
+
+TEST_CASE("inliner.cc: a call of a small function is its body")
+{
+    auto text = inlined("add(x, y) {\n  return(x + y);\n}\n"
+                        "main() {\n  auto a;\n  a = add(1, 2);\n"
+                        "  return(a);\n}\n");
+    CHECK(text.find("CALL") == std::string::npos);
+    CHECK(text.find("PUSH") == std::string::npos);
+    CHECK(text.find(" + ") != std::string::npos);
+}
+
+TEST_CASE("inliner.cc: a recursive function is not inlined")
+{
+    auto text = inlined("f(x) {\n  return(f(x));\n}\n"
+                        "main() {\n  auto a;\n  a = f(1);\n"
+                        "  return(a);\n}\n");
+    CHECK(text.find("CALL f") != std::string::npos);
+}
+
+TEST_CASE("inliner.cc: a function larger than the limit is not inlined")
+{
+    auto source = std::string{ "add(x, y) {\n  return(x + y);\n}\n"
+                               "main() {\n  auto a;\n  a = add(1, 2);\n"
+                               "  return(a);\n}\n" };
+    CHECK(inlined(source, 0).find("CALL add") != std::string::npos);
+}
+
+TEST_CASE("inliner.cc: functions that call each other are not inlined "
+          "however high the limit")
+{
+    auto text = inlined("f(x) {\n  return(g(x));\n}\n"
+                        "g(x) {\n  return(f(x));\n}\n"
+                        "main() {\n  auto a;\n  a = f(1);\n"
+                        "  return(a);\n}\n",
+        1000);
+    CHECK(text.find("CALL f") != std::string::npos);
+}
+
+TEST_CASE("inliner.cc: a function is inlined once the calls in it are")
+{
+    auto text = inlined("h(x) {\n  return(x + 1);\n}\n"
+                        "g(x) {\n  return(h(x) * 2);\n}\n"
+                        "main() {\n  auto a;\n  a = g(1);\n"
+                        "  return(a);\n}\n",
+        1000);
+    CHECK(text.find("CALL") == std::string::npos);
+    CHECK(text.find(" * ") != std::string::npos);
+}
+
+TEST_CASE("inliner.cc: a function is not inlined where its extrn is a "
+          "parameter of the caller")
+{
+    auto text = inlined("main() {\n  auto a;\n  a = f(1);\n"
+                        "  return(a);\n}\n"
+                        "g() {\n  extrn k;\n  return(k);\n}\n"
+                        "f(k) {\n  return(g() + k);\n}\n"
+                        "k 5;\n");
+    CHECK(text.find("CALL g") != std::string::npos);
+}
+
+TEST_CASE("inliner.cc: the local a call of a function that returns a "
+          "parameter sets keeps the size of the argument")
+{
+    auto text = inlined_main("id(x) {\n  return(x);\n}\n"
+                             "main() {\n  auto a;\n  a = id(5);\n"
+                             "  a = a + 1;\n}\n");
+    REQUIRE_FALSE(text.empty());
+    CHECK(text.find("call id") == std::string::npos);
+    CHECK(text.find("dword ptr [rbp - 4]") != std::string::npos);
+    CHECK(text.find("qword ptr") == std::string::npos);
+}
+
+TEST_CASE("inliner.cc: the local a call of a function that returns a "
+          "literal sets keeps the size of the literal")
+{
+    auto text = inlined_main("five() {\n  return(5);\n}\n"
+                             "main() {\n  auto a;\n  a = five();\n"
+                             "  a = a + 1;\n}\n");
+    REQUIRE_FALSE(text.empty());
+    CHECK(text.find("call five") == std::string::npos);
+    CHECK(text.find("dword ptr [rbp - 4]") != std::string::npos);
+    CHECK(text.find("qword ptr") == std::string::npos);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <credence/frontend/compile.h> // for compile
+#include <credence/ir/cfg.h>           // for function_ranges
+#include <credence/ir/ita.h>           // for make_ita_instructions, emit
+#include <credence/ir/symbols.h>       // for hoisted_symbols
+#include <cstddef>                     // for size_t, ptrdiff_t
+#include <sstream>                     // for ostringstream
+#include <string>                      // for string
+
+/****************************************************************************
+ *
+ * IR test helpers
+ *
+ * The ITA of a source, each of its functions through a pass, and the text
+ * -t ir prints of them, which the tests of each pass read.
+ *
+ ****************************************************************************/
+
+namespace credence::test {
+
+/**
+ * @brief The ITA of a source string, as the passes are run on it
+ */
+inline ir::Instructions instructions_of(std::string const& source)
+{
+    auto program = frontend::compile(source);
+    auto symbols = ir::hoisted_symbols(program.unit);
+    return ir::make_ita_instructions(program.unit, symbols).second;
+}
+
+/**
+ * @brief The instructions as the text -t ir prints
+ */
+inline std::string text_of(ir::Instructions const& instructions)
+{
+    std::ostringstream os{};
+    ir::detail::emit(os, instructions);
+    return os.str();
+}
+
+/**
+ * @brief A copy of the instructions from begin to end
+ */
+inline ir::Instructions function_of(ir::Instructions const& instructions,
+    std::size_t begin,
+    std::size_t end)
+{
+    return { instructions.begin() + static_cast<std::ptrdiff_t>(begin),
+        instructions.begin() + static_cast<std::ptrdiff_t>(end) };
+}
+
+/**
+ * @brief Each function of the ITA of a source as f gives it back from the
+ * instructions and its range, as the text -t ir prints
+ */
+template<typename F>
+std::string each_function(std::string const& source, F&& f)
+{
+    auto instructions = instructions_of(source);
+    ir::Instructions functions{};
+    for (auto [begin, end] : ir::function_ranges(instructions)) {
+        auto function = f(instructions, begin, end);
+        functions.insert(functions.end(), function.begin(), function.end());
+    }
+    return text_of(functions);
+}
+
+} // namespace credence::test
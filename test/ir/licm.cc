@@ -0,0 +1,91 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include "instructions.h"     // for each_function, function_of
+#include <credence/ir/licm.h> // for hoist_invariants
+#include <cstddef>            // for size_t
+#include <string>             // for string
+
+/****************************************************************************
+ *
+ * Loop-invariant code motion
+ *
+ * An operation a while loop does not change has to be computed once,
+ * before the predicate, one the body may never have run has to be left
+ * where it is, and so does a load where a call or a store in the loop may
+ * change what it reads.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+using credence::test::function_of;
+using credence::test::each_function;
+
+namespace {
+
+/**
+ * @brief Each function of the ITA of a source with its invariants hoisted,
+ * as the text -t ir prints
+ */
+std::string hoisted(std::string const& source)
+{
+    return each_function(source,
+        [](auto& instructions, std::size_t begin, std::size_t end) {
+            auto function = function_of(instructions, begin, end);
+            ir::hoist_invariants(function);
+            return function;
+        });
+}
+
+} // namespace
+
+TEST_CASE("licm.cc: an operation on names the loop does not assign is hoisted")
+{
+    auto text = hoisted("main() {\n  auto a, b, i, n, v[10];\n"
+                        "  a = 2;\n  b = 3;\n  i = 0;\n  n = 10;\n"
+                        "  while (i < n) {\n    v[i] = a * b;\n"
+                        "    i = i + 1;\n  }\n  return(v[0]);\n}\n");
+    auto product = text.find("a * b");
+    REQUIRE(product != std::string::npos);
+    CHECK(product < text.find("i < n"));
+    CHECK(text.find("i + (1:int:4)") > text.find("i < n"));
+}
+
+TEST_CASE("licm.cc: a division the loop may never run is left in it")
+{
+    auto text = hoisted("main() {\n  auto a, b, i, x;\n"
+                        "  a = 2;\n  b = 0;\n  i = 0;\n  x = 0;\n"
+                        "  while (i < a) {\n    x = a / b;\n"
+                        "    i = i + 1;\n  }\n  return(x);\n}\n");
+    auto quotient = text.find("a / b");
+    REQUIRE(quotient != std::string::npos);
+    CHECK(quotient > text.find("i < a"));
+}
+
+TEST_CASE("licm.cc: a load is left in a loop that calls, and an operation "
+          "on scalars is hoisted past the call")
+{
+    auto text = hoisted("g() {\n  return(1);\n}\n"
+                        "main() {\n  auto a, b, i, n, x, y, v[10];\n"
+                        "  a = 2;\n  b = 3;\n  i = 0;\n  n = 10;\n"
+                        "  v[1] = 4;\n  while (i < n) {\n"
+                        "    x = v[0];\n    y = a * b;\n    g();\n"
+                        "    i = i + 1;\n  }\n  return(x + y);\n}\n");
+    auto test = text.find("i < n");
+    REQUIRE(test != std::string::npos);
+    CHECK(text.find("a * b") < test);
+    CHECK(text.find(" = v[") > test);
+    CHECK(text.find("CALL g") > test);
+}
+
+TEST_CASE("licm.cc: a load is left in a loop that stores to a vector")
+{
+    auto text = hoisted("main() {\n  auto a, b, i, n, x, v[10];\n"
+                        "  a = 2;\n  b = 3;\n  i = 0;\n  n = 10;\n"
+                        "  v[1] = 4;\n  while (i < n) {\n"
+                        "    x = v[0];\n    v[1] = a * b;\n"
+                        "    i = i + 1;\n  }\n  return(x);\n}\n");
+    auto test = text.find("i < n");
+    REQUIRE(test != std::string::npos);
+    CHECK(text.find("a * b") < test);
+    CHECK(text.find(" = v[") > test);
+}
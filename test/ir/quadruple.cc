@@ -0,0 +1,228 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include <credence/arena.h>        // for Arena
+#include <credence/ir/ita.h>       // for emit_to, insert
+#include <credence/ir/quadruple.h> // for Quadruple, make_quadruple, get
+#include <iterator>                // for next
+#include <memory_resource>         // for get_default_resource
+#include <sstream>                 // for ostringstream
+#include <string>                  // for string
+#include <tuple>                   // for get
+#include <utility>                 // for move
+
+/****************************************************************************
+ *
+ * Quadruple
+ *
+ * An instruction is an opcode and three handles, and everything that reads
+ * it reads the operand text back out of the operand table. So an operand
+ * has to come back as the same text, under the same handle, every time it
+ * is made, and the -t ir printer has to print what the tuple did.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+
+TEST_CASE("quadruple.cc: the same operand interns to the same handle")
+{
+    auto& table = ir::operand_table();
+    auto handle = table.intern("_t_quadruple_test + x");
+    CHECK(table.intern("_t_quadruple_test + x") == handle);
+    CHECK(table.intern("") == ir::Operand_Table::empty);
+    CHECK(table.text(handle) == "_t_quadruple_test + x");
+    CHECK(table.intern("_t_quadruple_test - x") != handle);
+}
+
+TEST_CASE("quadruple.cc: operands are classified as they are interned")
+{
+    auto& table = ir::operand_table();
+    CHECK(table.kind(table.intern("")) == ir::Operand_Kind::Empty);
+    CHECK(table.kind(table.intern("_t15")) == ir::Operand_Kind::Temporary);
+    CHECK(table.number(table.intern("_t15")) == 15);
+    CHECK(table.kind(table.intern("_L3")) == ir::Operand_Kind::Label);
+    CHECK(table.number(table.intern("_L3")) == 3);
+    CHECK(table.kind(table.intern("(10:int:4)")) == ir::Operand_Kind::Literal);
+    CHECK(table.kind(table.intern("__main")) == ir::Operand_Kind::Symbol);
+    CHECK(table.kind(table.intern("_p1_1")) == ir::Operand_Kind::Symbol);
+    CHECK(table.kind(table.intern("_t1 + _t2")) ==
+          ir::Operand_Kind::Expression);
+    CHECK(table.kind(table.intern("_t")) == ir::Operand_Kind::Symbol);
+    CHECK(table.kind(table.intern("*x")) == ir::Operand_Kind::Expression);
+}
+
+TEST_CASE("quadruple.cc: a name may have a dot in it, as the lexer reads it")
+{
+    auto& table = ir::operand_table();
+    CHECK(table.kind(table.intern("k.ll")) == ir::Operand_Kind::Symbol);
+    CHECK(table.kind(table.intern("_a.b.c")) == ir::Operand_Kind::Symbol);
+    auto dereference = table.value(table.intern("*k.ll"));
+    CHECK(dereference.shape == ir::Lvalue_Shape::Dereference);
+    CHECK(table.text(dereference.base) == "k.ll");
+    CHECK(table.kind(table.intern(".k")) == ir::Operand_Kind::Expression);
+}
+
+TEST_CASE("quadruple.cc: an operand scope has a table of its own")
+{
+    auto& process = ir::operand_table();
+    auto handle = process.intern("quadruple_scope");
+    {
+        ir::Operand_Scope scope{};
+        auto& table = ir::operand_table();
+        CHECK(&table != &process);
+        CHECK(table.size() == 1);
+        CHECK(table.intern("quadruple_scope") == 1);
+        {
+            ir::Operand_Scope inner{};
+            CHECK(ir::operand_table().size() == 1);
+        }
+        CHECK(&ir::operand_table() == &table);
+        CHECK(table.size() == 2);
+    }
+    CHECK(&ir::operand_table() == &process);
+    CHECK(process.text(handle) == "quadruple_scope");
+}
+
+TEST_CASE("quadruple.cc: a handle read after its scope is gone is caught")
+{
+    ir::Operand_Scope scope{};
+    ir::Operand_Table::Handle handle{};
+    {
+        ir::Operand_Scope inner{};
+        ir::operand_table().intern("_t1");
+        handle = ir::operand_table().intern("_t2");
+    }
+    CHECK(ir::operand_table().size() == 1);
+    CHECK_THROWS(ir::operand_table().text(handle));
+}
+
+TEST_CASE("quadruple.cc: a quadruple reads and decomposes as a tuple")
+{
+    auto quadruple =
+        ir::make_quadruple(ir::Instruction::MOV, "_t5", "loop == ", "_t4");
+    CHECK(sizeof(quadruple) == 16);
+    CHECK(ir::get<0>(quadruple) == ir::Instruction::MOV);
+    CHECK(ir::get<1>(quadruple) == "_t5");
+    CHECK(ir::get<2>(quadruple) == "loop == ");
+    CHECK(ir::get<3>(quadruple) == "_t4");
+    CHECK(ir::kind_of<1>(quadruple) == ir::Operand_Kind::Temporary);
+
+    auto [op, lhs, rhs, next] = quadruple;
+    CHECK(op == ir::Instruction::MOV);
+    CHECK(lhs == "_t5");
+    CHECK(rhs == "loop == ");
+    CHECK(next == "_t4");
+
+    CHECK(quadruple ==
+          ir::make_quadruple(ir::Instruction::MOV, "_t5", "loop == ", "_t4"));
+    CHECK(quadruple !=
+          ir::make_quadruple(ir::Instruction::MOV, "_t6", "loop == ", "_t4"));
+}
+
+TEST_CASE("quadruple.cc: the printer writes the text of each operand")
+{
+    auto out = std::ostringstream{};
+    ir::detail::emit_to(out,
+        ir::make_quadruple(ir::Instruction::MOV, "x", "(5:int:4)"));
+    ir::detail::emit_to(out, ir::make_quadruple(ir::Instruction::LABEL, "_L2"));
+    ir::detail::emit_to(out,
+        ir::make_quadruple(ir::Instruction::IF, "_t3", "GOTO", "_L2"));
+    CHECK(out.str() == "x = (5:int:4);\n_L2:\nIF _t3 GOTO _L2;\n");
+}
+
+TEST_CASE("quadruple.cc: an operand value is read once from its text")
+{
+    auto const& literal = ir::value_of("(10:int:4)");
+    CHECK(literal.is_literal());
+    CHECK(literal.type == ir::Value_Type::Int);
+    CHECK(literal.integer == 10);
+    CHECK(std::get<2>(literal.literal) == 4);
+
+    auto const& real = ir::value_of("(1.5:double:8)");
+    CHECK(real.type == ir::Value_Type::Double);
+    CHECK(real.real == 1.5);
+
+    auto const& character = ir::value_of("('97':char:1)");
+    CHECK(character.type == ir::Value_Type::Char);
+    CHECK(character.integer == 97);
+
+    auto const& offset = ir::value_of("v[k]");
+    CHECK(offset.shape == ir::Lvalue_Shape::Offset);
+    CHECK(ir::text_of(offset.base) == "v");
+    CHECK(ir::text_of(offset.offset) == "k");
+
+    auto const& index = ir::value_of("argv[2]");
+    CHECK(index.shape == ir::Lvalue_Shape::Offset);
+    CHECK(not ir::value_of(index.offset).is_literal());
+    CHECK(ir::value_of(index.offset).integer == 2);
+
+    auto const& dereference = ir::value_of("*p");
+    CHECK(dereference.shape == ir::Lvalue_Shape::Dereference);
+    CHECK(ir::text_of(dereference.base) == "p");
+    CHECK(dereference.unary == "*");
+
+    auto const& binary = ir::value_of("_t1 + (2:int:4)");
+    CHECK(binary.is_binary());
+    CHECK(binary.binary == "+");
+    CHECK(ir::text_of(binary.lhs) == "_t1");
+    CHECK(ir::value_of(binary.lhs).kind == ir::Operand_Kind::Temporary);
+    CHECK(ir::value_of(binary.rhs).integer == 2);
+
+    auto const& unary = ir::value_of("-x");
+    CHECK(unary.is_unary());
+    CHECK(not unary.is_binary());
+
+    CHECK(ir::value_of("x").shape == ir::Lvalue_Shape::Scalar);
+}
+
+TEST_CASE("quadruple.cc: instruction lists given the arena come from it")
+{
+    auto* heap = std::pmr::get_default_resource();
+    credence::Arena arena{};
+    CHECK(std::pmr::get_default_resource() == heap);
+    CHECK(ir::Instructions{}.get_allocator().resource() == heap);
+
+    ir::Instructions to{ arena.resource() };
+    ir::Instructions from{ arena.resource() };
+    from.emplace_back(ir::make_quadruple(ir::Instruction::LABEL, "_L2"));
+    from.emplace_back(ir::make_quadruple(ir::Instruction::GOTO, "_L2"));
+    CHECK(from.get_allocator().resource() == arena.resource());
+
+    auto const* first = &from.front();
+    ir::insert(to, std::move(from));
+    CHECK(to.size() == 2);
+    CHECK(&to.front() == first);
+
+    // a copy is not given the arena, and is appended to it by copies
+    ir::Instructions copy{ to };
+    CHECK(copy.get_allocator().resource() == heap);
+    ir::insert(to, std::move(copy));
+    CHECK(to.size() == 4);
+    CHECK(to.get_allocator().resource() == arena.resource());
+    CHECK(ir::get<0>(to.back()) == ir::Instruction::GOTO);
+}
+
+TEST_CASE("quadruple.cc: a list the ITA builds is spliced onto the next")
+{
+    credence::Arena arena{};
+    ir::Instruction_List to{ arena.resource() };
+    ir::Instruction_List from{ arena.resource() };
+    to.emplace_back(ir::make_quadruple(ir::Instruction::LABEL, "_L1"));
+    from.emplace_back(ir::make_quadruple(ir::Instruction::LABEL, "_L2"));
+    from.emplace_back(ir::make_quadruple(ir::Instruction::GOTO, "_L2"));
+
+    // the nodes are relinked, not copied
+    auto const* first = &from.front();
+    ir::insert(to, std::move(from));
+    CHECK(from.empty());
+    CHECK(to.size() == 3);
+    CHECK(&*std::next(to.begin()) == first);
+
+    // a list of another resource can't be relinked, and is copied
+    ir::Instruction_List heap{};
+    heap.emplace_back(ir::make_quadruple(ir::Instruction::GOTO, "_L1"));
+    auto const* copied = &heap.front();
+    ir::insert(to, std::move(heap));
+    CHECK(to.size() == 4);
+    CHECK(&to.back() != copied);
+    CHECK(to.get_allocator().resource() == arena.resource());
+}
@@ -0,0 +1,101 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include "instructions.h"         // for instructions_of, text_of...
+#include <credence/ir/optimize.h> // for optimize, optimize_options
+#include <credence/ir/sccp.h>     // for propagate_constants, fold...
+#include <credence/ir/ssa.h>      // for SSA
+#include <cstddef>                // for size_t
+#include <string>                 // for string
+
+/****************************************************************************
+ *
+ * Sparse conditional constant propagation
+ *
+ * A constant has to reach what reads it through the branches it decides
+ * and no further, it has to be the value the backends would compute, and
+ * an operation that would trap or lose precision has to be left for run
+ * time.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+using credence::test::instructions_of;
+using credence::test::text_of;
+using credence::test::each_function;
+
+namespace {
+
+/**
+ * @brief Each function of the ITA of a source with its constants folded,
+ * as the text -t ir prints
+ */
+std::string folded(std::string const& source)
+{
+    return each_function(source,
+        [](auto& instructions, std::size_t begin, std::size_t end) {
+            ir::SSA ssa{ instructions, begin, end };
+            ir::propagate_constants(ssa);
+            auto function = ssa.destruct();
+            ir::fold_branches(function);
+            return function;
+        });
+}
+
+} // namespace
+
+TEST_CASE("sccp.cc: a branch on a constant keeps the arm it takes")
+{
+    auto text = folded("main() {\n  auto x, y;\n  x = 1;\n"
+                       "  if (x > 0) {\n    y = 2;\n"
+                       "  } else {\n    y = 3;\n  }\n"
+                       "  return(y);\n}\n");
+    CHECK(text.find("IF ") == std::string::npos);
+    CHECK(text.find("(3:int:4)") == std::string::npos);
+    CHECK(text.find("RET (2:int:4)") != std::string::npos);
+}
+
+TEST_CASE("sccp.cc: arithmetic on constants is folded")
+{
+    auto text = folded("main() {\n  auto x, y;\n  x = 6;\n"
+                       "  y = x * 7;\n  return(y);\n}\n");
+    CHECK(text.find("RET (42:int:4)") != std::string::npos);
+}
+
+TEST_CASE("sccp.cc: a division by zero is left for run time")
+{
+    auto text = folded("main() {\n  auto x, y;\n  x = 1;\n"
+                       "  y = x / 0;\n  return(y);\n}\n");
+    CHECK(text.find("(1:int:4) / (0:int:4)") != std::string::npos);
+    CHECK(text.find("RET (") == std::string::npos);
+}
+
+TEST_CASE("sccp.cc: a name a loop assigns is not a constant")
+{
+    auto text = folded("main() {\n  auto i;\n  i = 0;\n"
+                       "  while (i < 10) {\n"
+                       "    i = i + 1;\n  }\n  return(i);\n}\n");
+    CHECK(text.find("IF ") != std::string::npos);
+    CHECK(text.find("RET (") == std::string::npos);
+}
+
+TEST_CASE("sccp.cc: a name an increment changes is not its old constant")
+{
+    auto instructions = instructions_of("main() {\n  auto x, y;\n"
+                                        "  x = 1;\n  y = ++x + 1;\n"
+                                        "  return(x);\n}\n");
+    auto options = ir::optimize_options;
+    ir::optimize_options.sccp = true;
+    ir::optimize(instructions);
+    ir::optimize_options = options;
+
+    auto text = text_of(instructions);
+    CHECK(text.find("RET (1:int:4)") == std::string::npos);
+}
+
+TEST_CASE("sccp.cc: a right shift is logical, as the backends shift")
+{
+    auto text = folded("main() {\n  auto x, y;\n  x = -8;\n"
+                       "  y = x >> 1;\n  return(y);\n}\n");
+    CHECK(text.find("RET (-4:int:4)") == std::string::npos);
+    CHECK(text.find("RET (2147483644:int:4)") != std::string::npos);
+}
@@ -0,0 +1,220 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include "instructions.h"    // for instructions_of, text_of
+#include <credence/ir/cfg.h> // for function_ranges
+#include <credence/ir/ssa.h> // for SSA, dump
+#include <cstddef>           // for size_t
+#include <sstream>           // for ostringstream
+#include <string>            // for string
+
+/****************************************************************************
+ *
+ * Static single assignment form
+ *
+ * The phis have to be at the joins a name is assigned on the way to, the
+ * names that may change through a pointer have to be left alone, and the
+ * way back has to give the instructions the function was, as every pass
+ * between the two relies on it.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+using credence::test::instructions_of;
+using credence::test::text_of;
+using credence::test::each_function;
+
+namespace {
+
+std::string dump_of(ir::SSA const& ssa)
+{
+    std::ostringstream os{};
+    ir::dump(os, ssa);
+    return os.str();
+}
+
+/**
+ * @brief Each function of the ITA of a source, into SSA form and back
+ */
+std::string round_trip(std::string const& source)
+{
+    return each_function(source,
+        [](auto& instructions, std::size_t begin, std::size_t end) {
+            return ir::SSA{ instructions, begin, end }.destruct();
+        });
+}
+
+} // namespace
+
+TEST_CASE("ssa.cc: a name assigned on both arms of an if has a phi below")
+{
+    auto instructions = instructions_of("main() {\n  auto x;\n  x = 1;\n"
+                                        "  if (x > 1) {\n    x = 2;\n"
+                                        "  } else {\n    x = 3;\n  }\n"
+                                        "  return(x);\n}\n");
+    auto ranges = ir::function_ranges(instructions);
+    REQUIRE(ranges.size() == 1);
+    ir::SSA ssa{ instructions, ranges[0].first, ranges[0].second };
+    auto text = dump_of(ssa);
+
+    CHECK(text.find("x#1 = (1:int:4);") != std::string::npos);
+    CHECK(text.find("x = (2:int:4);") == std::string::npos);
+    CHECK(text.find("x = (3:int:4);") == std::string::npos);
+
+    std::size_t phis = 0;
+    for (ir::Block_Index block = 0; block < ssa.cfg().size(); block++) {
+        for (auto const& phi : ssa.phis(block)) {
+            phis++;
+            CHECK(ssa.cfg()[block].predecessors.size() == 2);
+            CHECK(phi.arguments.size() == 2);
+            CHECK(phi.arguments[0] != phi.arguments[1]);
+            CHECK(ssa.variable_of(phi.result) == phi.variable);
+            auto const& result = ir::operand_table().text(phi.result);
+            CHECK(text.find("RET " + result) != std::string::npos);
+        }
+    }
+    CHECK(phis == 1);
+}
+
+TEST_CASE("ssa.cc: a loop header has a phi of the value that enters it and "
+          "the one the body leaves")
+{
+    auto instructions = instructions_of("main() {\n  auto i;\n  i = 0;\n"
+                                        "  while (i < 10) {\n"
+                                        "    i = i + 1;\n  }\n}\n");
+    auto ranges = ir::function_ranges(instructions);
+    REQUIRE(ranges.size() == 1);
+    ir::SSA ssa{ instructions, ranges[0].first, ranges[0].second };
+    REQUIRE(ssa.cfg().loops().size() == 1);
+
+    auto header = ssa.cfg().loops()[0].header;
+    REQUIRE(ssa.phis(header).size() == 1);
+    auto const& phi = ssa.phis(header)[0];
+    CHECK(ir::operand_table().text(phi.variable) == "i");
+    CHECK(phi.arguments[0] != phi.arguments[1]);
+    for (auto argument : phi.arguments)
+        CHECK(ssa.variable_of(argument) == phi.variable);
+}
+
+TEST_CASE("ssa.cc: a loop made by a goto has a phi at its label")
+{
+    auto source = std::string{ "main() {\n  auto x;\n  x = 0;\n"
+                               "top:\n  x = x + 1;\n"
+                               "  if (x < 10) {\n    goto top;\n  }\n"
+                               "  return(x);\n}\n" };
+    auto instructions = instructions_of(source);
+    auto ranges = ir::function_ranges(instructions);
+    REQUIRE(ranges.size() == 1);
+    ir::SSA ssa{ instructions, ranges[0].first, ranges[0].second };
+    REQUIRE(ssa.cfg().loops().size() == 1);
+
+    auto header = ssa.cfg().loops()[0].header;
+    REQUIRE(ssa.phis(header).size() == 1);
+    auto const& phi = ssa.phis(header)[0];
+    CHECK(ir::operand_table().text(phi.variable) == "x");
+    CHECK(phi.arguments[0] != phi.arguments[1]);
+    CHECK(round_trip(source) == text_of(instructions_of(source)));
+}
+
+TEST_CASE("ssa.cc: a cycle with two entries has a phi at each")
+{
+    auto source = std::string{ "main() {\n  auto x;\n  x = 0;\n"
+                               "  if (x > 5) {\n    goto inside;\n  }\n"
+                               "top:\n  x = x + 1;\n"
+                               "inside:\n  x = x + 2;\n"
+                               "  if (x < 10) {\n    goto top;\n  }\n"
+                               "  return(x);\n}\n" };
+    auto instructions = instructions_of(source);
+    auto ranges = ir::function_ranges(instructions);
+    REQUIRE(ranges.size() == 1);
+    ir::SSA ssa{ instructions, ranges[0].first, ranges[0].second };
+    CHECK(ssa.cfg().loops().empty());
+
+    auto x = ir::operand_table().intern("x");
+    std::size_t phis = 0;
+    for (ir::Block_Index block = 0; block < ssa.cfg().size(); block++)
+        for (auto const& phi : ssa.phis(block))
+            if (phi.variable == x) {
+                phis++;
+                CHECK(phi.arguments[0] != phi.arguments[1]);
+            }
+    CHECK(phis >= 2);
+    CHECK(round_trip(source) == text_of(instructions_of(source)));
+}
+
+TEST_CASE("ssa.cc: pointers, vectors, and addresses keep their names")
+{
+    auto instructions = instructions_of("main() {\n  auto *p, v[2], x, y;\n"
+                                        "  x = 1;\n  p = &x;\n  *p = 2;\n"
+                                        "  v[0] = 3;\n  y = 4;\n"
+                                        "  y = x + y;\n}\n");
+    auto ranges = ir::function_ranges(instructions);
+    REQUIRE(ranges.size() == 1);
+    ir::SSA ssa{ instructions, ranges[0].first, ranges[0].second };
+    auto text = dump_of(ssa);
+
+    auto& table = ir::operand_table();
+    CHECK_FALSE(ssa.is_variable(table.intern("x")));
+    CHECK_FALSE(ssa.is_variable(table.intern("p")));
+    CHECK_FALSE(ssa.is_variable(table.intern("v")));
+    CHECK(ssa.is_variable(table.intern("y")));
+    CHECK(text.find("x = (1:int:4);") != std::string::npos);
+    CHECK(text.find("y#1 = (4:int:4);") != std::string::npos);
+}
+
+TEST_CASE("ssa.cc: a name with a dot in it is split as one name")
+{
+    auto source = std::string{ "main() {\n  auto k.ll;\n  k.ll = 1;\n"
+                               "  if (k.ll > 0) {\n    k.ll = 2;\n  }\n"
+                               "  return(k.ll);\n}\n" };
+    auto instructions = instructions_of(source);
+    auto ranges = ir::function_ranges(instructions);
+    REQUIRE(ranges.size() == 1);
+    ir::SSA ssa{ instructions, ranges[0].first, ranges[0].second };
+    auto text = dump_of(ssa);
+
+    auto& table = ir::operand_table();
+    CHECK(ssa.is_variable(table.intern("k.ll")));
+    CHECK_FALSE(ssa.is_variable(table.intern("k")));
+    CHECK(text.find("k.ll#1 = (1:int:4);") != std::string::npos);
+    CHECK(text.find("k.ll#2 = (2:int:4);") != std::string::npos);
+    CHECK(table.kind(table.intern("k.ll#2")) == ir::Operand_Kind::Symbol);
+    CHECK(round_trip(source) == text_of(instructions_of(source)));
+}
+
+TEST_CASE("ssa.cc: an increment is a new version of the name it changes")
+{
+    auto source = std::string{ "main() {\n  auto x, y;\n  x = 1;\n"
+                               "  y = ++x + 1;\n  return(x);\n}\n" };
+    auto instructions = instructions_of(source);
+    auto ranges = ir::function_ranges(instructions);
+    REQUIRE(ranges.size() == 1);
+    ir::SSA ssa{ instructions, ranges[0].first, ranges[0].second };
+    auto text = dump_of(ssa);
+
+    CHECK(text.find("x#2 = ++x#1;") != std::string::npos);
+    CHECK(text.find("_t2#1 = x#2 + (1:int:4);") != std::string::npos);
+    CHECK(text.find("RET x#2") != std::string::npos);
+    CHECK(round_trip(source) == text_of(instructions_of(source)));
+}
+
+TEST_CASE("ssa.cc: a function into SSA form and back is the function it was")
+{
+    std::string const sources[] = {
+        "main() {\n  auto x;\n  x = 1;\n  if (x > 1) {\n    x = 2;\n"
+        "  } else {\n    x = 3;\n  }\n  return(x);\n}\n",
+        "main() {\n  auto i, j, k;\n  i = 0;\n  k = 0;\n"
+        "  while (i < 10) {\n    j = 0;\n    while (j < i) {\n"
+        "      k = k + j;\n      j++;\n    }\n    i = i + 1;\n  }\n"
+        "  return(k);\n}\n",
+        "f(a, b) {\n  auto t;\n  while (a < b) {\n    t = a;\n"
+        "    a = b;\n    b = t;\n  }\n  return(a);\n}\n"
+        "main() {\n  return(f(1, 2));\n}\n",
+        "main() {\n  auto x;\n  x = 2;\n  switch (x) {\n"
+        "    case 1:\n      x = 5;\n      break;\n    case 2:\n"
+        "      x = 6;\n      break;\n  }\n  return(x);\n}\n",
+        "main() {\n  auto x;\n  x = 1;\n  goto done;\n  x = 2;\n"
+        "done:\n  x = 3;\n}\n"
+    };
+    for (auto const& source : sources)
+        CHECK(round_trip(source) == text_of(instructions_of(source)));
+}
@@ -2,8 +2,9 @@
 
 #include <credence/frontend/compile.h> // for compile
 #include <credence/frontend/hir/hir.h> // for Unit
-#include <credence/ir/symbols.h>       // for hoisted_symbols
-#include <credence/util.h>             // for AST_Node
+#include <credence/ir/symbols.h>       // for Symbols, hoisted_symbols
+#include <credence/util.h>             // for AST_Node, read_file_from...
+#include <easyjson.h>                  // for JSON
 #include <filesystem>                  // for path
 #include <fmt/format.h>                // for format
 #include <string>                      // for string
@@ -35,7 +36,7 @@ inline std::filesystem::path root_path()
 /**
  * @brief The hoisted symbol table of a source string
  */
-credence::util::AST_Node symbols_of(std::string const& source)
+credence::ir::Symbols symbols_of(std::string const& source)
 {
     auto program = credence::frontend::compile(source);
     return credence::ir::hoisted_symbols(program.unit);
@@ -44,11 +45,13 @@ credence::util::AST_Node symbols_of(std::string const& source)
 /**
  * @brief The shape a name was given, or empty when it is absent
  */
-std::string shape_of(credence::util::AST_Node& table, std::string const& name)
+std::string shape_of(credence::ir::Symbols const& table,
+    std::string const& name)
 {
-    if (!table.has_key(name))
+    auto const* symbol = table.find(name);
+    if (symbol == nullptr)
         return {};
-    return table[name]["type"].to_string();
+    return std::string{ credence::ir::shape_name(symbol->shape) };
 }
 
 } // namespace
@@ -72,14 +75,14 @@ TEST_CASE("symbols.cc: a vector at file scope carries its size")
     auto table = symbols_of("main() {\n  auto x;\n  x = 1;\n}\n"
                             "mess [2] \"a\", \"b\";\n");
     CHECK(shape_of(table, "mess") == "vector_definition");
-    CHECK(table["mess"]["size"].to_int() == 2);
+    CHECK(table.find("mess")->size == 2);
 }
 
 TEST_CASE("symbols.cc: a vector inside a function carries its size")
 {
     auto table = symbols_of("main() {\n  auto v[3];\n  v[0] = 1;\n}\n");
     CHECK(shape_of(table, "v") == "vector_lvalue");
-    CHECK(table["v"]["size"].to_int() == 3);
+    CHECK(table.find("v")->size == 3);
 }
 
 TEST_CASE("symbols.cc: a parameter is a declared name")
@@ -104,7 +107,7 @@ TEST_CASE("symbols.cc: an extrn vector keeps the shape of its definition")
                             "  x = mess[1];\n}\n"
                             "mess [2] \"a\", \"b\";\n");
     CHECK(shape_of(table, "mess") == "vector_definition");
-    CHECK(table["mess"]["size"].to_int() == 2);
+    CHECK(table.find("mess")->size == 2);
 }
 
 TEST_CASE("symbols.cc: a label is a declared name")
@@ -132,6 +135,36 @@ TEST_CASE("symbols.cc: every fixture builds a table")
                         .append(fmt::format("{}.b", name));
         auto source = credence::util::read_file_from_path(path.string());
         auto table = symbols_of(source);
-        CHECK(!table.dump_keys().empty());
+        CHECK(!table.empty());
     }
 }
+
+TEST_CASE("symbols.cc: a layer is found first and is not copied")
+{
+    credence::ir::Symbols layer{};
+    layer.add({ .name = "printf",
+        .shape = credence::ir::Shape::Function_Definition });
+
+    auto table = symbols_of("printf() {\n  auto x;\n  x = 1;\n}\n");
+    auto own = table.size();
+    table.layer_over(layer);
+    CHECK(table.size() == own);
+    CHECK(table.find("printf") == &layer[0]);
+    CHECK(shape_of(table, "x") == "lvalue");
+
+    std::size_t printf_count = 0;
+    table.for_each([&](credence::ir::Symbol const& symbol) {
+        if (symbol.name == "printf")
+            printf_count++;
+    });
+    CHECK(printf_count == 1);
+}
+
+TEST_CASE("symbols.cc: the table is written as the json -s prints")
+{
+    auto table = symbols_of("main() {\n  auto v[3];\n  v[0] = 1;\n}\n");
+    auto json = credence::ir::to_json(table);
+    CHECK(json["main"]["type"].to_string() == "function_definition");
+    CHECK(json["v"]["type"].to_string() == "vector_lvalue");
+    CHECK(json["v"]["size"].to_int() == 3);
+}
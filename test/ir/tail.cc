@@ -0,0 +1,115 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase
+
+#include "instructions.h"     // for each_function, function_of
+#include <credence/ir/tail.h> // for eliminate_tail_recursion
+#include <cstddef>            // for size_t
+#include <string>             // for string
+#include <utility>            // for pair
+
+/****************************************************************************
+ *
+ * Tail recursion
+ *
+ * A call of a function by itself whose value it returns is a jump to its
+ * start, each one of them, and one whose value it computes with first, or
+ * of a function whose frame an address reaches, is a call still.
+ *
+ ****************************************************************************/
+
+namespace ir = credence::ir;
+using credence::test::function_of;
+using credence::test::each_function;
+
+namespace {
+
+/**
+ * @brief Each function of the ITA of a source with its tail recursion
+ * made a loop, as the text -t ir prints, and the calls replaced
+ */
+std::pair<std::string, std::size_t> looped(std::string const& source)
+{
+    std::size_t replaced = 0;
+    auto text = each_function(source,
+        [&](auto& instructions, std::size_t begin, std::size_t end) {
+            auto function = function_of(instructions, begin, end);
+            replaced += ir::eliminate_tail_recursion(function);
+            return function;
+        });
+    return { text, replaced };
+}
+
+/**
+ * @brief The value a name is last assigned in the text before an offset,
+ * through each temporary it is a copy of
+ */
+std::string assigned(std::string const& text,
+    std::string name,
+    std::size_t before)
+{
+    for (;;) {
+        auto at = text.rfind("    " + name + " = ", before);
+        if (at == std::string::npos)
+            return {};
+        auto begin = at + name.size() + 7;
+        auto value = text.substr(begin, text.find(';', begin) - begin);
+        if (not value.starts_with("_t") or value.find(' ') != std::string::npos)
+            return value;
+        name = value;
+        before = at;
+    }
+}
+
+} // namespace
+
+TEST_CASE("tail.cc: a call whose value the function returns is a loop")
+{
+    auto [text, replaced] =
+        looped("count(n, s) {\n  auto r;\n  r = s;\n"
+               "  if (n > 0)\n    r = count(n - 1, s + n);\n"
+               "  return(r);\n}\n"
+               "main() {\n  auto a;\n  a = count(10, 0);\n"
+               "  return(a);\n}\n");
+    CHECK(replaced == 1);
+    auto main = text.find("__main(");
+    CHECK(text.find("CALL count") > main);
+    CHECK(text.find("n = _t") < main);
+    // the arguments are pushed last first, and each is still assigned to
+    // its own parameter
+    CHECK(assigned(text, "n", main) == "n - (1:int:4)");
+    CHECK(assigned(text, "s", main) == "s + n");
+}
+
+TEST_CASE("tail.cc: a call whose value is computed with is kept")
+{
+    auto [text, replaced] =
+        looped("fact(n) {\n  auto r;\n  r = 1;\n"
+               "  if (n > 1)\n    r = n * fact(n - 1);\n"
+               "  return(r);\n}\n"
+               "main() {\n  auto a;\n  a = fact(5);\n  return(a);\n}\n");
+    CHECK(replaced == 0);
+    CHECK(text.find("CALL fact") < text.find("__main("));
+}
+
+TEST_CASE("tail.cc: each call in tail position is replaced")
+{
+    auto [text, replaced] =
+        looped("f(n, s) {\n  if (n > 10) {\n    return(f(n - 2, s));\n  }\n"
+               "  if (n > 0) {\n    return(f(n - 1, s + 1));\n  }\n"
+               "  return(s);\n}\n"
+               "main() {\n  return(f(20, 0));\n}\n");
+    CHECK(replaced == 2);
+    CHECK(text.find("CALL f") > text.find("__main("));
+}
+
+TEST_CASE("tail.cc: a function whose parameter has its address taken keeps "
+          "its calls")
+{
+    auto [text, replaced] =
+        looped("count(n, s) {\n  auto r, p;\n  p = &n;\n  r = s;\n"
+               "  if (n > 0)\n    r = count(n - 1, s + n);\n"
+               "  return(r);\n}\n"
+               "main() {\n  auto a;\n  a = count(10, 0);\n"
+               "  return(a);\n}\n");
+    CHECK(replaced == 0);
+    CHECK(text.find("CALL count") < text.find("__main("));
+}
@@ -0,0 +1,99 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <credence/frontend/compile.h> // for compile
+#include <credence/passes.h>           // for Report, Scope, active_report
+#include <sstream>                     // for ostringstream
+#include <string>                      // for string
+
+using namespace credence;
+
+namespace {
+
+/**
+ * @brief The value of a named count on a record, or zero
+ */
+std::size_t count_of(passes::Record const& record, std::string_view what)
+{
+    for (auto const& [name, value] : record.counts)
+        if (name == what)
+            return value;
+    return 0;
+}
+
+} // namespace
+
+TEST_CASE("passes.cc: a scope with no active report records nothing")
+{
+    passes::Report report{};
+    {
+        passes::Scope pass{ "idle" };
+        pass.count("things", 3);
+    }
+    CHECK(report.records().empty());
+}
+
+TEST_CASE("passes.cc: every frontend stage is recorded in order")
+{
+    passes::Report report{};
+    passes::active_report = &report;
+    auto program = frontend::compile(
+        std::string{ "main() {\n  auto x;\n  x = 1 + 2;\n  return(x);\n}\n" });
+    passes::active_report = nullptr;
+
+    CHECK_FALSE(program.failed());
+    REQUIRE(report.records().size() == 4);
+    auto const& records = report.records();
+    CHECK(records[0].name == "parse");
+    CHECK(records[1].name == "lower");
+    CHECK(records[2].name == "check");
+    CHECK(records[3].name == "address");
+
+    CHECK(count_of(records[0], "tokens") > 10);
+    CHECK(count_of(records[0], "ast_nodes") == program.tree.nodes.size());
+    CHECK(count_of(records[1], "hir_nodes") == program.unit.nodes.size());
+    for (auto const& record : records) {
+        CHECK(record.wall_ms >= 0);
+        CHECK(record.cpu_ms >= 0);
+    }
+}
+
+TEST_CASE("passes.cc: a report is written as a table and as json")
+{
+    passes::Report report{};
+    passes::active_report = &report;
+    {
+        passes::Scope pass{ "parse" };
+        pass.count("tokens", 12);
+    }
+    passes::active_report = nullptr;
+
+    auto table = std::ostringstream{};
+    report.dump_table(table);
+    CHECK(table.str().find("parse") != std::string::npos);
+    CHECK(table.str().find("tokens=12") != std::string::npos);
+    CHECK(table.str().find("total") != std::string::npos);
+
+    auto json = std::ostringstream{};
+    report.dump_json(json);
+    CHECK(json.str().find("\"name\": \"parse\"") != std::string::npos);
+    CHECK(json.str().find("\"counts\": {\"tokens\": 12}") !=
+          std::string::npos);
+}
+
+TEST_CASE("passes.cc: the names and keys of a json report are escaped")
+{
+    passes::Report report{};
+    passes::active_report = &report;
+    {
+        passes::Scope pass{ "dead\"blocks" };
+        pass.count("f\\g\n", 2);
+    }
+    passes::active_report = nullptr;
+
+    auto json = std::ostringstream{};
+    report.dump_json(json);
+    CHECK(json.str().find("\"name\": \"dead\\\"blocks\"") !=
+          std::string::npos);
+    CHECK(json.str().find("\"counts\": {\"f\\\\g\\n\": 2}") !=
+          std::string::npos);
+}
@@ -0,0 +1,248 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include "../common/emitted.h"                // for emitted, function_text
+#include <credence/target/common/options.h>   // for Target_Options
+#include <credence/target/x86_64/generator.h> // for emit
+#include <cstddef>                            // for size_t
+#include <optional>                           // for optional, nullopt
+#include <set>                                // for set
+#include <string>                             // for string, stoul
+
+/****************************************************************************
+ *
+ * x86-64 target passes
+ *
+ * Under --regalloc a local has to be kept in a callee-saved register
+ * through its loops and the calls it lives across, a function has to save
+ * an even number of the registers it was given, and a local has to keep
+ * its slot once all four are taken. Under --slots two locals whose
+ * lifetimes do not overlap have to share a slot, and under --leaf a
+ * function that calls nothing has to lose its frame pointer, unless its
+ * slots do not fit in the red zone.
+ *
+ * The passes are checked by what the machine code they change must and
+ * must not hold, rather than against a golden file of it.
+ *
+ ****************************************************************************/
+
+using namespace credence::target;
+using credence::test::function_text;
+using credence::test::occurrences;
+
+namespace {
+
+/**
+ * @brief The x86-64 machine code of a source under the target passes set
+ */
+std::string emitted(std::string const& source, common::Target_Options options)
+{
+    return credence::test::emitted(x86_64::emit, source, options);
+}
+
+/**
+ * @brief The distinct offsets below rbp the text addresses
+ */
+std::set<std::size_t> frame_offsets(std::string const& text)
+{
+    std::string const address = "[rbp - ";
+    std::set<std::size_t> offsets{};
+    for (auto at = text.find(address); at != std::string::npos;
+        at = text.find(address, at + 1))
+        offsets.insert(std::stoul(text.substr(at + address.size())));
+    return offsets;
+}
+
+/**
+ * @brief The offset below rbp the text first stores an immediate to
+ */
+std::optional<std::size_t> stored_at(std::string const& text,
+    std::string const& immediate)
+{
+    std::string const address = "mov dword ptr [rbp - ";
+    for (auto at = text.find(address); at != std::string::npos;
+        at = text.find(address, at + 1)) {
+        auto end = text.find('\n', at);
+        auto line = text.substr(at, end - at);
+        if (line.ends_with("], " + immediate))
+            return std::stoul(line.substr(address.size()));
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+TEST_CASE("x86_64/passes.cc: a local of a loop is kept in a register")
+{
+    auto text = emitted("main() {\n  auto i;\n  i = 0;\n"
+                        "  while (i < 10)\n    i = i + 1;\n}\n",
+        { .regalloc = true });
+    CHECK(text.find("mov ebx, 0") != std::string::npos);
+    CHECK(text.find("mov ebx, eax") != std::string::npos);
+    CHECK(text.find("dword ptr [rbp - 4]") == std::string::npos);
+    // main never returns, so saves nothing
+    CHECK(text.find("push rbx") == std::string::npos);
+}
+
+TEST_CASE("x86_64/passes.cc: a register live across a call is saved by the "
+          "function, with one more to keep the stack aligned")
+{
+    auto text = emitted("main() {\n  f(10);\n}\n"
+                        "g() {\n  return(1);\n}\n"
+                        "f(n) {\n  auto i;\n  i = 0;\n"
+                        "  while (i < 10) {\n    g();\n"
+                        "    i = i + 1;\n  }\n  return(n);\n}\n",
+        { .regalloc = true });
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+    CHECK(f.find("call g") != std::string::npos);
+    CHECK(f.find("ebx") > f.find("push rbp"));
+
+    // rbx and then r12, before the prologue, and back in reverse before
+    // the ret
+    auto push = f.find("push rbx");
+    REQUIRE(push != std::string::npos);
+    CHECK(push < f.find("push r12"));
+    CHECK(f.find("push r12") < f.find("push rbp"));
+    CHECK(f.find("pop r12") < f.find("pop rbx"));
+    CHECK(f.find("pop rbx") < f.find("ret"));
+    CHECK(occurrences(text, "push rbx") == 1);
+    CHECK(occurrences(text, "push r13") == 0);
+}
+
+TEST_CASE("x86_64/passes.cc: a local keeps its slot once all four registers "
+          "are taken")
+{
+    auto text = emitted("main() {\n  f(100);\n}\n"
+                        "f(n) {\n  auto a, b, c, d, e;\n"
+                        "  a = 1;\n  b = 2;\n  c = 3;\n  d = 4;\n"
+                        "  e = 0;\n  while (e < 100) {\n"
+                        "    e = e + a;\n    e = e + b;\n"
+                        "    e = e + c;\n    e = e + d;\n  }\n"
+                        "  return(e);\n}\n",
+        { .regalloc = true });
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+    for (auto const* device : { "push rbx", "push r12", "push r13",
+             "push r14", "pop r14", "pop r13", "pop r12", "pop rbx" })
+        CHECK(f.find(device) != std::string::npos);
+    CHECK(f.find("dword ptr [rbp - ") != std::string::npos);
+}
+
+TEST_CASE("x86_64/passes.cc: two locals whose lifetimes do not overlap share "
+          "a slot")
+{
+    auto source = std::string{ "main() {\n  f(1);\n}\n"
+                               "f(a) {\n  auto x, y, z;\n  x = a * 2;\n"
+                               "  y = x + 10;\n  z = y - 5;\n"
+                               "  return(z);\n}\n" };
+    auto before = frame_offsets(function_text(emitted(source, {}), "f"));
+    auto after = frame_offsets(
+        function_text(emitted(source, { .slots = true }), "f"));
+    REQUIRE_FALSE(after.empty());
+    CHECK(after.size() < before.size());
+    CHECK(*after.rbegin() < *before.rbegin());
+}
+
+TEST_CASE("x86_64/passes.cc: the slots of a vector are kept while the "
+          "scalars around them share")
+{
+    auto source = std::string{ "main() {\n  f(1);\n}\n"
+                               "f(a) {\n  auto v[4], x, y, z;\n"
+                               "  v[0] = 1;\n  x = a * 2;\n"
+                               "  y = x + 10;\n  z = y - 5;\n"
+                               "  v[1] = 2;\n  return(z);\n}\n" };
+    auto before = function_text(emitted(source, {}), "f");
+    auto after = function_text(emitted(source, { .slots = true }), "f");
+    REQUIRE(stored_at(before, "1").has_value());
+    REQUIRE(stored_at(before, "2").has_value());
+    CHECK(stored_at(after, "1") == stored_at(before, "1"));
+    CHECK(stored_at(after, "2") == stored_at(before, "2"));
+    CHECK(frame_offsets(after).size() < frame_offsets(before).size());
+}
+
+TEST_CASE("x86_64/passes.cc: a leaf function loses its frame pointer")
+{
+    auto text = emitted("main() {\n  f(1);\n}\n"
+                        "f(a) {\n  auto x;\n  x = a * 2;\n"
+                        "  return(x);\n}\n",
+        { .leaf = true });
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+    CHECK(f.find("push rbp") == std::string::npos);
+    CHECK(f.find("pop rbp") == std::string::npos);
+    CHECK(f.find("[rbp") == std::string::npos);
+    CHECK(f.find("[rsp - ") != std::string::npos);
+    CHECK(f.find("ret") != std::string::npos);
+}
+
+TEST_CASE("x86_64/passes.cc: a function that calls keeps its frame pointer")
+{
+    auto text = emitted("main() {\n  f(1);\n}\n"
+                        "g(a) {\n  return(a);\n}\n"
+                        "f(a) {\n  auto x;\n  x = g(a);\n"
+                        "  return(x);\n}\n",
+        { .leaf = true });
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+    CHECK(f.find("push rbp") != std::string::npos);
+    CHECK(f.find("pop rbp") != std::string::npos);
+    CHECK(function_text(text, "g").find("push rbp") == std::string::npos);
+}
+
+TEST_CASE("x86_64/passes.cc: a leaf whose slots pass the red zone keeps its "
+          "frame pointer")
+{
+    // a vector takes slots only for the elements it touches, so spill
+    // enough scalars to pass the 128 bytes below rsp
+    std::string locals{};
+    std::string stores{};
+    for (int i = 0; i < 36; i++) {
+        auto name = "x" + std::to_string(i);
+        locals += (i ? ", " : "") + name;
+        stores += "  " + name + " = " + std::to_string(i) + ";\n";
+    }
+    auto text = emitted("main() {\n  f(1);\n}\n"
+                        "f(a) {\n  auto " + locals + ";\n" + stores +
+                            "  return(a);\n}\n",
+        { .leaf = true });
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+    CHECK(f.find("push rbp") != std::string::npos);
+    CHECK(f.find("[rsp - ") == std::string::npos);
+}
+
+TEST_CASE("x86_64/passes.cc: a leaf that saves registers addresses its "
+          "slots in the red zone below the pushes")
+{
+    auto text = emitted("main() {\n  g(100);\n  f(10);\n}\n"
+                        "g(n) {\n  auto a, b, c, d, e;\n"
+                        "  a = 1;\n  b = 2;\n  c = 3;\n  d = 4;\n"
+                        "  e = 0;\n  while (e < 100) {\n"
+                        "    e = e + a;\n    e = e + b;\n"
+                        "    e = e + c;\n    e = e + d;\n  }\n"
+                        "  return(e);\n}\n"
+                        "h() {\n  return(1);\n}\n"
+                        "f(n) {\n  auto i;\n  i = 0;\n"
+                        "  while (i < 10) {\n    h();\n"
+                        "    i = i + 1;\n  }\n  return(n);\n}\n",
+        { .regalloc = true, .leaf = true });
+
+    // the registers g was given are pushed without a frame pointer, and
+    // the slot it spills is addressed below them
+    auto g = function_text(text, "g");
+    REQUIRE_FALSE(g.empty());
+    CHECK(g.find("push rbp") == std::string::npos);
+    CHECK(g.find("[rbp") == std::string::npos);
+    auto slot = g.find("dword ptr [rsp - ");
+    REQUIRE(slot != std::string::npos);
+    CHECK(g.find("push r14") < slot);
+    CHECK(g.find("pop r14") < g.find("pop rbx"));
+    CHECK(g.find("pop rbx") < g.find("ret"));
+    CHECK(function_text(text, "h").find("push") == std::string::npos);
+
+    // f calls, so keeps its frame pointer inside the registers it saves
+    auto f = function_text(text, "f");
+    REQUIRE_FALSE(f.empty());
+    CHECK(f.find("push r12") < f.find("push rbp"));
+    CHECK(f.find("pop rbp") < f.find("pop r12"));
+}
@@ -0,0 +1,263 @@
+#include <doctest/doctest.h> // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <credence/target/common/assembly.h> // for make_numeric_immediate
+#include <credence/target/common/flags.h>    // for Flag_Accessor
+#include <credence/target/x86_64/assembly.h> // for Instruction, Register
+#include <credence/target/x86_64/peephole.h> // for rewrite_instructions
+#include <cstddef>                           // for size_t
+#include <string>                            // for string
+#include <string_view>                       // for string_view
+#include <variant>                           // for get
+
+/****************************************************************************
+ *
+ * x86-64 peephole patterns
+ *
+ * Each pattern has to rewrite the window it is made for and count it, and
+ * has to leave a window alone where the rewrite would change what the
+ * program does: a dword self-move or identity that clears the upper half,
+ * and the arithmetic whose status flags a conditional jump or set may still
+ * read.
+ *
+ ****************************************************************************/
+
+using namespace credence::target;
+using namespace credence::target::x86_64;
+
+namespace {
+
+using Instructions = assembly::Instructions;
+using Label = common::Label;
+using Offset = common::Stack_Offset;
+
+/**
+ * @brief Rewrite the instructions of the function f, and give back the
+ * hits of the pattern named
+ */
+std::size_t rewrite(Instructions& instructions,
+    std::string_view pattern,
+    common::Flag_Accessor& flags)
+{
+    auto hits = rewrite_instructions(
+        instructions, flags, [](Label const& label) { return label == "f"; });
+    std::size_t count = 0;
+    for (auto const& [name, hit] : hits)
+        if (name == pattern)
+            count = hit;
+    return count;
+}
+
+std::size_t rewrite(Instructions& instructions, std::string_view pattern)
+{
+    common::Flag_Accessor flags{};
+    return rewrite(instructions, pattern, flags);
+}
+
+assembly::Immediate integer(int value)
+{
+    return common::assembly::make_numeric_immediate(value);
+}
+
+assembly::Immediate label(std::string const& name)
+{
+    return common::assembly::make_direct_immediate(
+        assembly::make_label(name, "f"));
+}
+
+assembly::Instruction const& instruction_at(Instructions const& instructions,
+    std::size_t index)
+{
+    return std::get<assembly::Instruction>(instructions[index]);
+}
+
+} // namespace
+
+TEST_CASE("x86_64/peephole.cc: a qword self-move is dropped")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::mov, Register::rax, Register::rax },
+        assembly::Instruction{ Mnemonic::ret, {}, {} },
+    };
+    CHECK(rewrite(instructions, "self-move") == 1);
+    REQUIRE(instructions.size() == 2);
+    CHECK(std::get<0>(instruction_at(instructions, 1)) == Mnemonic::ret);
+}
+
+TEST_CASE("x86_64/peephole.cc: a dword self-move is kept, as it clears the "
+          "upper half")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::mov, Register::eax, Register::eax },
+        assembly::Instruction{ Mnemonic::ret, {}, {} },
+    };
+    CHECK(rewrite(instructions, "self-move") == 0);
+    CHECK(instructions.size() == 3);
+}
+
+TEST_CASE("x86_64/peephole.cc: a reload of a slot just stored reads the "
+          "register stored")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::mov, Offset{ 4 }, Register::eax },
+        assembly::Instruction{ Mnemonic::mov, Register::ecx, Offset{ 4 } },
+        assembly::Instruction{ Mnemonic::mov, Offset{ 8 }, Register::rax },
+        assembly::Instruction{ Mnemonic::mov, Register::rax, Offset{ 8 } },
+    };
+    CHECK(rewrite(instructions, "store-reload") == 2);
+    REQUIRE(instructions.size() == 4);
+    CHECK(instruction_at(instructions, 2) ==
+          assembly::Instruction{ Mnemonic::mov, Register::ecx, Register::eax });
+    CHECK(instruction_at(instructions, 3) ==
+          assembly::Instruction{ Mnemonic::mov, Offset{ 8 }, Register::rax });
+}
+
+TEST_CASE("x86_64/peephole.cc: a store of the register a slot was loaded "
+          "into is dropped")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::mov, Register::eax, Offset{ 4 } },
+        assembly::Instruction{ Mnemonic::mov, Offset{ 4 }, Register::eax },
+    };
+    CHECK(rewrite(instructions, "load-store") == 1);
+    CHECK(instructions.size() == 2);
+}
+
+TEST_CASE("x86_64/peephole.cc: a jump to the next label is dropped")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::goto_, label("_L2"), {} },
+        Label{ "_L2" },
+        assembly::Instruction{ Mnemonic::goto_, label("_L2"), {} },
+        Label{ "_L3" },
+    };
+    CHECK(rewrite(instructions, "jump-to-next") == 1);
+    REQUIRE(instructions.size() == 4);
+    CHECK(std::get<Label>(instructions[1]) == "_L2");
+}
+
+TEST_CASE("x86_64/peephole.cc: an add or sub of zero is dropped")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::add, Register::rax, integer(0) },
+        assembly::Instruction{ Mnemonic::sub, Offset{ 4 }, integer(0) },
+        assembly::Instruction{ Mnemonic::ret, {}, {} },
+    };
+    CHECK(rewrite(instructions, "add-zero") == 2);
+    CHECK(instructions.size() == 2);
+}
+
+TEST_CASE("x86_64/peephole.cc: an add of zero or a multiply by one of a "
+          "dword register is a mov, as it clears the upper half")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::add, Register::eax, integer(0) },
+        assembly::Instruction{ Mnemonic::imul, Register::ecx, integer(1) },
+        assembly::Instruction{ Mnemonic::ret, {}, {} },
+    };
+    common::Flag_Accessor flags{};
+    auto hits = rewrite_instructions(
+        instructions, flags, [](Label const& label) { return label == "f"; });
+    for (auto const& [name, hit] : hits) {
+        if (name == "add-zero" or name == "mul-one")
+            CHECK(hit == 1);
+        else
+            CHECK(hit == 0);
+    }
+    REQUIRE(instructions.size() == 4);
+    CHECK(instruction_at(instructions, 1) ==
+          assembly::Instruction{ Mnemonic::mov, Register::eax, Register::eax });
+    CHECK(instruction_at(instructions, 2) ==
+          assembly::Instruction{ Mnemonic::mov, Register::ecx, Register::ecx });
+}
+
+TEST_CASE("x86_64/peephole.cc: a multiply by one is dropped and by two is "
+          "an add")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::imul, Register::rax, integer(1) },
+        assembly::Instruction{ Mnemonic::imul, Register::ecx, integer(2) },
+        assembly::Instruction{ Mnemonic::ret, {}, {} },
+    };
+    common::Flag_Accessor flags{};
+    auto hits = rewrite_instructions(
+        instructions, flags, [](Label const& label) { return label == "f"; });
+    for (auto const& [name, hit] : hits) {
+        if (name == "mul-one" or name == "mul-two")
+            CHECK(hit == 1);
+        else
+            CHECK(hit == 0);
+    }
+    REQUIRE(instructions.size() == 3);
+    CHECK(instruction_at(instructions, 1) ==
+          assembly::Instruction{ Mnemonic::add, Register::ecx, Register::ecx });
+}
+
+TEST_CASE("x86_64/peephole.cc: arithmetic is kept when a conditional jump "
+          "or set reads its flags later")
+{
+    Instructions jump{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::add, Register::eax, integer(0) },
+        assembly::Instruction{ Mnemonic::mov, Register::ecx, Register::eax },
+        assembly::Instruction{ Mnemonic::je, label("_L2"), {} },
+        Label{ "_L2" },
+    };
+    CHECK(rewrite(jump, "add-zero") == 0);
+    CHECK(jump.size() == 5);
+
+    Instructions set{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::imul, Register::eax, integer(1) },
+        assembly::Instruction{ Mnemonic::setl, Register::al, {} },
+    };
+    CHECK(rewrite(set, "mul-one") == 0);
+    CHECK(set.size() == 3);
+}
+
+TEST_CASE("x86_64/peephole.cc: arithmetic is kept before a label or a jmp, "
+          "and dropped when its flags are set again first")
+{
+    Instructions labelled{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::add, Register::eax, integer(0) },
+        Label{ "_L2" },
+        assembly::Instruction{ Mnemonic::ret, {}, {} },
+    };
+    CHECK(rewrite(labelled, "add-zero") == 0);
+
+    Instructions jumped{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::add, Register::eax, integer(0) },
+        assembly::Instruction{ Mnemonic::goto_, label("_L3"), {} },
+    };
+    CHECK(rewrite(jumped, "add-zero") == 0);
+
+    Instructions compared{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::add, Register::rax, integer(0) },
+        assembly::Instruction{ Mnemonic::cmp, Register::eax, Register::ecx },
+        assembly::Instruction{ Mnemonic::je, label("_L2"), {} },
+    };
+    CHECK(rewrite(compared, "add-zero") == 1);
+    CHECK(compared.size() == 3);
+}
+
+TEST_CASE("x86_64/peephole.cc: a window with a flagged instruction is kept")
+{
+    Instructions instructions{
+        Label{ "f" },
+        assembly::Instruction{ Mnemonic::mov, Register::rax, Register::rax },
+    };
+    common::Flag_Accessor flags{};
+    flags.set_instruction_flag(common::flag::Address, 1);
+    CHECK(rewrite(instructions, "self-move", flags) == 0);
+    CHECK(instructions.size() == 2);
+}